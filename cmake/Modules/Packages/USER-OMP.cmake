@@ -24,6 +24,10 @@
     list(APPEND USER-OMP_SOURCES ${USER-OMP_SOURCES_DIR}/fix_rigid_nh_omp.cpp)
   endif()
 
+  if(PKG_USER-CAC)
+    list(APPEND USER-OMP_SOURCES ${USER-OMP_SOURCES_DIR}/pair_cac_omp.cpp)
+  endif()
+
   if(PKG_USER-REAXC)
     list(APPEND USER-OMP_SOURCES ${USER-OMP_SOURCES_DIR}/reaxc_bond_orders_omp.cpp
                                  ${USER-OMP_SOURCES_DIR}/reaxc_hydrogen_bonds_omp.cpp
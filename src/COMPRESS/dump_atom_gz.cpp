@@ -32,6 +32,7 @@ DumpAtomGZ::DumpAtomGZ(LAMMPS *lmp, int narg, char **arg) :
 
 DumpAtomGZ::~DumpAtomGZ()
 {
+  async_stop();
 }
 
 /* ----------------------------------------------------------------------
@@ -101,6 +102,13 @@ void DumpAtomGZ::openfile()
 
 void DumpAtomGZ::write_header(bigint ndump)
 {
+  // a snapshot captured for the writer thread is compressed by it
+
+  if (async_capture) {
+    DumpAtom::write_header(ndump);
+    return;
+  }
+
   std::string header;
 
   if ((multiproc) || (!multiproc && me == 0)) {
@@ -136,6 +144,11 @@ void DumpAtomGZ::write_header(bigint ndump)
 
 void DumpAtomGZ::write_data(int n, double *mybuf)
 {
+  if (async_capture) {
+    DumpAtom::write_data(n, mybuf);
+    return;
+  }
+
   if (buffer_flag == 1) {
     writer.write(mybuf, n);
   } else {
@@ -170,7 +183,7 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 void DumpAtomGZ::write()
 {
   DumpAtom::write();
-  if (filewriter) {
+  if (filewriter && !async) {
     if (multifile) {
       writer.close();
     } else {
@@ -181,6 +194,29 @@ void DumpAtomGZ::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   output of the writer thread goes through the compressing writer
+------------------------------------------------------------------------- */
+
+size_t DumpAtomGZ::async_output(FILE *, const char *data, size_t n)
+{
+  return writer.write(data, n);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpAtomGZ::async_flush(FILE *)
+{
+  if (writer.isopen()) writer.flush();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpAtomGZ::async_close(FILE *)
+{
+  writer.close();
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpAtomGZ::modify_param(int narg, char **arg)
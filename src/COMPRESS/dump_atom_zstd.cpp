@@ -40,6 +40,7 @@ DumpAtomZstd::DumpAtomZstd(LAMMPS *lmp, int narg, char **arg) :
 
 DumpAtomZstd::~DumpAtomZstd()
 {
+  async_stop();
 }
 
 /* ----------------------------------------------------------------------
@@ -109,6 +110,13 @@ void DumpAtomZstd::openfile()
 
 void DumpAtomZstd::write_header(bigint ndump)
 {
+  // a snapshot captured for the writer thread is compressed by it
+
+  if (async_capture) {
+    DumpAtom::write_header(ndump);
+    return;
+  }
+
   std::string header;
 
   if ((multiproc) || (!multiproc && me == 0)) {
@@ -144,6 +152,11 @@ void DumpAtomZstd::write_header(bigint ndump)
 
 void DumpAtomZstd::write_data(int n, double *mybuf)
 {
+  if (async_capture) {
+    DumpAtom::write_data(n, mybuf);
+    return;
+  }
+
   if (buffer_flag == 1) {
     writer.write(mybuf, n);
   } else {
@@ -178,7 +191,7 @@ void DumpAtomZstd::write_data(int n, double *mybuf)
 void DumpAtomZstd::write()
 {
   DumpAtom::write();
-  if (filewriter) {
+  if (filewriter && !async) {
     if (multifile) {
       writer.close();
     } else {
@@ -189,6 +202,29 @@ void DumpAtomZstd::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   output of the writer thread goes through the compressing writer
+------------------------------------------------------------------------- */
+
+size_t DumpAtomZstd::async_output(FILE *, const char *data, size_t n)
+{
+  return writer.write(data, n);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpAtomZstd::async_flush(FILE *)
+{
+  if (writer.isopen()) writer.flush();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpAtomZstd::async_close(FILE *)
+{
+  writer.close();
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpAtomZstd::modify_param(int narg, char **arg)
@@ -43,6 +43,9 @@ class DumpAtomZstd : public DumpAtom {
   virtual void write_header(bigint);
   virtual void write_data(int, double *);
   virtual void write();
+  virtual size_t async_output(FILE *, const char *, size_t);
+  virtual void async_flush(FILE *);
+  virtual void async_close(FILE *);
 
   virtual int modify_param(int, char **);
 };
@@ -32,6 +32,7 @@ DumpCustomGZ::DumpCustomGZ(LAMMPS *lmp, int narg, char **arg) :
 
 DumpCustomGZ::~DumpCustomGZ()
 {
+  async_stop();
 }
 
 /* ----------------------------------------------------------------------
@@ -99,6 +100,13 @@ void DumpCustomGZ::openfile()
 
 void DumpCustomGZ::write_header(bigint ndump)
 {
+  // a snapshot captured for the writer thread is compressed by it
+
+  if (async_capture) {
+    DumpCustom::write_header(ndump);
+    return;
+  }
+
   std::string header;
 
   if ((multiproc) || (!multiproc && me == 0)) {
@@ -134,6 +142,11 @@ void DumpCustomGZ::write_header(bigint ndump)
 
 void DumpCustomGZ::write_data(int n, double *mybuf)
 {
+  if (async_capture) {
+    DumpCustom::write_data(n, mybuf);
+    return;
+  }
+
   if (buffer_flag == 1) {
     writer.write(mybuf, n);
   } else {
@@ -170,7 +183,7 @@ void DumpCustomGZ::write_data(int n, double *mybuf)
 void DumpCustomGZ::write()
 {
   DumpCustom::write();
-  if (filewriter) {
+  if (filewriter && !async) {
     if (multifile) {
       writer.close();
     } else {
@@ -181,6 +194,29 @@ void DumpCustomGZ::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   output of the writer thread goes through the compressing writer
+------------------------------------------------------------------------- */
+
+size_t DumpCustomGZ::async_output(FILE *, const char *data, size_t n)
+{
+  return writer.write(data, n);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomGZ::async_flush(FILE *)
+{
+  if (writer.isopen()) writer.flush();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomGZ::async_close(FILE *)
+{
+  writer.close();
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpCustomGZ::modify_param(int narg, char **arg)
@@ -39,6 +39,7 @@ DumpCustomZstd::DumpCustomZstd(LAMMPS *lmp, int narg, char **arg) :
 
 DumpCustomZstd::~DumpCustomZstd()
 {
+  async_stop();
 }
 
 /* ----------------------------------------------------------------------
@@ -112,6 +113,13 @@ void DumpCustomZstd::openfile()
 
 void DumpCustomZstd::write_header(bigint ndump)
 {
+  // a snapshot captured for the writer thread is compressed by it
+
+  if (async_capture) {
+    DumpCustom::write_header(ndump);
+    return;
+  }
+
   std::string header;
 
   if ((multiproc) || (!multiproc && me == 0)) {
@@ -147,6 +155,11 @@ void DumpCustomZstd::write_header(bigint ndump)
 
 void DumpCustomZstd::write_data(int n, double *mybuf)
 {
+  if (async_capture) {
+    DumpCustom::write_data(n, mybuf);
+    return;
+  }
+
   if (buffer_flag == 1) {
     writer.write(mybuf, n);
   } else {
@@ -183,7 +196,7 @@ void DumpCustomZstd::write_data(int n, double *mybuf)
 void DumpCustomZstd::write()
 {
   DumpCustom::write();
-  if (filewriter) {
+  if (filewriter && !async) {
     if (multifile) {
       writer.close();
     } else {
@@ -194,6 +207,29 @@ void DumpCustomZstd::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   output of the writer thread goes through the compressing writer
+------------------------------------------------------------------------- */
+
+size_t DumpCustomZstd::async_output(FILE *, const char *data, size_t n)
+{
+  return writer.write(data, n);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomZstd::async_flush(FILE *)
+{
+  if (writer.isopen()) writer.flush();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomZstd::async_close(FILE *)
+{
+  writer.close();
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpCustomZstd::modify_param(int narg, char **arg)
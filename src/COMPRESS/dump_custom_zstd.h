@@ -44,6 +44,9 @@ class DumpCustomZstd : public DumpCustom {
   virtual void write_header(bigint);
   virtual void write_data(int, double *);
   virtual void write();
+  virtual size_t async_output(FILE *, const char *, size_t);
+  virtual void async_flush(FILE *);
+  virtual void async_close(FILE *);
 
   virtual int modify_param(int, char **);
 };
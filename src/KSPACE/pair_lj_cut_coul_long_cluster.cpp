@@ -0,0 +1,297 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_coul_long_cluster.h"
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "kspace.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+#include "npair_full_bin_cluster.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+#define EWALD_F   1.12837917
+#define EWALD_P   0.3275911
+#define A1        0.254829592
+#define A2       -0.284496736
+#define A3        1.421413741
+#define A4       -1.453152027
+#define A5        1.061405429
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCoulLongCluster::PairLJCutCoulLongCluster(LAMMPS *lmp) :
+  PairLJCutCoulLong(lmp)
+{
+  respa_enable = 0;
+  no_virial_fdotr_compute = 1;
+  maxq = 0;
+  qcluster = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCoulLongCluster::~PairLJCutCoulLongCluster()
+{
+  if (copymode) return;
+  memory->destroy(qcluster);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCoulLongCluster::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  list->pack_cluster();
+
+  // pack charges in the same slot order as coords
+
+  const int nslot = list->ncluster*list->clustersize;
+  if (nslot > maxq) {
+    maxq = list->maxslot;
+    memory->destroy(qcluster);
+    memory->create(qcluster,maxq,"pair:qcluster");
+  }
+
+  double *q = atom->q;
+  const int *clusteratom = list->clusteratom;
+  for (int m = 0; m < nslot; m++)
+    qcluster[m] = (clusteratom[m] >= 0) ? q[clusteratom[m]] : 0.0;
+
+  if (list->clustersize == 8) {
+    if (evflag) eval<8,1>();
+    else eval<8,0>();
+  } else {
+    if (evflag) eval<4,1>();
+    else eval<4,0>();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   loop over CS x CS tiles of a full cluster-pair list
+   real-space Coulomb is always evaluated analytically so that
+     the J loop stays free of table lookups
+------------------------------------------------------------------------- */
+
+template <int CS, int EVFLAG>
+void PairLJCutCoulLongCluster::eval()
+{
+  const int SKIP = NPairFullBinCluster::SKIP;
+  static const unsigned char nocode[CS] = {0};
+
+  double** _noalias f = atom->f;
+  const double* _noalias special_lj = force->special_lj;
+  const double* _noalias special_coul = force->special_coul;
+  const double qqrd2e = force->qqrd2e;
+  const double cut_coulsq_ = cut_coulsq;
+  const double g_ewald_ = g_ewald;
+
+  const int nicluster = list->nicluster;
+  const int* _noalias clusteratom = list->clusteratom;
+  const double* _noalias xcluster = list->xcluster;
+  const int* _noalias tcluster = list->tcluster;
+  const double* _noalias qc = qcluster;
+  const unsigned char* _noalias tilecode = list->tilecode;
+  int* _noalias numjcluster = list->numjcluster;
+  int** _noalias firstjcluster = list->firstjcluster;
+
+  // special factors for each tile code, SKIP pairs are masked out
+
+  double factor_lj[SKIP+1],factor_coul[SKIP+1];
+  for (int m = 0; m < 4; m++) {
+    factor_lj[m] = special_lj[m];
+    factor_coul[m] = special_coul[m];
+  }
+  factor_lj[SKIP] = factor_coul[SKIP] = 0.0;
+
+  for (int ic = 0; ic < nicluster; ic++) {
+    const int *iatoms = &clusteratom[ic*CS];
+    const double *xi = &xcluster[3*ic*CS];
+    const int *ti = &tcluster[ic*CS];
+    const double *qi = &qc[ic*CS];
+    const int *jlist = firstjcluster[ic];
+    const int jnum = numjcluster[ic];
+
+    double fxi[CS],fyi[CS],fzi[CS],evdwli[CS],ecouli[CS],vi[CS][6];
+    for (int ii = 0; ii < CS; ii++) {
+      fxi[ii] = fyi[ii] = fzi[ii] = 0.0;
+      if (EVFLAG) {
+        evdwli[ii] = ecouli[ii] = 0.0;
+        for (int m = 0; m < 6; m++) vi[ii][m] = 0.0;
+      }
+    }
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int jc = jlist[2*jj];
+      const int coff = jlist[2*jj+1];
+      const double* _noalias xj = &xcluster[3*jc*CS];
+      const int* _noalias tj = &tcluster[jc*CS];
+      const double* _noalias qj = &qc[jc*CS];
+
+      for (int ii = 0; ii < CS; ii++) {
+        if (iatoms[ii] < 0) continue;
+
+        const double xtmp = xi[ii];
+        const double ytmp = xi[CS+ii];
+        const double ztmp = xi[2*CS+ii];
+        const double qtmp = qi[ii];
+        const int itype = ti[ii];
+        const double* _noalias cutsqi = cutsq[itype];
+        const double* _noalias cut_ljsqi = cut_ljsq[itype];
+        const double* _noalias lj1i = lj1[itype];
+        const double* _noalias lj2i = lj2[itype];
+        const double* _noalias lj3i = lj3[itype];
+        const double* _noalias lj4i = lj4[itype];
+        const double* _noalias offseti = offset[itype];
+        const unsigned char* _noalias code =
+          (coff >= 0) ? &tilecode[coff+ii*CS] : nocode;
+
+        double fx = 0.0, fy = 0.0, fz = 0.0, evdwl = 0.0, ecoul = 0.0;
+        double v0 = 0.0, v1 = 0.0, v2 = 0.0, v3 = 0.0, v4 = 0.0, v5 = 0.0;
+
+#if defined(_OPENMP) || defined(LMP_OPENMP_SIMD)
+#pragma omp simd reduction(+:fx,fy,fz,evdwl,ecoul,v0,v1,v2,v3,v4,v5)
+#endif
+        for (int k = 0; k < CS; k++) {
+          const double delx = xtmp - xj[k];
+          const double dely = ytmp - xj[CS+k];
+          const double delz = ztmp - xj[2*CS+k];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          const int jtype = tj[k];
+
+          if (rsq < cutsqi[jtype] && code[k] != SKIP) {
+            const double r2inv = 1.0/rsq;
+            double forcecoul = 0.0, prefactor = 0.0, erfc = 0.0;
+            double forcelj = 0.0, r6inv = 0.0;
+
+            if (rsq < cut_coulsq_) {
+              const double r = sqrt(rsq);
+              const double grij = g_ewald_ * r;
+              const double expm2 = exp(-grij*grij);
+              const double t = 1.0 / (1.0 + EWALD_P*grij);
+              erfc = t * (A1+t*(A2+t*(A3+t*(A4+t*A5)))) * expm2;
+              prefactor = qqrd2e * qtmp*qj[k]/r;
+              forcecoul = prefactor * (erfc + EWALD_F*grij*expm2) -
+                (1.0-factor_coul[code[k]])*prefactor;
+            }
+
+            if (rsq < cut_ljsqi[jtype]) {
+              r6inv = r2inv*r2inv*r2inv;
+              forcelj = r6inv * (lj1i[jtype]*r6inv - lj2i[jtype]);
+            }
+
+            const double fpair =
+              (forcecoul + factor_lj[code[k]]*forcelj) * r2inv;
+
+            fx += delx*fpair;
+            fy += dely*fpair;
+            fz += delz*fpair;
+
+            if (EVFLAG) {
+              if (rsq < cut_coulsq_)
+                ecoul += prefactor*erfc - (1.0-factor_coul[code[k]])*prefactor;
+              if (rsq < cut_ljsqi[jtype])
+                evdwl += factor_lj[code[k]] *
+                  (r6inv*(lj3i[jtype]*r6inv - lj4i[jtype]) - offseti[jtype]);
+              v0 += delx*delx*fpair;
+              v1 += dely*dely*fpair;
+              v2 += delz*delz*fpair;
+              v3 += delx*dely*fpair;
+              v4 += delx*delz*fpair;
+              v5 += dely*delz*fpair;
+            }
+          }
+        }
+
+        fxi[ii] += fx;
+        fyi[ii] += fy;
+        fzi[ii] += fz;
+        if (EVFLAG) {
+          evdwli[ii] += evdwl;
+          ecouli[ii] += ecoul;
+          vi[ii][0] += v0;
+          vi[ii][1] += v1;
+          vi[ii][2] += v2;
+          vi[ii][3] += v3;
+          vi[ii][4] += v4;
+          vi[ii][5] += v5;
+        }
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = iatoms[ii];
+      if (i < 0) continue;
+      f[i][0] += fxi[ii];
+      f[i][1] += fyi[ii];
+      f[i][2] += fzi[ii];
+
+      if (EVFLAG) {
+        if (eflag_global) {
+          eng_vdwl += 0.5*evdwli[ii];
+          eng_coul += 0.5*ecouli[ii];
+        }
+        if (eflag_atom) eatom[i] += 0.5*(evdwli[ii] + ecouli[ii]);
+        if (vflag_global)
+          for (int m = 0; m < 6; m++) virial[m] += 0.5*vi[ii][m];
+        if (vflag_atom)
+          for (int m = 0; m < 6; m++) vatom[i][m] += 0.5*vi[ii][m];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   request a full cluster-pair neighbor list
+   Coulomb tables are still set up for use by single()
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulLongCluster::init_style()
+{
+  if (!atom->q_flag)
+    error->all(FLERR,"Pair style lj/cut/coul/long/cluster requires atom attribute q");
+
+  int irequest = neighbor->request(this,instance_me);
+  neighbor->requests[irequest]->half = 0;
+  neighbor->requests[irequest]->full = 1;
+  neighbor->requests[irequest]->cluster = 1;
+
+  cut_coulsq = cut_coul * cut_coul;
+  cut_respa = nullptr;
+
+  // insure use of KSpace long-range solver, set g_ewald
+
+  if (force->kspace == nullptr)
+    error->all(FLERR,"Pair style requires a KSpace style");
+  g_ewald = force->kspace->g_ewald;
+
+  if (ncoultablebits) init_tables(cut_coul,cut_respa);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJCutCoulLongCluster::memory_usage()
+{
+  double bytes = PairLJCutCoulLong::memory_usage();
+  bytes += memory->usage(qcluster,maxq);
+  return bytes;
+}
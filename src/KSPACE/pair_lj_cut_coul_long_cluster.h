@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/cut/coul/long/cluster,PairLJCutCoulLongCluster);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_CUT_COUL_LONG_CLUSTER_H
+#define LMP_PAIR_LJ_CUT_COUL_LONG_CLUSTER_H
+
+#include "pair_lj_cut_coul_long.h"
+
+namespace LAMMPS_NS {
+
+class PairLJCutCoulLongCluster : public PairLJCutCoulLong {
+ public:
+  PairLJCutCoulLongCluster(class LAMMPS *);
+  ~PairLJCutCoulLongCluster();
+  void compute(int, int);
+  void init_style();
+  double memory_usage();
+
+ private:
+  int maxq;
+  double *qcluster;    // charges packed by cluster
+
+  template <int CS, int EVFLAG> void eval();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Pair style lj/cut/coul/long/cluster requires atom attribute q
+
+The atom style defined does not have this attribute.
+
+E: Pair style requires a KSpace style
+
+No kspace style is defined.
+
+*/
@@ -0,0 +1,402 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_eam_cluster.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+#include "npair_full_bin_cluster.h"
+#include "update.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairEAMCluster::PairEAMCluster(LAMMPS *lmp) : PairEAM(lmp)
+{
+  no_virial_fdotr_compute = 1;
+  maxfp = 0;
+  fpcluster = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairEAMCluster::~PairEAMCluster()
+{
+  if (copymode) return;
+  memory->destroy(fpcluster);
+}
+
+/* ----------------------------------------------------------------------
+   densities of owned atoms are summed over a full cluster-pair list,
+     so no reverse communication of rho is needed
+   fp of ghost atoms is still communicated and then packed by cluster
+------------------------------------------------------------------------- */
+
+void PairEAMCluster::compute(int eflag, int vflag)
+{
+  int i,m;
+  double p,phi;
+  double *coeff;
+
+  ev_init(eflag,vflag);
+
+  // grow energy and fp arrays if necessary
+  // need to be atom->nmax in length
+
+  if (atom->nmax > nmax) {
+    memory->destroy(rho);
+    memory->destroy(fp);
+    memory->destroy(numforce);
+    nmax = atom->nmax;
+    memory->create(rho,nmax,"pair:rho");
+    memory->create(fp,nmax,"pair:fp");
+    memory->create(numforce,nmax,"pair:numforce");
+  }
+
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+
+  list->pack_cluster();
+
+  if (list->clustersize == 8) density<8>();
+  else density<4>();
+
+  // fp = derivative of embedding energy at each atom
+  // phi = embedding energy at each atom
+  // if rho > rhomax (e.g. due to close approach of two atoms),
+  //   will exceed table, so add linear term to conserve energy
+
+  for (i = 0; i < nlocal; i++) {
+    p = rho[i]*rdrho + 1.0;
+    m = static_cast<int> (p);
+    m = MAX(1,MIN(m,nrho-1));
+    p -= m;
+    p = MIN(p,1.0);
+    coeff = frho_spline[type2frho[type[i]]][m];
+    fp[i] = (coeff[0]*p + coeff[1])*p + coeff[2];
+    if (eflag) {
+      phi = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+      if (rho[i] > rhomax) phi += fp[i] * (rho[i]-rhomax);
+      phi *= scale[type[i]][type[i]];
+      if (eflag_global) eng_vdwl += phi;
+      if (eflag_atom) eatom[i] += phi;
+    }
+  }
+
+  // communicate derivative of embedding function
+
+  comm->forward_comm_pair(this);
+  embedstep = update->ntimestep;
+
+  // pack fp in the same slot order as coords
+
+  const int nslot = list->ncluster*list->clustersize;
+  if (nslot > maxfp) {
+    maxfp = list->maxslot;
+    memory->destroy(fpcluster);
+    memory->create(fpcluster,maxfp,"pair:fpcluster");
+  }
+
+  const int *clusteratom = list->clusteratom;
+  for (m = 0; m < nslot; m++)
+    fpcluster[m] = (clusteratom[m] >= 0) ? fp[clusteratom[m]] : 0.0;
+
+  if (list->clustersize == 8) {
+    if (evflag) eval<8,1>();
+    else eval<8,0>();
+  } else {
+    if (evflag) eval<4,1>();
+    else eval<4,0>();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   rho = density at each owned atom from CS x CS tiles
+   spline coefficients are addressed in the contiguous 3d spline arrays
+------------------------------------------------------------------------- */
+
+template <int CS>
+void PairEAMCluster::density()
+{
+  const int SKIP = NPairFullBinCluster::SKIP;
+  static const unsigned char nocode[CS] = {0};
+
+  const int nicluster = list->nicluster;
+  const int* _noalias clusteratom = list->clusteratom;
+  const double* _noalias xcluster = list->xcluster;
+  const int* _noalias tcluster = list->tcluster;
+  const unsigned char* _noalias tilecode = list->tilecode;
+  int* _noalias numjcluster = list->numjcluster;
+  int** _noalias firstjcluster = list->firstjcluster;
+
+  const double* _noalias rhor_flat = &rhor_spline[0][0][0];
+  const int stride = 7*(nr+1);
+  const int nt1 = atom->ntypes + 1;
+  const int* _noalias t2rhor = &type2rhor[0][0];
+  const double cutforcesq_ = cutforcesq;
+  const double rdr_ = rdr;
+  const int nr_ = nr;
+
+  for (int ic = 0; ic < nicluster; ic++) {
+    const int *iatoms = &clusteratom[ic*CS];
+    const double *xi = &xcluster[3*ic*CS];
+    const int *ti = &tcluster[ic*CS];
+    const int *jlist = firstjcluster[ic];
+    const int jnum = numjcluster[ic];
+
+    double rhoi[CS];
+    for (int ii = 0; ii < CS; ii++) rhoi[ii] = 0.0;
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int jc = jlist[2*jj];
+      const int coff = jlist[2*jj+1];
+      const double* _noalias xj = &xcluster[3*jc*CS];
+      const int* _noalias tj = &tcluster[jc*CS];
+
+      for (int ii = 0; ii < CS; ii++) {
+        if (iatoms[ii] < 0) continue;
+
+        const double xtmp = xi[ii];
+        const double ytmp = xi[CS+ii];
+        const double ztmp = xi[2*CS+ii];
+        const int itype = ti[ii];
+        const unsigned char* _noalias code =
+          (coff >= 0) ? &tilecode[coff+ii*CS] : nocode;
+
+        double rhosum = 0.0;
+
+#if defined(_OPENMP) || defined(LMP_OPENMP_SIMD)
+#pragma omp simd reduction(+:rhosum)
+#endif
+        for (int k = 0; k < CS; k++) {
+          const double delx = xtmp - xj[k];
+          const double dely = ytmp - xj[CS+k];
+          const double delz = ztmp - xj[2*CS+k];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+
+          if (rsq < cutforcesq_ && code[k] != SKIP) {
+            double p = sqrt(rsq)*rdr_ + 1.0;
+            int m = static_cast<int> (p);
+            m = MIN(m,nr_-1);
+            p -= m;
+            p = MIN(p,1.0);
+            const double *coeff =
+              &rhor_flat[t2rhor[tj[k]*nt1+itype]*stride + 7*m];
+            rhosum += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+          }
+        }
+
+        rhoi[ii] += rhosum;
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++)
+      if (iatoms[ii] >= 0) rho[iatoms[ii]] = rhoi[ii];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   forces on each owned atom from CS x CS tiles
+   pair energy and virial are tallied half from each side of a pair
+------------------------------------------------------------------------- */
+
+template <int CS, int EVFLAG>
+void PairEAMCluster::eval()
+{
+  const int SKIP = NPairFullBinCluster::SKIP;
+  static const unsigned char nocode[CS] = {0};
+
+  double** _noalias f = atom->f;
+
+  const int nicluster = list->nicluster;
+  const int* _noalias clusteratom = list->clusteratom;
+  const double* _noalias xcluster = list->xcluster;
+  const int* _noalias tcluster = list->tcluster;
+  const double* _noalias fpc = fpcluster;
+  const unsigned char* _noalias tilecode = list->tilecode;
+  int* _noalias numjcluster = list->numjcluster;
+  int** _noalias firstjcluster = list->firstjcluster;
+
+  const double* _noalias rhor_flat = &rhor_spline[0][0][0];
+  const double* _noalias z2r_flat = &z2r_spline[0][0][0];
+  const int stride = 7*(nr+1);
+  const int nt1 = atom->ntypes + 1;
+  const int* _noalias t2rhor = &type2rhor[0][0];
+  const int* _noalias t2z2r = &type2z2r[0][0];
+  const double cutforcesq_ = cutforcesq;
+  const double rdr_ = rdr;
+  const int nr_ = nr;
+
+  for (int ic = 0; ic < nicluster; ic++) {
+    const int *iatoms = &clusteratom[ic*CS];
+    const double *xi = &xcluster[3*ic*CS];
+    const int *ti = &tcluster[ic*CS];
+    const double *fpi = &fpc[ic*CS];
+    const int *jlist = firstjcluster[ic];
+    const int jnum = numjcluster[ic];
+
+    double fxi[CS],fyi[CS],fzi[CS],evdwli[CS],vi[CS][6];
+    int nforce[CS];
+    for (int ii = 0; ii < CS; ii++) {
+      fxi[ii] = fyi[ii] = fzi[ii] = 0.0;
+      nforce[ii] = 0;
+      if (EVFLAG) {
+        evdwli[ii] = 0.0;
+        for (int m = 0; m < 6; m++) vi[ii][m] = 0.0;
+      }
+    }
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int jc = jlist[2*jj];
+      const int coff = jlist[2*jj+1];
+      const double* _noalias xj = &xcluster[3*jc*CS];
+      const int* _noalias tj = &tcluster[jc*CS];
+      const double* _noalias fpj = &fpc[jc*CS];
+
+      for (int ii = 0; ii < CS; ii++) {
+        if (iatoms[ii] < 0) continue;
+
+        const double xtmp = xi[ii];
+        const double ytmp = xi[CS+ii];
+        const double ztmp = xi[2*CS+ii];
+        const double fptmp = fpi[ii];
+        const int itype = ti[ii];
+        const double* _noalias scalei = scale[itype];
+        const unsigned char* _noalias code =
+          (coff >= 0) ? &tilecode[coff+ii*CS] : nocode;
+
+        double fx = 0.0, fy = 0.0, fz = 0.0, evdwl = 0.0;
+        double v0 = 0.0, v1 = 0.0, v2 = 0.0, v3 = 0.0, v4 = 0.0, v5 = 0.0;
+        int nf = 0;
+
+#if defined(_OPENMP) || defined(LMP_OPENMP_SIMD)
+#pragma omp simd reduction(+:fx,fy,fz,evdwl,v0,v1,v2,v3,v4,v5,nf)
+#endif
+        for (int k = 0; k < CS; k++) {
+          const double delx = xtmp - xj[k];
+          const double dely = ytmp - xj[CS+k];
+          const double delz = ztmp - xj[2*CS+k];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          const int jtype = tj[k];
+
+          if (rsq < cutforcesq_ && code[k] != SKIP) {
+            ++nf;
+            const double r = sqrt(rsq);
+            double p = r*rdr_ + 1.0;
+            int m = static_cast<int> (p);
+            m = MIN(m,nr_-1);
+            p -= m;
+            p = MIN(p,1.0);
+
+            // rhoip = derivative of (density at atom j due to atom i)
+            // rhojp = derivative of (density at atom i due to atom j)
+            // same terms as in PairEAM::compute()
+
+            const double *coeff =
+              &rhor_flat[t2rhor[itype*nt1+jtype]*stride + 7*m];
+            const double rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+            coeff = &rhor_flat[t2rhor[jtype*nt1+itype]*stride + 7*m];
+            const double rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+            coeff = &z2r_flat[t2z2r[itype*nt1+jtype]*stride + 7*m];
+            const double z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+            const double z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+            const double recip = 1.0/r;
+            const double phi = z2*recip;
+            const double phip = z2p*recip - phi*recip;
+            const double psip = fptmp*rhojp + fpj[k]*rhoip + phip;
+            const double fpair = -scalei[jtype]*psip*recip;
+
+            fx += delx*fpair;
+            fy += dely*fpair;
+            fz += delz*fpair;
+
+            if (EVFLAG) {
+              evdwl += scalei[jtype]*phi;
+              v0 += delx*delx*fpair;
+              v1 += dely*dely*fpair;
+              v2 += delz*delz*fpair;
+              v3 += delx*dely*fpair;
+              v4 += delx*delz*fpair;
+              v5 += dely*delz*fpair;
+            }
+          }
+        }
+
+        fxi[ii] += fx;
+        fyi[ii] += fy;
+        fzi[ii] += fz;
+        nforce[ii] += nf;
+        if (EVFLAG) {
+          evdwli[ii] += evdwl;
+          vi[ii][0] += v0;
+          vi[ii][1] += v1;
+          vi[ii][2] += v2;
+          vi[ii][3] += v3;
+          vi[ii][4] += v4;
+          vi[ii][5] += v5;
+        }
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = iatoms[ii];
+      if (i < 0) continue;
+      f[i][0] += fxi[ii];
+      f[i][1] += fyi[ii];
+      f[i][2] += fzi[ii];
+      numforce[i] = nforce[ii];
+
+      if (EVFLAG) {
+        if (eflag_global) eng_vdwl += 0.5*evdwli[ii];
+        if (eflag_atom) eatom[i] += 0.5*evdwli[ii];
+        if (vflag_global)
+          for (int m = 0; m < 6; m++) virial[m] += 0.5*vi[ii][m];
+        if (vflag_atom)
+          for (int m = 0; m < 6; m++) vatom[i][m] += 0.5*vi[ii][m];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   change the default neighbor request into a full cluster-pair list
+   the request must be made by PairEAM, since the requestor pointer
+     is cast back to Pair and this class derives virtually from PairEAM
+------------------------------------------------------------------------- */
+
+void PairEAMCluster::init_style()
+{
+  PairEAM::init_style();
+
+  neighbor->requests[neighbor->nrequest-1]->half = 0;
+  neighbor->requests[neighbor->nrequest-1]->full = 1;
+  neighbor->requests[neighbor->nrequest-1]->cluster = 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairEAMCluster::memory_usage()
+{
+  double bytes = PairEAM::memory_usage();
+  bytes += memory->usage(fpcluster,maxfp);
+  return bytes;
+}
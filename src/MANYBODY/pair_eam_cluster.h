@@ -0,0 +1,46 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(eam/cluster,PairEAMCluster);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_EAM_CLUSTER_H
+#define LMP_PAIR_EAM_CLUSTER_H
+
+#include "pair_eam.h"
+
+namespace LAMMPS_NS {
+
+class PairEAMCluster : virtual public PairEAM {
+ public:
+  PairEAMCluster(class LAMMPS *);
+  virtual ~PairEAMCluster();
+  void compute(int, int);
+  void init_style();
+  double memory_usage();
+
+ protected:
+  int maxfp;
+  double *fpcluster;    // fp packed by cluster
+
+  template <int CS> void density();
+  template <int CS, int EVFLAG> void eval();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
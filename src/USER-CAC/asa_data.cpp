@@ -27,23 +27,7 @@ Asa_Data::Asa_Data(LAMMPS *lmp, NPairCAC *npaircac) : Pointers(lmp)
   Objective=NULL;
 
   npair_pointer = npaircac;
-  avec_pointer = NULL;
-  class_flag=0;
-   
-  allocate();
-}
-
-/* ---------------------------------------------------------------------- */
-
-Asa_Data::Asa_Data(LAMMPS *lmp, AtomVecCAC *atomveccac) : Pointers(lmp)
-{
-  cgParm=NULL;
-  asaParm=NULL;
-  Objective=NULL;
-
-  avec_pointer = atomveccac;
-  npair_pointer = NULL;
-  class_flag=1;
+  iterations=0;
    
   allocate();
 }
@@ -88,8 +72,12 @@ int Asa_Data::call_asa_cg(double *x,double *lo,double *hi, ASA_INT n,
   int flag; //return condition flag
   int max_tries = 100;
   int ntry = 0;
-  flag=asa_cg(x, lo, hi, n, NULL, cgParm, asaParm,
+  asa_stat stat;
+  //early returns of asa_cg leave the statistics untouched
+  stat.cgiter = stat.cbbiter = 0;
+  flag=asa_cg(x, lo, hi, n, &stat, cgParm, asaParm,
     grad_tol, NULL, Work, iWork, this);
+  iterations += stat.cgiter + stat.cbbiter;
   while((flag==4||flag==2||flag==7)&&ntry!=max_tries){
     //perturb point
     if(flag==7){
@@ -97,14 +85,13 @@ int Asa_Data::call_asa_cg(double *x,double *lo,double *hi, ASA_INT n,
       x[ni] += grad_tol;
     }
     ntry++;
-    flag=asa_cg(x, lo, hi, n, NULL, cgParm, asaParm,
+    stat.cgiter = stat.cbbiter = 0;
+    flag=asa_cg(x, lo, hi, n, &stat, cgParm, asaParm,
     grad_tol, NULL, Work, iWork, this);
+    iterations += stat.cgiter + stat.cbbiter;
   }
   if(flag>1&&flag!=7){
-  if(class_flag==0)
   sprintf(asa_error, "asa_cg iterations failed in finding a solution for quadrature neighboring processes. flag = %d ", flag);
-  if(class_flag==1)
-  sprintf(asa_error, "asa_cg iterations failed in finding a solution for reneighboring checks. flag = %d ", flag);
   error->one(FLERR,asa_error);
   }
   return flag;
@@ -116,13 +103,7 @@ int Asa_Data::call_asa_cg(double *x,double *lo,double *hi, ASA_INT n,
 
 double Asa_Data::myvalue(asa_objective *asa) 
 {   
-  double result;
-  if(class_flag==0)
-  result = myvalue_surfmin(asa);
-  if(class_flag==1)
-  result = myvalue_neigh_check(asa);
-
-  return result;
+  return myvalue_surfmin(asa);
 }
 
 /* evaluate the gradient of the objective function */
@@ -130,11 +111,7 @@ double Asa_Data::myvalue(asa_objective *asa)
 
 void Asa_Data::mygrad(asa_objective *asa)
 {
-  if(class_flag==0)
   mygrad_surfmin(asa);
-  if(class_flag==1)
-  mygrad_neigh_check(asa);
-  
 }
 
 /* evaluate the objective function for element to point surface minimization (Q8 element)
@@ -322,99 +299,3 @@ void Asa_Data::mygrad_surfmin(asa_objective *asa)
   g[1] = -2 * (r[0] - px)*px2 - 2 * (r[1] - py)*py2 - 2 * (r[2] - pz)*pz2;
   
 }
-
-/* evaluate the objective function for the neighbor list decision process
-/* ---------------------------------------------------------------------- */
-double Asa_Data::myvalue_neigh_check(asa_objective *asa)
-{
-  double f, t, *x;
-  double px, py, pz;
-  double shape_func2;
-    //get class data for current element
-  int min_element_index = avec_pointer->min_element_index;
-  int *current_element_scale = avec_pointer->check_element_scale[min_element_index];
-  int min_nodes_per_element = avec_pointer->min_nodes_per_element;
-  int poly_min = avec_pointer->poly_min;
-  double **current_hold_positions = avec_pointer->hold_nodal_positions[min_element_index][poly_min];
-  double **current_nodal_positions = avec_pointer->check_nodal_positions[min_element_index][poly_min];
-  ASA_INT i;
-  x = asa->x;
-  f = 0;
-
-  px = 0;
-  py = 0;
-  pz = 0;
-  for (int kk = 0; kk < min_nodes_per_element; kk++) {
-    shape_func2 = avec_pointer->shape_function(x[0], x[1], x[2], 2, kk + 1);
-    px += (current_nodal_positions[kk][0]-current_hold_positions[kk][0]) * shape_func2;
-    py += (current_nodal_positions[kk][1]-current_hold_positions[kk][1]) * shape_func2;
-    pz += (current_nodal_positions[kk][2]-current_hold_positions[kk][2]) * shape_func2;
-  }
-
-
-  f = -(px*px +  py*py +  pz*pz);
-
-
-  return (f);
-}
-
-/* evaluate the gradient of the objective function for the neighbor list decision process
-/* ---------------------------------------------------------------------- */
-void Asa_Data::mygrad_neigh_check(asa_objective *asa)
-{
-  double t, *g, *x;
-  double px, py, pz;
-  double px1, px2, px3, py1, py2, py3, pz1, pz2, pz3;
-  double shape_func3,shape_func2, shape_func1;
-    //get class data for current element
-  int min_element_index = avec_pointer->min_element_index;
-  int *current_element_scale = avec_pointer->check_element_scale[min_element_index];
-  int min_nodes_per_element = avec_pointer->min_nodes_per_element;
-  int poly_min = avec_pointer->poly_min;
-  double **current_hold_positions = avec_pointer->hold_nodal_positions[min_element_index][poly_min];
-    double **current_nodal_positions = avec_pointer->check_nodal_positions[min_element_index][poly_min];
-
-  ASA_INT i;
-  x = asa->x;
-  g = asa->g;
-
-
-  px = 0;
-  py = 0;
-  pz = 0;
-  for (int kk = 0; kk < min_nodes_per_element; kk++) {
-    shape_func2 = avec_pointer->shape_function(x[0], x[1], x[2], 2, kk + 1);
-    px += (current_nodal_positions[kk][0]-current_hold_positions[kk][0]) * shape_func2;
-    py += (current_nodal_positions[kk][1]-current_hold_positions[kk][1]) * shape_func2;
-    pz += (current_nodal_positions[kk][2]-current_hold_positions[kk][2]) * shape_func2;
-  }
-  
-  px1 = 0;
-  py1 = 0;
-  pz1 = 0;
-  px2 = 0;
-  py2 = 0;
-  pz2 = 0;
-  px3 = 0;
-  py3 = 0;
-  pz3 = 0;
-  for (int kk = 0; kk < min_nodes_per_element; kk++) {
-    shape_func1 = avec_pointer->shape_function_derivative(x[0], x[1], x[2], 2, kk + 1, 1);
-    shape_func2 = avec_pointer->shape_function_derivative(x[0], x[1], x[2], 2, kk + 1, 2);
-    shape_func3 = avec_pointer->shape_function_derivative(x[0], x[1], x[2], 2, kk + 1, 3);
-    px1 += (current_nodal_positions[kk][0]-current_hold_positions[kk][0]) * shape_func1;
-    py1 += (current_nodal_positions[kk][1]-current_hold_positions[kk][1]) * shape_func1;
-    pz1 += (current_nodal_positions[kk][2]-current_hold_positions[kk][2]) * shape_func1;
-    px2 += (current_nodal_positions[kk][0]-current_hold_positions[kk][0]) * shape_func2;
-    py2 += (current_nodal_positions[kk][1]-current_hold_positions[kk][1]) * shape_func2;
-    pz2 += (current_nodal_positions[kk][2]-current_hold_positions[kk][2]) * shape_func2;
-    px3 += (current_nodal_positions[kk][0]-current_hold_positions[kk][0]) * shape_func3;
-    py3 += (current_nodal_positions[kk][1]-current_hold_positions[kk][1]) * shape_func3;
-    pz3 += (current_nodal_positions[kk][2]-current_hold_positions[kk][2]) * shape_func3;
-  }
-
-
-  g[0] = -(2 * px*px1 + 2 * py*py1 + 2 *  pz*pz1);
-  g[1] = -(2 * px*px2 + 2 * py*py2 + 2 *  pz*pz2);
-  g[2] = -(2 * px*px3 + 2 * py*py3 + 2 *  pz*pz3);
-}
@@ -17,7 +17,6 @@
 #include "asa_user.h"
 #include "pointers.h"
 #include "npair_cac.h"
-#include "atom_vec_cac.h"
 using namespace std;
 
 namespace LAMMPS_NS {
@@ -25,28 +24,24 @@ namespace LAMMPS_NS {
 class Asa_Data : protected Pointers {
  public:
   Asa_Data(class LAMMPS *, class NPairCAC *);
-  Asa_Data(class LAMMPS *, class AtomVecCAC *);
  ~Asa_Data();
   
   asacg_parm *cgParm;
   asa_parm *asaParm;
   asa_objective *Objective;
 
-  AtomVecCAC *avec_pointer;
   NPairCAC *npair_pointer;
 
-  int class_flag; //0 for NPair CAC calling and 1 for Atom Vec calling, increment as new ones added
   int call_asa_cg(double *x,double *lo,double *hi, ASA_INT n,
     double grad_tol, double (*valgrad) (asa_objective *), double *Work, ASA_INT *iWork);
   double myvalue(asa_objective *asa);
   void mygrad(asa_objective *asa);
   double myvalue_surfmin(asa_objective *asa);
   void mygrad_surfmin(asa_objective *asa);
-  double myvalue_neigh_check(asa_objective *asa);
-  void mygrad_neigh_check(asa_objective *asa);  
   void allocate();
 
   char asa_error[100];
+  double iterations;     //cg and cbb iterations of all searches so far
 };
 
 }
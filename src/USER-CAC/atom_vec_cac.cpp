@@ -23,8 +23,6 @@
 #include "fix.h"
 #include "memory.h"
 #include "error.h"
-#include "asa_user.h"
-#include "asa_data.h"
 
 #define MAX_ELEMENT_NAME 256
 
@@ -51,30 +49,43 @@ AtomVecCAC::AtomVecCAC(LAMMPS *lmp) : AtomVec(lmp)
   search_range_max = 0;
   initial_size=0;
   check_distance_flag=1;
-  asa_pointer=NULL;
   hold_nodal_positions=NULL;
+  nodal_positions=initial_nodal_positions=NULL;
+  nodal_velocities=nodal_forces=nodal_virial=NULL;
+  node_types=NULL;
   max_old=0;
   CAC_nmax=0;
   alloc_counter=0;
-
-  //instance asa interface object
-   asa_pointer = new Asa_Data(lmp, this);
+  node_types_store=NULL;
+  slot_node_count=NULL;
+  comm_reference=NULL;
+  comm_reference_offset=NULL;
+  ncomm_reference=maxcomm_reference_offset=0;
+  maxcomm_reference=0;
+  NodalStore *stores[6] = {&x_store, &hold_store, &x0_store, &v_store, &f_store, &virial_store};
+  for(int istore = 0; istore < 6; istore++){
+    stores[istore]->data = NULL;
+    stores[istore]->node_ptrs = NULL;
+    stores[istore]->poly_ptrs = NULL;
+    stores[istore]->width = 3;
+  }
+  virial_store.width = 6;
 
 }
 
 //--------------------------------------------------------------------------
 
 AtomVecCAC::~AtomVecCAC() {
-delete asa_pointer;
-  for(int element_index=0; element_index < alloc_counter; element_index++){
-    memory->destroy(node_types[element_index]);
-    memory->destroy(nodal_positions[element_index]);
-    memory->destroy(hold_nodal_positions[element_index]);
-    memory->destroy(initial_nodal_positions[element_index]);
-    memory->destroy(nodal_velocities[element_index]);
-    memory->destroy(nodal_forces[element_index]);
-    memory->destroy(nodal_virial[element_index]);
+  NodalStore *stores[6] = {&x_store, &hold_store, &x0_store, &v_store, &f_store, &virial_store};
+  for(int istore = 0; istore < 6; istore++){
+    memory->sfree(stores[istore]->data);
+    memory->sfree(stores[istore]->node_ptrs);
+    memory->sfree(stores[istore]->poly_ptrs);
   }
+  memory->destroy(node_types_store);
+  memory->destroy(slot_node_count);
+  memory->destroy(comm_reference);
+  memory->destroy(comm_reference_offset);
 memory->sfree(hold_nodal_positions);
 }
 
@@ -177,38 +188,8 @@ void AtomVecCAC::grow(int n)
   element_type= memory->grow(atom->element_type, nmax, "atom:element_type");
   element_scale = memory->grow(atom->element_scale, nmax,3, "atom:element_scales");
 
-  //grow pointers for a ragged allocation strategy since atoms allocate far less memory
-  if(CAC_nmax==0){
-  atom->node_types = node_types = (int **) memory->smalloc(sizeof(int *)*nmax, "atom:node_types");
-  atom->nodal_positions = nodal_positions =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_positions");
-  hold_nodal_positions = (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:hold_nodal_positions");
-  atom->initial_nodal_positions = initial_nodal_positions =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:initial_nodal_positions");
-  atom->nodal_velocities = nodal_velocities =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_velocities");
-  atom->nodal_forces = nodal_forces =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_forces");
-  atom->nodal_virial = nodal_virial =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_virial");
-  CAC_nmax = nmax;
-  }
-  else{
-  atom->node_types = node_types = (int **) memory->srealloc(node_types,sizeof(int *)*nmax, "atom:node_types");
-  atom->nodal_positions = nodal_positions =
-    (double ****) memory->srealloc(nodal_positions,sizeof(double ***)*nmax, "atom:nodal_positions");
-  hold_nodal_positions =
-  (double ****) memory->srealloc(hold_nodal_positions,sizeof(double ***)*nmax, "atom:hold_nodal_positions");
-  atom->initial_nodal_positions = initial_nodal_positions =
-    (double ****) memory->srealloc(initial_nodal_positions,sizeof(double ***)*nmax, "atom:initial_nodal_positions");
-  atom->nodal_velocities = nodal_velocities =
-    (double ****) memory->srealloc(nodal_velocities,sizeof(double ***)*nmax, "atom:nodal_velocities");
-  atom->nodal_forces = nodal_forces =
-    (double ****) memory->srealloc(nodal_forces,sizeof(double ***)*nmax, "atom:nodal_forces");
-  atom->nodal_virial = nodal_virial =
-    (double ****) memory->srealloc(nodal_virial,sizeof(double ***)*nmax, "atom:nodal_virial");
-  CAC_nmax = nmax;
-  }
+  //grow the contiguous nodal stores and rebuild their pointer views
+  grow_nodal_storage(nmax);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -236,34 +217,10 @@ void AtomVecCAC::shrink_array(int n)
   element_type= memory->grow(atom->element_type, nmax, "atom:element_type");
   element_scale = memory->grow(atom->element_scale, nmax,3, "atom:element_scales");
 
-  //deallocate element contents if n is smaller than the alloc counter for elements
-  for(int element_index=alloc_counter-1; element_index >= nmax; element_index--){
-  memory->destroy(node_types[element_index]);
-  memory->destroy(nodal_positions[element_index]);
-  memory->destroy(hold_nodal_positions[element_index]);
-  memory->destroy(initial_nodal_positions[element_index]);
-  memory->destroy(nodal_velocities[element_index]);
-  memory->destroy(nodal_forces[element_index]);
-  memory->destroy(nodal_virial[element_index]);
-  }
+  //shrink the contiguous nodal stores; slots below nmax keep their contents
   if(alloc_counter>nmax)
   alloc_counter = nmax;
-
-  //shrink pointer arrays
-  atom->node_types = node_types = (int **) memory->srealloc(node_types,sizeof(int *)*nmax, "atom:node_types");
-  atom->nodal_positions = nodal_positions =
-    (double ****) memory->srealloc(nodal_positions,sizeof(double ***)*nmax, "atom:nodal_positions");
-  hold_nodal_positions =
-  (double ****) memory->srealloc(hold_nodal_positions,sizeof(double ***)*nmax, "atom:hold_nodal_positions");
-  atom->initial_nodal_positions = initial_nodal_positions =
-    (double ****) memory->srealloc(initial_nodal_positions,sizeof(double ***)*nmax, "atom:initial_nodal_positions");
-  atom->nodal_velocities = nodal_velocities =
-    (double ****) memory->srealloc(nodal_velocities,sizeof(double ***)*nmax, "atom:nodal_velocities");
-  atom->nodal_forces = nodal_forces =
-    (double ****) memory->srealloc(nodal_forces,sizeof(double ***)*nmax, "atom:nodal_forces");
-  atom->nodal_virial = nodal_virial =
-    (double ****) memory->srealloc(nodal_virial,sizeof(double ***)*nmax, "atom:nodal_virial");
-  CAC_nmax = nmax;
+  grow_nodal_storage(nmax);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -274,29 +231,182 @@ void AtomVecCAC::shrink_array(int n)
    allocate finite element data for nodal arrays
 ------------------------------------------------------------------------- */
 
-void AtomVecCAC::allocate_element(int element_index, int node_count, int poly_count)
+void AtomVecCAC::allocate_element(int element_index, int node_count)
 {
-  //destroy previous contents at that element index if present
-  if(element_index<alloc_counter){
-  memory->destroy(node_types[element_index]);
-  memory->destroy(nodal_positions[element_index]);
-  memory->destroy(hold_nodal_positions[element_index]);
-  memory->destroy(initial_nodal_positions[element_index]);
-  memory->destroy(nodal_velocities[element_index]);
-  memory->destroy(nodal_forces[element_index]);
-  memory->destroy(nodal_virial[element_index]);
-  }
-  else
+  //slots are preallocated at the maximum size; only the views depend on the node count
+  if(element_index>=alloc_counter)
   alloc_counter++;
-  //create new allocation for this element
-  memory->create(node_types[element_index], poly_count,  "atom:node_types");
-  memory->create(nodal_positions[element_index], poly_count, node_count, 3, "atom:nodal_positions");
-  memory->create(hold_nodal_positions[element_index], poly_count, node_count, 3, "atom:hold_nodal_positions");
-  memory->create(initial_nodal_positions[element_index], poly_count, node_count, 3, "atom:initial_nodal_positions");
-  memory->create(nodal_velocities[element_index], poly_count, node_count, 3, "atom:nodal_velocities");
-  memory->create(nodal_forces[element_index], poly_count, node_count, 3, "atom:nodal_forces");
-  memory->create(nodal_virial[element_index], poly_count, node_count, 6, "atom:nodal_virial");
+  if(slot_node_count[element_index]!=node_count)
+  set_slot_views(element_index, node_count);
+}
+
+/* ----------------------------------------------------------------------
+   resize the contiguous nodal stores to n element slots
+   each store is indexed with a fixed stride of maxpoly*nodes_per_element
+   nodes per slot so realloc preserves slot contents; the 4D pointer views
+   are then rebuilt on top of the (possibly moved) data
+------------------------------------------------------------------------- */
+
+void AtomVecCAC::grow_nodal_storage(int n)
+{
+  int old_nmax = CAC_nmax;
+  if(old_nmax > n) old_nmax = n;
+  node_types_store = memory->grow(node_types_store, n*maxpoly, "atom:node_types_store");
+  slot_node_count = memory->grow(slot_node_count, n, "atom:slot_node_count");
+  for(int islot = old_nmax; islot < n; islot++)
+    slot_node_count[islot] = nodes_per_element;
+
+  atom->node_types = node_types = (int **) memory->srealloc(node_types,sizeof(int *)*n, "atom:node_types");
+  for(int islot = 0; islot < n; islot++)
+    node_types[islot] = node_types_store + (bigint) islot*maxpoly;
+
+  grow_store(x_store, nodal_positions, n);
+  grow_store(hold_store, hold_nodal_positions, n);
+  grow_store(x0_store, initial_nodal_positions, n);
+  grow_store(v_store, nodal_velocities, n);
+  grow_store(f_store, nodal_forces, n);
+  grow_store(virial_store, nodal_virial, n);
+  atom->nodal_positions = nodal_positions;
+  atom->initial_nodal_positions = initial_nodal_positions;
+  atom->nodal_velocities = nodal_velocities;
+  atom->nodal_forces = nodal_forces;
+  atom->nodal_virial = nodal_virial;
+
+  for(int islot = 0; islot < n; islot++)
+    set_slot_views(islot, slot_node_count[islot]);
+  CAC_nmax = n;
+}
+
+/* ----------------------------------------------------------------------
+   resize one nodal store and the top level of its pointer view
+------------------------------------------------------------------------- */
+
+void AtomVecCAC::grow_store(NodalStore &store, double ****&view, int n)
+{
+  bigint slot_nodes = (bigint) maxpoly*nodes_per_element;
+  store.data = (double *)
+    memory->srealloc(store.data, sizeof(double)*n*slot_nodes*store.width, "atom:nodal_store");
+  store.node_ptrs = (double **)
+    memory->srealloc(store.node_ptrs, sizeof(double *)*n*slot_nodes, "atom:nodal_store_nodes");
+  store.poly_ptrs = (double ***)
+    memory->srealloc(store.poly_ptrs, sizeof(double **)*n*maxpoly, "atom:nodal_store_polys");
+  view = (double ****) memory->srealloc(view, sizeof(double ***)*n, "atom:nodal_view");
+}
+
+/* ----------------------------------------------------------------------
+   lay out the 4D pointer views of slot i for an element with node_count
+   nodes; the nodes of each poly index are packed back to back so the
+   element's data is one contiguous poly_count*node_count*width block
+   at the start of its fixed size maxpoly*nodes_per_element slot
+------------------------------------------------------------------------- */
+
+void AtomVecCAC::set_slot_views(int i, int node_count)
+{
+  NodalStore *stores[6] = {&x_store, &hold_store, &x0_store, &v_store, &f_store, &virial_store};
+  double ****views[6] = {nodal_positions, hold_nodal_positions, initial_nodal_positions,
+    nodal_velocities, nodal_forces, nodal_virial};
+  bigint slot_nodes = (bigint) maxpoly*nodes_per_element;
+
+  slot_node_count[i] = node_count;
+  for(int istore = 0; istore < 6; istore++){
+    NodalStore *store = stores[istore];
+    double **nodes = store->node_ptrs + i*slot_nodes;
+    double ***polys = store->poly_ptrs + (bigint) i*maxpoly;
+    double *data = store->data + i*slot_nodes*store->width;
+    for(int poly_index = 0; poly_index < maxpoly; poly_index++){
+      polys[poly_index] = nodes + poly_index*node_count;
+      for(int nodecount = 0; nodecount < node_count; nodecount++)
+        polys[poly_index][nodecount] = data + (poly_index*node_count + nodecount)*store->width;
+    }
+    views[istore][i] = polys;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy the nodal positions, initial positions and velocities of element i
+   into slot j as contiguous blocks
+------------------------------------------------------------------------- */
+
+void AtomVecCAC::copy_nodal(int i, int j)
+{
+  int node_count = atom->nodes_per_element_list[element_type[i]];
+  allocate_element(j,node_count);
+  if(i==j) return;
+  size_t nbytes = sizeof(double)*3*node_count*poly_count[i];
+  memcpy(node_types[j], node_types[i], sizeof(int)*poly_count[i]);
+  memcpy(nodal_positions[j][0][0], nodal_positions[i][0][0], nbytes);
+  memcpy(initial_nodal_positions[j][0][0], initial_nodal_positions[i][0][0], nbytes);
+  memcpy(nodal_velocities[j][0][0], nodal_velocities[i][0][0], nbytes);
+}
+
+/* ----------------------------------------------------------------------
+   pack the nodal positions, initial positions and velocities of element i
+   as three contiguous blocks; unshifted blocks are copied with memcpy
+   shift = NULL or position shift, applied in lamda coords if lamda_flag
+   vshift = NULL or velocity shift
+------------------------------------------------------------------------- */
 
+int AtomVecCAC::pack_nodal(int i, double *buf, double *shift, double *vshift, int lamda_flag)
+{
+  int n = 3*atom->nodes_per_element_list[element_type[i]]*poly_count[i];
+  double *xnode = nodal_positions[i][0][0];
+  double *x0node = initial_nodal_positions[i][0][0];
+  double *vnode = nodal_velocities[i][0][0];
+  double lamda_temp[3];
+
+  if(shift == NULL){
+    memcpy(buf, xnode, sizeof(double)*n);
+    memcpy(buf+n, x0node, sizeof(double)*n);
+  }
+  else if(lamda_flag){
+    for(int k = 0; k < n; k += 3){
+      domain->x2lamda(&xnode[k], lamda_temp);
+      lamda_temp[0] += shift[0];
+      lamda_temp[1] += shift[1];
+      lamda_temp[2] += shift[2];
+      domain->lamda2x(lamda_temp, &buf[k]);
+      domain->x2lamda(&x0node[k], lamda_temp);
+      lamda_temp[0] += shift[0];
+      lamda_temp[1] += shift[1];
+      lamda_temp[2] += shift[2];
+      domain->lamda2x(lamda_temp, &buf[n+k]);
+    }
+  }
+  else{
+    for(int k = 0; k < n; k += 3){
+      buf[k] = xnode[k] + shift[0];
+      buf[k+1] = xnode[k+1] + shift[1];
+      buf[k+2] = xnode[k+2] + shift[2];
+      buf[n+k] = x0node[k] + shift[0];
+      buf[n+k+1] = x0node[k+1] + shift[1];
+      buf[n+k+2] = x0node[k+2] + shift[2];
+    }
+  }
+
+  if(vshift == NULL)
+    memcpy(buf+2*n, vnode, sizeof(double)*n);
+  else{
+    for(int k = 0; k < n; k += 3){
+      buf[2*n+k] = vnode[k] + vshift[0];
+      buf[2*n+k+1] = vnode[k+1] + vshift[1];
+      buf[2*n+k+2] = vnode[k+2] + vshift[2];
+    }
+  }
+  return 3*n;
+}
+
+/* ----------------------------------------------------------------------
+   unpack the blocks written by pack_nodal into slot i; the slot views
+   must already be laid out for the element type of i
+------------------------------------------------------------------------- */
+
+int AtomVecCAC::unpack_nodal(int i, double *buf)
+{
+  int n = 3*atom->nodes_per_element_list[element_type[i]]*poly_count[i];
+  memcpy(nodal_positions[i][0][0], buf, sizeof(double)*n);
+  memcpy(initial_nodal_positions[i][0][0], buf+n, sizeof(double)*n);
+  memcpy(nodal_velocities[i][0][0], buf+2*n, sizeof(double)*n);
+  return 3*n;
 }
 
 /* ----------------------------------------------------------------------
@@ -326,8 +436,6 @@ void AtomVecCAC::grow_reset()
 
 void AtomVecCAC::copy(int i, int j, int delflag)
 {
-  int *nodes_count_list = atom->nodes_per_element_list;
-  int node_count;
   tag[j] = tag[i];
   type[j] = type[i];
   mask[j] = mask[i];
@@ -343,51 +451,9 @@ void AtomVecCAC::copy(int i, int j, int delflag)
   element_scale[j][1] = element_scale[i][1];
   element_scale[j][2] = element_scale[i][2];
   poly_count[j] = poly_count[i];
-  node_count = nodes_count_list[element_type[j]];
-  //copy nodal information; requires resizing since copy might be for
-  //an element of a different size
-    //destroy previous contents at that element index if present
-  if(j<alloc_counter){
-  memory->destroy(node_types[j]);
-  memory->destroy(nodal_positions[j]);
-  memory->destroy(hold_nodal_positions[j]);
-  memory->destroy(initial_nodal_positions[j]);
-  memory->destroy(nodal_velocities[j]);
-  memory->destroy(nodal_forces[j]);
-  memory->destroy(nodal_virial[j]);
-  }
-  else
-  alloc_counter++;
-
-  //create new allocation for this element
-  memory->create(node_types[j], poly_count[j],  "atom:node_types");
-  memory->create(nodal_positions[j], poly_count[j], node_count, 3, "atom:nodal_positions");
-  memory->create(hold_nodal_positions[j], poly_count[j], node_count, 3, "atom:hold_nodal_positions");
-  memory->create(initial_nodal_positions[j], poly_count[j], node_count, 3, "atom:initial_nodal_positions");
-  memory->create(nodal_velocities[j], poly_count[j], node_count, 3, "atom:nodal_velocities");
-  memory->create(nodal_forces[j], poly_count[j], node_count, 3, "atom:nodal_forces");
-  memory->create(nodal_virial[j], poly_count[j], node_count, 6, "atom:nodal_virial");
-
-  for (int type_map = 0; type_map < poly_count[j]; type_map++) {
-    node_types[j][type_map] = node_types[i][type_map];
-  }
-
-
-  for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-    for(int nodecount=0; nodecount< nodes_count_list[element_type[j]]; nodecount++ )
-      {
-        nodal_positions[j][poly_index][nodecount][0] = nodal_positions[i][poly_index][nodecount][0];
-        nodal_positions[j][poly_index][nodecount][1] = nodal_positions[i][poly_index][nodecount][1];
-        nodal_positions[j][poly_index][nodecount][2] = nodal_positions[i][poly_index][nodecount][2];
-        initial_nodal_positions[j][poly_index][nodecount][0] = initial_nodal_positions[i][poly_index][nodecount][0];
-        initial_nodal_positions[j][poly_index][nodecount][1] = initial_nodal_positions[i][poly_index][nodecount][1];
-        initial_nodal_positions[j][poly_index][nodecount][2] = initial_nodal_positions[i][poly_index][nodecount][2];
-        nodal_velocities[j][poly_index][nodecount][0] = nodal_velocities[i][poly_index][nodecount][0];
-        nodal_velocities[j][poly_index][nodecount][1] = nodal_velocities[i][poly_index][nodecount][1];
-        nodal_velocities[j][poly_index][nodecount][2] = nodal_velocities[i][poly_index][nodecount][2];
-      }
-    }
-
+  //copy nodal information; the slot views are relaid if the copy
+  //is for an element of a different size
+  copy_nodal(i,j);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -400,8 +466,7 @@ int AtomVecCAC::pack_comm(int n, int *list, double *buf,
                              int pbc_flag, int *pbc)
 {
   int i,j,m;
-  double dx,dy,dz;
-  int *nodes_count_list = atom->nodes_per_element_list;
+  double dx,dy,dz,dshift[3];
   m = 0;
   if (pbc_flag == 0) {
     for (i = 0; i < n; i++) {
@@ -421,20 +486,7 @@ int AtomVecCAC::pack_comm(int n, int *list, double *buf,
         buf[m++] = node_types[j][type_map];
       }
 
-      for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-        for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-        {
-          buf[m++] = nodal_positions[j][poly_index][nodecount][0];
-          buf[m++] = nodal_positions[j][poly_index][nodecount][1];
-          buf[m++] = nodal_positions[j][poly_index][nodecount][2];
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0];
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1];
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-        }
-      }
+      m += pack_nodal(j,&buf[m],NULL,NULL,0);
     }
   } else {
     if (domain->triclinic == 0) {
@@ -446,6 +498,9 @@ int AtomVecCAC::pack_comm(int n, int *list, double *buf,
       dy = pbc[1]*domain->yprd + pbc[3]*domain->yz;
       dz = pbc[2]*domain->zprd;
     }
+    dshift[0] = dx;
+    dshift[1] = dy;
+    dshift[2] = dz;
     for (i = 0; i < n; i++) {
       j = list[i];
       buf[m++] = x[j][0] + dx;
@@ -461,20 +516,7 @@ int AtomVecCAC::pack_comm(int n, int *list, double *buf,
         buf[m++] = node_types[j][type_map];
       }
 
-      for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-        for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-        {
-          buf[m++] = nodal_positions[j][poly_index][nodecount][0]+dx;
-          buf[m++] = nodal_positions[j][poly_index][nodecount][1] + dy;
-          buf[m++] = nodal_positions[j][poly_index][nodecount][2] + dz;
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0] + dx;
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1] + dy;
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2] + dz;
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-        }
-    }
+      m += pack_nodal(j,&buf[m],dshift,NULL,0);
 
     }
   }
@@ -487,8 +529,7 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
                                  int pbc_flag, int *pbc)
 {
   int i,j,m;
-  double dx,dy,dz,dvx,dvy,dvz;
-   int *nodes_count_list = atom->nodes_per_element_list;
+  double dx,dy,dz,dvx,dvy,dvz,dshift[3],dvshift[3];
   m = 0;
   if (pbc_flag == 0) {
     for (i = 0; i < n; i++) {
@@ -508,20 +549,7 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
         buf[m++] = node_types[j][type_map];
       }
 
-      for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-        for (int nodecount = 0; nodecount < nodes_count_list[element_type[j]]; nodecount++)
-        {
-          buf[m++] = nodal_positions[j][poly_index][nodecount][0];
-          buf[m++] = nodal_positions[j][poly_index][nodecount][1];
-          buf[m++] = nodal_positions[j][poly_index][nodecount][2];
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0];
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1];
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-        }
-      }
+      m += pack_nodal(j,&buf[m],NULL,NULL,0);
     }
   }
   else {
@@ -534,6 +562,9 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
       dy = pbc[1]*domain->yprd + pbc[3]*domain->yz;
       dz = pbc[2]*domain->zprd;
     }
+    dshift[0] = dx;
+    dshift[1] = dy;
+    dshift[2] = dz;
     if (!deform_vremap) {
       for (i = 0; i < n; i++) {
         j = list[i];
@@ -552,25 +583,15 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
           buf[m++] = node_types[j][type_map];
         }
 
-        for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-        for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-        {
-          buf[m++] = nodal_positions[j][poly_index][nodecount][0] + dx;
-          buf[m++] = nodal_positions[j][poly_index][nodecount][1] + dy;
-          buf[m++] = nodal_positions[j][poly_index][nodecount][2] + dz;
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0] + dx;
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1] + dy;
-          buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2] + dz;
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-        }
-        }
+        m += pack_nodal(j,&buf[m],dshift,NULL,0);
       }
     } else {
       dvx = pbc[0]*h_rate[0] + pbc[5]*h_rate[5] + pbc[4]*h_rate[4];
       dvy = pbc[1]*h_rate[1] + pbc[3]*h_rate[3];
       dvz = pbc[2]*h_rate[2];
+      dvshift[0] = dvx;
+      dvshift[1] = dvy;
+      dvshift[2] = dvz;
       for (i = 0; i < n; i++) {
         j = list[i];
         buf[m++] = x[j][0] + dx;
@@ -590,20 +611,7 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
             buf[m++] = node_types[j][type_map];
           }
 
-          for (int poly_index = 0; poly_index < poly_count[j]; poly_index++) {
-          for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-          {
-            buf[m++] = nodal_positions[j][poly_index][nodecount][0] + dx;
-            buf[m++] = nodal_positions[j][poly_index][nodecount][1] + dy;
-            buf[m++] = nodal_positions[j][poly_index][nodecount][2] + dz;
-            buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0] + dx;
-            buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1] + dy;
-            buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2] + dz;
-            buf[m++] = nodal_velocities[j][poly_index][nodecount][0] + dvx;
-            buf[m++] = nodal_velocities[j][poly_index][nodecount][1] + dvy;
-            buf[m++] = nodal_velocities[j][poly_index][nodecount][2] + dvz;
-          }
-          }
+          m += pack_nodal(j,&buf[m],dshift,dvshift,0);
         } else {
           buf[m++] = v[j][0];
           buf[m++] = v[j][1];
@@ -617,20 +625,7 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
             buf[m++] = node_types[j][type_map];
           }
 
-          for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-          for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-          {
-            buf[m++] = nodal_positions[j][poly_index][nodecount][0] + dx;
-            buf[m++] = nodal_positions[j][poly_index][nodecount][1] + dy;
-            buf[m++] = nodal_positions[j][poly_index][nodecount][2] + dz;
-            buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0] + dx;
-            buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1] + dy;
-            buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2] + dz;
-            buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-            buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-            buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-          }
-          }
+          m += pack_nodal(j,&buf[m],dshift,NULL,0);
         }
       }
     }
@@ -643,7 +638,6 @@ int AtomVecCAC::pack_comm_vel(int n, int *list, double *buf,
 void AtomVecCAC::unpack_comm(int n, int first, double *buf)
 {
   int i,m,last;
-  int *nodes_count_list = atom->nodes_per_element_list;
   m = 0;
   last = first + n;
   for (i = first; i < last; i++) {
@@ -659,20 +653,7 @@ void AtomVecCAC::unpack_comm(int n, int first, double *buf)
       node_types[i][type_map]= buf[m++];
     }
 
-  for (int poly_index = 0; poly_index < poly_count[i]; poly_index++){
-    for (int nodecount = 0; nodecount < nodes_count_list[element_type[i]]; nodecount++)
-    {
-      nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][0] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][1] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][2] = buf[m++];
-    }
-  }
+  m += unpack_nodal(i,&buf[m]);
   }
 }
 
@@ -681,7 +662,6 @@ void AtomVecCAC::unpack_comm(int n, int first, double *buf)
 void AtomVecCAC::unpack_comm_vel(int n, int first, double *buf)
 {
   int i,m,last;
-  int *nodes_count_list = atom->nodes_per_element_list;
   m = 0;
   last = first + n;
   for (i = first; i < last; i++) {
@@ -700,21 +680,266 @@ void AtomVecCAC::unpack_comm_vel(int n, int first, double *buf)
       node_types[i][type_map] = buf[m++];
     }
 
-  for (int poly_index = 0; poly_index < poly_count[i]; poly_index++){
-    for (int nodecount = 0; nodecount < nodes_count_list[element_type[i]]; nodecount++)
-    {
-      nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][0] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][1] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][2] = buf[m++];
+  m += unpack_nodal(i,&buf[m]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   periodic image shift for the pbc flags of a swap computed from the box
+   dimensions xprd,yprd,zprd,yz,xz,xy
+------------------------------------------------------------------------- */
+
+void AtomVecCAC::pbc_shift(int *pbc, double *box, double *dshift)
+{
+  if (domain->triclinic == 0) {
+    dshift[0] = pbc[0]*box[0];
+    dshift[1] = pbc[1]*box[1];
+    dshift[2] = pbc[2]*box[2];
+  } else {
+    dshift[0] = pbc[0]*box[0] + pbc[5]*box[5] + pbc[4]*box[4];
+    dshift[1] = pbc[1]*box[1] + pbc[3]*box[3];
+    dshift[2] = pbc[2]*box[2];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   forward comm of only the quantities that change between borders calls;
+   element types, scales and node types of ghosts are kept from borders
+------------------------------------------------------------------------- */
+
+int AtomVecCAC::pack_comm_nodal(int n, int *list, double *buf,
+                                 int pbc_flag, int *pbc)
+{
+  int i,j,k,m,nnodal,vshift_flag;
+  double box[6],dshift[3],dvshift[3];
+  double *xnode,*vnode;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  dshift[0] = dshift[1] = dshift[2] = 0.0;
+  dvshift[0] = dvshift[1] = dvshift[2] = 0.0;
+  if (pbc_flag) {
+    box[0] = domain->xprd; box[1] = domain->yprd; box[2] = domain->zprd;
+    box[3] = domain->yz; box[4] = domain->xz; box[5] = domain->xy;
+    pbc_shift(pbc,box,dshift);
+    if (deform_vremap) {
+      dvshift[0] = pbc[0]*h_rate[0] + pbc[5]*h_rate[5] + pbc[4]*h_rate[4];
+      dvshift[1] = pbc[1]*h_rate[1] + pbc[3]*h_rate[3];
+      dvshift[2] = pbc[2]*h_rate[2];
     }
   }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    vshift_flag = pbc_flag && deform_vremap && (mask[j] & deform_groupbit);
+    buf[m++] = x[j][0] + dshift[0];
+    buf[m++] = x[j][1] + dshift[1];
+    buf[m++] = x[j][2] + dshift[2];
+    if (vshift_flag) {
+      buf[m++] = v[j][0] + dvshift[0];
+      buf[m++] = v[j][1] + dvshift[1];
+      buf[m++] = v[j][2] + dvshift[2];
+    } else {
+      buf[m++] = v[j][0];
+      buf[m++] = v[j][1];
+      buf[m++] = v[j][2];
+    }
+
+    nnodal = 3*nodes_count_list[element_type[j]]*poly_count[j];
+    xnode = nodal_positions[j][0][0];
+    vnode = nodal_velocities[j][0][0];
+    if (!pbc_flag) memcpy(&buf[m], xnode, sizeof(double)*nnodal);
+    else
+      for (k = 0; k < nnodal; k += 3) {
+        buf[m+k] = xnode[k] + dshift[0];
+        buf[m+k+1] = xnode[k+1] + dshift[1];
+        buf[m+k+2] = xnode[k+2] + dshift[2];
+      }
+    m += nnodal;
+    if (!vshift_flag) memcpy(&buf[m], vnode, sizeof(double)*nnodal);
+    else
+      for (k = 0; k < nnodal; k += 3) {
+        buf[m+k] = vnode[k] + dvshift[0];
+        buf[m+k+1] = vnode[k+1] + dvshift[1];
+        buf[m+k+2] = vnode[k+2] + dvshift[2];
+      }
+    m += nnodal;
   }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecCAC::unpack_comm_nodal(int n, int first, double *buf)
+{
+  int i,m,last,nnodal;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  m = 0;
+  last = first + n;
+  for (i = first; i < last; i++) {
+    x[i][0] = buf[m++];
+    x[i][1] = buf[m++];
+    x[i][2] = buf[m++];
+    v[i][0] = buf[m++];
+    v[i][1] = buf[m++];
+    v[i][2] = buf[m++];
+    nnodal = 3*nodes_count_list[element_type[i]]*poly_count[i];
+    memcpy(nodal_positions[i][0][0], &buf[m], sizeof(double)*nnodal);
+    m += nnodal;
+    memcpy(nodal_velocities[i][0][0], &buf[m], sizeof(double)*nnodal);
+    m += nnodal;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   forward comm of nodal displacements since the last borders call as
+   floats; two floats are packed per double of the buffer. the change of
+   the periodic image shift since then is folded into the displacement so
+   the receiver only adds it to its own reference copy of the ghost.
+   nodal velocities have no reference and are sent in full precision.
+------------------------------------------------------------------------- */
+
+int AtomVecCAC::pack_comm_delta(int n, int *list, double *buf,
+                                 int pbc_flag, int *pbc)
+{
+  int i,j,k,m,nnodal,vshift_flag;
+  double box[6],dshift[3],dshift_ref[3],ddelta[3],dvshift[3];
+  double *xnode,*vnode,*xref;
+  float *fbuf;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  dshift[0] = dshift[1] = dshift[2] = 0.0;
+  ddelta[0] = ddelta[1] = ddelta[2] = 0.0;
+  dvshift[0] = dvshift[1] = dvshift[2] = 0.0;
+  if (pbc_flag) {
+    box[0] = domain->xprd; box[1] = domain->yprd; box[2] = domain->zprd;
+    box[3] = domain->yz; box[4] = domain->xz; box[5] = domain->xy;
+    pbc_shift(pbc,box,dshift);
+    pbc_shift(pbc,comm_reference_box,dshift_ref);
+    ddelta[0] = dshift[0] - dshift_ref[0];
+    ddelta[1] = dshift[1] - dshift_ref[1];
+    ddelta[2] = dshift[2] - dshift_ref[2];
+    if (deform_vremap) {
+      dvshift[0] = pbc[0]*h_rate[0] + pbc[5]*h_rate[5] + pbc[4]*h_rate[4];
+      dvshift[1] = pbc[1]*h_rate[1] + pbc[3]*h_rate[3];
+      dvshift[2] = pbc[2]*h_rate[2];
+    }
+  }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    if (j >= ncomm_reference)
+      error->one(FLERR,"CAC forward comm reference is out of date");
+    vshift_flag = pbc_flag && deform_vremap && (mask[j] & deform_groupbit);
+    buf[m++] = x[j][0] + dshift[0];
+    buf[m++] = x[j][1] + dshift[1];
+    buf[m++] = x[j][2] + dshift[2];
+    if (vshift_flag) {
+      buf[m++] = v[j][0] + dvshift[0];
+      buf[m++] = v[j][1] + dvshift[1];
+      buf[m++] = v[j][2] + dvshift[2];
+    } else {
+      buf[m++] = v[j][0];
+      buf[m++] = v[j][1];
+      buf[m++] = v[j][2];
+    }
+
+    nnodal = 3*nodes_count_list[element_type[j]]*poly_count[j];
+    xnode = nodal_positions[j][0][0];
+    vnode = nodal_velocities[j][0][0];
+    xref = &comm_reference[comm_reference_offset[j]];
+    fbuf = (float *) &buf[m];
+    for (k = 0; k < nnodal; k += 3) {
+      fbuf[k] = static_cast<float>(xnode[k] - xref[k] + ddelta[0]);
+      fbuf[k+1] = static_cast<float>(xnode[k+1] - xref[k+1] + ddelta[1]);
+      fbuf[k+2] = static_cast<float>(xnode[k+2] - xref[k+2] + ddelta[2]);
+    }
+    if (nnodal % 2) fbuf[nnodal] = 0.0f;
+    m += (nnodal+1)/2;
+    if (vshift_flag)
+      for (k = 0; k < nnodal; k += 3) {
+        buf[m++] = vnode[k] + dvshift[0];
+        buf[m++] = vnode[k+1] + dvshift[1];
+        buf[m++] = vnode[k+2] + dvshift[2];
+      }
+    else {
+      memcpy(&buf[m], vnode, sizeof(double)*nnodal);
+      m += nnodal;
+    }
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecCAC::unpack_comm_delta(int n, int first, double *buf)
+{
+  int i,k,m,last,nnodal;
+  double *xnode,*vnode,*xref;
+  float *fbuf;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  if (first+n > ncomm_reference)
+    error->one(FLERR,"CAC forward comm reference is out of date");
+
+  m = 0;
+  last = first + n;
+  for (i = first; i < last; i++) {
+    x[i][0] = buf[m++];
+    x[i][1] = buf[m++];
+    x[i][2] = buf[m++];
+    v[i][0] = buf[m++];
+    v[i][1] = buf[m++];
+    v[i][2] = buf[m++];
+    nnodal = 3*nodes_count_list[element_type[i]]*poly_count[i];
+    xnode = nodal_positions[i][0][0];
+    vnode = nodal_velocities[i][0][0];
+    xref = &comm_reference[comm_reference_offset[i]];
+    fbuf = (float *) &buf[m];
+    for (k = 0; k < nnodal; k++) xnode[k] = xref[k] + fbuf[k];
+    m += (nnodal+1)/2;
+    memcpy(vnode, &buf[m], sizeof(double)*nnodal);
+    m += nnodal;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   record the nodal positions of all local and ghost elements and the box
+   as the reference of delta forward comm; called at the end of borders
+------------------------------------------------------------------------- */
+
+void AtomVecCAC::store_comm_reference()
+{
+  int nall = atom->nlocal + atom->nghost;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  if (nall+1 > maxcomm_reference_offset) {
+    maxcomm_reference_offset = nall+1;
+    memory->destroy(comm_reference_offset);
+    memory->create(comm_reference_offset,maxcomm_reference_offset,"atom:comm_reference_offset");
+  }
+  comm_reference_offset[0] = 0;
+  for (int i = 0; i < nall; i++)
+    comm_reference_offset[i+1] = comm_reference_offset[i] +
+      3*nodes_count_list[element_type[i]]*poly_count[i];
+  if (comm_reference_offset[nall] > maxcomm_reference) {
+    maxcomm_reference = comm_reference_offset[nall];
+    memory->destroy(comm_reference);
+    memory->create(comm_reference,maxcomm_reference,"atom:comm_reference");
+  }
+  for (int i = 0; i < nall; i++)
+    memcpy(&comm_reference[comm_reference_offset[i]], nodal_positions[i][0][0],
+           sizeof(double)*(comm_reference_offset[i+1]-comm_reference_offset[i]));
+  ncomm_reference = nall;
+
+  comm_reference_box[0] = domain->xprd;
+  comm_reference_box[1] = domain->yprd;
+  comm_reference_box[2] = domain->zprd;
+  comm_reference_box[3] = domain->yz;
+  comm_reference_box[4] = domain->xz;
+  comm_reference_box[5] = domain->xy;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -754,10 +979,7 @@ int AtomVecCAC::pack_border(int n, int *list, double *buf,
                                int pbc_flag, int *pbc)
 {
   int i,j,m;
-  double dx,dy,dz;
-  double lamda_temp[3];
-  double nodal_temp[3];
-  int *nodes_count_list = atom->nodes_per_element_list;
+  double dx,dy,dz,dshift[3];
   m = 0;
   if (pbc_flag == 0) {
     for (i = 0; i < n; i++) {
@@ -777,20 +999,7 @@ int AtomVecCAC::pack_border(int n, int *list, double *buf,
       buf[m++] = node_types[j][type_map];
     }
 
-    for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-      for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-      {
-        buf[m++] = nodal_positions[j][poly_index][nodecount][0];
-        buf[m++] = nodal_positions[j][poly_index][nodecount][1];
-        buf[m++] = nodal_positions[j][poly_index][nodecount][2];
-        buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0];
-        buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1];
-        buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-      }
-    }
+    m += pack_nodal(j,&buf[m],NULL,NULL,0);
     }
   } else {
     if (domain->triclinic == 0) {
@@ -802,6 +1011,9 @@ int AtomVecCAC::pack_border(int n, int *list, double *buf,
       dy = pbc[1];
       dz = pbc[2];
     }
+    dshift[0] = dx;
+    dshift[1] = dy;
+    dshift[2] = dz;
     for (i = 0; i < n; i++) {
       j = list[i];
       buf[m++] = x[j][0] + dx;
@@ -819,51 +1031,7 @@ int AtomVecCAC::pack_border(int n, int *list, double *buf,
       buf[m++] = node_types[j][type_map];
     }
 
-    for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-      for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-      {
-        nodal_temp[0] = nodal_positions[j][poly_index][nodecount][0];
-        nodal_temp[1] = nodal_positions[j][poly_index][nodecount][1];
-        nodal_temp[2] = nodal_positions[j][poly_index][nodecount][2];
-        if (domain->triclinic != 0) {
-          domain->x2lamda(nodal_temp, lamda_temp);
-          lamda_temp[0] += dx;
-          lamda_temp[1] += dy;
-          lamda_temp[2] += dz;
-          domain->lamda2x(lamda_temp, nodal_temp);
-          buf[m++] = nodal_temp[0];
-          buf[m++] = nodal_temp[1];
-          buf[m++] = nodal_temp[2];
-        }
-        else {
-          buf[m++] = nodal_temp[0]+dx;
-          buf[m++] = nodal_temp[1]+dy;
-          buf[m++] = nodal_temp[2]+dz;
-        }
-
-        nodal_temp[0] = initial_nodal_positions[j][poly_index][nodecount][0];
-        nodal_temp[1] = initial_nodal_positions[j][poly_index][nodecount][1];
-        nodal_temp[2] = initial_nodal_positions[j][poly_index][nodecount][2];
-        if (domain->triclinic != 0) {
-          domain->x2lamda(nodal_temp, lamda_temp);
-          lamda_temp[0] += dx;
-          lamda_temp[1] += dy;
-          lamda_temp[2] += dz;
-          domain->lamda2x(lamda_temp, nodal_temp);
-          buf[m++] = nodal_temp[0];
-          buf[m++] = nodal_temp[1];
-          buf[m++] = nodal_temp[2];
-        }
-        else {
-          buf[m++] = nodal_temp[0] + dx;
-          buf[m++] = nodal_temp[1] + dy;
-          buf[m++] = nodal_temp[2] + dz;
-        }
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-      }
-    }
+    m += pack_nodal(j,&buf[m],dshift,NULL,domain->triclinic);
     }
   }
 
@@ -880,10 +1048,7 @@ int AtomVecCAC::pack_border_vel(int n, int *list, double *buf,
                                    int pbc_flag, int *pbc)
 {
   int i,j,m;
-  double dx,dy,dz,dvx,dvy,dvz;
-  double lamda_temp[3];
-  double nodal_temp[3];
-  int *nodes_count_list = atom->nodes_per_element_list;
+  double dx,dy,dz,dvx,dvy,dvz,dshift[3],dvshift[3];
   m = 0;
   if (pbc_flag == 0) {
     for (i = 0; i < n; i++) {
@@ -906,20 +1071,7 @@ int AtomVecCAC::pack_border_vel(int n, int *list, double *buf,
       buf[m++] = node_types[j][type_map];
     }
 
-    for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-      for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-      {
-        buf[m++] = nodal_positions[j][poly_index][nodecount][0];
-        buf[m++] = nodal_positions[j][poly_index][nodecount][1];
-        buf[m++] = nodal_positions[j][poly_index][nodecount][2];
-        buf[m++] = initial_nodal_positions[j][poly_index][nodecount][0];
-        buf[m++] = initial_nodal_positions[j][poly_index][nodecount][1];
-        buf[m++] = initial_nodal_positions[j][poly_index][nodecount][2];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-      }
-    }
+    m += pack_nodal(j,&buf[m],NULL,NULL,0);
     }
   } else {
     if (domain->triclinic == 0) {
@@ -931,6 +1083,9 @@ int AtomVecCAC::pack_border_vel(int n, int *list, double *buf,
       dy = pbc[1];
       dz = pbc[2];
     }
+    dshift[0] = dx;
+    dshift[1] = dy;
+    dshift[2] = dz;
     if (!deform_vremap) {
       for (i = 0; i < n; i++) {
         j = list[i];
@@ -952,56 +1107,15 @@ int AtomVecCAC::pack_border_vel(int n, int *list, double *buf,
       buf[m++] = node_types[j][type_map];
     }
 
-    for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-      for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-      {
-        nodal_temp[0] = nodal_positions[j][poly_index][nodecount][0];
-        nodal_temp[1] = nodal_positions[j][poly_index][nodecount][1];
-        nodal_temp[2] = nodal_positions[j][poly_index][nodecount][2];
-        if (domain->triclinic != 0) {
-          domain->x2lamda(nodal_temp, lamda_temp);
-          lamda_temp[0] += dx;
-          lamda_temp[1] += dy;
-          lamda_temp[2] += dz;
-          domain->lamda2x(lamda_temp, nodal_temp);
-          buf[m++] = nodal_temp[0];
-          buf[m++] = nodal_temp[1];
-          buf[m++] = nodal_temp[2];
-        }
-        else {
-          buf[m++] = nodal_temp[0] + dx;
-          buf[m++] = nodal_temp[1] + dy;
-          buf[m++] = nodal_temp[2] + dz;
-        }
-
-        nodal_temp[0] = initial_nodal_positions[j][poly_index][nodecount][0];
-        nodal_temp[1] = initial_nodal_positions[j][poly_index][nodecount][1];
-        nodal_temp[2] = initial_nodal_positions[j][poly_index][nodecount][2];
-        if (domain->triclinic != 0) {
-          domain->x2lamda(nodal_temp, lamda_temp);
-          lamda_temp[0] += dx;
-          lamda_temp[1] += dy;
-          lamda_temp[2] += dz;
-          domain->lamda2x(lamda_temp, nodal_temp);
-          buf[m++] = nodal_temp[0];
-          buf[m++] = nodal_temp[1];
-          buf[m++] = nodal_temp[2];
-        }
-        else {
-          buf[m++] = nodal_temp[0] + dx;
-          buf[m++] = nodal_temp[1] + dy;
-          buf[m++] = nodal_temp[2] + dz;
-        }
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-        buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-      }
-    }
+    m += pack_nodal(j,&buf[m],dshift,NULL,domain->triclinic);
       }
     } else {
       dvx = pbc[0]*h_rate[0] + pbc[5]*h_rate[5] + pbc[4]*h_rate[4];
       dvy = pbc[1]*h_rate[1] + pbc[3]*h_rate[3];
       dvz = pbc[2]*h_rate[2];
+      dvshift[0] = dvx;
+      dvshift[1] = dvy;
+      dvshift[2] = dvz;
       for (i = 0; i < n; i++) {
         j = list[i];
         buf[m++] = x[j][0] + dx;
@@ -1023,51 +1137,7 @@ int AtomVecCAC::pack_border_vel(int n, int *list, double *buf,
         buf[m++] = node_types[j][type_map];
       }
 
-      for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-        for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-        {
-          nodal_temp[0] = nodal_positions[j][poly_index][nodecount][0];
-          nodal_temp[1] = nodal_positions[j][poly_index][nodecount][1];
-          nodal_temp[2] = nodal_positions[j][poly_index][nodecount][2];
-          if (domain->triclinic != 0) {
-            domain->x2lamda(nodal_temp, lamda_temp);
-            lamda_temp[0] += dx;
-            lamda_temp[1] += dy;
-            lamda_temp[2] += dz;
-            domain->lamda2x(lamda_temp, nodal_temp);
-            buf[m++] = nodal_temp[0];
-            buf[m++] = nodal_temp[1];
-            buf[m++] = nodal_temp[2];
-          }
-          else {
-            buf[m++] = nodal_temp[0] + dx;
-            buf[m++] = nodal_temp[1] + dy;
-            buf[m++] = nodal_temp[2] + dz;
-          }
-
-          nodal_temp[0] = initial_nodal_positions[j][poly_index][nodecount][0];
-          nodal_temp[1] = initial_nodal_positions[j][poly_index][nodecount][1];
-          nodal_temp[2] = initial_nodal_positions[j][poly_index][nodecount][2];
-          if (domain->triclinic != 0) {
-            domain->x2lamda(nodal_temp, lamda_temp);
-            lamda_temp[0] += dx;
-            lamda_temp[1] += dy;
-            lamda_temp[2] += dz;
-            domain->lamda2x(lamda_temp, nodal_temp);
-            buf[m++] = nodal_temp[0];
-            buf[m++] = nodal_temp[1];
-            buf[m++] = nodal_temp[2];
-          }
-          else {
-            buf[m++] = nodal_temp[0] + dx;
-            buf[m++] = nodal_temp[1] + dy;
-            buf[m++] = nodal_temp[2] + dz;
-          }
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][0] + dvx;
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][1] + dvy;
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][2] + dvz;
-        }
-      }
+      m += pack_nodal(j,&buf[m],dshift,dvshift,domain->triclinic);
         } else {
           buf[m++] = v[j][0];
           buf[m++] = v[j][1];
@@ -1081,51 +1151,7 @@ int AtomVecCAC::pack_border_vel(int n, int *list, double *buf,
         buf[m++] = node_types[j][type_map];
       }
 
-      for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-        for (int nodecount = 0; nodecount< nodes_count_list[element_type[j]]; nodecount++)
-        {
-          nodal_temp[0] = nodal_positions[j][poly_index][nodecount][0];
-          nodal_temp[1] = nodal_positions[j][poly_index][nodecount][1];
-          nodal_temp[2] = nodal_positions[j][poly_index][nodecount][2];
-          if (domain->triclinic != 0) {
-            domain->x2lamda(nodal_temp, lamda_temp);
-            lamda_temp[0] += dx;
-            lamda_temp[1] += dy;
-            lamda_temp[2] += dz;
-            domain->lamda2x(lamda_temp, nodal_temp);
-            buf[m++] = nodal_temp[0];
-            buf[m++] = nodal_temp[1];
-            buf[m++] = nodal_temp[2];
-          }
-          else {
-            buf[m++] = nodal_temp[0] + dx;
-            buf[m++] = nodal_temp[1] + dy;
-            buf[m++] = nodal_temp[2] + dz;
-          }
-
-          nodal_temp[0] = initial_nodal_positions[j][poly_index][nodecount][0];
-          nodal_temp[1] = initial_nodal_positions[j][poly_index][nodecount][1];
-          nodal_temp[2] = initial_nodal_positions[j][poly_index][nodecount][2];
-          if (domain->triclinic != 0) {
-            domain->x2lamda(nodal_temp, lamda_temp);
-            lamda_temp[0] += dx;
-            lamda_temp[1] += dy;
-            lamda_temp[2] += dz;
-            domain->lamda2x(lamda_temp, nodal_temp);
-            buf[m++] = nodal_temp[0];
-            buf[m++] = nodal_temp[1];
-            buf[m++] = nodal_temp[2];
-          }
-          else {
-            buf[m++] = nodal_temp[0] + dx;
-            buf[m++] = nodal_temp[1] + dy;
-            buf[m++] = nodal_temp[2] + dz;
-          }
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][0];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][1];
-          buf[m++] = nodal_velocities[j][poly_index][nodecount][2];
-        }
-      }
+      m += pack_nodal(j,&buf[m],dshift,NULL,domain->triclinic);
         }
       }
     }
@@ -1159,25 +1185,12 @@ void AtomVecCAC::unpack_border(int n, int first, double *buf)
   element_scale[i][1] = buf[m++];
   element_scale[i][2] = buf[m++];
   poly_count[i] = buf[m++];
-  allocate_element(i,nodes_count_list[element_type[i]],poly_count[i]);
+  allocate_element(i,nodes_count_list[element_type[i]]);
   for (int type_map = 0; type_map < poly_count[i]; type_map++) {
     node_types[i][type_map] = buf[m++];
   }
 
-  for (int poly_index = 0; poly_index < poly_count[i]; poly_index++){
-    for (int nodecount = 0; nodecount < nodes_count_list[element_type[i]]; nodecount++)
-    {
-      nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][0] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][1] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][2] = buf[m++];
-    }
-  }
+  m += unpack_nodal(i,&buf[m]);
   }
 
   if (atom->nextra_border)
@@ -1210,25 +1223,12 @@ void AtomVecCAC::unpack_border_vel(int n, int first, double *buf)
   element_scale[i][1] = buf[m++];
   element_scale[i][2] = buf[m++];
   poly_count[i] = buf[m++];
-  allocate_element(i,nodes_count_list[element_type[i]],poly_count[i]);
+  allocate_element(i,nodes_count_list[element_type[i]]);
   for (int type_map = 0; type_map < poly_count[i]; type_map++) {
     node_types[i][type_map] = buf[m++];
   }
 
-  for (int poly_index = 0; poly_index < poly_count[i]; poly_index++){
-    for (int nodecount = 0; nodecount < nodes_count_list[element_type[i]]; nodecount++)
-    {
-      nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][0] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][1] = buf[m++];
-      initial_nodal_positions[i][poly_index][nodecount][2] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][0] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][1] = buf[m++];
-      nodal_velocities[i][poly_index][nodecount][2] = buf[m++];
-    }
-  }
+  m += unpack_nodal(i,&buf[m]);
   }
 
   if (atom->nextra_border)
@@ -1245,7 +1245,6 @@ void AtomVecCAC::unpack_border_vel(int n, int first, double *buf)
 int AtomVecCAC::pack_exchange(int i, double *buf)
 {
   int m = 1;
-  int *nodes_count_list = atom->nodes_per_element_list;
   buf[m++] = x[i][0];
   buf[m++] = x[i][1];
   buf[m++] = x[i][2];
@@ -1265,20 +1264,7 @@ int AtomVecCAC::pack_exchange(int i, double *buf)
     buf[m++] = node_types[i][type_map];
   }
 
-  for (int poly_index = 0; poly_index < poly_count[i]; poly_index++){
-    for (int nodecount = 0; nodecount< nodes_count_list[element_type[i]]; nodecount++)
-    {
-      buf[m++] = nodal_positions[i][poly_index][nodecount][0];
-      buf[m++] = nodal_positions[i][poly_index][nodecount][1];
-      buf[m++] = nodal_positions[i][poly_index][nodecount][2];
-      buf[m++] = initial_nodal_positions[i][poly_index][nodecount][0];
-      buf[m++] = initial_nodal_positions[i][poly_index][nodecount][1];
-      buf[m++] = initial_nodal_positions[i][poly_index][nodecount][2];
-      buf[m++] = nodal_velocities[i][poly_index][nodecount][0];
-      buf[m++] = nodal_velocities[i][poly_index][nodecount][1];
-      buf[m++] = nodal_velocities[i][poly_index][nodecount][2];
-    }
-  }
+  m += pack_nodal(i,&buf[m],NULL,NULL,0);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -1312,25 +1298,12 @@ int AtomVecCAC::unpack_exchange(double *buf)
   element_scale[nlocal][1] = buf[m++];
   element_scale[nlocal][2] = buf[m++];
   poly_count[nlocal] = buf[m++];
-  allocate_element(nlocal,nodes_count_list[element_type[nlocal]],poly_count[nlocal]);
+  allocate_element(nlocal,nodes_count_list[element_type[nlocal]]);
   for (int type_map = 0; type_map < poly_count[nlocal]; type_map++) {
     node_types[nlocal][type_map] = buf[m++];
   }
 
-  for (int poly_index = 0; poly_index < poly_count[nlocal]; poly_index++){
-    for (int nodecount = 0; nodecount < nodes_count_list[element_type[nlocal]]; nodecount++)
-    {
-      nodal_positions[nlocal][poly_index][nodecount][0] = buf[m++];
-      nodal_positions[nlocal][poly_index][nodecount][1] = buf[m++];
-      nodal_positions[nlocal][poly_index][nodecount][2] = buf[m++];
-      initial_nodal_positions[nlocal][poly_index][nodecount][0] = buf[m++];
-      initial_nodal_positions[nlocal][poly_index][nodecount][1] = buf[m++];
-      initial_nodal_positions[nlocal][poly_index][nodecount][2] = buf[m++];
-      nodal_velocities[nlocal][poly_index][nodecount][0] = buf[m++];
-      nodal_velocities[nlocal][poly_index][nodecount][1] = buf[m++];
-      nodal_velocities[nlocal][poly_index][nodecount][2] = buf[m++];
-    }
-  }
+  m += unpack_nodal(nlocal,&buf[m]);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -1455,7 +1428,7 @@ int AtomVecCAC::unpack_restart(double *buf)
   element_scale[nlocal][2] = (int) ubuf(buf[m++]).i;
   poly_count[nlocal] = (int) ubuf(buf[m++]).i;
   current_node_count=nodes_count_list[element_type[nlocal]];
-  allocate_element(nlocal,current_node_count,poly_count[nlocal]);
+  allocate_element(nlocal,current_node_count);
 
   for (int type_map = 0; type_map < poly_count[nlocal]; type_map++) {
     node_types[nlocal][type_map] = (int) ubuf(buf[m++]).i;
@@ -1513,7 +1486,7 @@ void AtomVecCAC::create_atom(int itype, double *coord)
   element_scale[nlocal][1] = 1;
   element_scale[nlocal][2] = 1;
   
-  allocate_element(nlocal,1,1);
+  allocate_element(nlocal,1);
   for (int type_map = 0; type_map < 1; type_map++) {
     node_types[nlocal][type_map] = itype;
   }
@@ -1597,7 +1570,7 @@ void AtomVecCAC::data_atom(double *coord, imageint imagetmp, char **values)
   if (nodetotal > nodes_per_element)
     error->one(FLERR, "element type requires a greater number of nodes than the specified maximum nodes per element passed to atom style cac");
 
-  allocate_element(nlocal,nodetotal,poly_count[nlocal]);
+  allocate_element(nlocal,nodetotal);
   for (int polycount = 0; polycount < npoly; polycount++) {
     node_types[nlocal][polycount] = 0; //initialize
     node_count_per_poly[polycount]=0;
@@ -1736,7 +1709,6 @@ void AtomVecCAC::write_data(FILE *fp, int n, double **buf)
 double AtomVecCAC::memory_usage()
 {
   bigint bytes = 0;
-  int *nodes_count_list = atom->nodes_per_element_list;
   if (atom->memcheck("tag")) bytes += memory->usage(tag,nmax);
   if (atom->memcheck("type")) bytes += memory->usage(type,nmax);
   if (atom->memcheck("mask")) bytes += memory->usage(mask,nmax);
@@ -1747,18 +1719,29 @@ double AtomVecCAC::memory_usage()
   if (atom->memcheck("element_types")) bytes += memory->usage(element_type, nmax);
   if (atom->memcheck("poly_counts")) bytes += memory->usage(poly_count, nmax);
   if (atom->memcheck("element_scale")) bytes += memory->usage(element_scale, nmax, 3);
-  for(int usage_index=0; usage_index < alloc_counter; usage_index++){
-  int current_poly_count = poly_count[usage_index];
-  int node_count = nodes_count_list[element_type[usage_index]];
-  if (atom->memcheck("node_types")) bytes += memory->usage(node_types[usage_index],current_poly_count);
-  if (atom->memcheck("nodal_positions")) bytes += memory->usage(nodal_positions[usage_index],current_poly_count, node_count,3);
-  if (atom->memcheck("hold_nodal_positions")) bytes += memory->usage(hold_nodal_positions[usage_index],current_poly_count, node_count,3);
-  if (atom->memcheck("initial_nodal_positions")) bytes += memory->usage(initial_nodal_positions[usage_index], current_poly_count, node_count, 3);
-  if (atom->memcheck("nodal_velocities")) bytes += memory->usage(nodal_velocities[usage_index], current_poly_count, node_count,3);
-  if (atom->memcheck("nodal_forces")) bytes += memory->usage(nodal_forces[usage_index], current_poly_count, node_count,3);
-  if (atom->memcheck("nodal_virial")) bytes += memory->usage(nodal_virial[usage_index], current_poly_count, node_count,6);
-  }
+  bytes += nodal_storage_usage();
+
+  return bytes;
+}
+
+/* ----------------------------------------------------------------------
+   return # of bytes held by the contiguous nodal stores
+------------------------------------------------------------------------- */
 
+double AtomVecCAC::nodal_storage_usage()
+{
+  bigint bytes = 0;
+  bigint slot_nodes = (bigint) maxpoly*nodes_per_element;
+  NodalStore *stores[6] = {&x_store, &hold_store, &x0_store, &v_store, &f_store, &virial_store};
+  const char *names[6] = {"nodal_positions", "hold_nodal_positions", "initial_nodal_positions",
+    "nodal_velocities", "nodal_forces", "nodal_virial"};
+  if (atom->memcheck("node_types")) bytes += (bigint) CAC_nmax*maxpoly*sizeof(int);
+  bytes += maxcomm_reference*sizeof(double) + maxcomm_reference_offset*sizeof(bigint);
+  for(int istore = 0; istore < 6; istore++){
+    if (!atom->memcheck(names[istore])) continue;
+    bytes += CAC_nmax*slot_nodes*stores[istore]->width*sizeof(double);
+    bytes += CAC_nmax*(slot_nodes*sizeof(double *) + maxpoly*sizeof(double **) + sizeof(double ***));
+  }
   return bytes;
 }
 
@@ -1769,20 +1752,9 @@ double AtomVecCAC::memory_usage()
 void AtomVecCAC::force_clear(int a, size_t b) {
   int *nodes_count_list = atom->nodes_per_element_list;
   for (int i = 0; i < atom->nlocal; i++) {
-    for (int poly_index = 0; poly_index < poly_count[i]; poly_index++){
-      for (int nodecount = 0; nodecount < nodes_count_list[element_type[i]]; nodecount++)
-      {
-        nodal_forces[i][poly_index][nodecount][0] = 0;
-        nodal_forces[i][poly_index][nodecount][1] = 0;
-        nodal_forces[i][poly_index][nodecount][2] = 0;
-        nodal_virial[i][poly_index][nodecount][0] = 0;
-        nodal_virial[i][poly_index][nodecount][1] = 0;
-        nodal_virial[i][poly_index][nodecount][2] = 0;
-        nodal_virial[i][poly_index][nodecount][3] = 0;
-        nodal_virial[i][poly_index][nodecount][4] = 0;
-        nodal_virial[i][poly_index][nodecount][5] = 0;
-      }
-    }
+    int nnode = nodes_count_list[element_type[i]]*poly_count[i];
+    memset(nodal_forces[i][0][0], 0, sizeof(double)*3*nnode);
+    memset(nodal_virial[i][0][0], 0, sizeof(double)*6*nnode);
   }
 
   if (atom->nextra_clear)
@@ -1938,21 +1910,12 @@ int element_index;
 int *nodes_count_list = atom->nodes_per_element_list;
 int *check_element_type = atom->element_type;
 int *check_poly_count = atom->poly_count;
-check_nodal_positions = atom->nodal_positions;
+double ****check_nodal_positions = atom->nodal_positions;
 
 for (element_index=0; element_index < atom->nlocal; element_index++){
-
-
-    for (int poly_index = 0; poly_index < check_poly_count[element_index]; poly_index++){
-      for (int nodecount = 0; nodecount < nodes_count_list[check_element_type[element_index]]; nodecount++)
-      {
-
-        hold_nodal_positions[element_index][poly_index][nodecount][0] = check_nodal_positions[element_index][poly_index][nodecount][0];
-        hold_nodal_positions[element_index][poly_index][nodecount][1] = check_nodal_positions[element_index][poly_index][nodecount][1];
-        hold_nodal_positions[element_index][poly_index][nodecount][2] = check_nodal_positions[element_index][poly_index][nodecount][2];
-
-      }
-    }
+  int nnode = nodes_count_list[check_element_type[element_index]]*check_poly_count[element_index];
+  memcpy(hold_nodal_positions[element_index][0][0], check_nodal_positions[element_index][0][0],
+    sizeof(double)*3*nnode);
 }
 
 }
@@ -1963,55 +1926,34 @@ for (element_index=0; element_index < atom->nlocal; element_index++){
 
 int AtomVecCAC::check_distance_function(double deltasq){
   int flag=0;
-  double Work[200];
-  long iWork[3];
-  double xm[3], lo[3], hi[3] ;
-  double unit_cell_mapped[3];
-  int i, element_index;
+  int element_index, nodes_per_element;
   int *nodes_count_list = atom->nodes_per_element_list;
   int *check_element_type = atom->element_type;
-  check_element_scale = atom->element_scale;
   int *check_poly_count = atom->poly_count;
-  check_nodal_positions = atom->nodal_positions;
-  int n = 3;
+  double ****check_nodal_positions = atom->nodal_positions;
   double delx, dely, delz;
   double distancesq;
   for (element_index=0; element_index < atom->nlocal; element_index++){
     if(check_element_type[element_index]){
-    min_nodes_per_element=nodes_count_list[check_element_type[element_index]];
-    min_element_index=element_index;
-    unit_cell_mapped[0] = 2 / double(check_element_scale[element_index][0]);
-    unit_cell_mapped[1] = 2 / double(check_element_scale[element_index][1]);
-    unit_cell_mapped[2] = 2 / double(check_element_scale[element_index][2]);
-    deltasq_trigger = deltasq; //make squared trigger distance visible to the min obj and grad functions
-    /* allocate arrays for problem solution and bounds */
-
-    xm[0] = 0;
-    xm[1] = 0;
-    xm[2] = 0;
-    for (i = 0; i < n; i++) lo[i] = (double)-1;
-    for (i = 0; i < n; i++) hi[i] = (double)1;
-
-    //clock_t tforce_density_min_e = clock();
-    iWork[0] = 0;
-    iWork[1] = 0;
-    iWork[2] = 0;
-    for (int Workcounter = 0; Workcounter < 200; Workcounter++) {
-      Work[Workcounter] = 0;
-    }
-
-    double unit_cell_min = unit_cell_mapped[0];
-    if (unit_cell_min > unit_cell_mapped[1]) unit_cell_min = unit_cell_mapped[1];
-    if (unit_cell_min > unit_cell_mapped[2]) unit_cell_min = unit_cell_mapped[2];
-    //loop minimum for every poly DOF to ensure maximum
-    // run the minimization code
-    for (poly_min = 0; poly_min < check_poly_count[element_index]; poly_min++) {
-    asa_pointer->call_asa_cg(xm, lo, hi, n, 1.e-2*unit_cell_min, NULL, Work, iWork);
-    if(evaluate_check(xm[0],xm[1],xm[2])>deltasq){
-      flag=1;
-      break;
-    }
-    }
+    nodes_per_element=nodes_count_list[check_element_type[element_index]];
+
+    //the displacement field is interpolated from the nodal displacements
+    //with non-negative shape functions that sum to one, and each node sits
+    //on a corner where its own shape function is one, so the largest nodal
+    //displacement is the maximum displacement inside the element
+    double ***current_nodal_positions = check_nodal_positions[element_index];
+    double ***current_hold_positions = hold_nodal_positions[element_index];
+    for (int ipoly = 0; ipoly < check_poly_count[element_index] && !flag; ipoly++)
+      for (int inode = 0; inode < nodes_per_element; inode++){
+        delx=current_nodal_positions[ipoly][inode][0]-current_hold_positions[ipoly][inode][0];
+        dely=current_nodal_positions[ipoly][inode][1]-current_hold_positions[ipoly][inode][1];
+        delz=current_nodal_positions[ipoly][inode][2]-current_hold_positions[ipoly][inode][2];
+        distancesq = delx*delx + dely*dely + delz*delz;
+        if (distancesq>deltasq){
+          flag=1;
+          break;
+        }
+      }
     if(flag) break;
     }
     else{
@@ -2028,43 +1970,3 @@ int AtomVecCAC::check_distance_function(double deltasq){
 
   return flag;
 }
-
-///////////////////////////////////////////////////
-
-double AtomVecCAC::evaluate_check /* evaluate the objective function */
-(double xp1, double xp2, double xp3)
-{
-  double f, xi, t, *g, x[3];
-  double px, py, pz;
-  double px1, px2, py1, py2, pz1, pz2;
-
-  double unit_cell_mapped[3];
-  double shape_func2;
-  double ***current_nodal_positions = atom->nodal_positions[min_element_index];
-  double ***current_hold_positions = hold_nodal_positions[min_element_index];
-  unit_cell_mapped[0] = 2 / double(atom->element_scale[min_element_index][0]);
-  unit_cell_mapped[1] = 2 / double(atom->element_scale[min_element_index][1]);
-  unit_cell_mapped[2] = 2 / double(atom->element_scale[min_element_index][2]);
-  int n = 3;
-  x[0] = xp1;
-  x[1] = xp2;
-  x[2] = xp3;
-
-  f = 0;
-
-  px = 0;
-  py = 0;
-  pz = 0;
-  for (int kk = 0; kk < min_nodes_per_element; kk++) {
-    shape_func2 = shape_function(x[0], x[1], x[2], 2, kk + 1);
-    px += (current_nodal_positions[poly_min][kk][0]-current_hold_positions[poly_min][kk][0]) * shape_func2;
-    py += (current_nodal_positions[poly_min][kk][1]-current_hold_positions[poly_min][kk][1]) * shape_func2;
-    pz += (current_nodal_positions[poly_min][kk][2]-current_hold_positions[poly_min][kk][2]) * shape_func2;
-  }
-
-
-  f = (px*px +  py*py +  pz*pz);
-
-
-  return (f);
-}
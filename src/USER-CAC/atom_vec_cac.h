@@ -26,15 +26,8 @@ namespace LAMMPS_NS {
 
 class AtomVecCAC : public AtomVec {
  public:
-  //minimization algorithm structs for neighbor rebuild checks
-  class Asa_Data *asa_pointer;
-  //variables for Asa_Data to obtain    
+  //nodal positions at the last reneighbor, for rebuild checks
   double ****hold_nodal_positions;
-  double ****check_nodal_positions;
-  int poly_min;
-  int min_nodes_per_element;
-  int min_element_index;
-  int **check_element_scale;
 
   AtomVecCAC(class LAMMPS *);
   virtual ~AtomVecCAC();
@@ -46,6 +39,11 @@ class AtomVecCAC : public AtomVec {
   virtual int pack_comm_vel(int, int *, double *, int, int *);
   virtual void unpack_comm(int, int, double *);
   virtual void unpack_comm_vel(int, int, double *);
+  virtual int pack_comm_nodal(int, int *, double *, int, int *);
+  virtual void unpack_comm_nodal(int, int, double *);
+  virtual int pack_comm_delta(int, int *, double *, int, int *);
+  virtual void unpack_comm_delta(int, int, double *);
+  void store_comm_reference(); //records ghost and local nodal positions for delta forward comm
   virtual int pack_reverse(int, int, double *);
   virtual void unpack_reverse(int, int *, double *);
   virtual int pack_border(int, int *, double *, int, int *);
@@ -66,6 +64,7 @@ class AtomVecCAC : public AtomVec {
   virtual int check_distance_function(double deltasq); //specific neighbor rebuild check function 
   virtual void set_hold_properties(); //sets nodal positions at reneighboring step for comparison
   virtual void shrink_array(int);
+  virtual void allocate_element(int,int); //lays out slot i for an element with the given node count
 
 
   virtual double shape_function(double, double, double,int,int);
@@ -87,15 +86,41 @@ class AtomVecCAC : public AtomVec {
   int element_type_count;
   int search_range_max;
   int initial_size;
-  double deltasq_trigger;
   int max_old;
   int *node_count_per_poly;
   int CAC_nmax;
   int alloc_counter;
 
-  double evaluate_check(double x1, double x2, double x3);
+  // contiguous backing store for one set of nodal 4D pointer views;
+  // slot i holds element i as [poly][node][dim] packed by its own node count
+  // and sits at a fixed stride of maxpoly*nodes_per_element nodes
+  struct NodalStore {
+    double *data;
+    double **node_ptrs;
+    double ***poly_ptrs;
+    int width;
+  };
+  NodalStore x_store, hold_store, x0_store, v_store, f_store, virial_store;
+  int *node_types_store;
+  int *slot_node_count;
+
+  // nodal positions of local and ghost elements at the last borders call;
+  // delta forward comm sends float displacements relative to these
+  double *comm_reference;
+  bigint *comm_reference_offset;
+  int ncomm_reference, maxcomm_reference_offset;
+  bigint maxcomm_reference;
+  double comm_reference_box[6];   //xprd,yprd,zprd,yz,xz,xy when the reference was recorded
+
   virtual void define_elements();
-  virtual void allocate_element(int,int,int);
+  void grow_nodal_storage(int);
+  void grow_store(NodalStore &, double ****&, int);
+  void set_slot_views(int, int);
+  void copy_nodal(int, int);
+  int pack_nodal(int, double *, double *, double *, int);
+  int unpack_nodal(int, double *);
+  void pbc_shift(int *, double *, double *);
+  double nodal_storage_usage();
 };
 
 }
@@ -169,4 +194,10 @@ E: cac atom style does not yet support writing data files
 
 Self-explanatory
 
+E: CAC forward comm reference is out of date
+
+The delta mode of the cac_forward_comm command needs the ghost elements
+to be unchanged since the last reneighboring. Use the full or nodal mode
+if this error occurs.
+
 */
@@ -22,7 +22,6 @@
 #include "fix.h"
 #include "memory.h"
 #include "error.h"
-#include "asa_data.h"
 
 #define MAX_ELEMENT_NAME 256
 
@@ -50,14 +49,14 @@ AtomVecCAC_Charge::AtomVecCAC_Charge(LAMMPS *lmp) : AtomVecCAC(lmp)
   search_range_max = 0;
   initial_size=0;
   check_distance_flag=1;
+  node_charges=NULL;
+  node_charges_store=NULL;
 }
 
 //--------------------------------------------------------------------------
 
 AtomVecCAC_Charge::~AtomVecCAC_Charge() {
-for(int element_index=0; element_index < alloc_counter; element_index++){
-  memory->destroy(node_charges[element_index]);
-}
+  memory->destroy(node_charges_store);
 }
 
 /* ----------------------------------------------------------------------
@@ -118,40 +117,10 @@ void AtomVecCAC_Charge::grow(int n)
   element_type= memory->grow(atom->element_type, nmax, "atom:element_type");
   element_scale = memory->grow(atom->element_scale, nmax,3, "atom:element_scales");
 
-  //grow pointers for a ragged allocation strategy since atoms allocate far less memory
-  if(CAC_nmax==0){
-  atom->node_types = node_types = (int **) memory->smalloc(sizeof(int *)*nmax, "atom:node_types");
-  atom->node_charges = node_charges = (double **) memory->smalloc(sizeof(double *)*nmax, "atom:node_charges");
-  atom->nodal_positions = nodal_positions =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_positions");
-  hold_nodal_positions = (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:hold_nodal_positions");
-  atom->initial_nodal_positions = initial_nodal_positions =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:initial_nodal_positions");
-  atom->nodal_velocities = nodal_velocities =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_velocities");
-  atom->nodal_forces = nodal_forces =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_forces");
-  atom->nodal_virial = nodal_virial =
-    (double ****) memory->smalloc(sizeof(double ***)*nmax, "atom:nodal_virial");
-  CAC_nmax = nmax;
-  }
-  else{
-  atom->node_types = node_types = (int **) memory->srealloc(node_types,sizeof(int *)*nmax, "atom:node_types");
-  atom->node_charges = node_charges = (double **) memory->srealloc(node_charges,sizeof(double *)*nmax, "atom:node_charges");
-  atom->nodal_positions = nodal_positions =
-    (double ****) memory->srealloc(nodal_positions,sizeof(double ***)*nmax, "atom:nodal_positions");
-  hold_nodal_positions =
-  (double ****) memory->srealloc(hold_nodal_positions,sizeof(double ***)*nmax, "atom:hold_nodal_positions");
-  atom->initial_nodal_positions = initial_nodal_positions =
-    (double ****) memory->srealloc(initial_nodal_positions,sizeof(double ***)*nmax, "atom:initial_nodal_positions");
-  atom->nodal_velocities = nodal_velocities =
-    (double ****) memory->srealloc(nodal_velocities,sizeof(double ***)*nmax, "atom:nodal_velocities");
-  atom->nodal_forces = nodal_forces =
-    (double ****) memory->srealloc(nodal_forces,sizeof(double ***)*nmax, "atom:nodal_forces");
-  atom->nodal_virial = nodal_virial =
-    (double ****) memory->srealloc(nodal_virial,sizeof(double ***)*nmax, "atom:nodal_virial");
-  CAC_nmax = nmax;
-  }
+  //grow the contiguous nodal stores and rebuild their pointer views
+  grow_nodal_storage(nmax);
+  grow_charge_storage(nmax);
+
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
       modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
@@ -178,36 +147,11 @@ void AtomVecCAC_Charge::shrink_array(int n)
   element_type= memory->grow(atom->element_type, nmax, "atom:element_type");
   element_scale = memory->grow(atom->element_scale, nmax,3, "atom:element_scales");
 
-  //deallocate element contents if n is smaller than the alloc counter for elements
-  for(int element_index=alloc_counter-1; element_index >= nmax; element_index--){
-  memory->destroy(node_types[element_index]);
-  memory->destroy(node_charges[element_index]);
-  memory->destroy(nodal_positions[element_index]);
-  memory->destroy(hold_nodal_positions[element_index]);
-  memory->destroy(initial_nodal_positions[element_index]);
-  memory->destroy(nodal_velocities[element_index]);
-  memory->destroy(nodal_forces[element_index]);
-  memory->destroy(nodal_virial[element_index]);
-  }
+  //shrink the contiguous nodal stores; slots below nmax keep their contents
   if(alloc_counter>nmax)
   alloc_counter = nmax;
-
-  //shrink pointer arrays
-  atom->node_types = node_types = (int **) memory->srealloc(node_types,sizeof(int *)*nmax, "atom:node_types");
-  atom->node_charges = node_charges = (double **) memory->srealloc(node_charges,sizeof(double *)*nmax, "atom:node_charges");
-  atom->nodal_positions = nodal_positions =
-    (double ****) memory->srealloc(nodal_positions,sizeof(double ***)*nmax, "atom:nodal_positions");
-  hold_nodal_positions =
-  (double ****) memory->srealloc(hold_nodal_positions,sizeof(double ***)*nmax, "atom:hold_nodal_positions");
-  atom->initial_nodal_positions = initial_nodal_positions =
-    (double ****) memory->srealloc(initial_nodal_positions,sizeof(double ***)*nmax, "atom:initial_nodal_positions");
-  atom->nodal_velocities = nodal_velocities =
-    (double ****) memory->srealloc(nodal_velocities,sizeof(double ***)*nmax, "atom:nodal_velocities");
-  atom->nodal_forces = nodal_forces =
-    (double ****) memory->srealloc(nodal_forces,sizeof(double ***)*nmax, "atom:nodal_forces");
-  atom->nodal_virial = nodal_virial =
-    (double ****) memory->srealloc(nodal_virial,sizeof(double ***)*nmax, "atom:nodal_virial");
-  CAC_nmax = nmax;
+  grow_nodal_storage(nmax);
+  grow_charge_storage(nmax);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -215,34 +159,16 @@ void AtomVecCAC_Charge::shrink_array(int n)
 }
 
 /* ----------------------------------------------------------------------
-   allocate finite element data for nodal arrays
+   resize the per slot node charges; stored with a stride of maxpoly
 ------------------------------------------------------------------------- */
 
-void AtomVecCAC_Charge::allocate_element(int element_index, int node_count, int poly_count)
+void AtomVecCAC_Charge::grow_charge_storage(int n)
 {
-  //destroy previous contents at that element index if present
-  if(element_index<alloc_counter){
-  memory->destroy(node_types[element_index]);
-  memory->destroy(node_charges[element_index]);
-  memory->destroy(nodal_positions[element_index]);
-  memory->destroy(hold_nodal_positions[element_index]);
-  memory->destroy(initial_nodal_positions[element_index]);
-  memory->destroy(nodal_velocities[element_index]);
-  memory->destroy(nodal_forces[element_index]);
-  memory->destroy(nodal_virial[element_index]);
-  }
-  else
-  alloc_counter++;
-  //create new allocation for this element
-  memory->create(node_types[element_index], poly_count,  "atom:node_types");
-  memory->create(node_charges[element_index], poly_count,  "atom:node_charges");
-  memory->create(nodal_positions[element_index], poly_count, node_count, 3, "atom:nodal_positions");
-  memory->create(hold_nodal_positions[element_index], poly_count, node_count, 3, "atom:hold_nodal_positions");
-  memory->create(initial_nodal_positions[element_index], poly_count, node_count, 3, "atom:initial_nodal_positions");
-  memory->create(nodal_velocities[element_index], poly_count, node_count, 3, "atom:nodal_velocities");
-  memory->create(nodal_forces[element_index], poly_count, node_count, 3, "atom:nodal_forces");
-  memory->create(nodal_virial[element_index], poly_count, node_count, 6, "atom:nodal_virial");
-
+  node_charges_store = memory->grow(node_charges_store, n*maxpoly, "atom:node_charges_store");
+  atom->node_charges = node_charges =
+    (double **) memory->srealloc(node_charges,sizeof(double *)*n, "atom:node_charges");
+  for(int islot = 0; islot < n; islot++)
+    node_charges[islot] = node_charges_store + (bigint) islot*maxpoly;
 }
 
 /* ----------------------------------------------------------------------
@@ -272,8 +198,6 @@ void AtomVecCAC_Charge::grow_reset()
 
 void AtomVecCAC_Charge::copy(int i, int j, int delflag)
 {
-  int *nodes_count_list = atom->nodes_per_element_list;
-  int node_count;
   tag[j] = tag[i];
   type[j] = type[i];
   mask[j] = mask[i];
@@ -289,52 +213,10 @@ void AtomVecCAC_Charge::copy(int i, int j, int delflag)
   element_scale[j][1] = element_scale[i][1];
   element_scale[j][2] = element_scale[i][2];
   poly_count[j] = poly_count[i];
-  node_count = nodes_count_list[element_type[j]];
-  //copy nodal information; requires resizing since copy might be for
-  //an element of a different size
-    //destroy previous contents at that element index if present
-  if(j<alloc_counter){
-  memory->destroy(node_types[j]);
-  memory->destroy(node_charges[j]);
-  memory->destroy(nodal_positions[j]);
-  memory->destroy(hold_nodal_positions[j]);
-  memory->destroy(initial_nodal_positions[j]);
-  memory->destroy(nodal_velocities[j]);
-  memory->destroy(nodal_forces[j]);
-  memory->destroy(nodal_virial[j]);
-  }
-  else
-  alloc_counter++;
-
-  //create new allocation for this element
-  memory->create(node_types[j], poly_count[j],  "atom:node_types");
-  memory->create(node_charges[j], poly_count[j],  "atom:node_charges");
-  memory->create(nodal_positions[j], poly_count[j], node_count, 3, "atom:nodal_positions");
-  memory->create(hold_nodal_positions[j], poly_count[j], node_count, 3, "atom:hold_nodal_positions");
-  memory->create(initial_nodal_positions[j], poly_count[j], node_count, 3, "atom:initial_nodal_positions");
-  memory->create(nodal_velocities[j], poly_count[j], node_count, 3, "atom:nodal_velocities");
-  memory->create(nodal_forces[j], poly_count[j], node_count, 3, "atom:nodal_forces");
-  memory->create(nodal_virial[j], poly_count[j], node_count, 6, "atom:nodal_virial");
-
-  for (int type_map = 0; type_map < poly_count[j]; type_map++) {
-    node_types[j][type_map] = node_types[i][type_map];
-    node_charges[j][type_map] = node_charges[i][type_map];
-  }
-
-   for (int poly_index = 0; poly_index < poly_count[j]; poly_index++){
-    for(int nodecount=0; nodecount< nodes_count_list[element_type[j]]; nodecount++ )
-      {
-        nodal_positions[j][poly_index][nodecount][0] = nodal_positions[i][poly_index][nodecount][0];
-        nodal_positions[j][poly_index][nodecount][1] = nodal_positions[i][poly_index][nodecount][1];
-        nodal_positions[j][poly_index][nodecount][2] = nodal_positions[i][poly_index][nodecount][2];
-        initial_nodal_positions[j][poly_index][nodecount][0] = initial_nodal_positions[i][poly_index][nodecount][0];
-        initial_nodal_positions[j][poly_index][nodecount][1] = initial_nodal_positions[i][poly_index][nodecount][1];
-        initial_nodal_positions[j][poly_index][nodecount][2] = initial_nodal_positions[i][poly_index][nodecount][2];
-        nodal_velocities[j][poly_index][nodecount][0] = nodal_velocities[i][poly_index][nodecount][0];
-        nodal_velocities[j][poly_index][nodecount][1] = nodal_velocities[i][poly_index][nodecount][1];
-        nodal_velocities[j][poly_index][nodecount][2] = nodal_velocities[i][poly_index][nodecount][2];
-      }
-    }
+  //copy nodal information; the slot views are relaid if the copy
+  //is for an element of a different size
+  copy_nodal(i,j);
+  if(i!=j) memcpy(node_charges[j], node_charges[i], sizeof(double)*poly_count[i]);
 
   if (atom->nextra_grow)
     for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
@@ -1140,7 +1022,7 @@ void AtomVecCAC_Charge::unpack_border(int n, int first, double *buf)
   element_scale[i][1] = (int)ubuf(buf[m++]).i;
   element_scale[i][2] = (int)ubuf(buf[m++]).i;
   poly_count[i] = (int)ubuf(buf[m++]).i;
-  allocate_element(i,nodes_count_list[element_type[i]],poly_count[i]);
+  allocate_element(i,nodes_count_list[element_type[i]]);
   for (int type_map = 0; type_map < poly_count[i]; type_map++) {
     node_types[i][type_map] = (int)ubuf(buf[m++]).i;
     node_charges[i][type_map] = buf[m++];
@@ -1191,7 +1073,7 @@ void AtomVecCAC_Charge::unpack_border_vel(int n, int first, double *buf)
   element_scale[i][1] = (int)ubuf(buf[m++]).i;
   element_scale[i][2] = (int)ubuf(buf[m++]).i;
   poly_count[i] = (int)ubuf(buf[m++]).i;
-  allocate_element(i,nodes_count_list[element_type[i]],poly_count[i]);
+  allocate_element(i,nodes_count_list[element_type[i]]);
   for (int type_map = 0; type_map < poly_count[i]; type_map++) {
     node_types[i][type_map] = (int)ubuf(buf[m++]).i;
     node_charges[i][type_map] = buf[m++];
@@ -1295,7 +1177,7 @@ int AtomVecCAC_Charge::unpack_exchange(double *buf)
   element_scale[nlocal][1] = (int)ubuf(buf[m++]).i;
   element_scale[nlocal][2] = (int)ubuf(buf[m++]).i;
   poly_count[nlocal] = (int)ubuf(buf[m++]).i;
-  allocate_element(nlocal,nodes_count_list[element_type[nlocal]],poly_count[nlocal]);
+  allocate_element(nlocal,nodes_count_list[element_type[nlocal]]);
   for (int type_map = 0; type_map < poly_count[nlocal]; type_map++) {
     node_types[nlocal][type_map] = (int)ubuf(buf[m++]).i;
     node_charges[nlocal][type_map] = buf[m++];
@@ -1438,7 +1320,7 @@ int AtomVecCAC_Charge::unpack_restart(double *buf)
   element_scale[nlocal][2] = (int) ubuf(buf[m++]).i;
   poly_count[nlocal] = (int) ubuf(buf[m++]).i;
   current_node_count=nodes_count_list[element_type[nlocal]];
-  allocate_element(nlocal,current_node_count,poly_count[nlocal]);
+  allocate_element(nlocal,current_node_count);
 
   for (int type_map = 0; type_map < poly_count[nlocal]; type_map++) {
     node_types[nlocal][type_map] = (int) ubuf(buf[m++]).i;
@@ -1496,7 +1378,7 @@ void AtomVecCAC_Charge::create_atom(int itype, double *coord)
   element_scale[nlocal][1] = 1;
   element_scale[nlocal][2] = 1;
   poly_count[nlocal] =1;
-  allocate_element(nlocal,1,poly_count[nlocal]);
+  allocate_element(nlocal,1);
   for (int type_map = 0; type_map < poly_count[nlocal]; type_map++) {
     node_types[nlocal][type_map] = itype;
     node_charges[nlocal][type_map] = 0;
@@ -1584,7 +1466,7 @@ void AtomVecCAC_Charge::data_atom(double *coord, imageint imagetmp, char **value
   if (nodetotal > nodes_per_element)
     error->one(FLERR, "element type requires a greater number of nodes than the specified maximum nodes per element passed to atom style cac/charge");
 
-  allocate_element(nlocal,nodetotal,poly_count[nlocal]);
+  allocate_element(nlocal,nodetotal);
   for (int polycount = 0; polycount < npoly; polycount++) {
     node_types[nlocal][polycount] = 0; //initialize
     node_charges[nlocal][polycount] = 0; //initialize
@@ -1728,7 +1610,6 @@ void AtomVecCAC_Charge::write_data(FILE *fp, int n, double **buf)
 double AtomVecCAC_Charge::memory_usage()
 {
   bigint bytes = 0;
-  int *nodes_count_list = atom->nodes_per_element_list;
   if (atom->memcheck("tag")) bytes += memory->usage(tag,nmax);
   if (atom->memcheck("type")) bytes += memory->usage(type,nmax);
   if (atom->memcheck("mask")) bytes += memory->usage(mask,nmax);
@@ -1739,18 +1620,8 @@ double AtomVecCAC_Charge::memory_usage()
   if (atom->memcheck("element_types")) bytes += memory->usage(element_type, nmax);
   if (atom->memcheck("poly_counts")) bytes += memory->usage(poly_count, nmax);
   if (atom->memcheck("element_scale")) bytes += memory->usage(element_scale, nmax, 3);
-  for(int usage_index=0; usage_index < alloc_counter; usage_index++){
-  int current_poly_count = poly_count[usage_index];
-  int node_count = nodes_count_list[element_type[usage_index]];
-  if (atom->memcheck("node_types")) bytes += memory->usage(node_types[usage_index],current_poly_count);
-  if (atom->memcheck("node_charges")) bytes += memory->usage(node_charges[usage_index], current_poly_count);
-  if (atom->memcheck("nodal_positions")) bytes += memory->usage(nodal_positions[usage_index],current_poly_count, node_count,3);
-  if (atom->memcheck("hold_nodal_positions")) bytes += memory->usage(hold_nodal_positions[usage_index],current_poly_count, node_count,3);
-  if (atom->memcheck("initial_nodal_positions")) bytes += memory->usage(initial_nodal_positions[usage_index], current_poly_count, node_count, 3);
-  if (atom->memcheck("nodal_velocities")) bytes += memory->usage(nodal_velocities[usage_index], current_poly_count, node_count,3);
-  if (atom->memcheck("nodal_forces")) bytes += memory->usage(nodal_forces[usage_index], current_poly_count, node_count,3);
-  if (atom->memcheck("nodal_virial")) bytes += memory->usage(nodal_virial[usage_index], current_poly_count, node_count,6);
-  }
+  if (atom->memcheck("node_charges")) bytes += (bigint) CAC_nmax*maxpoly*sizeof(double);
+  bytes += nodal_storage_usage();
 
   return bytes;
 }
\ No newline at end of file
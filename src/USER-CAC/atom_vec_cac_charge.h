@@ -56,8 +56,9 @@ class AtomVecCAC_Charge : public AtomVecCAC {
   
  protected:
   double  **node_charges;
-  
-  virtual void allocate_element(int,int,int);
+  double *node_charges_store;
+
+  void grow_charge_storage(int);
 };
 
 }
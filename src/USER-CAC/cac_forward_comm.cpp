@@ -0,0 +1,42 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "cac_forward_comm.h"
+#include <cstring>
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+CACForwardComm::CACForwardComm(LAMMPS *lmp) : Command(lmp) {}
+
+/* ---------------------------------------------------------------------- */
+
+void CACForwardComm::command(int narg, char **arg)
+{
+  if (narg != 1) error->all(FLERR,"Illegal cac_forward_comm command");
+  //check if simulation box has been defined
+  if (domain->box_exist == 0)
+    error->all(FLERR,"cac_forward_comm command before simulation box is defined");
+  //check if CAC atom style is defined
+  if(!atom->CAC_flag)
+  error->all(FLERR, "cac_forward_comm command requires a CAC atom style");
+
+  if (strcmp(arg[0], "full") == 0) atom->cac_forward_comm = 0;
+  else if (strcmp(arg[0], "nodal") == 0) atom->cac_forward_comm = 1;
+  else if (strcmp(arg[0], "delta") == 0) atom->cac_forward_comm = 2;
+  else error->all(FLERR, "Unexpected argument in cac_forward_comm command");
+}
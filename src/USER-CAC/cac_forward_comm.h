@@ -0,0 +1,52 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+
+CommandStyle(cac_forward_comm,CACForwardComm)
+
+#else
+
+#ifndef LMP_CAC_FORWARD_COMM_H
+#define LMP_CAC_FORWARD_COMM_H
+
+#include "command.h"
+
+namespace LAMMPS_NS {
+
+class CACForwardComm : public Command {
+ public:
+  CACForwardComm(class LAMMPS *);
+  void command(int, char **);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: cac_forward_comm command before simulation box is defined
+
+Self-explanatory.
+
+E: cac_forward_comm command requires a CAC atom style
+
+Self-explanatory.
+
+E: Unexpected argument in cac_forward_comm command
+
+The only accepted arguments are full, nodal and delta.
+
+*/
@@ -0,0 +1,49 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "cac_neigh_bin.h"
+#include <cstring>
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+#include "utils.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+CACNeighBin::CACNeighBin(LAMMPS *lmp) : Command(lmp) {}
+
+/* ---------------------------------------------------------------------- */
+
+void CACNeighBin::command(int narg, char **arg)
+{
+  if (narg < 1 || narg > 2) error->all(FLERR,"Illegal cac_neigh_bin command");
+  //check if simulation box has been defined
+  if (domain->box_exist == 0)
+    error->all(FLERR,"cac_neigh_bin command before simulation box is defined");
+  //check if CAC atom style is defined
+  if(!atom->CAC_flag)
+  error->all(FLERR, "cac_neigh_bin command requires a CAC atom style");
+
+  if (strcmp(arg[0], "standard") == 0) {
+    if (narg != 1) error->all(FLERR,"Illegal cac_neigh_bin command");
+    atom->cac_bin_hierarchical = 0;
+  } else if (strcmp(arg[0], "hierarchical") == 0) {
+    int factor = 4;
+    if (narg == 2) factor = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (factor < 2) error->all(FLERR,"Illegal cac_neigh_bin command");
+    atom->cac_bin_hierarchical = 1;
+    atom->cac_bin_coarse_factor = factor;
+  } else error->all(FLERR, "Unexpected argument in cac_neigh_bin command");
+}
@@ -0,0 +1,41 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "cac_timing.h"
+#include <cstring>
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+CACTiming::CACTiming(LAMMPS *lmp) : Command(lmp) {}
+
+/* ---------------------------------------------------------------------- */
+
+void CACTiming::command(int narg, char **arg)
+{
+  if (narg != 1) error->all(FLERR,"Illegal cac_timing command");
+  //check if simulation box has been defined
+  if (domain->box_exist == 0)
+    error->all(FLERR,"cac_timing command before simulation box is defined");
+  //check if CAC atom style is defined
+  if(!atom->CAC_flag)
+  error->all(FLERR, "cac_timing command requires a CAC atom style");
+
+  if (strcmp(arg[0], "yes") == 0) atom->cac_timing_flag = 1;
+  else if (strcmp(arg[0], "no") == 0) atom->cac_timing_flag = 0;
+  else error->all(FLERR, "Unexpected argument in cac_timing command");
+}
@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+
+CommandStyle(cac_timing,CACTiming)
+
+#else
+
+#ifndef LMP_CAC_TIMING_H
+#define LMP_CAC_TIMING_H
+
+#include "command.h"
+
+namespace LAMMPS_NS {
+
+class CACTiming : public Command {
+ public:
+  CACTiming(class LAMMPS *);
+  void command(int, char **);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal cac_timing command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: cac_timing command before simulation box is defined
+
+Self-explanatory.
+
+E: cac_timing command requires a CAC atom style
+
+Self-explanatory.
+
+E: Unexpected argument in cac_timing command
+
+The only accepted values are yes and no.
+
+*/
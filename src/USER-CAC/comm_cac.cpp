@@ -17,10 +17,12 @@
 
 #include <cstring>
 #include <cmath>
+#include <algorithm>
 #include "comm_cac.h"
 #include "comm_brick.h"
 #include "atom.h"
 #include "atom_vec.h"
+#include "atom_vec_cac.h"
 #include "domain.h"
 #include "force.h"
 #include "pair.h"
@@ -47,6 +49,8 @@ using namespace LAMMPS_NS;
 #define LAMDASCALE 1000
 #define PRDEPSILON 3.0e-2
 #define DELTA_PROCS 16
+#define BIG 1.0e20
+#define MAXINDEXBIN 64   //max number of ebox index bins per dim
 
 /* ---------------------------------------------------------------------- */
 
@@ -68,6 +72,16 @@ CommCAC::CommCAC(LAMMPS *lmp) : CommTiled(lmp)
   foreign_swaps=NULL;
   overlap_repeat=NULL;
   proc2box=NULL;
+  index_flag=0;
+  index_nitems=0;
+  index_binhead=NULL;
+  index_items=NULL;
+  index_stamp=NULL;
+  index_candidates=NULL;
+  foreign_order=NULL;
+  index_maxbin=index_maxitems=index_maxstamp=0;
+  index_query=index_ncandidates=index_maxcandidates=0;
+  maxforeign_order=0;
   init_buffers();
 }
 
@@ -95,6 +109,16 @@ CommCAC::CommCAC(LAMMPS *lmp, Comm *oldcomm) : CommTiled(lmp, oldcomm)
   foreign_swaps=NULL;
   overlap_repeat=NULL;
   proc2box=NULL;
+  index_flag=0;
+  index_nitems=0;
+  index_binhead=NULL;
+  index_items=NULL;
+  index_stamp=NULL;
+  index_candidates=NULL;
+  foreign_order=NULL;
+  index_maxbin=index_maxitems=index_maxstamp=0;
+  index_query=index_ncandidates=index_maxcandidates=0;
+  maxforeign_order=0;
   comm_style = (const char *) "cac";
   Comm::copy_arrays(oldcomm);
   init_buffers();
@@ -110,6 +134,11 @@ CommCAC::~CommCAC()
   memory->destroy(overlap);
   deallocate_swap(nswap);
   memory->sfree(rcbinfo);
+  memory->destroy(index_binhead);
+  memory->destroy(index_items);
+  memory->destroy(index_stamp);
+  memory->destroy(index_candidates);
+  memory->destroy(foreign_order);
    if (mode == Comm::MULTI) {
     memory->destroy(cutghostmulti);
   }
@@ -1080,7 +1109,6 @@ void CommCAC::setup()
 void CommCAC::forward_comm(int /*dummy*/)
 {
   int i,irecv,n,nsend,nrecv;
-  AtomVec *avec = atom->avec;
   double **x = atom->x;
 
   // exchange data with another set of procs in each swap
@@ -1103,7 +1131,7 @@ void CommCAC::forward_comm(int /*dummy*/)
       }
       if (sendother[iswap]) {
         for (i = 0; i < nsend; i++) {
-          n = avec->pack_comm_vel(sendnum[iswap][i],sendlist[iswap][i],
+          n = pack_forward(sendnum[iswap][i],sendlist[iswap][i],
           buf_send,pbc_flag[iswap][i],pbc[iswap][i]);
           MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap][i],9,world);
         }
@@ -1111,20 +1139,45 @@ void CommCAC::forward_comm(int /*dummy*/)
       if (recvother[iswap]) {
         for (i = 0; i < nrecv; i++) {
           MPI_Waitany(nrecv,requests,&irecv,MPI_STATUS_IGNORE);
-          avec->unpack_comm_vel(recvnum[iswap][irecv],firstrecv[iswap][irecv],
+          unpack_forward(recvnum[iswap][irecv],firstrecv[iswap][irecv],
           &buf_recv[recvoffset[iswap][irecv]]);
         }
       }
       if (sendself[iswap]) {
         for(int selfcount=nsendproc[iswap]-sendself[iswap]; selfcount<nsendproc[iswap]; selfcount++){
-        avec->pack_comm_vel(sendnum[iswap][selfcount],sendlist[iswap][selfcount],
+        pack_forward(sendnum[iswap][selfcount],sendlist[iswap][selfcount],
           buf_send,pbc_flag[iswap][selfcount],pbc[iswap][selfcount]);
-        avec->unpack_comm_vel(recvnum[iswap][selfcount],firstrecv[iswap][selfcount],
+        unpack_forward(recvnum[iswap][selfcount],firstrecv[iswap][selfcount],
           buf_send);
         }
       }
 }
 
+/* ----------------------------------------------------------------------
+   pack ghost data for forward comm in the format chosen by cac_forward_comm;
+   the full format resends everything borders sent, the nodal format only
+   positions and velocities, the delta format float nodal displacements
+   since the last borders call
+------------------------------------------------------------------------- */
+
+int CommCAC::pack_forward(int n, int *list, double *buf, int pbc_flag, int *pbc)
+{
+  AtomVecCAC *avec = (AtomVecCAC *) atom->avec;
+  if (atom->cac_forward_comm == 1) return avec->pack_comm_nodal(n,list,buf,pbc_flag,pbc);
+  if (atom->cac_forward_comm == 2) return avec->pack_comm_delta(n,list,buf,pbc_flag,pbc);
+  return avec->pack_comm_vel(n,list,buf,pbc_flag,pbc);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommCAC::unpack_forward(int n, int first, double *buf)
+{
+  AtomVecCAC *avec = (AtomVecCAC *) atom->avec;
+  if (atom->cac_forward_comm == 1) avec->unpack_comm_nodal(n,first,buf);
+  else if (atom->cac_forward_comm == 2) avec->unpack_comm_delta(n,first,buf);
+  else avec->unpack_comm_vel(n,first,buf);
+}
+
 /* ----------------------------------------------------------------------
    exchange: move atoms to correct processors
    atoms exchanged with procs that touch sub-box in each of 3 dims
@@ -1622,7 +1675,11 @@ void CommCAC::overlap_element_comm(int iswap){
     if(!(box_overlap_flag[0]==1&&box_overlap_flag[1]==1&&box_overlap_flag[2]==1)) continue;
 
 
-    for(int iebox=0; iebox<ebox_limit; iebox++){
+    int ncandidates = ebox_limit;
+    if(index_flag) ncandidates = overlap_candidates(oboxlo,oboxhi);
+    for(int icandidate=0; icandidate<ncandidates; icandidate++){
+    int iebox = icandidate;
+    if(index_flag) iebox = index_candidates[icandidate];
     current_ebox=eboxes[iebox];
     //test if this bounding box exceeds local sub box
     //test if element ebox overlaps the sendbox for this comm pair
@@ -1895,10 +1952,12 @@ void CommCAC::borders()
   nforeign_eboxes=0;
   //communicate all overlapping elements in all 6 swaps first to modify all sendboxes as needed
   compute_eboxes(1);
+  build_ebox_index();
 
   //communicate overlapping elements
   get_aug_oboxes(iswap);
   overlap_element_comm(iswap);
+  sort_foreign_eboxes();
   atom->nforeign_eboxes=nforeign_eboxes;
   atom->foreign_eboxes=foreign_eboxes;
   atom->bin_foreign=1;
@@ -1935,7 +1994,20 @@ void CommCAC::borders()
       if((!sendbox_flag[iswap][m]&&overlap_recvnum[iswap][m]==0)&&overlap_sendnum[iswap][m]==0) continue;
       bbox = sendbox[iswap][m];
 
-      if (!bordergroup) {
+      if (index_flag) {
+        //only elements and atoms whose boxes touch this send proc can be included
+        int ilimit = nlast;
+        if (bordergroup) ilimit = atom->nfirst;
+        int ncandidates = border_candidates(iswap, m);
+        for (int icandidate = 0; icandidate < ncandidates; icandidate++) {
+          i = index_candidates[icandidate];
+          if (i >= ilimit) break;
+          if (sendbox_include(iswap, m, i)) {
+            if (ncount == maxsendlist[iswap][m]) grow_list(iswap,m,ncount);
+            sendlist[iswap][m][ncount++] = i;
+          }
+        }
+      } else if (!bordergroup) {
         for (i = 0; i < nlast; i++) {
           if (sendbox_include(iswap, m, i)) {
             //check is recv flag array is sized properly
@@ -2163,6 +2235,9 @@ void CommCAC::borders()
   //compute eboxes for all nlocal and ghost elements at this point
   compute_eboxes(1);
 
+  //reference positions for forward comm of nodal displacements
+  if (atom->cac_forward_comm == 2) ((AtomVecCAC *) atom->avec)->store_comm_reference();
+
   // reset global->local map
 
   if (map_style) atom->map_set();
@@ -2689,6 +2764,259 @@ int CommCAC::sendbox_include(int iswap, int m, int current_element)
  return 0;
 }
 
+/* ----------------------------------------------------------------------
+   build_ebox_index: bin the padded eboxes of local elements and the
+   positions of local atoms so that border and overlap selection only
+   tests the elements and atoms near each send proc instead of all of them.
+   for triclinic boxes atoms are in lamda coords during borders while
+   eboxes are not, so the full scan is kept in that case.
+------------------------------------------------------------------------- */
+
+void CommCAC::build_ebox_index()
+{
+  int i,ibin,ix,iy,iz,nbins;
+  int blo[3],bhi[3];
+  double lo[3],hi[3],extent[3];
+
+  index_flag = 0;
+  if (triclinic) return;
+  index_nitems = elimit;
+
+  //extent of all indexed boxes
+  for (int dim = 0; dim < 3; dim++) {
+    index_lo[dim] = BIG;
+    index_hi[dim] = -BIG;
+  }
+  for (i = 0; i < index_nitems; i++) {
+    index_item_box(i,lo,hi);
+    for (int dim = 0; dim < 3; dim++) {
+      if (lo[dim] < index_lo[dim]) index_lo[dim] = lo[dim];
+      if (hi[dim] > index_hi[dim]) index_hi[dim] = hi[dim];
+    }
+  }
+  if (index_nitems == 0)
+    for (int dim = 0; dim < 3; dim++) index_lo[dim] = index_hi[dim] = 0.0;
+
+  //bin size chosen to hold about one element or atom per bin
+  double volume = 1.0;
+  for (int dim = 0; dim < 3; dim++) {
+    extent[dim] = MAX(index_hi[dim]-index_lo[dim],BOXEPSILON);
+    if (dim < dimension) volume *= extent[dim];
+  }
+  double binsize = pow(volume/MAX(index_nitems,1),1.0/dimension);
+  nbins = 1;
+  for (int dim = 0; dim < 3; dim++) {
+    index_nbin[dim] = 1;
+    index_bininv[dim] = 0.0;
+    if (dim < dimension) {
+      index_nbin[dim] = MIN(MAXINDEXBIN,MAX(1,static_cast<int>(extent[dim]/binsize)));
+      index_bininv[dim] = index_nbin[dim]/extent[dim];
+    }
+    nbins *= index_nbin[dim];
+  }
+
+  if (nbins+1 > index_maxbin) {
+    index_maxbin = nbins+1;
+    memory->destroy(index_binhead);
+    memory->create(index_binhead,index_maxbin,"commCAC:index_binhead");
+  }
+  if (index_nitems > index_maxstamp) {
+    index_maxstamp = index_maxcandidates = index_nitems;
+    memory->destroy(index_stamp);
+    memory->destroy(index_candidates);
+    memory->create(index_stamp,index_maxstamp,"commCAC:index_stamp");
+    memory->create(index_candidates,index_maxcandidates,"commCAC:index_candidates");
+  }
+
+  //count the bins overlapped by each box, then fill the bins in ascending order
+  for (ibin = 0; ibin <= nbins; ibin++) index_binhead[ibin] = 0;
+  for (i = 0; i < index_nitems; i++) {
+    index_item_box(i,lo,hi);
+    index_bin_range(lo,hi,blo,bhi);
+    for (iz = blo[2]; iz <= bhi[2]; iz++)
+      for (iy = blo[1]; iy <= bhi[1]; iy++)
+        for (ix = blo[0]; ix <= bhi[0]; ix++)
+          index_binhead[(iz*index_nbin[1]+iy)*index_nbin[0]+ix+1]++;
+  }
+  for (ibin = 0; ibin < nbins; ibin++) index_binhead[ibin+1] += index_binhead[ibin];
+  if (index_binhead[nbins] > index_maxitems) {
+    index_maxitems = index_binhead[nbins];
+    memory->destroy(index_items);
+    memory->create(index_items,index_maxitems,"commCAC:index_items");
+  }
+  for (i = 0; i < index_nitems; i++) {
+    index_item_box(i,lo,hi);
+    index_bin_range(lo,hi,blo,bhi);
+    for (iz = blo[2]; iz <= bhi[2]; iz++)
+      for (iy = blo[1]; iy <= bhi[1]; iy++)
+        for (ix = blo[0]; ix <= bhi[0]; ix++)
+          index_items[index_binhead[(iz*index_nbin[1]+iy)*index_nbin[0]+ix]++] = i;
+  }
+  for (ibin = nbins; ibin > 0; ibin--) index_binhead[ibin] = index_binhead[ibin-1];
+  index_binhead[0] = 0;
+
+  for (i = 0; i < index_nitems; i++) index_stamp[i] = 0;
+  index_query = 0;
+  index_flag = 1;
+}
+
+/* ----------------------------------------------------------------------
+   box of element or atom i in the ebox index; the padded ebox for
+   elements and the position for atoms
+------------------------------------------------------------------------- */
+
+void CommCAC::index_item_box(int i, double *lo, double *hi)
+{
+  if (atom->element_type[i]) {
+    double *current_ebox = eboxes[ebox_ref[i]];
+    lo[0] = current_ebox[0]; lo[1] = current_ebox[1]; lo[2] = current_ebox[2];
+    hi[0] = current_ebox[3]; hi[1] = current_ebox[4]; hi[2] = current_ebox[5];
+  } else {
+    double *xi = atom->x[i];
+    lo[0] = hi[0] = xi[0]; lo[1] = hi[1] = xi[1]; lo[2] = hi[2] = xi[2];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   range of ebox index bins overlapped by the lo/hi box
+   boxes extending past the index extent are clamped to the edge bins
+------------------------------------------------------------------------- */
+
+void CommCAC::index_bin_range(double *lo, double *hi, int *blo, int *bhi)
+{
+  double coord;
+  for (int dim = 0; dim < 3; dim++) {
+    coord = (lo[dim]-index_lo[dim])*index_bininv[dim];
+    blo[dim] = 0;
+    if (coord >= index_nbin[dim]) blo[dim] = index_nbin[dim]-1;
+    else if (coord > 0.0) blo[dim] = static_cast<int>(coord);
+    coord = (hi[dim]-index_lo[dim])*index_bininv[dim];
+    bhi[dim] = 0;
+    if (coord >= index_nbin[dim]) bhi[dim] = index_nbin[dim]-1;
+    else if (coord > 0.0) bhi[dim] = static_cast<int>(coord);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   append elements and atoms whose index box overlaps the closed lo/hi
+   box to the candidates, skipping those already selected by this query
+------------------------------------------------------------------------- */
+
+void CommCAC::query_ebox_index(double *qlo, double *qhi)
+{
+  int i,k,ix,iy,iz,ibin,overlap_flag;
+  int blo[3],bhi[3];
+  double lo[3],hi[3];
+
+  for (int dim = 0; dim < dimension; dim++)
+    if (qhi[dim] < index_lo[dim] || qlo[dim] > index_hi[dim]) return;
+
+  index_bin_range(qlo,qhi,blo,bhi);
+  for (iz = blo[2]; iz <= bhi[2]; iz++)
+    for (iy = blo[1]; iy <= bhi[1]; iy++)
+      for (ix = blo[0]; ix <= bhi[0]; ix++) {
+        ibin = (iz*index_nbin[1]+iy)*index_nbin[0]+ix;
+        for (k = index_binhead[ibin]; k < index_binhead[ibin+1]; k++) {
+          i = index_items[k];
+          if (index_stamp[i] == index_query) continue;
+          index_item_box(i,lo,hi);
+          overlap_flag = 1;
+          for (int dim = 0; dim < dimension; dim++)
+            if (lo[dim] > qhi[dim] || hi[dim] < qlo[dim]) overlap_flag = 0;
+          if (!overlap_flag) continue;
+          index_stamp[i] = index_query;
+          index_candidates[index_ncandidates++] = i;
+        }
+      }
+}
+
+/* ----------------------------------------------------------------------
+   order the foreign eboxes received in overlap_element_comm by the proc
+   they belong to so border_candidates can look up those of one send proc
+------------------------------------------------------------------------- */
+
+void CommCAC::sort_foreign_eboxes()
+{
+  if (!index_flag) return;
+  if (nforeign_eboxes > maxforeign_order) {
+    maxforeign_order = nforeign_eboxes;
+    memory->destroy(foreign_order);
+    memory->create(foreign_order,maxforeign_order,"commCAC:foreign_order");
+  }
+  for (int iebox = 0; iebox < nforeign_eboxes; iebox++) foreign_order[iebox] = iebox;
+  int *eprocs = foreign_eprocs;
+  std::sort(foreign_order,foreign_order+nforeign_eboxes,
+            [eprocs](int a, int b) { return eprocs[a] < eprocs[b]; });
+}
+
+/* ----------------------------------------------------------------------
+   select the elements and atoms that sendbox_include could accept for
+   proc m of swap iswap: atoms in the sendbox, elements overlapping the
+   cutoff expanded box of the other proc, and anything overlapping the
+   eboxes that proc sent in overlap_element_comm. returns the number of
+   candidates, stored in ascending order in index_candidates.
+------------------------------------------------------------------------- */
+
+int CommCAC::border_candidates(int iswap, int m)
+{
+  double qlo[3],qhi[3],oboxlo[3],oboxhi[3];
+  double cut = neighbor->cutneighmax + atom->cut_add;
+  int proc = sendproc[iswap][m];
+  double *bbox = sendbox[iswap][m];
+
+  index_query++;
+  index_ncandidates = 0;
+
+  for (int dim = 0; dim < 3; dim++) {
+    qlo[dim] = bbox[dim]-box_epsilon[dim];
+    qhi[dim] = bbox[3+dim]+box_epsilon[dim];
+  }
+  query_ebox_index(qlo,qhi);
+
+  overlap_counter = m;
+  (this->*box_other_full)(0,0,proc,oboxlo,oboxhi);
+  for (int dim = 0; dim < 3; dim++) {
+    qlo[dim] = oboxlo[dim]-pbc[iswap][m][dim]*prd[dim]-cut-BOXEPSILON;
+    qhi[dim] = oboxhi[dim]-pbc[iswap][m][dim]*prd[dim]+cut+BOXEPSILON;
+  }
+  query_ebox_index(qlo,qhi);
+
+  int *eprocs = foreign_eprocs;
+  int *jebox = std::lower_bound(foreign_order,foreign_order+nforeign_eboxes,proc,
+                                [eprocs](int iebox, int p) { return eprocs[iebox] < p; });
+  for (; jebox < foreign_order+nforeign_eboxes && foreign_eprocs[*jebox] == proc; jebox++) {
+    int *image = foreign_image[*jebox];
+    if (image[0] != -pbc[iswap][m][0] || image[1] != -pbc[iswap][m][1] ||
+        image[2] != -pbc[iswap][m][2]) continue;
+    query_ebox_index(foreign_eboxes[*jebox],&foreign_eboxes[*jebox][3]);
+  }
+
+  std::sort(index_candidates,index_candidates+index_ncandidates);
+  return index_ncandidates;
+}
+
+/* ----------------------------------------------------------------------
+   select the local eboxes overlapping the lo/hi box of another task;
+   returns the number of candidates, stored as ascending ebox indices
+------------------------------------------------------------------------- */
+
+int CommCAC::overlap_candidates(double *lo, double *hi)
+{
+  int *element_type = atom->element_type;
+  int n = 0;
+
+  index_query++;
+  index_ncandidates = 0;
+  query_ebox_index(lo,hi);
+  for (int icandidate = 0; icandidate < index_ncandidates; icandidate++) {
+    int i = index_candidates[icandidate];
+    if (element_type[i]) index_candidates[n++] = ebox_ref[i];
+  }
+  index_ncandidates = n;
+  std::sort(index_candidates,index_candidates+index_ncandidates);
+  return index_ncandidates;
+}
+
 /* ----------------------------------------------------------------------
    determine overlap list of Noverlap procs the lo/hi box overlaps
    overlap = non-zero area in common between box and proc sub-domain
@@ -3761,5 +4089,8 @@ void CommCAC::deallocate_swap(int n)
 double CommCAC::memory_usage()
 {
   bigint bytes = 0;
+  bytes += (bigint)(index_maxbin+1) * sizeof(int);
+  bytes += (bigint)(index_maxitems+index_maxstamp+index_maxcandidates) * sizeof(int);
+  bytes += (bigint)maxforeign_order * sizeof(int);
   return bytes;
 }
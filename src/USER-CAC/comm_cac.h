@@ -112,6 +112,23 @@ class CommCAC : public CommTiled {
   int *nbin_element_overlap;  //array storing the number of bins this element overlaps
   int **bin_element_overlap;  //set of bins this element overlaps
 
+  // binned index over the boxes of local elements and atoms; replaces the scan
+  // over all elements and atoms per send proc when selecting borders and overlaps
+  int index_flag;               //1 if the ebox index is current for this borders call
+  int index_nitems;             //number of elements and atoms in the index
+  int index_nbin[3];            //number of index bins in each dim
+  double index_lo[3],index_hi[3];  //extent of all indexed boxes
+  double index_bininv[3];       //inverse index bin size in each dim
+  int *index_binhead;           //offset of each bin in index_items
+  int *index_items;             //element and atom indices ordered by bin
+  int index_maxbin,index_maxitems;
+  int *index_stamp;             //last query that selected each element or atom
+  int index_maxstamp,index_query;
+  int *index_candidates;        //ascending candidates selected by the last gather
+  int index_ncandidates,index_maxcandidates;
+  int *foreign_order;           //foreign eboxes ordered by the proc that owns them
+  int maxforeign_order;
+
   double ***sendbox;            // bounding box of atoms to send per swap/proc
   double ***overlap_sendbox;            // bounding box of atoms to send per swap/proc
   double ****sendbox_multi;     // bounding box of atoms to send per swap/proc for multi comm
@@ -197,7 +214,16 @@ class CommCAC : public CommTiled {
   void get_aug_oboxes(int);       // communicate element overlaps
   void compute_eboxes(int);                //compute set of local and ghost eboxes as needed
   int  sendbox_include(int,int,int);            // decide if elements or atoms should be in the ghost sendbox
+  void build_ebox_index();              // bin local element and atom boxes
+  void index_item_box(int, double *, double *);  // box of an element or atom in the index
+  void index_bin_range(double *, double *, int *, int *);  // bins overlapped by a box
+  void query_ebox_index(double *, double *);  // add elements and atoms overlapping a box to candidates
+  void sort_foreign_eboxes();           // order foreign eboxes by owning proc
+  int  border_candidates(int, int);      // candidates for the ghost sendbox of a swap/proc
+  int  overlap_candidates(double *, double *);  // candidate eboxes overlapping another task box
   int  pack_eboxes(int, int *, double *, int, int *,int); //pack element bounding boxes to send
+  int  pack_forward(int, int *, double *, int, int *); //pack ghost data in the cac_forward_comm format
+  void unpack_forward(int, int, double *);             //unpack ghost data in the cac_forward_comm format
   void unpack_eboxes(int, int, double *); //unpack element bounding boxes on recv
   void grow_send(int, int);            // reallocate send buffer
   void grow_eboxes(int);               // storage for element bounding boxes
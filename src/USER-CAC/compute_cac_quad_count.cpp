@@ -20,6 +20,7 @@
 #include "comm.h"
 #include "force.h"
 #include "neighbor.h"
+#include "npair_cac.h"
 #include "pair.h"
 #include "memory.h"
 #include "error.h"
@@ -95,7 +96,7 @@ void ComputeCACQuadCount::compute_peratom()
   double interior_scales[3];
   int n1, n2, n3;
   //enable passing quadrature rank that is not 2
-  int quad = atom->quadrature_node_count;
+  int quad;
   /*its possible when create atoms is used, or some other mechanism has added atoms/elements,
   that the algorithm must revert back to counting quadrature points in this case*/
   for (int i = 0; i < nlocal; i++) {
@@ -110,6 +111,10 @@ void ComputeCACQuadCount::compute_peratom()
       if (current_element_type != 0) {
         compute_surface_depths(interior_scales[0], interior_scales[1], interior_scales[2],
           n1, n2, n3, 1);
+        //count with the order the neighbor build will pick for this element
+        quad = atom->quadrature_node_count;
+        if (atom->quad_adapt_flag && atom->npair_cac)
+          quad = atom->npair_cac->select_quad_order(i);
 
         quad_count[i]= quad*quad*quad + 2 * n1*quad*quad + 2 * n2*quad*quad +
           + 2 * n3*quad*quad + 4 * n1*n2*quad + 4 * n3*n2*quad + 4 * n1*n3*quad
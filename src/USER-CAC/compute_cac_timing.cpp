@@ -0,0 +1,78 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <mpi.h>
+#include "compute_cac_timing.h"
+#include "atom.h"
+#include "comm.h"
+#include "update.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ComputeCACTiming::ComputeCACTiming(LAMMPS *lmp, int narg, char **arg) :
+  Compute(lmp, narg, arg)
+{
+  if (narg != 3) error->all(FLERR,"Illegal compute cac/timing command");
+
+  vector_flag = 1;
+  size_vector = Atom::CAC_NTIME + Atom::CAC_NCOUNT;
+  extvector = 0;
+
+  vector = new double[size_vector];
+}
+
+/* ---------------------------------------------------------------------- */
+
+ComputeCACTiming::~ComputeCACTiming()
+{
+  delete [] vector;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeCACTiming::init()
+{
+  if (!atom->CAC_flag) error->all(FLERR,"Compute cac/timing requires a CAC atom style");
+  if (!atom->cac_timing_flag) error->all(FLERR,"Compute cac/timing requires cac_timing yes");
+}
+
+/* ----------------------------------------------------------------------
+   stage times averaged over procs, followed by the neighbor builds and
+   the quadrature point, neighbor and surface search counts per build
+------------------------------------------------------------------------- */
+
+void ComputeCACTiming::compute_vector()
+{
+  invoked_vector = update->ntimestep;
+
+  int nprocs = comm->nprocs;
+  double times[Atom::CAC_NTIME], counts[Atom::CAC_NCOUNT];
+  MPI_Allreduce(atom->cac_times,times,Atom::CAC_NTIME,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(atom->cac_counts,counts,Atom::CAC_NCOUNT,MPI_DOUBLE,MPI_SUM,world);
+
+  for (int i = 0; i < Atom::CAC_NTIME; i++) vector[i] = times[i]/nprocs;
+
+  double nbuild = counts[Atom::CAC_COUNT_BUILD]/nprocs;
+  double nquad = counts[Atom::CAC_COUNT_QUAD];
+  double *counters = vector + Atom::CAC_NTIME;
+  counters[0] = nbuild;
+  counters[1] = counters[2] = counters[3] = 0.0;
+  if (nbuild > 0.0) {
+    counters[1] = nquad/nbuild;
+    counters[3] = counts[Atom::CAC_COUNT_SURF]/nbuild;
+  }
+  if (nquad > 0.0) counters[2] = counts[Atom::CAC_COUNT_NEIGH]/nquad;
+}
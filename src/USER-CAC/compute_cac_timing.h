@@ -0,0 +1,56 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMPUTE_CLASS
+
+ComputeStyle(cac/timing,ComputeCACTiming)
+
+#else
+
+#ifndef LMP_COMPUTE_CAC_TIMING_H
+#define LMP_COMPUTE_CAC_TIMING_H
+
+#include "compute.h"
+
+namespace LAMMPS_NS {
+
+class ComputeCACTiming : public Compute {
+ public:
+  ComputeCACTiming(class LAMMPS *, int, char **);
+  ~ComputeCACTiming();
+  void init();
+  void compute_vector();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal compute cac/timing command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Compute cac/timing requires a CAC atom style
+
+Self-explanatory.
+
+E: Compute cac/timing requires cac_timing yes
+
+The stage timers are only accumulated after the cac_timing command
+enabled them.
+
+*/
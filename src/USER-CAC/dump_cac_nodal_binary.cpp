@@ -0,0 +1,810 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <cstring>
+#include "dump_cac_nodal_binary.h"
+#include "atom.h"
+#include "comm.h"
+#include "group.h"
+#include "error.h"
+#include "memory.h"
+#include "update.h"
+#include "domain.h"
+#include "utils.h"
+
+using namespace LAMMPS_NS;
+
+// FNV-1a hash step for the key of a connectivity record
+
+static inline unsigned int hash_int(unsigned int key, int value)
+{
+  for (int k = 0; k < 4; k++) {
+    key ^= (value >> 8*k) & 0xff;
+    key *= 16777619u;
+  }
+  return key;
+}
+
+// file layout, all values in native byte order:
+//   file header  = "CACNODAL", int version, fieldmask, nodes_per_element, maxpoly
+//   frame header = bigint timestep, int triclinic, connectivity,
+//                  double box[3][3], bigint nelements, nnodes
+//   connectivity = per element: id, element type, poly count, node count,
+//                  3 scales, maxpoly node types; only in frames that flag it
+//   nodal blocks = per field in fieldmask order: 3 doubles per node and poly,
+//                  elements in connectivity order
+// elements are stored in ascending ID order; the order and thus the place
+// of each element in the blocks only changes with the set of elements
+
+#define MAGIC "CACNODAL"
+#define VERSION 1
+#define FILEHEADER (8 + 4*sizeof(int))
+#define FRAMEHEADER (sizeof(bigint) + 2*sizeof(int) + 9*sizeof(double) + 2*sizeof(bigint))
+#define RVOUS 1   // 0 for irregular, 1 for all2all
+
+enum{POSITIONS=1,VELOCITIES=2,FORCES=4};
+
+/* ---------------------------------------------------------------------- */
+
+DumpCACNodalBinary::DumpCACNodalBinary(LAMMPS *lmp, int narg, char **arg) : Dump(lmp, narg, arg)
+{
+  if (narg < 6) error->all(FLERR,"Illegal dump cac/nodal/binary command");
+  if (multiproc) error->all(FLERR,"Invalid dump cac/nodal/binary filename");
+
+  fieldmask = nfields = 0;
+  for (int iarg = 5; iarg < narg; iarg++) {
+    int bit;
+    if (strcmp(arg[iarg],"positions") == 0) bit = POSITIONS;
+    else if (strcmp(arg[iarg],"velocities") == 0) bit = VELOCITIES;
+    else if (strcmp(arg[iarg],"forces") == 0) bit = FORCES;
+    else error->all(FLERR,"Illegal dump cac/nodal/binary command");
+    if (fieldmask & bit) error->all(FLERR,"Illegal dump cac/nodal/binary command");
+    fieldmask |= bit;
+    nfields++;
+  }
+
+  // always a binary file, gzip compression is selected by a .gz suffix
+
+  binary = 1;
+  size_one = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+  sort_flag = 0;
+  sortcol = 0;
+
+  mpiio_flag = 0;
+  header_pending = conn_pending = 1;
+  conn_nelements = conn_nvalues = 0;
+  dir_nper = 1;
+  ndir = maxdir = 0;
+  dir_tag = NULL;
+  dir_key = NULL;
+  dir_index = dir_offset = NULL;
+  elem_index = elem_offset = NULL;
+  order = NULL;
+  runs = NULL;
+  maxlocal = 0;
+  dbuf = rbuf = fbuf = NULL;
+  maxdbuf = maxrbuf = maxfbuf = 0;
+  rruns = NULL;
+  maxrruns = 0;
+#if !defined(MPI_STUBS)
+  mpifo = 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpCACNodalBinary::~DumpCACNodalBinary()
+{
+#if !defined(MPI_STUBS)
+  if (mpiio_flag && multifile == 0 && singlefile_opened) MPI_File_close(&mpifh);
+#endif
+  memory->destroy(dir_tag);
+  memory->destroy(dir_key);
+  memory->destroy(dir_index);
+  memory->destroy(dir_offset);
+  memory->destroy(elem_index);
+  memory->destroy(elem_offset);
+  memory->destroy(order);
+  memory->destroy(runs);
+  memory->destroy(dbuf);
+  memory->destroy(rbuf);
+  memory->destroy(fbuf);
+  memory->destroy(rruns);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCACNodalBinary::init_style()
+{
+  //check if CAC atom style is defined
+  if(!atom->CAC_flag)
+  error->all(FLERR, "CAC dump styles require a CAC atom style");
+
+  //check if sorting was used
+  if(sort_flag)
+  error->all(FLERR, "CAC dump styles cannot currently be sorted");
+
+  if (mpiio_flag && (compressed || append_flag))
+    error->all(FLERR,"Dump cac/nodal/binary mpiio cannot write gzipped or appended files");
+
+  nodes_per_element = atom->nodes_per_element;
+  maxpoly = atom->maxpoly;
+  conn_size = 7 + maxpoly;
+
+  // open single file, one time only
+
+  if (multifile == 0) openfile();
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"mpiio") == 0) {
+    if (narg < 2) error->all(FLERR,"Illegal dump_modify command");
+    if (strcmp(arg[1],"yes") == 0) mpiio_flag = 1;
+    else if (strcmp(arg[1],"no") == 0) mpiio_flag = 0;
+    else error->all(FLERR,"Illegal dump_modify command");
+#if defined(MPI_STUBS)
+    if (mpiio_flag)
+      error->all(FLERR,"Dump cac/nodal/binary mpiio requires an MPI library");
+#endif
+    if (singlefile_opened)
+      error->all(FLERR,"Illegal dump_modify command");
+    return 2;
+  }
+
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   open the file with stdio on proc 0 or collectively with MPI-IO;
+   every newly opened file starts with the file header and connectivity
+------------------------------------------------------------------------- */
+
+void DumpCACNodalBinary::openfile()
+{
+  if (singlefile_opened) return;
+
+  header_pending = conn_pending = 1;
+
+  if (!mpiio_flag) {
+    Dump::openfile();
+    return;
+  }
+
+#if !defined(MPI_STUBS)
+  if (multifile == 0) singlefile_opened = 1;
+
+  char *filecurrent = filename;
+  if (multifile) {
+    char *filestar = filecurrent;
+    filecurrent = new char[strlen(filestar) + 16];
+    char *ptr = strchr(filestar,'*');
+    *ptr = '\0';
+    if (padflag == 0)
+      sprintf(filecurrent,"%s" BIGINT_FORMAT "%s",
+              filestar,update->ntimestep,ptr+1);
+    else {
+      char bif[8],pad[16];
+      strcpy(bif,BIGINT_FORMAT);
+      sprintf(pad,"%%s%%0%d%s%%s",padflag,&bif[1]);
+      sprintf(filecurrent,pad,filestar,update->ntimestep,ptr+1);
+    }
+    *ptr = '*';
+  }
+
+  int err = MPI_File_open(world,filecurrent,MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                          MPI_INFO_NULL,&mpifh);
+  if (err != MPI_SUCCESS) error->one(FLERR,"Cannot open dump file");
+  MPI_File_set_size(mpifh,0);
+  mpifo = 0;
+
+  if (multifile) delete [] filecurrent;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   find the place of all my dumped elements in the element order
+   the order is kept until the set of elements or their connectivity
+     changes, it is then rebuilt in ascending ID order
+   allcount = global number of dumped elements and nodal values
+   return 1 if the connectivity must be written with this frame
+------------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::place_elements(bigint *allcount)
+{
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  if (atom->nmax > maxlocal) {
+    maxlocal = atom->nmax;
+    memory->destroy(elem_index);
+    memory->destroy(elem_offset);
+    memory->destroy(order);
+    memory->destroy(runs);
+    memory->create(elem_index,maxlocal,"dump:elem_index");
+    memory->create(elem_offset,maxlocal,"dump:elem_offset");
+    memory->create(order,maxlocal,"dump:order");
+    memory->create(runs,4*maxlocal,"dump:runs");
+  }
+
+  int ndump = 0;
+  for (int i = 0; i < nlocal; i++)
+    if (mask[i] & groupbit) order[ndump++] = i;
+
+  // look up my elements in the current order
+  // an element that is new or whose connectivity changed is not found
+
+  int connflag = conn_pending;
+  if (!connflag && allcount[0] == conn_nelements && allcount[1] == conn_nvalues) {
+    int flag = exchange_places(ndump,0);
+    MPI_Allreduce(&flag,&connflag,1,MPI_INT,MPI_MAX,world);
+  } else connflag = 1;
+
+  // rebuild the order from the IDs of all dumped elements
+
+  if (connflag) {
+    tagint maxtag = 0;
+    for (int k = 0; k < ndump; k++) maxtag = MAX(maxtag,tag[order[k]]);
+    tagint maxtag_all;
+    MPI_Allreduce(&maxtag,&maxtag_all,1,MPI_LMP_TAGINT,MPI_MAX,world);
+    dir_nper = maxtag_all/nprocs + 1;
+
+    exchange_places(ndump,1);
+    conn_nelements = allcount[0];
+    conn_nvalues = allcount[1];
+    conn_pending = 0;
+  }
+
+  // sort my elements by their place so each block is packed in file order
+
+  utils::merge_sort(order,ndump,(void *) elem_index,compare_index);
+
+  return connflag;
+}
+
+/* ----------------------------------------------------------------------
+   send the first ndump elements of order to the directory procs
+   owning their IDs and set elem_index and elem_offset from the reply
+   buildflag = 1 to replace the directory by the sent elements
+   return 1 if any of my elements was not found in the directory
+------------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::exchange_places(int ndump, int buildflag)
+{
+  tagint *tag = atom->tag;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  int *proclist;
+  memory->create(proclist,ndump,"dump:proclist");
+  ElementRvous *inbuf = (ElementRvous *)
+    memory->smalloc((bigint) ndump*sizeof(ElementRvous),"dump:inbuf");
+
+  for (int k = 0; k < ndump; k++) {
+    int i = order[k];
+    proclist[k] = MIN((tag[i]-1)/dir_nper,nprocs-1);
+    inbuf[k].tag = tag[i];
+    inbuf[k].proc = me;
+    inbuf[k].ilocal = i;
+    inbuf[k].nvalues = nodes_count_list[element_type[i]]*poly_count[i];
+    inbuf[k].key = element_key(i);
+  }
+
+  char *buf;
+  int nreturn;
+  if (buildflag)
+    nreturn = comm->rendezvous(RVOUS,ndump,(char *) inbuf,sizeof(ElementRvous),
+                               0,proclist,rendezvous_build,
+                               0,buf,sizeof(PlaceRvous),(void *) this);
+  else
+    nreturn = comm->rendezvous(RVOUS,ndump,(char *) inbuf,sizeof(ElementRvous),
+                               0,proclist,rendezvous_lookup,
+                               0,buf,sizeof(PlaceRvous),(void *) this);
+  PlaceRvous *outbuf = (PlaceRvous *) buf;
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  int flag = 0;
+  for (int m = 0; m < nreturn; m++) {
+    int i = outbuf[m].ilocal;
+    if (!outbuf[m].found) flag = 1;
+    elem_index[i] = outbuf[m].index;
+    elem_offset[i] = outbuf[m].offset;
+  }
+
+  memory->sfree(outbuf);
+  return flag;
+}
+
+/* ----------------------------------------------------------------------
+   hash of the connectivity record of element i besides its ID
+------------------------------------------------------------------------- */
+
+unsigned int DumpCACNodalBinary::element_key(int i)
+{
+  int *scale = atom->element_scale[i];
+  int poly = atom->poly_count[i];
+
+  unsigned int key = 2166136261u;
+  key = hash_int(key,atom->element_type[i]);
+  key = hash_int(key,poly);
+  key = hash_int(key,scale[0]);
+  key = hash_int(key,scale[1]);
+  key = hash_int(key,scale[2]);
+  for (int k = 0; k < poly; k++)
+    key = hash_int(key,atom->node_types[i][k]);
+  return key;
+}
+
+/* ----------------------------------------------------------------------
+   process elements assigned to me in rendezvous decomposition
+   sort them by ID, store them as my part of the directory and
+     return their place in the new element order
+------------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::rendezvous_build(int n, char *inbuf,
+                                         int &flag, int *&proclist, char *&outbuf,
+                                         void *ptr)
+{
+  DumpCACNodalBinary *dptr = (DumpCACNodalBinary *) ptr;
+  Memory *memory = dptr->memory;
+  ElementRvous *in = (ElementRvous *) inbuf;
+
+  int *sorted;
+  memory->create(sorted,n,"dump:sorted");
+  for (int i = 0; i < n; i++) sorted[i] = i;
+  utils::merge_sort(sorted,n,(void *) in,compare_tag);
+
+  if (n > dptr->maxdir) {
+    dptr->maxdir = n;
+    memory->destroy(dptr->dir_tag);
+    memory->destroy(dptr->dir_key);
+    memory->destroy(dptr->dir_index);
+    memory->destroy(dptr->dir_offset);
+    memory->create(dptr->dir_tag,n,"dump:dir_tag");
+    memory->create(dptr->dir_key,n,"dump:dir_key");
+    memory->create(dptr->dir_index,n,"dump:dir_index");
+    memory->create(dptr->dir_offset,n,"dump:dir_offset");
+  }
+
+  // MPI_Scan() to find where my ID range begins in the element order
+
+  bigint mycount[2],before[2];
+  mycount[0] = n;
+  mycount[1] = 0;
+  for (int i = 0; i < n; i++) mycount[1] += in[i].nvalues;
+  MPI_Scan(mycount,before,2,MPI_LMP_BIGINT,MPI_SUM,dptr->world);
+  bigint index = before[0] - mycount[0];
+  bigint offset = before[1] - mycount[1];
+
+  memory->create(proclist,n,"dump:proclist");
+  PlaceRvous *out = (PlaceRvous *)
+    memory->smalloc((bigint) n*sizeof(PlaceRvous),"dump:out");
+
+  for (int m = 0; m < n; m++) {
+    int i = sorted[m];
+    dptr->dir_tag[m] = in[i].tag;
+    dptr->dir_key[m] = in[i].key;
+    dptr->dir_index[m] = index;
+    dptr->dir_offset[m] = offset;
+    proclist[m] = in[i].proc;
+    out[m].ilocal = in[i].ilocal;
+    out[m].found = 1;
+    out[m].index = index++;
+    out[m].offset = offset;
+    offset += in[i].nvalues;
+  }
+  dptr->ndir = n;
+
+  memory->destroy(sorted);
+
+  flag = 2;
+  outbuf = (char *) out;
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   process elements assigned to me in rendezvous decomposition
+   return their place from my part of the directory
+------------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::rendezvous_lookup(int n, char *inbuf,
+                                          int &flag, int *&proclist, char *&outbuf,
+                                          void *ptr)
+{
+  DumpCACNodalBinary *dptr = (DumpCACNodalBinary *) ptr;
+  Memory *memory = dptr->memory;
+  ElementRvous *in = (ElementRvous *) inbuf;
+  tagint *dir_tag = dptr->dir_tag;
+
+  memory->create(proclist,n,"dump:proclist");
+  PlaceRvous *out = (PlaceRvous *)
+    memory->smalloc((bigint) n*sizeof(PlaceRvous),"dump:out");
+
+  for (int i = 0; i < n; i++) {
+    int lo = 0;
+    int hi = dptr->ndir;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (dir_tag[mid] < in[i].tag) lo = mid + 1;
+      else hi = mid;
+    }
+
+    proclist[i] = in[i].proc;
+    out[i].ilocal = in[i].ilocal;
+    out[i].found = (lo < dptr->ndir && dir_tag[lo] == in[i].tag &&
+                    dptr->dir_key[lo] == in[i].key);
+    out[i].index = out[i].found ? dptr->dir_index[lo] : 0;
+    out[i].offset = out[i].found ? dptr->dir_offset[lo] : 0;
+  }
+
+  flag = 2;
+  outbuf = (char *) out;
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   comparison functions for utils::merge_sort()
+------------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::compare_index(int i, int j, void *ptr)
+{
+  bigint *index = (bigint *) ptr;
+  if (index[i] < index[j]) return -1;
+  if (index[i] > index[j]) return 1;
+  return 0;
+}
+
+int DumpCACNodalBinary::compare_tag(int i, int j, void *ptr)
+{
+  ElementRvous *in = (ElementRvous *) ptr;
+  if (in[i].tag < in[j].tag) return -1;
+  if (in[i].tag > in[j].tag) return 1;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   ranges of a block covered by the first ndump elements of order
+   as pairs of start and length in doubles, adjacent elements are merged
+   connflag = 1 for the connectivity block, 0 for a nodal block
+   return the number of ranges
+------------------------------------------------------------------------- */
+
+int DumpCACNodalBinary::element_runs(int ndump, int connflag, bigint *r)
+{
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  int nruns = 0;
+  for (int k = 0; k < ndump; k++) {
+    int i = order[k];
+    bigint start,length;
+    if (connflag) {
+      start = elem_index[i]*conn_size;
+      length = conn_size;
+    } else {
+      start = 3*elem_offset[i];
+      length = 3*nodes_count_list[element_type[i]]*poly_count[i];
+    }
+    if (nruns && r[2*nruns-2] + r[2*nruns-1] == start) r[2*nruns-1] += length;
+    else {
+      r[2*nruns] = start;
+      r[2*nruns+1] = length;
+      nruns++;
+    }
+  }
+  return nruns;
+}
+
+/* ----------------------------------------------------------------------
+   pack the connectivity (if needed) and the nodal blocks of my elements
+   and write them at their place in the element order
+------------------------------------------------------------------------- */
+
+void DumpCACNodalBinary::write()
+{
+  // if timestep < delaystep, just return
+
+  if (delay_flag && update->ntimestep < delaystep) return;
+
+  // if file per timestep, open new file
+
+  if (multifile) openfile();
+
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int **node_types = atom->node_types;
+  int **element_scale = atom->element_scale;
+  int *nodes_count_list = atom->nodes_per_element_list;
+
+  // local and global element and node counts
+
+  bigint mycount[2],allcount[2],maxcount[2];
+  mycount[0] = mycount[1] = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    mycount[0]++;
+    mycount[1] += nodes_count_list[element_type[i]]*poly_count[i];
+  }
+  MPI_Allreduce(mycount,allcount,2,MPI_LMP_BIGINT,MPI_SUM,world);
+  MPI_Allreduce(mycount,maxcount,2,MPI_LMP_BIGINT,MPI_MAX,world);
+
+  int connflag = place_elements(allcount);
+  int ndump = mycount[0];
+
+  // my part of each block: connectivity, then one block per nodal field
+  // all nodal blocks cover the same ranges
+
+  int nblock = 0;
+  int nruns[4];
+  bigint *blockruns[4];
+  bigint blocksize[4],blockmax[4],blocktotal[4];
+  if (connflag) {
+    nruns[nblock] = element_runs(ndump,1,runs);
+    blockruns[nblock] = runs;
+    blocksize[nblock] = mycount[0]*conn_size;
+    blockmax[nblock] = maxcount[0]*conn_size;
+    blocktotal[nblock++] = allcount[0]*conn_size;
+  }
+  int nnodalruns = element_runs(ndump,0,&runs[2*maxlocal]);
+  for (int ifield = 0; ifield < nfields; ifield++) {
+    nruns[nblock] = nnodalruns;
+    blockruns[nblock] = &runs[2*maxlocal];
+    blocksize[nblock] = 3*mycount[1];
+    blockmax[nblock] = 3*maxcount[1];
+    blocktotal[nblock++] = 3*allcount[1];
+  }
+
+  bigint ntotal = 0;
+  for (int iblock = 0; iblock < nblock; iblock++) {
+    if (blockmax[iblock] > MAXSMALLINT || 2*maxcount[0] > MAXSMALLINT)
+      error->all(FLERR,"Too much per-proc info for dump");
+    ntotal += blocksize[iblock];
+  }
+  if (ntotal > maxdbuf) {
+    maxdbuf = ntotal;
+    memory->destroy(dbuf);
+    memory->create(dbuf,maxdbuf,"dump:dbuf");
+  }
+
+  bigint m = 0;
+  if (connflag) {
+    for (int k = 0; k < ndump; k++) {
+      int i = order[k];
+      dbuf[m++] = tag[i];
+      dbuf[m++] = element_type[i];
+      dbuf[m++] = poly_count[i];
+      dbuf[m++] = nodes_count_list[element_type[i]];
+      dbuf[m++] = element_scale[i][0];
+      dbuf[m++] = element_scale[i][1];
+      dbuf[m++] = element_scale[i][2];
+      for (int ipoly = 0; ipoly < maxpoly; ipoly++)
+        dbuf[m++] = (ipoly < poly_count[i]) ? node_types[i][ipoly] : 0;
+    }
+  }
+
+  double ****fieldarrays[3] = {atom->nodal_positions,atom->nodal_velocities,atom->nodal_forces};
+  for (int ifield = 0; ifield < 3; ifield++) {
+    if (!(fieldmask & (1 << ifield))) continue;
+    double ****nodal = fieldarrays[ifield];
+    for (int k = 0; k < ndump; k++) {
+      int i = order[k];
+      int nodes = nodes_count_list[element_type[i]];
+      for (int ipoly = 0; ipoly < poly_count[i]; ipoly++)
+        for (int j = 0; j < nodes; j++) {
+          dbuf[m++] = nodal[i][ipoly][j][0];
+          dbuf[m++] = nodal[i][ipoly][j][1];
+          dbuf[m++] = nodal[i][ipoly][j][2];
+        }
+    }
+  }
+
+  // file header (if needed) and frame header
+
+  char header[FILEHEADER + FRAMEHEADER];
+  int nheader = 0;
+  if (header_pending) {
+    int values[4] = {VERSION,fieldmask,nodes_per_element,maxpoly};
+    memcpy(&header[nheader],MAGIC,8);
+    nheader += 8;
+    memcpy(&header[nheader],values,4*sizeof(int));
+    nheader += 4*sizeof(int);
+    header_pending = 0;
+  }
+
+  double box[3][3];
+  int triclinic = domain->triclinic;
+  if (triclinic == 0) {
+    box[0][0] = domain->boxlo[0];
+    box[0][1] = domain->boxhi[0];
+    box[1][0] = domain->boxlo[1];
+    box[1][1] = domain->boxhi[1];
+    box[2][0] = domain->boxlo[2];
+    box[2][1] = domain->boxhi[2];
+    box[0][2] = box[1][2] = box[2][2] = 0.0;
+  } else {
+    box[0][0] = domain->boxlo_bound[0];
+    box[0][1] = domain->boxhi_bound[0];
+    box[1][0] = domain->boxlo_bound[1];
+    box[1][1] = domain->boxhi_bound[1];
+    box[2][0] = domain->boxlo_bound[2];
+    box[2][1] = domain->boxhi_bound[2];
+    box[0][2] = domain->xy;
+    box[1][2] = domain->xz;
+    box[2][2] = domain->yz;
+  }
+
+  bigint ntimestep = update->ntimestep;
+  memcpy(&header[nheader],&ntimestep,sizeof(bigint));
+  nheader += sizeof(bigint);
+  memcpy(&header[nheader],&triclinic,sizeof(int));
+  nheader += sizeof(int);
+  memcpy(&header[nheader],&connflag,sizeof(int));
+  nheader += sizeof(int);
+  memcpy(&header[nheader],&box[0][0],9*sizeof(double));
+  nheader += 9*sizeof(double);
+  memcpy(&header[nheader],allcount,2*sizeof(bigint));
+  nheader += 2*sizeof(bigint);
+
+  if (mpiio_flag) write_mpiio(header,nheader,nblock,blocksize,blocktotal,nruns,blockruns);
+  else write_serial(header,nheader,nblock,blocksize,blockmax,blocktotal,
+                    2*maxcount[0],nruns,blockruns);
+
+  // if file per timestep, close file
+
+  if (multifile) {
+    if (mpiio_flag) {
+#if !defined(MPI_STUBS)
+      MPI_File_close(&mpifh);
+#endif
+    } else if (filewriter && fp != NULL) {
+      if (compressed) pclose(fp);
+      else fclose(fp);
+    }
+    fp = NULL;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes the headers, then assembles each block from the ranges
+   of all procs and writes it
+   maxruns = max length of the range list of any proc
+------------------------------------------------------------------------- */
+
+void DumpCACNodalBinary::write_serial(char *header, int nheader, int nblock,
+                                      bigint *blocksize, bigint *blockmax, bigint *blocktotal,
+                                      bigint maxruns, int *nruns, bigint **blockruns)
+{
+  int tmp,count;
+  MPI_Status status;
+  MPI_Request requests[2];
+
+  if (me == 0) {
+    bigint maxrecv = 0, maxblock = 0;
+    for (int iblock = 0; iblock < nblock; iblock++) {
+      maxrecv = MAX(maxrecv,blockmax[iblock]);
+      maxblock = MAX(maxblock,blocktotal[iblock]);
+    }
+    if (maxrecv > maxrbuf) {
+      maxrbuf = maxrecv;
+      memory->destroy(rbuf);
+      memory->create(rbuf,maxrbuf,"dump:rbuf");
+    }
+    if (maxblock > maxfbuf) {
+      maxfbuf = maxblock;
+      memory->destroy(fbuf);
+      memory->create(fbuf,maxfbuf,"dump:fbuf");
+    }
+    if (maxruns > maxrruns) {
+      maxrruns = maxruns;
+      memory->destroy(rruns);
+      memory->create(rruns,maxrruns,"dump:rruns");
+    }
+    fwrite(header,sizeof(char),nheader,fp);
+  }
+
+  double *mybuf = dbuf;
+  for (int iblock = 0; iblock < nblock; iblock++) {
+    if (me == 0) {
+      place_runs(mybuf,nruns[iblock],blockruns[iblock]);
+      for (int iproc = 1; iproc < nprocs; iproc++) {
+        MPI_Irecv(rruns,maxrruns,MPI_LMP_BIGINT,iproc,0,world,&requests[0]);
+        MPI_Irecv(rbuf,maxrbuf,MPI_DOUBLE,iproc,0,world,&requests[1]);
+        MPI_Send(&tmp,0,MPI_INT,iproc,0,world);
+        MPI_Wait(&requests[0],&status);
+        MPI_Get_count(&status,MPI_LMP_BIGINT,&count);
+        MPI_Wait(&requests[1],MPI_STATUS_IGNORE);
+        place_runs(rbuf,count/2,rruns);
+      }
+      fwrite(fbuf,sizeof(double),blocktotal[iblock],fp);
+    } else {
+      MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
+      MPI_Rsend(blockruns[iblock],2*nruns[iblock],MPI_LMP_BIGINT,0,0,world);
+      MPI_Rsend(mybuf,blocksize[iblock],MPI_DOUBLE,0,0,world);
+    }
+    mybuf += blocksize[iblock];
+  }
+
+  if (me == 0 && flush_flag) fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   copy packed values to their ranges of the assembled block
+------------------------------------------------------------------------- */
+
+void DumpCACNodalBinary::place_runs(double *buf, int n, bigint *r)
+{
+  for (int irun = 0; irun < n; irun++) {
+    memcpy(&fbuf[r[2*irun]],buf,r[2*irun+1]*sizeof(double));
+    buf += r[2*irun+1];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes the headers, then all procs write their ranges of each
+   block through a file view with collective MPI-IO
+------------------------------------------------------------------------- */
+
+void DumpCACNodalBinary::write_mpiio(char *header, int nheader, int nblock, bigint *blocksize,
+                                     bigint *blocktotal, int *nruns, bigint **blockruns)
+{
+#if !defined(MPI_STUBS)
+  if (me == 0)
+    MPI_File_write_at(mpifh,mpifo,header,nheader,MPI_BYTE,MPI_STATUS_IGNORE);
+  mpifo += nheader;
+
+  double *mybuf = dbuf;
+  for (int iblock = 0; iblock < nblock; iblock++) {
+    int n = nruns[iblock];
+    bigint *r = blockruns[iblock];
+
+    MPI_Datatype filetype = MPI_DOUBLE;
+    if (n) {
+      int *lengths = new int[n];
+      MPI_Aint *displs = new MPI_Aint[n];
+      for (int irun = 0; irun < n; irun++) {
+        displs[irun] = (MPI_Aint) r[2*irun]*sizeof(double);
+        lengths[irun] = r[2*irun+1];
+      }
+      MPI_Type_create_hindexed(n,lengths,displs,MPI_DOUBLE,&filetype);
+      MPI_Type_commit(&filetype);
+      delete [] lengths;
+      delete [] displs;
+    }
+
+    MPI_File_set_view(mpifh,mpifo,MPI_DOUBLE,filetype,(char *) "native",MPI_INFO_NULL);
+    MPI_File_write_all(mpifh,mybuf,blocksize[iblock],MPI_DOUBLE,MPI_STATUS_IGNORE);
+    if (n) MPI_Type_free(&filetype);
+
+    mybuf += blocksize[iblock];
+    mpifo += (MPI_Offset) blocktotal[iblock]*sizeof(double);
+  }
+
+  // restore the byte view for the next frame header
+
+  MPI_File_set_view(mpifh,0,MPI_BYTE,MPI_BYTE,(char *) "native",MPI_INFO_NULL);
+
+  if (flush_flag) MPI_File_sync(mpifh);
+#endif
+}
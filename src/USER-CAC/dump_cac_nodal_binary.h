@@ -0,0 +1,149 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+
+DumpStyle(cac/nodal/binary,DumpCACNodalBinary)
+
+#else
+
+#ifndef LMP_DUMP_CACNODALBINARY_H
+#define LMP_DUMP_CACNODALBINARY_H
+
+#include "dump.h"
+
+namespace LAMMPS_NS {
+
+class DumpCACNodalBinary : public Dump {
+ public:
+  struct ElementRvous {
+    tagint tag;
+    int proc, ilocal;
+    int nvalues;                 // nodes times poly count
+    unsigned int key;            // hash of the connectivity record
+  };
+
+  struct PlaceRvous {
+    int ilocal, found;
+    bigint index, offset;        // position in element order and nodal values
+  };
+
+  DumpCACNodalBinary(class LAMMPS *, int, char**);
+  virtual ~DumpCACNodalBinary();
+  void write();
+
+ protected:
+  int fieldmask;                 // nodal arrays written each frame
+  int nfields;
+  int nodes_per_element,maxpoly;
+  int conn_size;                 // doubles per element in the connectivity block
+  int mpiio_flag;                // 1 = collective MPI-IO writes
+  int header_pending;            // 1 if the file header must still be written
+  int conn_pending;              // 1 if the next frame must contain the connectivity
+
+  // directory of the element order set by the last connectivity,
+  // each proc holds the elements of one range of IDs sorted by ID
+
+  bigint conn_nelements;         // elements and nodal values in that order
+  bigint conn_nvalues;
+  tagint dir_nper;               // element IDs per directory proc
+  int ndir,maxdir;
+  tagint *dir_tag;
+  unsigned int *dir_key;
+  bigint *dir_index,*dir_offset;
+
+  bigint *elem_index,*elem_offset;   // place of my elements in the element order
+  int *order;                    // my dumped elements sorted by place
+  bigint *runs;                  // contiguous file ranges of my elements
+  int maxlocal;
+
+  double *dbuf;                  // packed connectivity and nodal blocks
+  bigint maxdbuf;
+  double *rbuf;                  // receive buffer of the writing proc
+  bigint maxrbuf;
+  double *fbuf;                  // one complete block on the writing proc
+  bigint maxfbuf;
+  bigint *rruns;                 // received file ranges
+  bigint maxrruns;
+
+#if !defined(MPI_STUBS)
+  MPI_File mpifh;
+  MPI_Offset mpifo;              // end of the data written so far
+#endif
+
+  void init_style();
+  void openfile();
+  void write_header(bigint) {}
+  void pack(tagint *) {}
+  void write_data(int, double *) {}
+  int modify_param(int, char **);
+
+  int place_elements(bigint *);
+  int exchange_places(int, int);
+  unsigned int element_key(int);
+  int element_runs(int, int, bigint *);
+  void write_serial(char *, int, int, bigint *, bigint *, bigint *, bigint, int *, bigint **);
+  void place_runs(double *, int, bigint *);
+  void write_mpiio(char *, int, int, bigint *, bigint *, int *, bigint **);
+
+  // callback functions for rendezvous communication
+
+  static int rendezvous_build(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_lookup(int, char *, int &, int *&, char *&, void *);
+  static int compare_index(int, int, void *);
+  static int compare_tag(int, int, void *);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Invalid dump cac/nodal/binary filename
+
+Files cannot be written by each processor with this dump style.
+
+E: CAC dump styles require a CAC atom style
+
+Self-explanatory
+
+E: CAC dump styles cannot currently be sorted
+
+Self-explanatory.
+
+E: Dump cac/nodal/binary mpiio requires an MPI library
+
+MPI-IO is not available when LAMMPS is built with the MPI STUBS library.
+
+E: Dump cac/nodal/binary mpiio cannot write gzipped or appended files
+
+Collective writes need a regular file that is written from the start.
+
+E: Cannot open dump file
+
+The output file for the dump command cannot be opened.  Check that the
+path and name are correct.
+
+E: Too much per-proc info for dump
+
+Number of local elements times the nodal data per element is too large.
+
+*/
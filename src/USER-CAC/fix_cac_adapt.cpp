@@ -0,0 +1,945 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_cac_adapt.h"
+#include <mpi.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "atom.h"
+#include "atom_vec_cac.h"
+#include "update.h"
+#include "modify.h"
+#include "compute.h"
+#include "comm.h"
+#include "domain.h"
+#include "lattice.h"
+#include "force.h"
+#include "pair.h"
+#include "kspace.h"
+#include "neighbor.h"
+#include "math_extra.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define Q8 1                // element type index of Eight_Node elements
+#define LATTICE_TOL 0.25    // largest distance of a mergeable atom from its lattice site in unit cells
+
+// natural coordinates of the Q8 nodes in the node order of the data file
+
+static const double node_signs[8][3] = {{-1,-1,-1},{1,-1,-1},{1,1,-1},{-1,1,-1},
+                                        {-1,-1,1},{1,-1,1},{1,1,1},{-1,1,1}};
+
+/* ---------------------------------------------------------------------- */
+
+FixCACAdapt::FixCACAdapt(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg), converted(NULL), split_list(NULL), merge_list(NULL),
+  dlist(NULL), site_shape(NULL), sites(NULL), block_atoms(NULL), basis_types(NULL), block_data(NULL),
+  site_v(NULL), c_pe(NULL), avec(NULL)
+{
+  if (narg < 5) error->all(FLERR,"Illegal fix cac/adapt command");
+  if (!atom->CAC_flag) error->all(FLERR,"Fix cac/adapt requires a CAC atom style");
+  if (atom->q_flag)
+    error->all(FLERR,"Fix cac/adapt does not support charged CAC atom styles");
+  if (!atom->tag_enable) error->all(FLERR,"Fix cac/adapt requires atom IDs");
+
+  vector_flag = 1;
+  size_vector = 3;
+  global_freq = 1;
+  extvector = 0;
+
+  nevery = utils::inumeric(FLERR,arg[3],false,lmp);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix cac/adapt command");
+
+  split_flag = merge_flag = 0;
+  energy_flag = 1;
+  merge_cells = 0;
+  split_strain = merge_tol = 0.0;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"split") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix cac/adapt command");
+      if (strcmp(arg[iarg+1],"strain") != 0)
+        error->all(FLERR,"Illegal fix cac/adapt command");
+      split_strain = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (split_strain <= 0.0) error->all(FLERR,"Illegal fix cac/adapt command");
+      split_flag = 1;
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"merge") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix cac/adapt command");
+      merge_cells = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      merge_tol = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (merge_tol <= 0.0) error->all(FLERR,"Illegal fix cac/adapt command");
+      merge_flag = 1;
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"energy") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix cac/adapt command");
+      if (strcmp(arg[iarg+1],"no") == 0) energy_flag = 0;
+      else if (strcmp(arg[iarg+1],"yes") == 0) energy_flag = 1;
+      else error->all(FLERR,"Illegal fix cac/adapt command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix cac/adapt command");
+  }
+
+  if (!split_flag && !merge_flag)
+    error->all(FLERR,"Fix cac/adapt requires the split or merge keyword");
+
+  // shape functions at the lattice sites of a merged element and the
+  // inverse of the normal matrix fitting its 8 nodes to the site values
+
+  nblock_sites = 0;
+  if (merge_flag) {
+    Lattice *lattice = domain->lattice;
+    if (lattice == NULL || lattice->style == Lattice::NONE)
+      error->all(FLERR,"Fix cac/adapt merge requires a lattice");
+    if (domain->dimension != 3 || merge_cells < 2)
+      error->all(FLERR,"Fix cac/adapt merge requires a 3d lattice with 2 or more unit cells per element edge");
+    if (lattice->nbasis > atom->maxpoly || atom->nodes_per_element < 8)
+      error->all(FLERR,"Fix cac/adapt merge exceeds the maximum nodes or internal degrees of freedom");
+
+    int n = merge_cells;
+    int ncell = n*n*n;
+    nblock_sites = lattice->nbasis*ncell;
+    memory->create(site_shape,ncell,8,"cac/adapt:site_shape");
+    memory->create(block_atoms,nblock_sites,"cac/adapt:block_atoms");
+    memory->create(basis_types,lattice->nbasis,"cac/adapt:basis_types");
+    memory->create(block_data,lattice->nbasis*8*9,"cac/adapt:block_data");
+
+    double normal[8][8],inverse[8][16];
+    for (int k = 0; k < 8; k++)
+      for (int l = 0; l < 8; l++) normal[k][l] = 0.0;
+    for (int a = 0; a < n; a++)
+      for (int b = 0; b < n; b++)
+        for (int c = 0; c < n; c++) {
+          int j = (a*n + b)*n + c;
+          double s = -1.0 + (2*a + 1.0)/n;
+          double t = -1.0 + (2*b + 1.0)/n;
+          double w = -1.0 + (2*c + 1.0)/n;
+          for (int k = 0; k < 8; k++)
+            site_shape[j][k] = 0.125*(1 + s*node_signs[k][0])*
+              (1 + t*node_signs[k][1])*(1 + w*node_signs[k][2]);
+          for (int k = 0; k < 8; k++)
+            for (int l = 0; l < 8; l++) normal[k][l] += site_shape[j][k]*site_shape[j][l];
+        }
+
+    // Gauss-Jordan elimination; the normal matrix is symmetric positive definite
+
+    for (int k = 0; k < 8; k++)
+      for (int l = 0; l < 16; l++)
+        inverse[k][l] = (l < 8) ? normal[k][l] : (l-8 == k ? 1.0 : 0.0);
+    for (int k = 0; k < 8; k++) {
+      double pivot = inverse[k][k];
+      for (int l = 0; l < 16; l++) inverse[k][l] /= pivot;
+      for (int m = 0; m < 8; m++) {
+        if (m == k) continue;
+        double factor = inverse[m][k];
+        for (int l = 0; l < 16; l++) inverse[m][l] -= factor*inverse[k][l];
+      }
+    }
+    for (int k = 0; k < 8; k++)
+      for (int l = 0; l < 8; l++) fit_matrix[k][l] = inverse[k][l+8];
+  }
+
+  // converted flags are per-atom so they follow atoms that migrate
+
+  grow_arrays(atom->nmax);
+  atom->add_callback(0);
+  for (int i = 0; i < atom->nlocal; i++) converted[i] = 0;
+
+  maxlist = maxdlist = maxsites = maxsite_v = 0;
+  nsplit_local = nmerge_local = 0;
+  nsplit = nmerge = energy_unrestored = 0.0;
+
+  force_reneighbor = 1;
+  next_reneighbor = (update->ntimestep/nevery)*nevery + nevery;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixCACAdapt::~FixCACAdapt()
+{
+  atom->delete_callback(id,0);
+  memory->destroy(converted);
+  memory->destroy(split_list);
+  memory->destroy(merge_list);
+  memory->destroy(dlist);
+  memory->destroy(site_shape);
+  memory->sfree(sites);
+  memory->destroy(block_atoms);
+  memory->destroy(basis_types);
+  memory->destroy(block_data);
+  memory->destroy(site_v);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixCACAdapt::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixCACAdapt::init()
+{
+  int ipe = modify->find_compute("thermo_pe");
+  if (ipe < 0) error->all(FLERR,"Fix cac/adapt requires the thermo_pe compute");
+  c_pe = modify->compute[ipe];
+  avec = (AtomVecCAC *) atom->avec;
+
+  // the number of atoms and elements changes; the thermo_temp compute,
+  // recreated by the atom style, must recount its degrees of freedom,
+  // other temperature computes are left to compute_modify dynamic/dof
+
+  int itemp = modify->find_compute("thermo_temp");
+  if (itemp >= 0) {
+    char *dynamic_args[2];
+    dynamic_args[0] = (char *) "dynamic/dof";
+    dynamic_args[1] = (char *) "yes";
+    modify->compute[itemp]->modify_params(2,dynamic_args);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   split strained elements and merge quiescent atom blocks;
+   the total energy before and after the conversions is evaluated with
+   full force computations like fix cac/swap does
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::pre_exchange()
+{
+  if (next_reneighbor != update->ntimestep) return;
+  next_reneighbor = update->ntimestep + nevery;
+
+  reneighbor();
+
+  select_splits();
+  select_merges();
+  int counts[2] = {nsplit_local, nmerge_local};
+  int counts_all[2];
+  MPI_Allreduce(counts,counts_all,2,MPI_INT,MPI_SUM,world);
+  if (counts_all[0] == 0 && counts_all[1] == 0) return;
+
+  double energy_before = 0.0;
+  if (energy_flag) energy_before = energy_full() + kinetic_energy();
+
+  // pre-grow the atom arrays for the atoms of all split elements so the
+  // nodal views of the elements being split do not move while they are read
+
+  int nlocal = atom->nlocal;
+  int nnew = 0;
+  for (int m = 0; m < nsplit_local; m++) {
+    int i = split_list[m];
+    int *scale = atom->element_scale[i];
+    nnew += atom->poly_count[i]*scale[0]*scale[1]*scale[2];
+  }
+  if (nlocal + nnew > atom->nmax) avec->grow(nlocal + nnew);
+  if (atom->nmax > maxdlist) {
+    maxdlist = atom->nmax;
+    memory->destroy(dlist);
+    memory->create(dlist,maxdlist,"cac/adapt:dlist");
+  }
+  for (int i = 0; i < nlocal + nnew; i++) dlist[i] = 0;
+  for (int i = 0; i < nlocal; i++) converted[i] = 0;
+
+  for (int m = 0; m < nmerge_local; m++) merge_block(merge_list[m]);
+  for (int m = 0; m < nsplit_local; m++) split_element(split_list[m]);
+
+  // delete split elements and the atoms absorbed by new elements
+
+  AtomVec *atomvec = atom->avec;
+  nlocal = atom->nlocal;
+  int i = 0;
+  while (i < nlocal) {
+    if (dlist[i]) {
+      atomvec->copy(nlocal-1,i,1);
+      dlist[i] = dlist[nlocal-1];
+      nlocal--;
+    } else i++;
+  }
+  atom->nlocal = nlocal;
+
+  bigint nblocal = atom->nlocal;
+  MPI_Allreduce(&nblocal,&atom->natoms,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  atom->tag_extend();
+  if (atom->map_style) {
+    atom->nghost = 0;
+    atom->map_init();
+    atom->map_set();
+  }
+
+  nsplit += counts_all[0];
+  nmerge += counts_all[1];
+
+  if (energy_flag) {
+    reneighbor();
+    double energy_after = energy_full() + kinetic_energy();
+    restore_energy(energy_after - energy_before);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   migrate atoms and rebuild ghosts and neighbor lists for the current state
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::reneighbor()
+{
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  domain->pbc();
+  if (domain->box_change) {
+    domain->reset_box();
+    comm->setup();
+    if (neighbor->style) neighbor->setup_bins();
+  }
+  comm->exchange();
+  comm->borders();
+  if (domain->triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
+  if (modify->n_pre_neighbor) modify->pre_neighbor();
+  neighbor->build(1);
+}
+
+/* ----------------------------------------------------------------------
+   select local Q8 elements whose strain exceeds the split threshold
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::select_splits()
+{
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  double ****nodal_positions = atom->nodal_positions;
+  double ****initial_nodal_positions = atom->initial_nodal_positions;
+
+  if (atom->nmax > maxlist) {
+    maxlist = atom->nmax;
+    memory->destroy(split_list);
+    memory->destroy(merge_list);
+    memory->create(split_list,maxlist,"cac/adapt:split_list");
+    memory->create(merge_list,maxlist,"cac/adapt:merge_list");
+  }
+
+  nsplit_local = 0;
+  if (!split_flag) return;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit) || element_type[i] != Q8) continue;
+    for (int ipoly = 0; ipoly < poly_count[i]; ipoly++)
+      if (element_strain(nodal_positions[i][ipoly],initial_nodal_positions[i][ipoly]) >
+          split_strain) {
+        split_list[nsplit_local++] = i;
+        break;
+      }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   assign local atoms to the nearest site of the lattice, group them into
+   blocks of merge_cells^3 unit cells and select the complete blocks
+   that an element reproduces within the merge tolerance
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::select_merges()
+{
+  nmerge_local = 0;
+  if (!merge_flag) return;
+
+  int nlocal = atom->nlocal;
+  double **x = atom->x;
+  int *mask = atom->mask;
+  int *element_type = atom->element_type;
+  Lattice *lattice = domain->lattice;
+  int nbasis = lattice->nbasis;
+  int n = merge_cells;
+  int ncell = n*n*n;
+
+  if (nlocal > maxsites) {
+    maxsites = atom->nmax;
+    memory->sfree(sites);
+    sites = (BlockSite *) memory->smalloc(sizeof(BlockSite)*maxsites,"cac/adapt:sites");
+  }
+
+  int nsites = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit) || element_type[i] != 0) continue;
+    double lamda[3] = {x[i][0], x[i][1], x[i][2]};
+    lattice->box2lattice(lamda[0],lamda[1],lamda[2]);
+    int best = -1;
+    int cell[3];
+    double bestdev = LATTICE_TOL*LATTICE_TOL;
+    for (int ibasis = 0; ibasis < nbasis; ibasis++) {
+      double dev = 0.0;
+      int icell[3];
+      for (int dim = 0; dim < 3; dim++) {
+        double d = lamda[dim] - lattice->basis[ibasis][dim];
+        icell[dim] = static_cast<int> (floor(d + 0.5));
+        dev += (d - icell[dim])*(d - icell[dim]);
+      }
+      if (dev < bestdev) {
+        bestdev = dev;
+        best = ibasis;
+        cell[0] = icell[0]; cell[1] = icell[1]; cell[2] = icell[2];
+      }
+    }
+    if (best < 0) continue;
+
+    BlockSite *one = &sites[nsites++];
+    int local[3];
+    for (int dim = 0; dim < 3; dim++) {
+      one->block[dim] = static_cast<int> (floor(static_cast<double> (cell[dim])/n));
+      local[dim] = cell[dim] - one->block[dim]*n;
+    }
+    one->site = best*ncell + (local[0]*n + local[1])*n + local[2];
+    one->index = i;
+  }
+
+  qsort(sites,nsites,sizeof(BlockSite),compare_sites);
+
+  int start = 0;
+  while (start < nsites) {
+    int end = start + 1;
+    while (end < nsites && sites[end].block[0] == sites[start].block[0] &&
+           sites[end].block[1] == sites[start].block[1] &&
+           sites[end].block[2] == sites[start].block[2]) end++;
+    if (fit_block(start,end-start)) merge_list[nmerge_local++] = start;
+    start = end;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   order block sites by block and by site within the block
+------------------------------------------------------------------------- */
+
+int FixCACAdapt::compare_sites(const void *iptr, const void *jptr)
+{
+  const BlockSite *i = (const BlockSite *) iptr;
+  const BlockSite *j = (const BlockSite *) jptr;
+  for (int dim = 0; dim < 3; dim++) {
+    if (i->block[dim] < j->block[dim]) return -1;
+    if (i->block[dim] > j->block[dim]) return 1;
+  }
+  if (i->site < j->site) return -1;
+  if (i->site > j->site) return 1;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   fit the nodes of an element to the count sorted sites starting at start
+   return 1 if every lattice site of the block holds exactly one atom, the
+     atoms of each basis share a type and image, every atom lies within
+     merge_tol of the element and the element strain is below half the
+     split strain, so that new elements are not split again right away
+   the fitted nodal positions, velocities and lattice reference positions
+     are left in block_data, the atom of each site in block_atoms
+------------------------------------------------------------------------- */
+
+int FixCACAdapt::fit_block(int start, int count)
+{
+  if (count != nblock_sites) return 0;
+
+  double **x = atom->x;
+  double **v = atom->v;
+  int *type = atom->type;
+  imageint *image = atom->image;
+  Lattice *lattice = domain->lattice;
+  int nbasis = lattice->nbasis;
+  int n = merge_cells;
+  int ncell = n*n*n;
+
+  int i0 = sites[start].index;
+  for (int k = 0; k < count; k++) {
+    if (sites[start+k].site != k) return 0;
+    int i = block_atoms[k] = sites[start+k].index;
+    if (image[i] != image[i0]) return 0;
+    if (type[i] != type[block_atoms[(k/ncell)*ncell]]) return 0;
+  }
+
+  double tolsq = merge_tol*merge_tol;
+  for (int ibasis = 0; ibasis < nbasis; ibasis++) {
+    int *atoms = &block_atoms[ibasis*ncell];
+    double *nodes = &block_data[ibasis*72];
+    double rhs[8][6];
+    for (int k = 0; k < 8; k++)
+      for (int dim = 0; dim < 6; dim++) rhs[k][dim] = 0.0;
+    for (int j = 0; j < ncell; j++)
+      for (int k = 0; k < 8; k++) {
+        rhs[k][0] += site_shape[j][k]*x[atoms[j]][0];
+        rhs[k][1] += site_shape[j][k]*x[atoms[j]][1];
+        rhs[k][2] += site_shape[j][k]*x[atoms[j]][2];
+        rhs[k][3] += site_shape[j][k]*v[atoms[j]][0];
+        rhs[k][4] += site_shape[j][k]*v[atoms[j]][1];
+        rhs[k][5] += site_shape[j][k]*v[atoms[j]][2];
+      }
+    for (int k = 0; k < 8; k++)
+      for (int dim = 0; dim < 6; dim++) {
+        double sum = 0.0;
+        for (int l = 0; l < 8; l++) sum += fit_matrix[k][l]*rhs[l][dim];
+        nodes[9*k + dim] = sum;
+      }
+
+    for (int j = 0; j < ncell; j++) {
+      double dx[3];
+      for (int dim = 0; dim < 3; dim++) {
+        dx[dim] = -x[atoms[j]][dim];
+        for (int k = 0; k < 8; k++) dx[dim] += site_shape[j][k]*nodes[9*k + dim];
+      }
+      if (dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2] > tolsq) return 0;
+    }
+
+    // reference nodes at the corners of the undeformed lattice block,
+    // half a unit cell outside the outermost sites
+
+    const int *block = sites[start].block;
+    for (int k = 0; k < 8; k++) {
+      double *ref = &nodes[9*k + 6];
+      for (int dim = 0; dim < 3; dim++)
+        ref[dim] = block[dim]*n - 0.5 + (node_signs[k][dim] > 0 ? n : 0) +
+          lattice->basis[ibasis][dim];
+      lattice->lattice2box(ref[0],ref[1],ref[2]);
+    }
+
+    if (split_flag) {
+      double *xnodes[8],*refnodes[8];
+      for (int k = 0; k < 8; k++) {
+        xnodes[k] = &nodes[9*k];
+        refnodes[k] = &nodes[9*k + 6];
+      }
+      if (element_strain(xnodes,refnodes) > 0.5*split_strain) return 0;
+    }
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   replace the atoms of the block starting at sorted site start by a Q8
+   element; the element takes the slot and ID of the atom with lowest ID
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::merge_block(int start)
+{
+  fit_block(start,nblock_sites);
+
+  tagint *tag = atom->tag;
+  int *type = atom->type;
+  int nbasis = domain->lattice->nbasis;
+  int n = merge_cells;
+  int ncell = n*n*n;
+
+  int i0 = block_atoms[0];
+  for (int k = 1; k < nblock_sites; k++)
+    if (tag[block_atoms[k]] < tag[i0]) i0 = block_atoms[k];
+
+  // each poly keeps the momentum and kinetic energy of its atoms
+
+  for (int ibasis = 0; ibasis < nbasis; ibasis++) {
+    int *atoms = &block_atoms[ibasis*ncell];
+    basis_types[ibasis] = type[atoms[0]];
+    double ke = 0.0;
+    for (int j = 0; j < ncell; j++)
+      ke += MathExtra::lensq3(atom->v[atoms[j]]);
+    double *vnodes[8];
+    for (int k = 0; k < 8; k++) vnodes[k] = &block_data[ibasis*72 + 9*k + 3];
+    conserve_ke(vnodes,8,ncell/8.0,ke);
+  }
+
+  for (int k = 0; k < nblock_sites; k++)
+    if (block_atoms[k] != i0) dlist[block_atoms[k]] = 1;
+
+  avec->allocate_element(i0,8);
+  atom->element_type[i0] = Q8;
+  atom->poly_count[i0] = nbasis;
+  atom->element_scale[i0][0] = atom->element_scale[i0][1] = atom->element_scale[i0][2] = n;
+  type[i0] = 0;
+  double *x = atom->x[i0];
+  double *v = atom->v[i0];
+  x[0] = x[1] = x[2] = v[0] = v[1] = v[2] = 0.0;
+  for (int ibasis = 0; ibasis < nbasis; ibasis++) {
+    atom->node_types[i0][ibasis] = basis_types[ibasis];
+    for (int k = 0; k < 8; k++) {
+      double *node = &block_data[ibasis*72 + 9*k];
+      for (int dim = 0; dim < 3; dim++) {
+        atom->nodal_positions[i0][ibasis][k][dim] = node[dim];
+        atom->nodal_velocities[i0][ibasis][k][dim] = node[dim+3];
+        atom->initial_nodal_positions[i0][ibasis][k][dim] = node[dim+6];
+        atom->nodal_forces[i0][ibasis][k][dim] = 0.0;
+        x[dim] += node[dim];
+        v[dim] += node[dim+3];
+      }
+    }
+  }
+  for (int dim = 0; dim < 3; dim++) {
+    x[dim] /= 8*nbasis;
+    v[dim] /= 8*nbasis;
+  }
+  converted[i0] = 1;
+}
+
+/* ----------------------------------------------------------------------
+   replace local element i by one atom at each of its lattice sites;
+   the atom arrays were grown beforehand
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::split_element(int i)
+{
+  int *scale = atom->element_scale[i];
+  int nsite = scale[0]*scale[1]*scale[2];
+  int npoly = atom->poly_count[i];
+
+  if (nsite > maxsite_v) {
+    maxsite_v = nsite;
+    memory->destroy(site_v);
+    memory->create(site_v,maxsite_v,3,"cac/adapt:site_v");
+  }
+
+  for (int ipoly = 0; ipoly < npoly; ipoly++) {
+    double **xnodes = atom->nodal_positions[i][ipoly];
+    double **x0nodes = atom->initial_nodal_positions[i][ipoly];
+    double **vnodes = atom->nodal_velocities[i][ipoly];
+
+    // interpolated site velocities keep the momentum of the poly;
+    // their spread is scaled to keep its kinetic energy
+
+    double ke = 0.0;
+    for (int k = 0; k < 8; k++) ke += MathExtra::lensq3(vnodes[k]);
+    ke *= nsite/8.0;
+
+    int j = 0;
+    for (int a = 0; a < scale[0]; a++)
+      for (int b = 0; b < scale[1]; b++)
+        for (int c = 0; c < scale[2]; c++, j++) {
+          double s = -1.0 + (2*a + 1.0)/scale[0];
+          double t = -1.0 + (2*b + 1.0)/scale[1];
+          double w = -1.0 + (2*c + 1.0)/scale[2];
+          site_v[j][0] = site_v[j][1] = site_v[j][2] = 0.0;
+          for (int k = 0; k < 8; k++) {
+            double shape = 0.125*(1 + s*node_signs[k][0])*
+              (1 + t*node_signs[k][1])*(1 + w*node_signs[k][2]);
+            site_v[j][0] += shape*vnodes[k][0];
+            site_v[j][1] += shape*vnodes[k][1];
+            site_v[j][2] += shape*vnodes[k][2];
+          }
+        }
+    conserve_ke(site_v,nsite,1.0,ke);
+
+    j = 0;
+    for (int a = 0; a < scale[0]; a++)
+      for (int b = 0; b < scale[1]; b++)
+        for (int c = 0; c < scale[2]; c++, j++) {
+          double s = -1.0 + (2*a + 1.0)/scale[0];
+          double t = -1.0 + (2*b + 1.0)/scale[1];
+          double w = -1.0 + (2*c + 1.0)/scale[2];
+          double coord[3] = {0.0, 0.0, 0.0};
+          double ref[3] = {0.0, 0.0, 0.0};
+          for (int k = 0; k < 8; k++) {
+            double shape = 0.125*(1 + s*node_signs[k][0])*
+              (1 + t*node_signs[k][1])*(1 + w*node_signs[k][2]);
+            for (int dim = 0; dim < 3; dim++) {
+              coord[dim] += shape*xnodes[k][dim];
+              ref[dim] += shape*x0nodes[k][dim];
+            }
+          }
+
+          avec->create_atom(atom->node_types[i][ipoly],coord);
+          int m = atom->nlocal - 1;
+          atom->mask[m] = atom->mask[i];
+          atom->image[m] = atom->image[i];
+          for (int dim = 0; dim < 3; dim++) {
+            atom->v[m][dim] = site_v[j][dim];
+            atom->nodal_velocities[m][0][0][dim] = site_v[j][dim];
+            atom->initial_nodal_positions[m][0][0][dim] = ref[dim];
+            atom->nodal_forces[m][0][0][dim] = 0.0;
+          }
+          converted[m] = 1;
+          dlist[m] = 0;
+        }
+  }
+
+  dlist[i] = 1;
+}
+
+/* ----------------------------------------------------------------------
+   largest von Mises shear strain at the corners of a Q8 element with
+   nodes x relative to its reference nodes x0
+------------------------------------------------------------------------- */
+
+double FixCACAdapt::element_strain(double **x, double **x0)
+{
+  double strain = 0.0;
+
+  for (int corner = 0; corner < 8; corner++) {
+    const double *at = node_signs[corner];
+    double jac[3][3],jac0[3][3];
+    for (int d = 0; d < 3; d++)
+      for (int a = 0; a < 3; a++) jac[d][a] = jac0[d][a] = 0.0;
+    for (int k = 0; k < 8; k++) {
+      const double *sk = node_signs[k];
+      double factor[3];
+      for (int a = 0; a < 3; a++) factor[a] = 1 + at[a]*sk[a];
+      double deriv[3] = {0.125*sk[0]*factor[1]*factor[2],
+                         0.125*sk[1]*factor[0]*factor[2],
+                         0.125*sk[2]*factor[0]*factor[1]};
+      for (int d = 0; d < 3; d++)
+        for (int a = 0; a < 3; a++) {
+          jac[d][a] += x[k][d]*deriv[a];
+          jac0[d][a] += x0[k][d]*deriv[a];
+        }
+    }
+    if (fabs(MathExtra::det3(jac0)) == 0.0) continue;
+
+    // deformation gradient F and Green strain E = (F^T F - I)/2
+
+    double inv0[3][3],defgrad[3][3],cauchy_green[3][3];
+    MathExtra::invert3(jac0,inv0);
+    MathExtra::times3(jac,inv0,defgrad);
+    MathExtra::transpose_times3(defgrad,defgrad,cauchy_green);
+    double e[3][3];
+    for (int d = 0; d < 3; d++)
+      for (int a = 0; a < 3; a++)
+        e[d][a] = 0.5*(cauchy_green[d][a] - (d == a ? 1.0 : 0.0));
+
+    double vm = e[0][1]*e[0][1] + e[0][2]*e[0][2] + e[1][2]*e[1][2] +
+      ((e[0][0]-e[1][1])*(e[0][0]-e[1][1]) + (e[1][1]-e[2][2])*(e[1][1]-e[2][2]) +
+       (e[0][0]-e[2][2])*(e[0][0]-e[2][2]))/6.0;
+    strain = MAX(strain,sqrt(vm));
+  }
+
+  return strain;
+}
+
+/* ----------------------------------------------------------------------
+   scale the spread of n velocities of equal weight about their mean so
+   that sum weight*|v|^2 equals ke; the mean and thus the momentum are
+   kept; nothing is done if the spread vanishes or ke is too small
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::conserve_ke(double **vel, int n, double weight, double ke)
+{
+  double vmean[3] = {0.0, 0.0, 0.0};
+  for (int j = 0; j < n; j++) {
+    vmean[0] += vel[j][0];
+    vmean[1] += vel[j][1];
+    vmean[2] += vel[j][2];
+  }
+  vmean[0] /= n;
+  vmean[1] /= n;
+  vmean[2] /= n;
+
+  double kemean = weight*n*MathExtra::lensq3(vmean);
+  double kespread = 0.0;
+  for (int j = 0; j < n; j++) {
+    double dv[3];
+    MathExtra::sub3(vel[j],vmean,dv);
+    kespread += weight*MathExtra::lensq3(dv);
+  }
+  if (kespread <= 0.0 || ke <= kemean) return;
+
+  double factor = sqrt((ke - kemean)/kespread);
+  for (int j = 0; j < n; j++)
+    for (int dim = 0; dim < 3; dim++)
+      vel[j][dim] = vmean[dim] + factor*(vel[j][dim] - vmean[dim]);
+}
+
+/* ----------------------------------------------------------------------
+   potential energy from a full force evaluation
+------------------------------------------------------------------------- */
+
+double FixCACAdapt::energy_full()
+{
+  int eflag = 1;
+  int vflag = 0;
+
+  if (modify->n_pre_force) modify->pre_force(vflag);
+  if (force->pair) force->pair->compute(eflag,vflag);
+  if (force->kspace) force->kspace->compute(eflag,vflag);
+  if (modify->n_post_force) modify->post_force(vflag);
+
+  update->eflag_global = update->ntimestep;
+  return c_pe->compute_scalar();
+}
+
+/* ----------------------------------------------------------------------
+   kinetic energy of all atoms and elements with lumped nodal masses
+------------------------------------------------------------------------- */
+
+double FixCACAdapt::kinetic_energy()
+{
+  int nlocal = atom->nlocal;
+  double *mass = atom->mass;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int **node_types = atom->node_types;
+  int **element_scale = atom->element_scale;
+  int *nodes_count_list = atom->nodes_per_element_list;
+  double ****nodal_velocities = atom->nodal_velocities;
+
+  double ke = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    int nodes_per_element = nodes_count_list[element_type[i]];
+    double sites = element_scale[i][0]*element_scale[i][1]*element_scale[i][2];
+    for (int ipoly = 0; ipoly < poly_count[i]; ipoly++)
+      for (int k = 0; k < nodes_per_element; k++)
+        ke += mass[node_types[i][ipoly]]*sites/nodes_per_element*
+          MathExtra::lensq3(nodal_velocities[i][ipoly][k]);
+  }
+
+  double ke_all;
+  MPI_Allreduce(&ke,&ke_all,1,MPI_DOUBLE,MPI_SUM,world);
+  return 0.5*force->mvv2e*ke_all;
+}
+
+/* ----------------------------------------------------------------------
+   remove the total energy change delta of the conversions by scaling the
+   velocities of the converted atoms and elements about their common
+   center-of-mass velocity; what cannot be removed is accumulated
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::restore_energy(double delta)
+{
+  int nlocal = atom->nlocal;
+  double *mass = atom->mass;
+  double **v = atom->v;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int **node_types = atom->node_types;
+  int **element_scale = atom->element_scale;
+  int *nodes_count_list = atom->nodes_per_element_list;
+  double ****nodal_velocities = atom->nodal_velocities;
+
+  double p[4] = {0.0, 0.0, 0.0, 0.0};
+  for (int i = 0; i < nlocal; i++) {
+    if (!converted[i]) continue;
+    int nodes_per_element = nodes_count_list[element_type[i]];
+    double sites = element_scale[i][0]*element_scale[i][1]*element_scale[i][2];
+    for (int ipoly = 0; ipoly < poly_count[i]; ipoly++)
+      for (int k = 0; k < nodes_per_element; k++) {
+        double weight = mass[node_types[i][ipoly]]*sites/nodes_per_element;
+        p[0] += weight*nodal_velocities[i][ipoly][k][0];
+        p[1] += weight*nodal_velocities[i][ipoly][k][1];
+        p[2] += weight*nodal_velocities[i][ipoly][k][2];
+        p[3] += weight;
+      }
+  }
+  double p_all[4];
+  MPI_Allreduce(p,p_all,4,MPI_DOUBLE,MPI_SUM,world);
+
+  double vcm[3] = {0.0, 0.0, 0.0};
+  if (p_all[3] > 0.0) {
+    vcm[0] = p_all[0]/p_all[3];
+    vcm[1] = p_all[1]/p_all[3];
+    vcm[2] = p_all[2]/p_all[3];
+  }
+
+  double kespread = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!converted[i]) continue;
+    int nodes_per_element = nodes_count_list[element_type[i]];
+    double sites = element_scale[i][0]*element_scale[i][1]*element_scale[i][2];
+    for (int ipoly = 0; ipoly < poly_count[i]; ipoly++)
+      for (int k = 0; k < nodes_per_element; k++) {
+        double dv[3];
+        MathExtra::sub3(nodal_velocities[i][ipoly][k],vcm,dv);
+        kespread += mass[node_types[i][ipoly]]*sites/nodes_per_element*MathExtra::lensq3(dv);
+      }
+  }
+  double kespread_all;
+  MPI_Allreduce(&kespread,&kespread_all,1,MPI_DOUBLE,MPI_SUM,world);
+  kespread_all *= 0.5*force->mvv2e;
+
+  double factor = 1.0;
+  if (kespread_all > 0.0) {
+    factor = (kespread_all - delta > 0.0) ? sqrt((kespread_all - delta)/kespread_all) : 0.0;
+    energy_unrestored += delta - kespread_all*(1.0 - factor*factor);
+  } else energy_unrestored += delta;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (!converted[i]) continue;
+    int nodes_per_element = nodes_count_list[element_type[i]];
+    v[i][0] = v[i][1] = v[i][2] = 0.0;
+    for (int ipoly = 0; ipoly < poly_count[i]; ipoly++)
+      for (int k = 0; k < nodes_per_element; k++)
+        for (int dim = 0; dim < 3; dim++) {
+          double *vnode = nodal_velocities[i][ipoly][k];
+          vnode[dim] = vcm[dim] + factor*(vnode[dim] - vcm[dim]);
+          v[i][dim] += vnode[dim];
+        }
+    for (int dim = 0; dim < 3; dim++) v[i][dim] /= nodes_per_element*poly_count[i];
+    converted[i] = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return split and merge counts and the energy that was not restored
+------------------------------------------------------------------------- */
+
+double FixCACAdapt::compute_vector(int n)
+{
+  if (n == 0) return nsplit;
+  if (n == 1) return nmerge;
+  return energy_unrestored;
+}
+
+/* ----------------------------------------------------------------------
+   allocate the per-atom converted flags
+------------------------------------------------------------------------- */
+
+void FixCACAdapt::grow_arrays(int nmax)
+{
+  memory->grow(converted,nmax,"cac/adapt:converted");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixCACAdapt::copy_arrays(int i, int j, int /*delflag*/)
+{
+  converted[j] = converted[i];
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixCACAdapt::pack_exchange(int i, double *buf)
+{
+  buf[0] = converted[i];
+  return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixCACAdapt::unpack_exchange(int nlocal, double *buf)
+{
+  converted[nlocal] = static_cast<int> (buf[0]);
+  return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixCACAdapt::memory_usage()
+{
+  double bytes = (double)atom->nmax*sizeof(int);
+  bytes += (double)(2*maxlist + maxdlist)*sizeof(int);
+  bytes += (double)maxsites*sizeof(BlockSite);
+  bytes += (double)maxsite_v*3*sizeof(double);
+  if (merge_flag) {
+    int nbasis = domain->lattice->nbasis;
+    bytes += (double)(nblock_sites/nbasis)*8*sizeof(double);
+    bytes += (double)(nblock_sites + nbasis)*sizeof(int);
+    bytes += (double)nbasis*72*sizeof(double);
+  }
+  return bytes;
+}
@@ -0,0 +1,141 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(cac/adapt,FixCACAdapt)
+
+#else
+
+#ifndef LMP_FIX_CAC_ADAPT_H
+#define LMP_FIX_CAC_ADAPT_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixCACAdapt : public Fix {
+ public:
+  FixCACAdapt(class LAMMPS *, int, char **);
+  ~FixCACAdapt();
+  int setmask();
+  void init();
+  void pre_exchange();
+  double compute_vector(int);
+  double memory_usage();
+
+  void grow_arrays(int);
+  void copy_arrays(int, int, int);
+  int pack_exchange(int, double *);
+  int unpack_exchange(int, double *);
+
+ private:
+  int nevery;
+  int split_flag;                   // 1 if elements are split into atoms
+  double split_strain;              // von Mises strain above which an element is split
+  int merge_flag;                   // 1 if atom blocks are merged into elements
+  int merge_cells;                  // unit cells per element edge of merged elements
+  double merge_tol;                 // largest distance of an atom from the fitted element
+  int energy_flag;                  // 1 if the total energy is restored after conversions
+
+  double nsplit, nmerge;            // cumulative number of split and created elements
+  double energy_unrestored;         // cumulative energy change that could not be restored
+
+  int *converted;                   // 1 for atoms and elements created in this adapt step
+  int *split_list, nsplit_local;    // local elements selected for splitting
+  int *merge_list, nmerge_local;    // first sorted site of each local block selected for merging
+  int maxlist;
+  int *dlist, maxdlist;             // local atoms and elements to delete
+  int nblock_sites;                 // lattice sites of a merged element, all basis atoms
+  double **site_shape;              // shape functions of the Q8 nodes at the block sites
+  double fit_matrix[8][8];          // inverse normal matrix of the nodal least squares fit
+
+  struct BlockSite {
+    int block[3];                   // block of merge_cells^3 unit cells holding the atom
+    int site;                       // basis atom and unit cell within the block
+    int index;                      // local atom index
+  };
+  BlockSite *sites;
+  int maxsites;
+  int *block_atoms;                 // local atom at each site of the block being merged
+  int *basis_types;                 // atom type of each basis atom of the block
+  double *block_data;               // fitted nodal positions, velocities and references
+  double **site_v;                  // velocities of the atoms created for one poly of an element
+  int maxsite_v;
+
+  class Compute *c_pe;
+  class AtomVecCAC *avec;
+
+  void reneighbor();
+  void select_splits();
+  void select_merges();
+  void split_element(int);
+  int fit_block(int, int);
+  void merge_block(int);
+  double element_strain(double **, double **);
+  void conserve_ke(double **, int, double, double);
+  double energy_full();
+  double kinetic_energy();
+  void restore_energy(double);
+  static int compare_sites(const void *, const void *);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal fix cac/adapt command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Fix cac/adapt requires a CAC atom style
+
+Self-explanatory.
+
+E: Fix cac/adapt does not support charged CAC atom styles
+
+The nodal charges of split or merged elements are not interpolated.
+
+E: Fix cac/adapt requires the split or merge keyword
+
+Without either keyword the fix would have nothing to do.
+
+E: Fix cac/adapt merge requires a lattice
+
+Use the lattice command to define the lattice the atoms to be merged
+sit on before defining this fix.
+
+E: Fix cac/adapt merge requires a 3d lattice with 2 or more unit cells per element edge
+
+A least squares fit of the 8 element nodes needs at least two sites
+along each element edge.
+
+E: Fix cac/adapt merge exceeds the maximum nodes or internal degrees of freedom
+
+The atom style must admit Eight_Node elements with one internal degree
+of freedom per basis atom of the lattice.
+
+E: Fix cac/adapt requires atom IDs
+
+Atoms created by splitting an element need IDs.
+
+E: Fix cac/adapt requires the thermo_pe compute
+
+The energy of the model before and after the conversions is evaluated
+with the thermo_pe compute, which must not have been deleted.
+
+*/
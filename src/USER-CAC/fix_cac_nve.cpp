@@ -63,6 +63,8 @@ void FixNVECAC::initial_integrate(int vflag)
   double dtfm;
 
   // update v and x of atoms in group
+  // the nodes of an element are contiguous and poly index major
+  // so each poly index is streamed as one flat block
 
   double **x = atom->x;
   double **v = atom->v;
@@ -73,115 +75,58 @@ void FixNVECAC::initial_integrate(int vflag)
   int *element_type = atom->element_type;
   int *poly_count = atom->poly_count;
   int **node_types = atom->node_types;
-  int *nodes_count_list = atom->nodes_per_element_list;	
+  int *nodes_count_list = atom->nodes_per_element_list;
 
-  int nodes_per_element;
+  int nodes_per_element, nblock, ntotal;
+  double *xnode, *vnode, *fnode;
 
   double *rmass = atom->rmass;
   double *mass = atom->mass;
-  int *type = atom->type;
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
   if (igroup == atom->firstgroup) nlocal = atom->nfirst;
 
-  if (rmass) {
   for (int i = 0; i < nlocal; i++){
-  nodes_per_element = nodes_count_list[element_type[i]];
-
-  if (mask[i] & groupbit) {
-    x[i][0] = 0;
-    x[i][1] = 0;
-    x[i][2] = 0;
-    v[i][0] = 0;
-    v[i][1] = 0;
-    v[i][2] = 0;
-    f[i][0] = 0;
-    f[i][1] = 0;
-    f[i][2] = 0;
-  for (int poly_counter = 0; poly_counter < poly_count[i];poly_counter++) {	
-      for(int k=0; k<nodes_per_element; k++){	
-        dtfm = dtf / rmass[i];
-        nodal_velocities[i][poly_counter][k][0] += dtfm * nodal_forces[i][poly_counter][k][0];
-        nodal_velocities[i][poly_counter][k][1] += dtfm * nodal_forces[i][poly_counter][k][1];
-        nodal_velocities[i][poly_counter][k][2] += dtfm * nodal_forces[i][poly_counter][k][2];
-        nodal_positions[i][poly_counter][k][0] += dtv * nodal_velocities[i][poly_counter][k][0];
-        nodal_positions[i][poly_counter][k][1] += dtv * nodal_velocities[i][poly_counter][k][1];
-        nodal_positions[i][poly_counter][k][2] += dtv * nodal_velocities[i][poly_counter][k][2];
-
-        x[i][0] += nodal_positions[i][poly_counter][k][0];
-        x[i][1] += nodal_positions[i][poly_counter][k][1];
-        x[i][2] += nodal_positions[i][poly_counter][k][2];
-        v[i][0] += nodal_velocities[i][poly_counter][k][0];
-        v[i][1] += nodal_velocities[i][poly_counter][k][1];
-        v[i][2] += nodal_velocities[i][poly_counter][k][2];
-        f[i][0] += nodal_forces[i][poly_counter][k][0];
-        f[i][1] += nodal_forces[i][poly_counter][k][1];
-        f[i][2] += nodal_forces[i][poly_counter][k][2];
+    if (!(mask[i] & groupbit)) continue;
+    nodes_per_element = nodes_count_list[element_type[i]];
+    nblock = 3*nodes_per_element;
+    ntotal = nblock*poly_count[i];
+    xnode = nodal_positions[i][0][0];
+    vnode = nodal_velocities[i][0][0];
+    fnode = nodal_forces[i][0][0];
+
+    for (int poly_counter = 0; poly_counter < poly_count[i]; poly_counter++) {
+      if (rmass) dtfm = dtf / rmass[i];
+      else dtfm = dtf / mass[node_types[i][poly_counter]];
+      for (int k = poly_counter*nblock; k < (poly_counter+1)*nblock; k++) {
+        vnode[k] += dtfm * fnode[k];
+        xnode[k] += dtv * vnode[k];
       }
     }
-  x[i][0] = x[i][0] / nodes_per_element / poly_count[i];
-  x[i][1] = x[i][1] / nodes_per_element / poly_count[i];
-  x[i][2] = x[i][2] / nodes_per_element / poly_count[i];
-  v[i][0] = v[i][0] / nodes_per_element / poly_count[i];
-  v[i][1] = v[i][1] / nodes_per_element / poly_count[i];
-  v[i][2] = v[i][2] / nodes_per_element / poly_count[i];
-  f[i][0] = f[i][0] / nodes_per_element / poly_count[i];
-  f[i][1] = f[i][1] / nodes_per_element / poly_count[i];
-  f[i][2] = f[i][2] / nodes_per_element / poly_count[i];
-  }
-
-
-
-  }
-
-  } else {
-    for (int i = 0; i < nlocal; i++){
-    
-    nodes_per_element = nodes_count_list[element_type[i]];
 
-      if (mask[i] & groupbit) {
-        x[i][0] = 0;
-        x[i][1] = 0;
-        x[i][2] = 0;
-        v[i][0] = 0;
-        v[i][1] = 0;
-        v[i][2] = 0;
-        f[i][0] = 0;
-        f[i][1] = 0;
-        f[i][2] = 0;
-      for (int poly_counter = 0; poly_counter < poly_count[i];poly_counter++) {	
-        for(int k=0; k<nodes_per_element; k++){	
-          
-          dtfm = dtf / mass[node_types[i][poly_counter]];
-          nodal_velocities[i][poly_counter][k][0] += dtfm * nodal_forces[i][poly_counter][k][0];
-          nodal_velocities[i][poly_counter][k][1] += dtfm * nodal_forces[i][poly_counter][k][1];
-          nodal_velocities[i][poly_counter][k][2] += dtfm * nodal_forces[i][poly_counter][k][2];
-          nodal_positions[i][poly_counter][k][0] += dtv * nodal_velocities[i][poly_counter][k][0];
-          nodal_positions[i][poly_counter][k][1] += dtv * nodal_velocities[i][poly_counter][k][1];
-          nodal_positions[i][poly_counter][k][2] += dtv * nodal_velocities[i][poly_counter][k][2];
-
-          x[i][0] += nodal_positions[i][poly_counter][k][0];
-          x[i][1] += nodal_positions[i][poly_counter][k][1];
-          x[i][2] += nodal_positions[i][poly_counter][k][2];
-          v[i][0] += nodal_velocities[i][poly_counter][k][0];
-          v[i][1] += nodal_velocities[i][poly_counter][k][1];
-          v[i][2] += nodal_velocities[i][poly_counter][k][2];
-          f[i][0] += nodal_forces[i][poly_counter][k][0];
-          f[i][1] += nodal_forces[i][poly_counter][k][1];
-          f[i][2] += nodal_forces[i][poly_counter][k][2];
-        }
-      }
-      x[i][0] = x[i][0] / nodes_per_element / poly_count[i];
-      x[i][1] = x[i][1] / nodes_per_element / poly_count[i];
-      x[i][2] = x[i][2] / nodes_per_element / poly_count[i];
-      v[i][0] = v[i][0] / nodes_per_element / poly_count[i];
-      v[i][1] = v[i][1] / nodes_per_element / poly_count[i];
-      v[i][2] = v[i][2] / nodes_per_element / poly_count[i];
-      f[i][0] = f[i][0] / nodes_per_element / poly_count[i];
-      f[i][1] = f[i][1] / nodes_per_element / poly_count[i];
-      f[i][2] = f[i][2] / nodes_per_element / poly_count[i];
-      }
+    x[i][0] = x[i][1] = x[i][2] = 0;
+    v[i][0] = v[i][1] = v[i][2] = 0;
+    f[i][0] = f[i][1] = f[i][2] = 0;
+    for (int k = 0; k < ntotal; k += 3) {
+      x[i][0] += xnode[k];
+      x[i][1] += xnode[k+1];
+      x[i][2] += xnode[k+2];
+      v[i][0] += vnode[k];
+      v[i][1] += vnode[k+1];
+      v[i][2] += vnode[k+2];
+      f[i][0] += fnode[k];
+      f[i][1] += fnode[k+1];
+      f[i][2] += fnode[k+2];
     }
+    x[i][0] = x[i][0] / nodes_per_element / poly_count[i];
+    x[i][1] = x[i][1] / nodes_per_element / poly_count[i];
+    x[i][2] = x[i][2] / nodes_per_element / poly_count[i];
+    v[i][0] = v[i][0] / nodes_per_element / poly_count[i];
+    v[i][1] = v[i][1] / nodes_per_element / poly_count[i];
+    v[i][2] = v[i][2] / nodes_per_element / poly_count[i];
+    f[i][0] = f[i][0] / nodes_per_element / poly_count[i];
+    f[i][1] = f[i][1] / nodes_per_element / poly_count[i];
+    f[i][2] = f[i][2] / nodes_per_element / poly_count[i];
   }
 }
 
@@ -197,91 +142,51 @@ void FixNVECAC::final_integrate()
   double **f = atom->f;
   double *rmass = atom->rmass;
   double *mass = atom->mass;
-  double ****nodal_positions = atom->nodal_positions;
   double ****nodal_velocities = atom->nodal_velocities;
   double ****nodal_forces = atom->nodal_forces;
   int *element_type = atom->element_type;
   int *poly_count = atom->poly_count;
   int **node_types = atom->node_types;
-  int *nodes_count_list = atom->nodes_per_element_list;	
+  int *nodes_count_list = atom->nodes_per_element_list;
 
-  int nodes_per_element;
+  int nodes_per_element, nblock, ntotal;
+  double *vnode, *fnode;
 
-  int *type = atom->type;
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
   if (igroup == atom->firstgroup) nlocal = atom->nfirst;
 
-  if (rmass) {
-    for (int i = 0; i < nlocal; i++){
+  for (int i = 0; i < nlocal; i++){
+    if (!(mask[i] & groupbit)) continue;
     nodes_per_element = nodes_count_list[element_type[i]];
-         
-      if (mask[i] & groupbit) {
-        v[i][0] = 0;
-        v[i][1] = 0;
-        v[i][2] = 0;
-        f[i][0] = 0;
-        f[i][1] = 0;
-        f[i][2] = 0;
-      for (int poly_counter = 0; poly_counter < poly_count[i];poly_counter++) {	
-        for(int k=0; k<nodes_per_element; k++){	
-          
-            dtfm = dtf / rmass[i];
-            nodal_velocities[i][poly_counter][k][0] += dtfm * nodal_forces[i][poly_counter][k][0];
-            nodal_velocities[i][poly_counter][k][1] += dtfm * nodal_forces[i][poly_counter][k][1];
-            nodal_velocities[i][poly_counter][k][2] += dtfm * nodal_forces[i][poly_counter][k][2];
-
-            v[i][0] += nodal_velocities[i][poly_counter][k][0];
-            v[i][1] += nodal_velocities[i][poly_counter][k][1];
-            v[i][2] += nodal_velocities[i][poly_counter][k][2];
-            f[i][0] += nodal_forces[i][poly_counter][k][0];
-            f[i][1] += nodal_forces[i][poly_counter][k][1];
-            f[i][2] += nodal_forces[i][poly_counter][k][2];
-          }
-        }
-      v[i][0] = v[i][0] / nodes_per_element / poly_count[i];
-      v[i][1] = v[i][1] / nodes_per_element / poly_count[i];
-      v[i][2] = v[i][2] / nodes_per_element / poly_count[i];
-      f[i][0] = f[i][0] / nodes_per_element / poly_count[i];
-      f[i][1] = f[i][1] / nodes_per_element / poly_count[i];
-      f[i][2] = f[i][2] / nodes_per_element / poly_count[i];
-      }
+    nblock = 3*nodes_per_element;
+    ntotal = nblock*poly_count[i];
+    vnode = nodal_velocities[i][0][0];
+    fnode = nodal_forces[i][0][0];
+
+    for (int poly_counter = 0; poly_counter < poly_count[i]; poly_counter++) {
+      if (rmass) dtfm = dtf / rmass[i];
+      else dtfm = dtf / mass[node_types[i][poly_counter]];
+      for (int k = poly_counter*nblock; k < (poly_counter+1)*nblock; k++)
+        vnode[k] += dtfm * fnode[k];
     }
 
-  } else {
-    for (int i = 0; i < nlocal; i++){
-    nodes_per_element = nodes_count_list[element_type[i]];
-
-      if (mask[i] & groupbit) {
-        v[i][0] = 0;
-        v[i][1] = 0;
-        v[i][2] = 0;
-        f[i][0] = 0;
-        f[i][1] = 0;
-        f[i][2] = 0;
-      for (int poly_counter = 0; poly_counter < poly_count[i];poly_counter++) {	
-        for(int k=0; k<nodes_per_element; k++){	
-            dtfm = dtf / mass[node_types[i][poly_counter]];
-            nodal_velocities[i][poly_counter][k][0] += dtfm * nodal_forces[i][poly_counter][k][0];
-            nodal_velocities[i][poly_counter][k][1] += dtfm * nodal_forces[i][poly_counter][k][1];
-            nodal_velocities[i][poly_counter][k][2] += dtfm * nodal_forces[i][poly_counter][k][2];
-
-            v[i][0] += nodal_velocities[i][poly_counter][k][0];
-            v[i][1] += nodal_velocities[i][poly_counter][k][1];
-            v[i][2] += nodal_velocities[i][poly_counter][k][2];
-            f[i][0] += nodal_forces[i][poly_counter][k][0];
-            f[i][1] += nodal_forces[i][poly_counter][k][1];
-            f[i][2] += nodal_forces[i][poly_counter][k][2];
-          }
-        }
-      v[i][0] = v[i][0] / nodes_per_element / poly_count[i];
-      v[i][1] = v[i][1] / nodes_per_element / poly_count[i];
-      v[i][2] = v[i][2] / nodes_per_element / poly_count[i];
-      f[i][0] = f[i][0] / nodes_per_element / poly_count[i];
-      f[i][1] = f[i][1] / nodes_per_element / poly_count[i];
-      f[i][2] = f[i][2] / nodes_per_element / poly_count[i];
-      }
+    v[i][0] = v[i][1] = v[i][2] = 0;
+    f[i][0] = f[i][1] = f[i][2] = 0;
+    for (int k = 0; k < ntotal; k += 3) {
+      v[i][0] += vnode[k];
+      v[i][1] += vnode[k+1];
+      v[i][2] += vnode[k+2];
+      f[i][0] += fnode[k];
+      f[i][1] += fnode[k+1];
+      f[i][2] += fnode[k+2];
     }
+    v[i][0] = v[i][0] / nodes_per_element / poly_count[i];
+    v[i][1] = v[i][1] / nodes_per_element / poly_count[i];
+    v[i][2] = v[i][2] / nodes_per_element / poly_count[i];
+    f[i][0] = f[i][0] / nodes_per_element / poly_count[i];
+    f[i][1] = f[i][1] / nodes_per_element / poly_count[i];
+    f[i][2] = f[i][2] / nodes_per_element / poly_count[i];
   }
 }
 
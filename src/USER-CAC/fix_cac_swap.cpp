@@ -42,6 +42,7 @@
 #include "memory.h"
 #include "error.h"
 #include "neighbor.h"
+#include "pair_cac.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -50,8 +51,11 @@ using namespace FixConst;
 
 FixCACSwap::FixCACSwap(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg),
-  idregion(NULL), type_list(NULL), mu(NULL), qtype(NULL),
-  sqrt_mass_ratio(NULL), local_swap_iatom_list(NULL),
+  idregion(NULL), type_list(NULL), mu(NULL), pair_cac(NULL),
+  element_energy(NULL), trial_energy(NULL), element_qi(NULL),
+  element_mark(NULL), site_mark(NULL), site_first(NULL), site_elements(NULL),
+  affected(NULL), site_index(NULL), site_type(NULL), site_q(NULL),
+  qtype(NULL), sqrt_mass_ratio(NULL), local_swap_iatom_list(NULL),
   local_swap_jatom_list(NULL), local_swap_atom_list(NULL),
   random_equal(NULL), random_unequal(NULL), c_pe(NULL)
 {
@@ -109,6 +113,10 @@ FixCACSwap::FixCACSwap(LAMMPS *lmp, int narg, char **arg) :
   local_swap_iatom_list = NULL;
   local_swap_jatom_list = NULL;
 
+  local_active = 0;
+  local_nmax = maxsite_elements = maxsites = 0;
+  naffected = nsites = mark_count = 0;
+
   // set comm size needed by this Fix
 
   if (atom->q_flag) comm_forward = 2;
@@ -130,6 +138,7 @@ void FixCACSwap::options(int narg, char **arg)
   nswaptypes = 0;
   nmutypes = 0;
   iregion = -1;
+  local_flag = 1;
 
   int iarg = 0;
   while (iarg < narg) {
@@ -176,6 +185,12 @@ void FixCACSwap::options(int narg, char **arg)
         mu[nmutypes] = utils::numeric(FLERR,arg[iarg],false,lmp);
         iarg++;
       }
+    } else if (strcmp(arg[iarg],"local") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix cac/swap command");
+      if (strcmp(arg[iarg+1],"no") == 0) local_flag = 0;
+      else if (strcmp(arg[iarg+1],"yes") == 0) local_flag = 1;
+      else error->all(FLERR,"Illegal fix cac/swap command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal fix cac/swap command");
   }
 }
@@ -188,6 +203,17 @@ FixCACSwap::~FixCACSwap()
   memory->destroy(mu);
   memory->destroy(qtype);
   memory->destroy(sqrt_mass_ratio);
+  memory->destroy(element_energy);
+  memory->destroy(trial_energy);
+  memory->destroy(element_qi);
+  memory->destroy(element_mark);
+  memory->destroy(site_mark);
+  memory->destroy(site_first);
+  memory->destroy(site_elements);
+  memory->destroy(affected);
+  memory->destroy(site_index);
+  memory->destroy(site_type);
+  memory->destroy(site_q);
   if (regionflag) delete [] idregion;
   delete random_equal;
   delete random_unequal;
@@ -292,6 +318,16 @@ void FixCACSwap::init()
     if (flagall)
       error->all(FLERR,"Cannot do cac/swap on atoms in atom_modify first group");
   }
+
+  // trial energies can be summed over the elements that interact with the
+  // swapped sites if the CAC pair style allows it, the neighbor lists stay
+  // valid, and nothing else contributes to the energy
+
+  local_active = 0;
+  pair_cac = dynamic_cast<PairCAC *>(force->pair);
+  if (local_flag && pair_cac && pair_cac->local_energy_flag && !unequal_cutoffs &&
+      !force->kspace && !atom->molecular && modify->n_energy_global == 0)
+    local_active = 1;
 }
 
 /* ----------------------------------------------------------------------
@@ -312,15 +348,41 @@ void FixCACSwap::pre_exchange()
   if (modify->n_pre_neighbor) modify->pre_neighbor();
   neighbor->build(1);
 
-  energy_stored = energy_full();
-
   int nsuccess = 0;
-  if (semi_grand_flag) {
-    update_semi_grand_atoms_list();
-    for (int i = 0; i < ncycles; i++) nsuccess += attempt_semi_grand();
+  if (local_active) {
+
+    // trial sites are looked up through the atom map,
+    // create a temporary one if the run does not keep one
+
+    int mapflag = 0;
+    if (atom->map_style == Atom::MAP_NONE) {
+      mapflag = 1;
+      atom->map_init();
+      atom->map_set();
+    }
+
+    setup_local_energy();
+    if (semi_grand_flag) {
+      update_semi_grand_atoms_list();
+      for (int i = 0; i < ncycles; i++) nsuccess += attempt_semi_grand_local();
+    } else {
+      update_swap_atoms_list();
+      for (int i = 0; i < ncycles; i++) nsuccess += attempt_swap_local();
+    }
+
+    if (mapflag) {
+      atom->map_delete();
+      atom->map_style = Atom::MAP_NONE;
+    }
   } else {
-    update_swap_atoms_list();
-    for (int i = 0; i < ncycles; i++) nsuccess += attempt_swap();
+    energy_stored = energy_full();
+    if (semi_grand_flag) {
+      update_semi_grand_atoms_list();
+      for (int i = 0; i < ncycles; i++) nsuccess += attempt_semi_grand();
+    } else {
+      update_swap_atoms_list();
+      for (int i = 0; i < ncycles; i++) nsuccess += attempt_swap();
+    }
   }
 
   nswap_attempts += ncycles;
@@ -390,7 +452,7 @@ int FixCACSwap::attempt_semi_grand()
     return 1;
   } else {
     if (i >= 0) {
-      atom->type[i] = itype;
+      atom->type[i] = atom->node_types[i][0] = itype;
     }
     if (force->kspace) force->kspace->qsum_qsq();
     energy_stored = energy_before;
@@ -465,9 +527,9 @@ int FixCACSwap::attempt_swap()
         atom->v[j][0] *= sqrt_mass_ratio[jtype][itype];
         atom->v[j][1] *= sqrt_mass_ratio[jtype][itype];
         atom->v[j][2] *= sqrt_mass_ratio[jtype][itype];
-        atom->nodal_velocities[j][0][0][0] *= sqrt_mass_ratio[itype][jtype];
-        atom->nodal_velocities[j][0][0][1] *= sqrt_mass_ratio[itype][jtype];
-        atom->nodal_velocities[j][0][0][2] *= sqrt_mass_ratio[itype][jtype];
+        atom->nodal_velocities[j][0][0][0] *= sqrt_mass_ratio[jtype][itype];
+        atom->nodal_velocities[j][0][0][1] *= sqrt_mass_ratio[jtype][itype];
+        atom->nodal_velocities[j][0][0][2] *= sqrt_mass_ratio[jtype][itype];
       }
     }
     return 1;
@@ -497,6 +559,309 @@ int FixCACSwap::attempt_swap()
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+   store the energy of every local element and map each local or ghost
+   site to the local elements with a quadrature point that interacts
+   with it; a type change of a site only changes the energy of these
+   elements and of the site itself
+------------------------------------------------------------------------- */
+
+void FixCACSwap::setup_local_energy()
+{
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  int *quadrature_counts = atom->quadrature_counts;
+  int *poly_count = atom->poly_count;
+  int *e2quad_index = atom->e2quad_index;
+  int ***quad_lists_index[2];
+  int *quad_lists_counts[2];
+  int nlists = 1;
+
+  quad_lists_index[0] = atom->inner_quad_lists_index;
+  quad_lists_counts[0] = atom->inner_quad_lists_counts;
+  if (atom->outer_neigh_flag) {
+    quad_lists_index[1] = atom->outer_quad_lists_index;
+    quad_lists_counts[1] = atom->outer_quad_lists_counts;
+    nlists = 2;
+  }
+
+  if (atom->nmax > local_nmax) {
+    memory->destroy(element_energy);
+    memory->destroy(trial_energy);
+    memory->destroy(element_qi);
+    memory->destroy(element_mark);
+    memory->destroy(site_mark);
+    memory->destroy(site_first);
+    memory->destroy(affected);
+    local_nmax = atom->nmax;
+    memory->create(element_energy,local_nmax,"cac/swap:element_energy");
+    memory->create(trial_energy,local_nmax,"cac/swap:trial_energy");
+    memory->create(element_qi,local_nmax,"cac/swap:element_qi");
+    memory->create(element_mark,local_nmax,"cac/swap:element_mark");
+    memory->create(site_mark,local_nmax,"cac/swap:site_mark");
+    memory->create(site_first,local_nmax+1,"cac/swap:site_first");
+    memory->create(affected,local_nmax,"cac/swap:affected");
+  }
+
+  // count the elements of each site, then fill them in
+  // site_mark[k] = e+1 once element e was listed for site k
+
+  for (int k = 0; k <= nall; k++) site_first[k] = 0;
+  for (int pass = 0; pass < 2; pass++) {
+    for (int k = 0; k < nall; k++) site_mark[k] = 0;
+    for (int e = 0; e < nlocal; e++) {
+      int pqilo = e2quad_index[e];
+      int pqihi = pqilo + quadrature_counts[e]*poly_count[e];
+      for (int ilist = 0; ilist < nlists; ilist++) {
+        for (int pqi = pqilo; pqi < pqihi; pqi++) {
+          int **indices = quad_lists_index[ilist][pqi];
+          int count = quad_lists_counts[ilist][pqi];
+          for (int l = 0; l < count; l++) {
+            int k = indices[l][0];
+            if (site_mark[k] == e+1) continue;
+            site_mark[k] = e+1;
+            if (pass == 0) site_first[k+1]++;
+            else site_elements[site_first[k]++] = e;
+          }
+        }
+      }
+    }
+    if (pass == 0) {
+      for (int k = 0; k < nall; k++) site_first[k+1] += site_first[k];
+      if (site_first[nall] > maxsite_elements) {
+        maxsite_elements = site_first[nall];
+        memory->destroy(site_elements);
+        memory->create(site_elements,maxsite_elements,"cac/swap:site_elements");
+      }
+    }
+  }
+
+  // the fill pass advanced site_first[k] to the start of site k+1
+
+  for (int k = nall; k > 0; k--) site_first[k] = site_first[k-1];
+  site_first[0] = 0;
+
+  // element energies with the current types
+
+  pair_cac->setup_local_energy();
+  int iqi = 0;
+  for (int e = 0; e < nlocal; e++) {
+    element_qi[e] = iqi;
+    element_energy[e] = pair_cac->compute_element(e,iqi);
+    element_mark[e] = 0;
+    iqi += quadrature_counts[e];
+  }
+  mark_count = 0;
+
+  double energy_local = 0.0;
+  for (int e = 0; e < nlocal; e++) energy_local += element_energy[e];
+  MPI_Allreduce(&energy_local,&energy_stored,1,MPI_DOUBLE,MPI_SUM,world);
+}
+
+/* ----------------------------------------------------------------------
+   change the types of all local and ghost copies of the ntrial sites with
+   the given tags, found through the atom map and return the resulting change of the total energy;
+   no communication of the new types is needed since every proc applies
+   the same change to its copies
+------------------------------------------------------------------------- */
+
+double FixCACSwap::energy_local_change(int ntrial, tagint *trial_tag,
+                                       int *trial_type, double *trial_q)
+{
+  int nlocal = atom->nlocal;
+  int *type = atom->type;
+  int **node_types = atom->node_types;
+  int *sametag = atom->sametag;
+  double *q = atom->q;
+
+  // walk the local and ghost copies of each site through the atom map
+
+  nsites = 0;
+  for (int itrial = 0; itrial < ntrial; itrial++) {
+    for (int k = atom->map(trial_tag[itrial]); k >= 0; k = sametag[k]) {
+      if (nsites == maxsites) {
+        maxsites += 16;
+        memory->grow(site_index,maxsites,"cac/swap:site_index");
+        memory->grow(site_type,maxsites,"cac/swap:site_type");
+        memory->grow(site_q,maxsites,"cac/swap:site_q");
+      }
+      site_index[nsites] = k;
+      site_type[nsites] = node_types[k][0];
+      if (atom->q_flag) site_q[nsites] = q[k];
+      nsites++;
+      type[k] = node_types[k][0] = trial_type[itrial];
+      if (trial_q) q[k] = trial_q[itrial];
+    }
+  }
+
+  // local elements whose energy can change
+
+  mark_count++;
+  naffected = 0;
+  for (int isite = 0; isite < nsites; isite++) {
+    int k = site_index[isite];
+    if (k < nlocal && element_mark[k] != mark_count) {
+      element_mark[k] = mark_count;
+      affected[naffected++] = k;
+    }
+    for (int m = site_first[k]; m < site_first[k+1]; m++) {
+      int e = site_elements[m];
+      if (element_mark[e] == mark_count) continue;
+      element_mark[e] = mark_count;
+      affected[naffected++] = e;
+    }
+  }
+
+  pair_cac->setup_local_energy();
+  double delta = 0.0;
+  for (int a = 0; a < naffected; a++) {
+    int e = affected[a];
+    trial_energy[a] = pair_cac->compute_element(e,element_qi[e]);
+    delta += trial_energy[a] - element_energy[e];
+  }
+
+  double deltaall;
+  MPI_Allreduce(&delta,&deltaall,1,MPI_DOUBLE,MPI_SUM,world);
+  return deltaall;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixCACSwap::accept_local_change()
+{
+  for (int a = 0; a < naffected; a++)
+    element_energy[affected[a]] = trial_energy[a];
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixCACSwap::reject_local_change()
+{
+  int *type = atom->type;
+  int **node_types = atom->node_types;
+  double *q = atom->q;
+
+  for (int isite = 0; isite < nsites; isite++) {
+    int k = site_index[isite];
+    type[k] = node_types[k][0] = site_type[isite];
+    if (atom->q_flag) q[k] = site_q[isite];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as attempt_semi_grand(), with the energy change of the trial
+   evaluated from the affected elements only
+------------------------------------------------------------------------- */
+
+int FixCACSwap::attempt_semi_grand_local()
+{
+  if (nswap == 0) return 0;
+
+  int itype,jtype,jswaptype;
+  tagint itag = 0;
+  int i = pick_semi_grand_atom();
+  itype = jtype = 0;
+  if (i >= 0) {
+    jswaptype = static_cast<int> (nswaptypes*random_unequal->uniform());
+    jtype = type_list[jswaptype];
+    itype = atom->node_types[i][0];
+    while (itype == jtype) {
+      jswaptype = static_cast<int> (nswaptypes*random_unequal->uniform());
+      jtype = type_list[jswaptype];
+    }
+    itag = atom->tag[i];
+  }
+
+  tagint itagall;
+  int jtypeall;
+  MPI_Allreduce(&itag,&itagall,1,MPI_LMP_TAGINT,MPI_MAX,world);
+  MPI_Allreduce(&jtype,&jtypeall,1,MPI_INT,MPI_MAX,world);
+
+  double delta = energy_local_change(1,&itagall,&jtypeall,NULL);
+
+  int success = 0;
+  if (i >= 0)
+    if (random_unequal->uniform() <
+      exp(beta*(-delta + mu[jtype] - mu[itype]))) success = 1;
+
+  int success_all = 0;
+  MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
+
+  if (success_all) {
+    accept_local_change();
+    update_semi_grand_atoms_list();
+    energy_stored += delta;
+    if (conserve_ke_flag) {
+      if (i >= 0) {
+        atom->v[i][0] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][1] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][2] *= sqrt_mass_ratio[itype][jtype];
+      }
+    }
+    return 1;
+  }
+  reject_local_change();
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   same as attempt_swap(), with the energy change of the trial evaluated
+   from the affected elements only
+------------------------------------------------------------------------- */
+
+int FixCACSwap::attempt_swap_local()
+{
+  if ((niswap == 0) || (njswap == 0)) return 0;
+
+  int i = pick_i_swap_atom();
+  int j = pick_j_swap_atom();
+  int itype = type_list[0];
+  int jtype = type_list[1];
+
+  tagint tags[2],tagsall[2];
+  tags[0] = (i >= 0) ? atom->tag[i] : 0;
+  tags[1] = (j >= 0) ? atom->tag[j] : 0;
+  MPI_Allreduce(tags,tagsall,2,MPI_LMP_TAGINT,MPI_MAX,world);
+
+  int newtype[2];
+  double newq[2];
+  newtype[0] = jtype;
+  newtype[1] = itype;
+  if (atom->q_flag) {
+    newq[0] = qtype[1];
+    newq[1] = qtype[0];
+  }
+
+  double delta = energy_local_change(2,tagsall,newtype,atom->q_flag ? newq : NULL);
+
+  if (random_equal->uniform() < exp(-beta*delta)) {
+    accept_local_change();
+    update_swap_atoms_list();
+    energy_stored += delta;
+    if (conserve_ke_flag) {
+      if (i >= 0) {
+        atom->v[i][0] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][1] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][2] *= sqrt_mass_ratio[itype][jtype];
+        atom->nodal_velocities[i][0][0][0] *= sqrt_mass_ratio[itype][jtype];
+        atom->nodal_velocities[i][0][0][1] *= sqrt_mass_ratio[itype][jtype];
+        atom->nodal_velocities[i][0][0][2] *= sqrt_mass_ratio[itype][jtype];
+      }
+      if (j >= 0) {
+        atom->v[j][0] *= sqrt_mass_ratio[jtype][itype];
+        atom->v[j][1] *= sqrt_mass_ratio[jtype][itype];
+        atom->v[j][2] *= sqrt_mass_ratio[jtype][itype];
+        atom->nodal_velocities[j][0][0][0] *= sqrt_mass_ratio[jtype][itype];
+        atom->nodal_velocities[j][0][0][1] *= sqrt_mass_ratio[jtype][itype];
+        atom->nodal_velocities[j][0][0][2] *= sqrt_mass_ratio[jtype][itype];
+      }
+    }
+    return 1;
+  }
+  reject_local_change();
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    compute system potential energy
 ------------------------------------------------------------------------- */
@@ -714,7 +1079,7 @@ int FixCACSwap::pack_forward_comm(int n, int *list, double *buf, int /*pbc_flag*
 {
   int i,j,m;
 
-  int *type = atom->type;
+  int **node_types = atom->node_types;
   double *q = atom->q;
 
   m = 0;
@@ -722,13 +1087,13 @@ int FixCACSwap::pack_forward_comm(int n, int *list, double *buf, int /*pbc_flag*
   if (atom->q_flag) {
     for (i = 0; i < n; i++) {
       j = list[i];
-      buf[m++] = type[j];
+      buf[m++] = node_types[j][0];
       buf[m++] = q[j];
     }
   } else {
     for (i = 0; i < n; i++) {
       j = list[i];
-      buf[m++] = type[j];
+      buf[m++] = node_types[j][0];
     }
   }
 
@@ -742,6 +1107,7 @@ void FixCACSwap::unpack_forward_comm(int n, int first, double *buf)
   int i,m,last;
 
   int *type = atom->type;
+  int **node_types = atom->node_types;
   double *q = atom->q;
 
   m = 0;
@@ -749,12 +1115,12 @@ void FixCACSwap::unpack_forward_comm(int n, int first, double *buf)
 
   if (atom->q_flag) {
     for (i = first; i < last; i++) {
-      type[i] = static_cast<int> (buf[m++]);
+      type[i] = node_types[i][0] = static_cast<int> (buf[m++]);
       q[i] = buf[m++];
     }
   } else {
     for (i = first; i < last; i++)
-      type[i] = static_cast<int> (buf[m++]);
+      type[i] = node_types[i][0] = static_cast<int> (buf[m++]);
   }
 }
 
@@ -776,6 +1142,8 @@ double FixCACSwap::compute_vector(int n)
 double FixCACSwap::memory_usage()
 {
   double bytes = atom_swap_nmax * sizeof(int);
+  bytes += local_nmax * (2*sizeof(double) + 5*sizeof(int));
+  bytes += maxsite_elements * sizeof(int);
   return bytes;
 }
 
@@ -34,6 +34,12 @@ class FixCACSwap : public Fix {
   int attempt_semi_grand();
   int attempt_swap();
   double energy_full();
+  void setup_local_energy();
+  double energy_local_change(int, tagint *, int *, double *);
+  void accept_local_change();
+  void reject_local_change();
+  int attempt_semi_grand_local();
+  int attempt_swap_local();
   int pick_semi_grand_atom();
   int pick_i_swap_atom();
   int pick_j_swap_atom();
@@ -70,6 +76,24 @@ class FixCACSwap : public Fix {
 
   bool unequal_cutoffs;
 
+  int local_flag;                         // yes = evaluate trial energies from affected elements only
+  int local_active;                       // 1 if local energy changes are used in this run
+  class PairCAC *pair_cac;
+  int local_nmax;                         // length of per element/site arrays
+  double *element_energy;                 // energy of each local element
+  double *trial_energy;                   // energy of the affected elements in a trial
+  int *element_qi;                        // first quadrature point of each local element
+  int *element_mark,*site_mark;           // stamps to avoid listing an element twice
+  int mark_count;
+  int *site_first;                        // first element in site_elements of each site
+  int *site_elements;                     // local elements whose neighbor lists contain a site
+  int maxsite_elements;
+  int *affected;                          // local elements affected by a trial
+  int naffected;
+  int *site_index,*site_type;             // sites changed by a trial and their old types
+  double *site_q;                         // old charges of the changed sites
+  int nsites,maxsites;
+
   int atom_swap_nmax;
   double beta;
   double *qtype;
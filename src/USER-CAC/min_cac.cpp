@@ -74,6 +74,29 @@ void CACMin::init()
   fix_cac_minimize = (FixCACMinimize *) modify->fix[modify->nfix-1];
 }
 
+/* ----------------------------------------------------------------------
+   the flat vectors are set up by reset_vectors() before the setup forces
+   are computed; refresh them so the initial force norms are correct
+------------------------------------------------------------------------- */
+
+void CACMin::setup(int flag)
+{
+  Min::setup(flag);
+  if (force_copy_flag) copy_force();
+  fnorm2_init = sqrt(fnorm_sqr());
+  fnorminf_init = sqrt(fnorm_inf());
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CACMin::setup_minimal(int flag)
+{
+  Min::setup_minimal(flag);
+  if (force_copy_flag) copy_force();
+  fnorm2_init = sqrt(fnorm_sqr());
+  fnorminf_init = sqrt(fnorm_inf());
+}
+
 /* ----------------------------------------------------------------------
    evaluate potential energy and forces
    may migrate atoms due to reneighboring
@@ -97,6 +120,8 @@ double CACMin::energy_force(int resetflag)
     comm->forward_comm();
     timer->stamp(Timer::COMM);
   } else {
+    // flat per-dof vectors of the minimizer migrate with the nodes
+    if (copy_flag) pack_search();
     if (modify->n_min_pre_exchange) {
       timer->stamp();
       modify->min_pre_exchange();
@@ -16,6 +16,10 @@
 
 #include "min.h"
 
+// flat nodal dof vectors shorter than this are not worth threading
+
+#define CAC_MIN_OMP_MINDOF 16384
+
 namespace LAMMPS_NS {
 
 class CACMin : public Min {
@@ -23,11 +27,14 @@ class CACMin : public Min {
   CACMin(class LAMMPS *);
   virtual ~CACMin();
   virtual void init();
+  virtual void setup(int flag = 1);
+  virtual void setup_minimal(int);
 
  protected:
   class FixCACMinimize *fix_cac_minimize;  // fix that stores auxiliary data
   
   double energy_force(int);
+  virtual void pack_search() {}   // store flat search vectors with the nodes before migration
 };
 
 }
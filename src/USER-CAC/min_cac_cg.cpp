@@ -24,6 +24,7 @@
 #include <cmath>
 #include "min_cac_cg.h"
 #include "atom.h"
+#include "comm.h"
 #include "update.h"
 #include "neighbor.h"
 #include "domain.h"
@@ -65,6 +66,7 @@ CACMinCG::CACMinCG(LAMMPS *lmp) : CACMin(lmp)
   copy_flag = force_copy_flag = 1;
   densemax=0;
   x0 = g = h = NULL;
+  search_current = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -161,11 +163,12 @@ void CACMinCG::reset_vectors()
 
   //copy nodal arrays to the continuous arrays for the min algorithm
   copy_force();
+  unpack_search();
+  search_current = 0;
   nvec=atom->dense_count;
   if (nvec) xvec = atom->min_x;
   if (nvec) fvec = atom->min_f;
-  
-  
+
 
   // extra per-atom dof
 
@@ -198,32 +201,14 @@ void CACMinCG::copy_vectors(){
   double **x = atom->x;
   int nodes_per_element;
 
-  //copy contents to these vectors
-  int dense_count_x=0;
-  int dense_count_f=0;
-  int dense_count_x0=0;
-  int dense_count_g=0;
-  int dense_count_h=0;
+  //copy contents to these vectors; the nodal data of an element is contiguous
+  int dense_count=0;
   for(int element_counter=0; element_counter < atom->nlocal; element_counter++){
-    for(int poly_counter=0; poly_counter < npoly[element_counter]; poly_counter++){
-      for(int node_counter=0; node_counter < nodes_per_element_list[element_type[element_counter]]; node_counter++){
-         nodal_positions[element_counter][poly_counter][node_counter][0] = min_x[dense_count_x++];
-         nodal_positions[element_counter][poly_counter][node_counter][1] = min_x[dense_count_x++];
-         nodal_positions[element_counter][poly_counter][node_counter][2] = min_x[dense_count_x++];
-         nodal_forces[element_counter][poly_counter][node_counter][0] = min_f[dense_count_f++];
-         nodal_forces[element_counter][poly_counter][node_counter][1] = min_f[dense_count_f++];
-         nodal_forces[element_counter][poly_counter][node_counter][2] = min_f[dense_count_f++];
-         nodal_x0[element_counter][poly_counter][node_counter][0] = x0[dense_count_x0++];
-         nodal_x0[element_counter][poly_counter][node_counter][1] = x0[dense_count_x0++];
-         nodal_x0[element_counter][poly_counter][node_counter][2] = x0[dense_count_x0++];
-         nodal_g[element_counter][poly_counter][node_counter][0] = g[dense_count_g++];
-         nodal_g[element_counter][poly_counter][node_counter][1] = g[dense_count_g++];
-         nodal_g[element_counter][poly_counter][node_counter][2] = g[dense_count_g++];
-         nodal_h[element_counter][poly_counter][node_counter][0] = h[dense_count_h++];
-         nodal_h[element_counter][poly_counter][node_counter][1] = h[dense_count_h++];
-         nodal_h[element_counter][poly_counter][node_counter][2] = h[dense_count_h++];
-       }
-     }
+    int nvalues = 3*npoly[element_counter]*nodes_per_element_list[element_type[element_counter]];
+    int nbytes = nvalues*sizeof(double);
+    memcpy(nodal_positions[element_counter][0][0],&min_x[dense_count],nbytes);
+    memcpy(nodal_forces[element_counter][0][0],&min_f[dense_count],nbytes);
+    dense_count += nvalues;
   }
 
     // update x for elements and atoms using nodal variables
@@ -264,15 +249,7 @@ void CACMinCG::copy_force(){
   double *min_x = atom->min_x;
   double *min_v = atom->min_v;
   double *min_f = atom->min_f;
-  
-  //copy contents of min vectors to the avec arrays and vice versa
-  int dense_count_x=0;
-  int dense_count_v=0;
-  int dense_count_f=0;
-  int dense_count_x0=0;
-  int dense_count_g=0;
-  int dense_count_h=0;
-  
+
   //grow the dense aligned vectors
   if(atom->dense_count>densemax){
   min_x = memory->grow(atom->min_x,atom->dense_count,"min_CAC_cg:min_x");
@@ -284,29 +261,55 @@ void CACMinCG::copy_force(){
   densemax=atom->dense_count;
   }
 
+  int dense_count=0;
+  for(int element_counter=0; element_counter < atom->nlocal; element_counter++){
+    int nvalues = 3*npoly[element_counter]*nodes_per_element_list[element_type[element_counter]];
+    int nbytes = nvalues*sizeof(double);
+    memcpy(&min_x[dense_count],nodal_positions[element_counter][0][0],nbytes);
+    memcpy(&min_v[dense_count],nodal_velocities[element_counter][0][0],nbytes);
+    memcpy(&min_f[dense_count],nodal_forces[element_counter][0][0],nbytes);
+    dense_count += nvalues;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy x0,g,h into the nodal vectors of fix cac/minimize
+   only needed before the nodes migrate, not for every energy evaluation
+------------------------------------------------------------------------- */
+
+void CACMinCG::pack_search(){
+  int *npoly = atom->poly_count;
+  int *nodes_per_element_list = atom->nodes_per_element_list;
+  int *element_type = atom->element_type;
+
+  int dense_count=0;
+  for(int element_counter=0; element_counter < atom->nlocal; element_counter++){
+    int nvalues = 3*npoly[element_counter]*nodes_per_element_list[element_type[element_counter]];
+    int nbytes = nvalues*sizeof(double);
+    memcpy(nodal_x0[element_counter][0][0],&x0[dense_count],nbytes);
+    memcpy(nodal_g[element_counter][0][0],&g[dense_count],nbytes);
+    memcpy(nodal_h[element_counter][0][0],&h[dense_count],nbytes);
+    dense_count += nvalues;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy the migrated nodal vectors of fix cac/minimize back to x0,g,h
+------------------------------------------------------------------------- */
+
+void CACMinCG::unpack_search(){
+  int *npoly = atom->poly_count;
+  int *nodes_per_element_list = atom->nodes_per_element_list;
+  int *element_type = atom->element_type;
+
+  int dense_count=0;
   for(int element_counter=0; element_counter < atom->nlocal; element_counter++){
-    for(int poly_counter=0; poly_counter < npoly[element_counter]; poly_counter++){
-      for(int node_counter=0; node_counter < nodes_per_element_list[element_type[element_counter]]; node_counter++){
-         min_x[dense_count_x++] = nodal_positions[element_counter][poly_counter][node_counter][0];
-         min_x[dense_count_x++] = nodal_positions[element_counter][poly_counter][node_counter][1];
-         min_x[dense_count_x++] = nodal_positions[element_counter][poly_counter][node_counter][2];
-         min_v[dense_count_v++] = nodal_velocities[element_counter][poly_counter][node_counter][0];
-         min_v[dense_count_v++] = nodal_velocities[element_counter][poly_counter][node_counter][1];
-         min_v[dense_count_v++] = nodal_velocities[element_counter][poly_counter][node_counter][2];
-         min_f[dense_count_f++] = nodal_forces[element_counter][poly_counter][node_counter][0];
-         min_f[dense_count_f++] = nodal_forces[element_counter][poly_counter][node_counter][1];
-         min_f[dense_count_f++] = nodal_forces[element_counter][poly_counter][node_counter][2];
-         x0[dense_count_x0++] = nodal_x0[element_counter][poly_counter][node_counter][0];
-         x0[dense_count_x0++] = nodal_x0[element_counter][poly_counter][node_counter][1];
-         x0[dense_count_x0++] = nodal_x0[element_counter][poly_counter][node_counter][2];
-         g[dense_count_g++] = nodal_g[element_counter][poly_counter][node_counter][0];
-         g[dense_count_g++] = nodal_g[element_counter][poly_counter][node_counter][1];
-         g[dense_count_g++] = nodal_g[element_counter][poly_counter][node_counter][2];
-         h[dense_count_h++] = nodal_h[element_counter][poly_counter][node_counter][0];
-         h[dense_count_h++] = nodal_h[element_counter][poly_counter][node_counter][1];
-         h[dense_count_h++] = nodal_h[element_counter][poly_counter][node_counter][2];
-       }
-     }
+    int nvalues = 3*npoly[element_counter]*nodes_per_element_list[element_type[element_counter]];
+    int nbytes = nvalues*sizeof(double);
+    memcpy(&x0[dense_count],nodal_x0[element_counter][0][0],nbytes);
+    memcpy(&g[dense_count],nodal_g[element_counter][0][0],nbytes);
+    memcpy(&h[dense_count],nodal_h[element_counter][0][0],nbytes);
+    dense_count += nvalues;
   }
 }
 
@@ -317,7 +320,7 @@ minimization via conjugate gradient iterations
 int CACMinCG::iterate(int maxiter)
 {
   int i, m, n, fail, ntimestep;
-  double beta, gg, dot[2], dotall[2];
+  double beta, gg, dot[3], dotall[3];
   double *fatom, *gatom, *hatom;
  
   //copy nodal arrays to the continuous arrays for the min algorithm
@@ -333,6 +336,7 @@ int CACMinCG::iterate(int maxiter)
   // initialize working vectors
 
   for (i = 0; i < nvec; i++) h[i] = g[i] = fvec[i];
+  search_current = 0;
   if (nextra_atom)
     for (m = 0; m < nextra_atom; m++) {
       fatom = fextra_atom[m];
@@ -371,27 +375,40 @@ int CACMinCG::iterate(int maxiter)
       return ETOL;
 
     // force tolerance criterion
-
-    dot[0] = dot[1] = 0.0;
+    // f.f, f.g and f.h share one pass and one reduction,
+    // f.h yields g.h of the new search direction below
+
+    double *fv = fvec, *gv = g, *hv = h;
+    double ff = 0.0, fg = 0.0, fh = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(+:ff,fg,fh)
+#endif
     for (i = 0; i < nvec; i++) {
-      dot[0] += fvec[i] * fvec[i];
-      dot[1] += fvec[i] * g[i];
+      ff += fv[i] * fv[i];
+      fg += fv[i] * gv[i];
+      fh += fv[i] * hv[i];
     }
+    dot[0] = ff;
+    dot[1] = fg;
+    dot[2] = fh;
     if (nextra_atom)
       for (m = 0; m < nextra_atom; m++) {
         fatom = fextra_atom[m];
         gatom = gextra_atom[m];
+        hatom = hextra_atom[m];
         n = extra_nlen[m];
         for (i = 0; i < n; i++) {
           dot[0] += fatom[i] * fatom[i];
           dot[1] += fatom[i] * gatom[i];
+          dot[2] += fatom[i] * hatom[i];
         }
       }
-    MPI_Allreduce(dot, dotall, 2, MPI_DOUBLE, MPI_SUM, world);
+    MPI_Allreduce(dot, dotall, 3, MPI_DOUBLE, MPI_SUM, world);
     if (nextra_global)
       for (i = 0; i < nextra_global; i++) {
         dotall[0] += fextra[i] * fextra[i];
         dotall[1] += fextra[i] * gextra[i];
+        dotall[2] += fextra[i] * hextra[i];
       }
 
     if (dotall[0] < update->ftol*update->ftol) return FTOL;
@@ -405,9 +422,14 @@ int CACMinCG::iterate(int maxiter)
     if ((niter + 1) % nlimit == 0) beta = 0.0;
     gg = dotall[0];
 
+    double hme = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(max:hme)
+#endif
     for (i = 0; i < nvec; i++) {
-      g[i] = fvec[i];
-      h[i] = g[i] + beta*h[i];
+      gv[i] = fv[i];
+      hv[i] = gv[i] + beta*hv[i];
+      hme = MAX(hme,fabs(hv[i]));
     }
     if (nextra_atom)
       for (m = 0; m < nextra_atom; m++) {
@@ -427,23 +449,19 @@ int CACMinCG::iterate(int maxiter)
       }
 
     // reinitialize CG if new search direction h is not downhill
+    // g = f, so g.h = f.f + beta*(f.h of the old h)
 
-    dot[0] = 0.0;
-    for (i = 0; i < nvec; i++) dot[0] += g[i] * h[i];
-    if (nextra_atom)
-      for (m = 0; m < nextra_atom; m++) {
-        gatom = gextra_atom[m];
-        hatom = hextra_atom[m];
-        n = extra_nlen[m];
-        for (i = 0; i < n; i++) dot[0] += gatom[i] * hatom[i];
-      }
-    MPI_Allreduce(dot, dotall, 1, MPI_DOUBLE, MPI_SUM, world);
-    if (nextra_global)
-      for (i = 0; i < nextra_global; i++)
-        dotall[0] += gextra[i] * hextra[i];
+    double gh = dotall[0] + beta*dotall[2];
 
-    if (dotall[0] <= 0.0) {
-      for (i = 0; i < nvec; i++) h[i] = g[i];
+    if (gh <= 0.0) {
+      hme = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(max:hme)
+#endif
+      for (i = 0; i < nvec; i++) {
+        hv[i] = gv[i];
+        hme = MAX(hme,fabs(hv[i]));
+      }
       if (nextra_atom)
         for (m = 0; m < nextra_atom; m++) {
           gatom = gextra_atom[m];
@@ -453,8 +471,16 @@ int CACMinCG::iterate(int maxiter)
         }
       if (nextra_global)
         for (i = 0; i < nextra_global; i++) hextra[i] = gextra[i];
+      gh = dotall[0];
     }
 
+    // f and h are unchanged until the next line search,
+    // which reuses f.h and the local max of |h|
+
+    fdoth_search = gh;
+    hme_search = hme;
+    search_current = 1;
+
     // output for thermo, dump, restart files
 
     if (output->next == ntimestep) {
@@ -492,25 +518,14 @@ int CACMinCG::iterate(int maxiter)
 int CACMinCG::linemin_backtrack(double eoriginal, double &alpha)
 {
   int i,m,n;
-  double fdothall,fdothme,hme,hmax,hmaxall;
+  double fdothall,hme,hmax,hmaxall;
   double de_ideal,de;
-  double *xatom,*x0atom,*fatom,*hatom;
+  double *xatom,*x0atom,*hatom;
 
   // fdothall = projection of search dir along downhill gradient
   // if search direction is not downhill, exit with error
 
-  fdothme = 0.0;
-  for (i = 0; i < nvec; i++) fdothme += fvec[i]*h[i];
-  if (nextra_atom)
-    for (m = 0; m < nextra_atom; m++) {
-      fatom = fextra_atom[m];
-      hatom = hextra_atom[m];
-      n = extra_nlen[m];
-      for (i = 0; i < n; i++) fdothme += fatom[i]*hatom[i];
-    }
-  MPI_Allreduce(&fdothme,&fdothall,1,MPI_DOUBLE,MPI_SUM,world);
-  if (nextra_global)
-    for (i = 0; i < nextra_global; i++) fdothall += fextra[i]*hextra[i];
+  fdothall = search_projection(hme);
   if (output->thermo->normflag) fdothall /= atom->natoms;
   if (fdothall <= 0.0) return DOWNHILL;
 
@@ -522,8 +537,6 @@ int CACMinCG::linemin_backtrack(double eoriginal, double &alpha)
   // else will have to backtrack from huge value when forces are tiny
   // if all search dir components are already 0.0, exit with error
 
-  hme = 0.0;
-  for (i = 0; i < nvec; i++) hme = MAX(hme,fabs(h[i]));
   MPI_Allreduce(&hme,&hmaxall,1,MPI_DOUBLE,MPI_MAX,world);
   alpha = MIN(ALPHA_MAX,dmax/hmaxall);
   if (nextra_atom)
@@ -547,7 +560,7 @@ int CACMinCG::linemin_backtrack(double eoriginal, double &alpha)
   // store box and values of all dof at start of linesearch
 
   fix_cac_minimize->store_box();
-  for (i = 0; i < nvec; i++) x0[i] = xvec[i];
+  if (nvec) memcpy(x0,xvec,nvec*sizeof(double));
   if (nextra_atom)
     for (m = 0; m < nextra_atom; m++) {
       xatom = xextra_atom[m];
@@ -641,7 +654,7 @@ int CACMinCG::linemin_backtrack(double eoriginal, double &alpha)
 int CACMinCG::linemin_quadratic(double eoriginal, double &alpha)
 {
   int i,m,n;
-  double fdothall,fdothme,hme,hmax,hmaxall;
+  double fdothall,hme,hmax,hmaxall;
   double de_ideal,de;
   double delfh,engprev,relerr,alphaprev,fhprev,ff,fh,alpha0;
   double dot[2],dotall[2];
@@ -651,18 +664,7 @@ int CACMinCG::linemin_quadratic(double eoriginal, double &alpha)
   // fdothall = projection of search dir along downhill gradient
   // if search direction is not downhill, exit with error
 
-  fdothme = 0.0;
-  for (i = 0; i < nvec; i++) fdothme += fvec[i]*h[i];
-  if (nextra_atom)
-    for (m = 0; m < nextra_atom; m++) {
-      fatom = fextra_atom[m];
-      hatom = hextra_atom[m];
-      n = extra_nlen[m];
-      for (i = 0; i < n; i++) fdothme += fatom[i]*hatom[i];
-    }
-  MPI_Allreduce(&fdothme,&fdothall,1,MPI_DOUBLE,MPI_SUM,world);
-  if (nextra_global)
-    for (i = 0; i < nextra_global; i++) fdothall += fextra[i]*hextra[i];
+  fdothall = search_projection(hme);
   if (output->thermo->normflag) fdothall /= atom->natoms;
   if (fdothall <= 0.0) return DOWNHILL;
 
@@ -674,8 +676,6 @@ int CACMinCG::linemin_quadratic(double eoriginal, double &alpha)
   // else will have to backtrack from huge value when forces are tiny
   // if all search dir components are already 0.0, exit with error
 
-  hme = 0.0;
-  for (i = 0; i < nvec; i++) hme = MAX(hme,fabs(h[i]));
   MPI_Allreduce(&hme,&hmaxall,1,MPI_DOUBLE,MPI_MAX,world);
   alphamax = MIN(ALPHA_MAX,dmax/hmaxall);
   if (nextra_atom)
@@ -700,7 +700,7 @@ int CACMinCG::linemin_quadratic(double eoriginal, double &alpha)
   // store box and values of all dof at start of linesearch
 
   fix_cac_minimize->store_box();
-  for (i = 0; i < nvec; i++) x0[i] = xvec[i];
+  if (nvec) memcpy(x0,xvec,nvec*sizeof(double));
   if (nextra_atom)
     for (m = 0; m < nextra_atom; m++) {
       xatom = xextra_atom[m];
@@ -733,10 +733,7 @@ int CACMinCG::linemin_quadratic(double eoriginal, double &alpha)
     // compute new fh, alpha, delfh
 
     dot[0] = dot[1] = 0.0;
-    for (i = 0; i < nvec; i++) {
-      dot[0] += fvec[i]*fvec[i];
-      dot[1] += fvec[i]*h[i];
-    }
+    vector_dots(dot);
     if (nextra_atom)
       for (m = 0; m < nextra_atom; m++) {
         fatom = fextra_atom[m];
@@ -898,9 +895,9 @@ pseudo code:
 int CACMinCG::linemin_forcezero(double eoriginal, double &alpha)
 {
   int i,m,n;
-  double fdothall,fdothme,hme,hmax,hmaxall;
+  double fdothall,hme,hmax,hmaxall;
   double de;
-  double *xatom,*x0atom,*fatom,*hatom;
+  double *xatom,*x0atom,*hatom;
 
   double alpha_max, alpha_init, alpha_del;
   // projection of: force on itself, current force on search direction,
@@ -926,21 +923,7 @@ int CACMinCG::linemin_forcezero(double eoriginal, double &alpha)
   // fdothall = projection of search dir along downhill gradient
   // if search direction is not downhill, exit with error
 
-  fdothme = 0.0;
-  for (i = 0; i < nvec; i++) fdothme += fvec[i]*h[i];
-  if (nextra_atom)
-    for (m = 0; m < nextra_atom; m++) {
-      fatom = fextra_atom[m];
-      hatom = hextra_atom[m];
-      n = extra_nlen[m];
-      for (i = 0; i < n; i++)
-        fdothme += fatom[i]*hatom[i];
-    }
-
-  MPI_Allreduce(&fdothme,&fdothall,1,MPI_DOUBLE,MPI_SUM,world);
-  if (nextra_global)
-    for (i = 0; i < nextra_global; i++)
-      fdothall += fextra[i]*hextra[i];
+  fdothall = search_projection(hme);
   if (output->thermo->normflag) fdothall /= atom->natoms;
   if (fdothall <= 0.0) return DOWNHILL;
 
@@ -954,10 +937,6 @@ int CACMinCG::linemin_forcezero(double eoriginal, double &alpha)
 
   // if all search dir components are already 0.0, exit with error
 
-  hme = 0.0;
-  for (i = 0; i < nvec; i++)
-    hme = MAX(hme,fabs(h[i]));
-
   MPI_Allreduce(&hme,&hmaxall,1,MPI_DOUBLE,MPI_MAX,world);
   alpha_max = dmax/hmaxall;
   if (nextra_atom)
@@ -984,7 +963,7 @@ int CACMinCG::linemin_forcezero(double eoriginal, double &alpha)
 
   fix_cac_minimize->store_box();
 
-  for (i = 0; i < nvec; i++) x0[i] = xvec[i];
+  if (nvec) memcpy(x0,xvec,nvec*sizeof(double));
   if (nextra_atom)
     for (m = 0; m < nextra_atom; m++) {
       xatom = xextra_atom[m];
@@ -1157,9 +1136,17 @@ double CACMinCG::alpha_step(double alpha, int resetflag)
   double *xatom,*x0atom,*hatom;
 
   // reset to starting point
+  // for the nodal dof the reset and the step along h are fused
+
+  double *xv = xvec, *x0v = x0, *hv = h;
 
   if (nextra_global) modify->min_step(0.0,hextra);
-  for (i = 0; i < nvec; i++) xvec[i] = x0[i];
+  if (alpha > 0.0) {
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF)
+#endif
+    for (i = 0; i < nvec; i++) xv[i] = x0v[i] + alpha*hv[i];
+  } else if (nvec) memcpy(xv,x0v,nvec*sizeof(double));
   if (nextra_atom)
     for (m = 0; m < nextra_atom; m++) {
       xatom = xextra_atom[m];
@@ -1173,7 +1160,6 @@ double CACMinCG::alpha_step(double alpha, int resetflag)
 
   if (alpha > 0.0) {
     if (nextra_global) modify->min_step(alpha,hextra);
-    for (i = 0; i < nvec; i++) xvec[i] += alpha*h[i];
     if (nextra_atom)
       for (m = 0; m < nextra_atom; m++) {
         xatom = xextra_atom[m];
@@ -1206,10 +1192,7 @@ double CACMinCG::compute_dir_deriv(double &ff)
    // compute new fh, alpha, delfh
 
     dot[0] = dot[1] = 0.0;
-    for (i = 0; i < nvec; i++) {
-      dot[0] += fvec[i]*fvec[i];
-      dot[1] += fvec[i]*h[i];
-    }
+    vector_dots(dot);
 
     if (nextra_atom)
       for (m = 0; m < nextra_atom; m++) {
@@ -1239,3 +1222,64 @@ double CACMinCG::compute_dir_deriv(double &ff)
 
     return fh;
 }
+
+/* ----------------------------------------------------------------------
+   f dot h over all dof and local max of |h| at the start of a line search
+   the values of the fused reduction in iterate() are used if current
+------------------------------------------------------------------------- */
+
+double CACMinCG::search_projection(double &hme)
+{
+  int i,m,n;
+  double *fatom,*hatom;
+  double fdothme,fdothall;
+
+  if (search_current) {
+    search_current = 0;
+    hme = hme_search;
+    return fdoth_search;
+  }
+
+  double *fv = fvec, *hv = h;
+  double fh = 0.0, hmax = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(+:fh) reduction(max:hmax)
+#endif
+  for (i = 0; i < nvec; i++) {
+    fh += fv[i]*hv[i];
+    hmax = MAX(hmax,fabs(hv[i]));
+  }
+  fdothme = fh;
+  hme = hmax;
+  if (nextra_atom)
+    for (m = 0; m < nextra_atom; m++) {
+      fatom = fextra_atom[m];
+      hatom = hextra_atom[m];
+      n = extra_nlen[m];
+      for (i = 0; i < n; i++) fdothme += fatom[i]*hatom[i];
+    }
+  MPI_Allreduce(&fdothme,&fdothall,1,MPI_DOUBLE,MPI_SUM,world);
+  if (nextra_global)
+    for (i = 0; i < nextra_global; i++) fdothall += fextra[i]*hextra[i];
+
+  return fdothall;
+}
+
+/* ----------------------------------------------------------------------
+   local f dot f and f dot h of the nodal dof, added to dot[0] and dot[1]
+------------------------------------------------------------------------- */
+
+void CACMinCG::vector_dots(double *dot)
+{
+  double *fv = fvec, *hv = h;
+  double ff = 0.0, fh = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(+:ff,fh)
+#endif
+  for (int i = 0; i < nvec; i++) {
+    ff += fv[i]*fv[i];
+    fh += fv[i]*hv[i];
+  }
+  dot[0] += ff;
+  dot[1] += fh;
+}
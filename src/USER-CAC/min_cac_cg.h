@@ -50,6 +50,10 @@ class CACMinCG : public CACMin {
 
   int densemax;               // bounds arrays size for continuous x,v,f nodal arrays
 
+  int search_current;         // 1 if fdoth_search and hme_search match f and h
+  double fdoth_search;        // f dot h from the fused reduction of iterate()
+  double hme_search;          // local max of |h|
+
 
   typedef int (CACMinCG::*FnPtr)(double, double &);
   FnPtr linemin;
@@ -59,8 +63,12 @@ class CACMinCG : public CACMin {
 
   double alpha_step(double, int);
   double compute_dir_deriv(double &);
+  double search_projection(double &);
+  void vector_dots(double *);
   virtual void copy_vectors();
   virtual void copy_force();
+  void pack_search();
+  void unpack_search();
 };
 
 }
@@ -13,8 +13,10 @@
 
 #include <cmath>
 #include "min_cac_fire.h"
+#include <cstring>
 #include "universe.h"
 #include "atom.h"
+#include "comm.h"
 #include "force.h"
 #include "update.h"
 #include "output.h"
@@ -100,7 +102,8 @@ void CACMinFire::reset_vectors()
 int CACMinFire::iterate(int maxiter)
 {
   bigint ntimestep;
-  double vmax,vdotf,vdotfall,vdotv,vdotvall,fdotf,fdotfall;
+  double vmax,vdotfall,vdotvall,fdotfall;
+  double dots[3],dotsall[3];
   double scale1,scale2;
   double dtvone,dtv,dtf,dtfm;
   int i, flag,flagall;
@@ -116,6 +119,11 @@ int CACMinFire::iterate(int maxiter)
 
   alpha_final = 0.0;
 
+  // v dot f, v dot v and f dot f of the current state
+  // computed once per force evaluation and reused by the next iteration
+
+  vector_dots(dots,dotsall);
+
   for (int iter = 0; iter < maxiter; iter++) {
 
     if (timer->check_timeout(niter))
@@ -124,24 +132,22 @@ int CACMinFire::iterate(int maxiter)
     ntimestep = ++update->ntimestep;
     niter++;
 
-    // vdotfall = v dot f
-
     double *f = atom->min_f;
     double *v = atom->min_v;
     nvec=atom->dense_count;
 
-    vdotf = 0.0;
-    for (i = 0; i < nvec; i+=3) {
-      vdotf += v[i]*f[i] + v[i+1]*f[i+1] + v[i+2]*f[i+2];
-    }
-    MPI_Allreduce(&vdotf,&vdotfall,1,MPI_DOUBLE,MPI_SUM,world);
-
-    // sum vdotf over replicas, if necessary
+    // sum over replicas, if necessary
     // this communicator would be invalid for multiprocess replicas
 
     if (update->multireplica == 1) {
-      vdotf = vdotfall;
-      MPI_Allreduce(&vdotf,&vdotfall,1,MPI_DOUBLE,MPI_SUM,universe->uworld);
+      MPI_Allreduce(dotsall,dots,3,MPI_DOUBLE,MPI_SUM,universe->uworld);
+      vdotfall = dots[0];
+      vdotvall = dots[1];
+      fdotfall = dots[2];
+    } else {
+      vdotfall = dotsall[0];
+      vdotvall = dotsall[1];
+      fdotfall = dotsall[2];
     }
 
     // if (v dot f) > 0:
@@ -149,43 +155,19 @@ int CACMinFire::iterate(int maxiter)
     // |v| = length of v, Fhat = unit f
     // if more than DELAYSTEP since v dot f was negative:
     // increase timestep and decrease alpha
+    // the max velocity component for the timestep limit is found on the fly
 
+    vmax = 0.0;
     if (vdotfall > 0.0) {
-      vdotv = 0.0;
-      for (i = 0; i < nvec; i+=3) {
-        vdotv += v[i]*v[i] + v[i+1]*v[i+1] + v[i+2]*v[i+2];
-      }
-      MPI_Allreduce(&vdotv,&vdotvall,1,MPI_DOUBLE,MPI_SUM,world);
-
-      // sum vdotv over replicas, if necessary
-      // this communicator would be invalid for multiprocess replicas
-
-      if (update->multireplica == 1) {
-        vdotv = vdotvall;
-        MPI_Allreduce(&vdotv,&vdotvall,1,MPI_DOUBLE,MPI_SUM,universe->uworld);
-      }
-
-      fdotf = 0.0;
-      for (i = 0; i < nvec; i+=3) {
-        fdotf += f[i]*f[i] + f[i+1]*f[i+1] + f[i+2]*f[i+2];
-      }
-      MPI_Allreduce(&fdotf,&fdotfall,1,MPI_DOUBLE,MPI_SUM,world);
-
-      // sum fdotf over replicas, if necessary
-      // this communicator would be invalid for multiprocess replicas
-
-      if (update->multireplica == 1) {
-        fdotf = fdotfall;
-        MPI_Allreduce(&fdotf,&fdotfall,1,MPI_DOUBLE,MPI_SUM,universe->uworld);
-      }
-
       scale1 = 1.0 - alpha;
       if (fdotfall == 0.0) scale2 = 0.0;
       else scale2 = alpha * sqrt(vdotvall/fdotfall);
-      for (i = 0; i < nvec; i+=3) {
-        v[i] =  scale1*v[i] + scale2*f[i];
-        v[i+1] =  scale1*v[i+1] + scale2*f[i+1];
-        v[i+2] =  scale1*v[i+2] + scale2*f[i+2];
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(max:vmax)
+#endif
+      for (i = 0; i < nvec; i++) {
+        v[i] = scale1*v[i] + scale2*f[i];
+        vmax = MAX(vmax,fabs(v[i]));
       }
 
       if (ntimestep - last_negative > DELAYSTEP) {
@@ -200,9 +182,7 @@ int CACMinFire::iterate(int maxiter)
       last_negative = ntimestep;
       dt *= DT_SHRINK;
       alpha = ALPHA0;
-      for (i = 0; i < nvec; i+=3) {
-        v[i] =  v[i+1] = v[i+2] = 0.0;
-      }
+      if (nvec) memset(v,0,nvec*sizeof(double));
     }
 
     // limit timestep so no particle moves further than dmax
@@ -212,12 +192,7 @@ int CACMinFire::iterate(int maxiter)
     int *type = atom->type;
 
     dtvone = dt;
-
-    for (int i = 0; i < nvec; i+=3) {
-      vmax = MAX(fabs(v[i]),fabs(v[i+1]));
-      vmax = MAX(vmax,fabs(v[i+2]));
-      if (dtvone*vmax > dmax) dtvone = dmax/vmax;
-    }
+    if (dtvone*vmax > dmax) dtvone = dmax/vmax;
     MPI_Allreduce(&dtvone,&dtv,1,MPI_DOUBLE,MPI_MIN,world);
 
     // min dtv over replicas, if necessary
@@ -247,21 +222,21 @@ int CACMinFire::iterate(int maxiter)
         int *element_type = atom->element_type;
         int **node_types = atom->node_types;
         int *npoly = atom->poly_count;
-        // nodal loops required to get mass
+        // nodal loops required to get mass; the nodes of one poly
+        // share it and form a contiguous stretch of the flat vectors
         for(int element_counter=0; element_counter < atom->nlocal; element_counter++) {
+          int nstretch = 3*nodes_per_element_list[element_type[element_counter]];
           for (int poly_counter = 0; poly_counter < npoly[element_counter]; poly_counter++) {
             dtfm = dtf / mass[node_types[element_counter][poly_counter]];
-            for(int node_counter=0; node_counter < nodes_per_element_list[element_type[element_counter]]; node_counter++){
-
-              x[dense+0] += dtv * v[dense+0];
-              x[dense+1] += dtv * v[dense+1];
-              x[dense+2] += dtv * v[dense+2];
-              v[dense+0] += dtfm * f[dense+0];
-              v[dense+1] += dtfm * f[dense+1];
-              v[dense+2] += dtfm * f[dense+2];
-
-              dense+=3;
+            double *xs = &x[dense], *vs = &v[dense], *fs = &f[dense];
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+            for (int k = 0; k < nstretch; k++) {
+              xs[k] += dtv * vs[k];
+              vs[k] += dtfm * fs[k];
             }
+            dense += nstretch;
           }
         }
     }
@@ -270,6 +245,7 @@ int CACMinFire::iterate(int maxiter)
     eprevious = ecurrent;
     ecurrent = energy_force(0);
     neval++;
+    vector_dots(dots,dotsall);
 
     // energy tolerance criterion
     // only check after DELAYSTEP elapsed since velocties reset to 0
@@ -294,7 +270,7 @@ int CACMinFire::iterate(int maxiter)
     // sync across replicas if running multi-replica minimization
 
     if (update->ftol > 0.0) {
-      fdotf = fnorm_sqr();
+      double fdotf = fnorm_sqr();
       if (update->multireplica == 0) {
         if (fdotf < update->ftol*update->ftol) return FTOL;
       } else {
@@ -317,6 +293,30 @@ int CACMinFire::iterate(int maxiter)
   return MAXITER;
 }
 
+/* ----------------------------------------------------------------------
+   v dot f, v dot v and f dot f of the nodal dof in one pass
+   dots = local sums, dotsall = sums over this replica
+------------------------------------------------------------------------- */
+
+void CACMinFire::vector_dots(double *dots, double *dotsall)
+{
+  double *f = atom->min_f;
+  double *v = atom->min_v;
+  double vf = 0.0, vv = 0.0, ff = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for simd num_threads(comm->nthreads) if(nvec > CAC_MIN_OMP_MINDOF) reduction(+:vf,vv,ff)
+#endif
+  for (int i = 0; i < nvec; i++) {
+    vf += v[i]*f[i];
+    vv += v[i]*v[i];
+    ff += f[i]*f[i];
+  }
+  dots[0] = vf;
+  dots[1] = vv;
+  dots[2] = ff;
+  MPI_Allreduce(dots,dotsall,3,MPI_DOUBLE,MPI_SUM,world);
+}
+
 
 /* ----------------------------------------------------------------------
    copy dense arrays to atomvec arrays for energy_force evaluation
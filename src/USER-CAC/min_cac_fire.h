@@ -36,6 +36,7 @@ class CACMinFire : public CACMin {
 
   virtual void copy_vectors();
   virtual void copy_force();
+  void vector_dots(double *, double *);
  private:
   double dt,dtmax;
   double alpha;
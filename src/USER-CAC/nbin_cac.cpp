@@ -46,6 +46,17 @@ NBinCAC::NBinCAC(LAMMPS *lmp) : NBin(lmp) {
   max_bin_expansion_count=0;
   nmax=0;
   max_nall=0;
+  coarse_flag=0;
+  coarse_factor=1;
+  mcbinx=mcbiny=mcbinz=0;
+  coarse_ncontent=NULL;
+  coarse_content=NULL;
+  coarse_max=NULL;
+  coarse_limits=NULL;
+  fine_limits=NULL;
+  coarse_binned=NULL;
+  maxcbin=0;
+  max_coarse_nall=0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -61,6 +72,14 @@ NBinCAC::~NBinCAC() {
   for(int i=0 ; i<max_nall; i++)
   memory->destroy(bin_element_overlap[i]);
   memory->sfree(bin_element_overlap);
+  for(int i=0 ; i<maxcbin; i++)
+  memory->destroy(coarse_content[i]);
+  memory->sfree(coarse_content);
+  memory->destroy(coarse_ncontent);
+  memory->destroy(coarse_max);
+  memory->destroy(coarse_limits);
+  memory->destroy(fine_limits);
+  memory->destroy(coarse_binned);
 }
 
 /* ----------------------------------------------------------------------
@@ -424,6 +443,10 @@ void NBinCAC::bin_atoms()
   int current_bin;
   CAC_setup_bins(0);
   CAC_bin_atoms_setup(atom->nlocal+atom->nghost);
+  //hierarchical binning registers large elements in a coarse grid only;
+  //not used when binning foreign element boxes for the CAC comm style
+  coarse_flag = atom->cac_bin_hierarchical && !atom->bin_foreign;
+  if(coarse_flag) setup_coarse_bins();
   //initialize bin counts
   for(int init=0; init<maxbin; init++)
   bin_ncontent[init]=0;
@@ -438,6 +461,7 @@ void NBinCAC::bin_atoms()
       ibin = element2bins(i);
       if(element_type[i]!=0) rboundingbox2bins(i);
       atom2bin[i] = ibin;
+      if(coarse_flag && coarse_bin_entity(i,ibin)) continue;
       if(element_type[i]==0){
         if(!atom->bin_foreign){
           current_bin_ncount=bin_ncontent[ibin];
@@ -488,6 +512,7 @@ void NBinCAC::bin_atoms()
       ibin = element2bins(i);
       if(element_type[i]!=0) rboundingbox2bins(i);
       atom2bin[i] = ibin;
+      if(coarse_flag && coarse_bin_entity(i,ibin)) continue;
       if(element_type[i]==0){
         if(!atom->bin_foreign){
           current_bin_ncount=bin_ncontent[ibin];
@@ -543,6 +568,7 @@ void NBinCAC::bin_atoms()
       if(element_type[i]!=0) rboundingbox2bins(i);
       if(ibin<0) error->one(FLERR," negative bin index");
       if(ibin>=mbins) error->one(FLERR," excessive bin index");
+      if(coarse_flag && coarse_bin_entity(i,ibin)) continue;
       if(element_type[i]==0){
         if(!atom->bin_foreign){
           current_bin_ncount=bin_ncontent[ibin];
@@ -909,6 +935,89 @@ max_nall=size;
 }
 }
 
+/* ----------------------------------------------------------------------
+   size the coarse grid of hierarchical binning; each coarse bin holds
+   coarse_factor^3 fine bins
+------------------------------------------------------------------------- */
+
+void NBinCAC::setup_coarse_bins()
+{
+  int nall = atom->nlocal + atom->nghost;
+  coarse_factor = atom->cac_bin_coarse_factor;
+  mcbinx = (mbinx-1)/coarse_factor + 1;
+  mcbiny = (mbiny-1)/coarse_factor + 1;
+  mcbinz = (mbinz-1)/coarse_factor + 1;
+
+  int ncbins = mcbinx*mcbiny*mcbinz;
+  if (ncbins > maxcbin) {
+    coarse_content = (int **) memory->srealloc(coarse_content,ncbins*sizeof(int *),"bin_CAC:coarse_content");
+    memory->grow(coarse_ncontent,ncbins,"bin_CAC:coarse_ncontent");
+    memory->grow(coarse_max,ncbins,"bin_CAC:coarse_max");
+    for (int init = maxcbin; init < ncbins; init++) {
+      coarse_max[init] = MAXBINCONTENT;
+      memory->create(coarse_content[init],MAXBINCONTENT,"bin_CAC:coarse_content");
+    }
+    maxcbin = ncbins;
+  }
+  for (int init = 0; init < ncbins; init++)
+    coarse_ncontent[init] = 0;
+
+  if (nall > max_coarse_nall) {
+    max_coarse_nall = nall;
+    memory->grow(coarse_limits,max_coarse_nall,6,"bin_CAC:coarse_limits");
+    memory->grow(fine_limits,max_coarse_nall,6,"bin_CAC:fine_limits");
+    memory->grow(coarse_binned,max_coarse_nall,"bin_CAC:coarse_binned");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   record the coarse bins spanned by atom or element i in fine bin ibin;
+   elements overlapping more fine bins than a coarse bin holds are only
+   registered in the coarse grid and keep the fine bin limits of their
+   reduced box instead of an overlap array
+   return 1 if element i was binned in the coarse grid
+------------------------------------------------------------------------- */
+
+int NBinCAC::coarse_bin_entity(int i, int ibin)
+{
+  int *climits = coarse_limits[i];
+  int mbinlo[3] = {mbinxlo, mbinylo, mbinzlo};
+  coarse_binned[i] = 0;
+
+  if (atom->element_type[i] == 0) {
+    climits[0] = climits[3] = (ibin % mbinx)/coarse_factor;
+    climits[1] = climits[4] = (ibin/mbinx % mbiny)/coarse_factor;
+    climits[2] = climits[5] = (ibin/(mbinx*mbiny))/coarse_factor;
+    return 0;
+  }
+
+  int nfine = 1;
+  for (int dim = 0; dim < 3; dim++) {
+    climits[dim] = (bin_overlap_limits[dim]-mbinlo[dim])/coarse_factor;
+    climits[3+dim] = (bin_overlap_limits[3+dim]-mbinlo[dim])/coarse_factor;
+    nfine *= bin_overlap_limits[3+dim] - bin_overlap_limits[dim] + 1;
+  }
+  if (nfine <= coarse_factor*coarse_factor*coarse_factor) return 0;
+
+  coarse_binned[i] = 1;
+  for (int dim = 0; dim < 3; dim++) {
+    fine_limits[i][dim] = MAX(bin_overlap_limits[dim],rbin_overlap_limits[dim]);
+    fine_limits[i][3+dim] = MIN(bin_overlap_limits[3+dim],rbin_overlap_limits[3+dim]);
+  }
+
+  for (int cz = climits[2]; cz <= climits[5]; cz++)
+    for (int cy = climits[1]; cy <= climits[4]; cy++)
+      for (int cx = climits[0]; cx <= climits[3]; cx++) {
+        int cbin = (cz*mcbiny + cy)*mcbinx + cx;
+        if (coarse_ncontent[cbin] == coarse_max[cbin]) {
+          coarse_max[cbin] += EXPAND;
+          memory->grow(coarse_content[cbin],coarse_max[cbin],"bin_CAC:coarse_content");
+        }
+        coarse_content[cbin][coarse_ncontent[cbin]++] = i;
+      }
+  return 1;
+}
+
 /* ----------------------------------------------------------------------
    convert quadrature point coordinate into local bin #
    for orthogonal, only ghost atoms will have coord >= bboxhi or coord < bboxlo
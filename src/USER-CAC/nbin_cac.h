@@ -46,6 +46,9 @@ class NBinCAC : public NBin {
   int max_nall;                  //upper bound on number of local + ghost atoms that have been encountered
   int *max_nbin_overlap;         //upper bound on how many bins an element has overlapped
   int foreign_boxes;
+  int maxcbin;                   //number of coarse bins allocated
+  int *coarse_max;               //capacity of each coarse bin
+  int max_coarse_nall;           //number of local + ghost atoms coarse bin limits are allocated for
   virtual int coord2bin(double *);
   virtual int element2bins(int element_index);
   virtual void rboundingbox2bins(int element_index);
@@ -55,6 +58,8 @@ class NBinCAC : public NBin {
   void allocate_surface_counts();
   void quadrature_init(int degree);
   void expand_overlap_arrays(int size);
+  void setup_coarse_bins();
+  int coarse_bin_entity(int, int);
   void compute_surface_depths(double &x, double &y, double &z,
 	  int &xb, int &yb, int &zb, int flag);
   double shape_function(double, double, double, int, int);
@@ -12,6 +12,7 @@
 ------------------------------------------------------------------------- */
 
 #include <cmath> 
+#include <cstring>
 #include "npair_cac.h"
 #include "neighbor.h"
 #include "neigh_list.h"
@@ -30,6 +31,9 @@
 #define MAXNEIGH  10
 #define EXPAND 50
 #define MAXBIN 100000
+#define MAXPROJITER 20
+#define PROJTOL 1.0e-10
+#define QUADORDERMAX 3 //highest Gauss-Legendre order selectable per element
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
@@ -44,6 +48,9 @@ NPairCAC::NPairCAC(LAMMPS *lmp) : NPair(lmp) {
   bin_scan_flags = NULL;
   bins_searched = NULL;
   interface_flags = NULL;
+  quad_orders = NULL;
+  quad_rule_weights = quad_rule_abcissae = NULL;
+  quadrature_weights = quadrature_abcissae = NULL;
   quadrature_point_data = NULL;
   quadrature_counts = NULL;
   e2quad_index = NULL;
@@ -56,6 +63,12 @@ NPairCAC::NPairCAC(LAMMPS *lmp) : NPair(lmp) {
   maxbins_searched = 0;
   nbins_searched = 0;
   nmax = 0;
+  quad_ref_flag = quad_ref_nlocal = quad_ref_nall = 0;
+  quad_ref_max = quad_ref_pos_max = quad_ref_rows_max = 0;
+  quad_ref_tags = NULL;
+  quad_ref_counts = quad_ref_poly = quad_ref_offset = NULL;
+  quad_moved = quad_dirty = NULL;
+  quad_ref_positions = quad_ref_rows = NULL;
 
   surface_counts_max[0] = 1;
   surface_counts_max[1] = 1;
@@ -65,6 +78,8 @@ NPairCAC::NPairCAC(LAMMPS *lmp) : NPair(lmp) {
   surface_counts_max_old[2] = 1;
   //instance asa interface object
   asa_pointer = new Asa_Data(lmp, this);
+  timing_flag = 0;
+  surface_time = surface_iterations = 0.0;
   atom->npair_cac = this;
 
   //initiate arrays used in the neighbor_accumulate function
@@ -142,6 +157,23 @@ NPairCAC::~NPairCAC()
   memory->destroy(bin_scan_flags);
   memory->destroy(bins_searched);
   memory->destroy(interface_flags);
+  memory->destroy(quad_orders);
+  if(quad_rule_weights){
+    for (int order = 1; order <= QUADORDERMAX; order++) {
+      memory->destroy(quad_rule_weights[order]);
+      memory->destroy(quad_rule_abcissae[order]);
+    }
+    memory->sfree(quad_rule_weights);
+    memory->sfree(quad_rule_abcissae);
+  }
+  memory->destroy(quad_ref_tags);
+  memory->destroy(quad_ref_counts);
+  memory->destroy(quad_ref_poly);
+  memory->destroy(quad_ref_offset);
+  memory->destroy(quad_moved);
+  memory->destroy(quad_dirty);
+  memory->destroy(quad_ref_positions);
+  memory->destroy(quad_ref_rows);
   if (neigh_allocated) {
   for (int init = 0; init < max_atom_count; init++)
     memory->destroy(list_container[init]);	
@@ -219,6 +251,13 @@ void NPairCAC::build(NeighList *list)
   int nsum = atom->nlocal;
   int *nodes_per_element_list = atom->nodes_per_element_list;
   int nodes_per_element;
+  double stage_start = 0.0, stage_end, asa_iterations = 0.0;
+  timing_flag = atom->cac_timing_flag;
+  if (timing_flag) {
+    stage_start = MPI_Wtime();
+    surface_time = surface_iterations = 0.0;
+    if (asa_pointer) asa_iterations = asa_pointer->iterations;
+  }
   cac_flux_flag = atom->cac_flux_flag;
   double cutoff_skin = neighbor->skin;
   outer_neigh_flag = atom->outer_neigh_flag;
@@ -239,6 +278,7 @@ void NPairCAC::build(NeighList *list)
   memory->grow(scan_flags,atom->nlocal + atom->nghost,"scan_flags");
   memory->grow(bin_scan_flags,mbins,"bin_scan_flags");
   memory->grow(interface_flags,nsum,"interface_flags");
+  memory->grow(quad_orders,nsum,"quad_orders");
 
   //initialize scan flags to 0
   for (int init=0; init < atom->nlocal + atom->nghost; init++){
@@ -268,70 +308,32 @@ void NPairCAC::build(NeighList *list)
   //loop over quadrature points of elements, by convention an atom is one quadrature point
   neigh_count = 0;
   nbins_searched = 0;
-  //debug check for instability
-  if(nbin_element_overlap[i] > MAXBIN) error->one(FLERR," too many bin overlaps for one element; simulation may be unstable");
-  for(int ocount=0; ocount < nbin_element_overlap[i]; ocount++){
-    ibin = bin_element_overlap[i][ocount];
-  for (k = 0; k < nstencil; k++) {
-    if(bin_scan_flags[ibin + stencil[k]]) continue;
-    if(ibin + stencil[k]<0) error->one(FLERR," negative bin index");
-    if(ibin + stencil[k]>=mbins) error->one(FLERR," excessive bin index");
-    if(nbins_searched==maxbins_searched){
-      maxbins_searched+=EXPAND;
-      memory->grow(bins_searched, maxbins_searched, "NPairCAC:bins_searched");
-    }
-    bin_scan_flags[ibin + stencil[k]] = 1;
-    bins_searched[nbins_searched++] = ibin+stencil[k];
-
-    for (int jj = 0; jj < bin_ncontent[ibin + stencil[k]]; jj++) {
-      j = bin_content[ibin + stencil[k]][jj];
-      neighbor_element_type = element_type[j];
-      if (i == j) continue;
-      //checks for a possible repeat element in this neighbor list
-      if(neighbor_element_type!=0)
-        if(scan_flags[j]) continue;
-        
-      jtype = type[j];
-      
-      if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
-      
-      //check if array is large enough; allocate more if needed
-      if (neigh_count == list_maxes[i]) {
-          list_maxes[i] += EXPAND;
-          memory->grow(list_container[i], list_maxes[i], "NPair CAC:list_container");
-      }
-      
-      if (neighbor_element_type != 0||current_element_type != 0) {
-      if(neighbor_element_type != 0 && current_element_type != 0){
-        if(CAC_decide_element2element(i,j)){
-        scan_flags[j]=1;
-        list_container[i][neigh_count++] = j;
-        }
-      }
-      else if(neighbor_element_type != 0){
-        if(CAC_decide_element2element(j,i)){
-        scan_flags[j]=1;
-        list_container[i][neigh_count++] = j;
-        }
-      }
-      else{
-        if(CAC_decide_element2element(i,j))
-        list_container[i][neigh_count++] = j;
-      }
-      }
-      else{
-      delx = x[i][0] - x[j][0];
-      dely = x[i][1] - x[j][1];
-      delz = x[i][2] - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-        if (rsq <= cutneighmax*cutneighmax)
-        list_container[i][neigh_count++] = j;
-      }
-  }   
+  //elements binned in the coarse grid scan the fine bins of their reduced box from its limits
+  if(coarse_flag && coarse_binned[i]){
+    int *flimits = fine_limits[i];
+    //debug check for instability; coarse binned elements keep no overlap count
+    bigint nfine = (bigint) (flimits[3]-flimits[0]+1)*(flimits[4]-flimits[1]+1)*(flimits[5]-flimits[2]+1);
+    if(nfine > MAXBIN) error->one(FLERR," too many bin overlaps for one element; simulation may be unstable");
+    for(int overlapz = flimits[2]; overlapz <= flimits[5]; overlapz++)
+      for(int overlapy = flimits[1]; overlapy <= flimits[4]; overlapy++)
+        for(int overlapx = flimits[0]; overlapx <= flimits[3]; overlapx++)
+          scan_stencil(i, (overlapz-mbinzlo)*mbiny*mbinx + (overlapy-mbinylo)*mbinx + (overlapx-mbinxlo));
   }
-  //reset bin scan flags
-  for(int reset = 0; reset < nbins_searched; reset++)
-  bin_scan_flags[bins_searched[reset]] = 0;
+  else{
+    //debug check for instability
+    if(nbin_element_overlap[i] > MAXBIN) error->one(FLERR," too many bin overlaps for one element; simulation may be unstable");
+    for(int ocount=0; ocount < nbin_element_overlap[i]; ocount++)
+      scan_stencil(i, bin_element_overlap[i][ocount]);
+  }
+  //large elements are found in the coarse bins spanned by this bounding box
+  if(coarse_flag){
+    int *climits = coarse_limits[i];
+    for(int cz = climits[2]; cz <= climits[5]; cz++)
+      for(int cy = climits[1]; cy <= climits[4]; cy++)
+        for(int cx = climits[0]; cx <= climits[3]; cx++){
+          int cbin = (cz*mcbiny + cy)*mcbinx + cx;
+          scan_bin(i, coarse_content[cbin], coarse_ncontent[cbin]);
+        }
   }
   numneigh[i] = neigh_count;
   
@@ -342,6 +344,12 @@ void NPairCAC::build(NeighList *list)
   
   }
 
+  if (timing_flag) {
+    stage_end = MPI_Wtime();
+    atom->cac_times[Atom::CAC_TIME_ELIST] += stage_end - stage_start;
+    stage_start = stage_end;
+  }
+
   //determine which elements need more quadrature points due to interfacing with smaller resolutions
   if(atom->interface_quadrature){
     for (i = 0; i < nlocal; i++) {
@@ -359,20 +367,17 @@ void NPairCAC::build(NeighList *list)
     }
   }
 
-  //communicate interface flags for ghosts if ghost quadrature points are defined
+  //select the quadrature order of each element from its deformation gradient
+  for (i = 0; i < nlocal; i++)
+    quad_orders[i] = select_quad_order(i);
+
+  //communicate interface flags and quadrature orders for ghosts if ghost quadrature points are defined
   if(ghost_quad_flag)
   comm->forward_comm_npair(this,0);
   
   if (nsum > nmax) 
     allocate_local_arrays();
 
-  //initialize the neighbor weights used to balance procs to 0
-  for (i = 0; i < nsum; i++){  
-    neighbor_weights[i][0]=0;
-    neighbor_weights[i][1]=0;
-    neighbor_weights[i][2]=0;
-  }
-
   //compute surface counts for quadrature neighbor list allocation
   // initialize or grow surface counts array for quadrature scheme
   // along with interior scaling for the quadrature domain
@@ -420,7 +425,27 @@ void NPairCAC::build(NeighList *list)
   }
   quadrature_poly_count = pqi;
   atom->max_quad_per_element = max_quad_per_element;
-  allocate_quad_neigh_list();
+
+  //in incremental mode keep the quadrature lists of the last build for elements
+  //that, along with their neighbors, moved less than half the skin since then
+  int reuse = 0;
+  if (atom->quad_neigh_incremental) reuse = check_quad_reuse(nsum, numneigh);
+
+  if (!reuse) {
+    allocate_quad_neigh_list();
+    //initialize the neighbor weights used to balance procs to 0
+    for (i = 0; i < nsum; i++){  
+      neighbor_weights[i][0]=0;
+      neighbor_weights[i][1]=0;
+      neighbor_weights[i][2]=0;
+    }
+  }
+
+  if (timing_flag) {
+    stage_end = MPI_Wtime();
+    atom->cac_times[Atom::CAC_TIME_QPOINTS] += stage_end - stage_start;
+    stage_start = stage_end;
+  }
 
   /*compute quadrature point virtual atom list in several steps; first bin the quadrature point, search the stencil
   around it for atoms and elements, find virtual atoms on each neighboring element using asa cg*/
@@ -433,6 +458,23 @@ void NPairCAC::build(NeighList *list)
   current_element_type = element_type[i];
   nodes_per_element = nodes_per_element_list[current_element_type];
 
+  //retained lists and weights are left untouched; rebuilt ones start empty
+  if (reuse) {
+    if (!quad_dirty[i]) {
+      qi += quadrature_counts[i];
+      pqi += quadrature_counts[i]*poly_count[i];
+      continue;
+    }
+    for (int ipq = pqi; ipq < pqi + quadrature_counts[i]*poly_count[i]; ipq++) {
+      inner_quad_lists_counts[ipq] = 0;
+      if (outer_neigh_flag) outer_quad_lists_counts[ipq] = 0;
+      if (add_neigh_flag) add_quad_lists_counts[ipq] = 0;
+    }
+    neighbor_weights[i][0] = 0;
+    neighbor_weights[i][1] = 0;
+    neighbor_weights[i][2] = 0;
+  }
+
   // loop over all atoms in surrounding bins in stencil including self
   // skip i = j
   //loop over quadrature points of elements, by convention an atom is one quadrature point
@@ -506,6 +548,27 @@ void NPairCAC::build(NeighList *list)
     }
   }
 
+  //large elements are found in the coarse bin holding the quadrature point
+  if(coarse_flag){
+    int cbin = coarse_bin(ibin);
+    for (int jj = 0; jj < coarse_ncontent[cbin]; jj++) {
+      j = coarse_content[cbin][jj];
+      if (i == j) continue;
+      if(scan_flags[j]) continue;
+      jtype = type[j];
+      if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+      if (neigh_count == quad_scan_list_max) {
+          quad_scan_list_max += EXPAND;
+          memory->grow(current_quad_list,
+          quad_scan_list_max, "NPair CAC:current_quad_list");
+      }
+      if(CAC_decide_quad2element(quad_position,j)){
+        scan_flags[j]=1;
+        current_quad_list[neigh_count++] = j;
+      }
+    }
+  }
+
   //use the current quad list to construct the virtual atom list with asa cg and local unit cell scans
   quad_list_build(i,quadrature_point_data[qi][0],quadrature_point_data[qi][1],quadrature_point_data[qi][2]);
 
@@ -518,7 +581,120 @@ void NPairCAC::build(NeighList *list)
 qi++;
 }
 }
-memory->destroy(quadrature_abcissae);
+if (atom->quad_neigh_incremental && !reuse) store_quad_reference(nsum);
+
+  //the surface searches are reported apart from the rest of the list construction
+  if (timing_flag) {
+    atom->cac_times[Atom::CAC_TIME_QLISTS] += MPI_Wtime() - stage_start - surface_time;
+    atom->cac_times[Atom::CAC_TIME_SURF] += surface_time;
+    double *counts = atom->cac_counts;
+    counts[Atom::CAC_COUNT_BUILD] += 1.0;
+    counts[Atom::CAC_COUNT_QUAD] += pqi;
+    for (int ipq = 0; ipq < pqi; ipq++) {
+      counts[Atom::CAC_COUNT_NEIGH] += inner_quad_lists_counts[ipq];
+      if (outer_neigh_flag) counts[Atom::CAC_COUNT_NEIGH] += outer_quad_lists_counts[ipq];
+    }
+    if (atom->asa_surface_search) surface_iterations = asa_pointer->iterations - asa_iterations;
+    counts[Atom::CAC_COUNT_SURF] += surface_iterations;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   scan the stencil around fine bin ibin for neighbors of atom or element i
+------------------------------------------------------------------------- */
+
+void NPairCAC::scan_stencil(int i, int ibin)
+{
+  for (int k = 0; k < nstencil; k++) {
+    if(bin_scan_flags[ibin + stencil[k]]) continue;
+    if(ibin + stencil[k]<0) error->one(FLERR," negative bin index");
+    if(ibin + stencil[k]>=mbins) error->one(FLERR," excessive bin index");
+    if(nbins_searched==maxbins_searched){
+      maxbins_searched+=EXPAND;
+      memory->grow(bins_searched, maxbins_searched, "NPairCAC:bins_searched");
+    }
+    bin_scan_flags[ibin + stencil[k]] = 1;
+    bins_searched[nbins_searched++] = ibin+stencil[k];
+    scan_bin(i, bin_content[ibin + stencil[k]], bin_ncontent[ibin + stencil[k]]);
+  }
+  //reset bin scan flags
+  for(int reset = 0; reset < nbins_searched; reset++)
+  bin_scan_flags[bins_searched[reset]] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   add the atoms and elements of one bin that neighbor atom or element i
+------------------------------------------------------------------------- */
+
+void NPairCAC::scan_bin(int i, int *content, int ncontent)
+{
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *molecule = atom->molecule;
+  int *element_type = atom->element_type;
+  int itype = type[i];
+  int current_element_type = element_type[i];
+  int j, jtype, neighbor_element_type;
+  double delx, dely, delz, rsq;
+
+  for (int jj = 0; jj < ncontent; jj++) {
+      j = content[jj];
+      neighbor_element_type = element_type[j];
+      if (i == j) continue;
+      //checks for a possible repeat element in this neighbor list
+      if(neighbor_element_type!=0)
+        if(scan_flags[j]) continue;
+        
+      jtype = type[j];
+      
+      if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+      
+      //check if array is large enough; allocate more if needed
+      if (neigh_count == list_maxes[i]) {
+          list_maxes[i] += EXPAND;
+          memory->grow(list_container[i], list_maxes[i], "NPair CAC:list_container");
+      }
+      
+      if (neighbor_element_type != 0||current_element_type != 0) {
+      if(neighbor_element_type != 0 && current_element_type != 0){
+        if(CAC_decide_element2element(i,j)){
+        scan_flags[j]=1;
+        list_container[i][neigh_count++] = j;
+        }
+      }
+      else if(neighbor_element_type != 0){
+        if(CAC_decide_element2element(j,i)){
+        scan_flags[j]=1;
+        list_container[i][neigh_count++] = j;
+        }
+      }
+      else{
+        if(CAC_decide_element2element(i,j))
+        list_container[i][neigh_count++] = j;
+      }
+      }
+      else{
+      delx = x[i][0] - x[j][0];
+      dely = x[i][1] - x[j][1];
+      delz = x[i][2] - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+        if (rsq <= cutneighmax*cutneighmax)
+        list_container[i][neigh_count++] = j;
+      }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   coarse bin holding the fine bin ibin in hierarchical binning
+------------------------------------------------------------------------- */
+
+int NPairCAC::coarse_bin(int ibin)
+{
+  int cx = (ibin % mbinx)/coarse_factor;
+  int cy = (ibin/mbinx % mbiny)/coarse_factor;
+  int cz = (ibin/(mbinx*mbiny))/coarse_factor;
+  return (cz*mcbiny + cy)*mcbinx + cx;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -952,6 +1128,13 @@ void NPairCAC::neighbor_accumulate(double x,double y,double z,int iii,int inner_
   int outer_neigh_index = outer_neigh_initial;
   int add_neigh_index = add_neigh_initial;
   int neigh_poly_count;
+  int asa_surface_search = atom->asa_surface_search;
+  double search_cutsq;
+
+  if (outer_neigh_flag)
+    search_cutsq = (2*cut_global + cutoff_skin)*(2*cut_global + cutoff_skin);
+  else
+    search_cutsq = (cut_global + cutoff_skin)*(cut_global + cutoff_skin);
 
   //initialize quadrature position vector
   quad_r[0]=x;
@@ -1116,9 +1299,19 @@ void NPairCAC::neighbor_accumulate(double x,double y,double z,int iii,int inner_
           //loop minimum for every poly DOF to ensure minimum
           // run the minimization code
           for (poly_min = 0; poly_min < neigh_poly_count; poly_min++) {
-            flag = asa_pointer->call_asa_cg(xm, lo, hi, n, 
-              1.e-2*unit_cell_min, NULL, Work, iWork);
-              if(flag==7) check_flag = 1;
+            double surface_start = 0.0;
+            if (timing_flag) surface_start = MPI_Wtime();
+            if (asa_surface_search) {
+              flag = asa_pointer->call_asa_cg(xm, lo, hi, n, 
+                1.e-2*unit_cell_min, NULL, Work, iWork);
+                if(flag==7) check_flag = 1;
+            }
+            //closed form search; skip this poly if its surface is out of range
+            else if (!surface_projection(xm, search_cutsq)) {
+              if (timing_flag) surface_time += MPI_Wtime() - surface_start;
+              continue;
+            }
+            if (timing_flag) surface_time += MPI_Wtime() - surface_start;
 
             double tol = 0.00001*unit_cell_min;
             if (xm[0] > 1 + tol || xm[1] > 1 + tol || xm[0] < -1 - tol || xm[1] < -1 - tol) {
@@ -1651,6 +1844,151 @@ void NPairCAC::neighbor_accumulate(double x,double y,double z,int iii,int inner_
   }
 }
 
+/* ----------------------------------------------------------------------
+   closed form search for the point on the current Q8 element surface
+   (surf_select, poly_min) closest to quad_r; replaces the asa_cg surface
+   minimization. The surface at a fixed isoparametric coordinate is a
+   bilinear patch, so the interior stationary point is found with a Newton
+   iteration using its analytic Jacobian and the constrained minimum along
+   each patch edge is a linear projection. Returns 0 without setting xm if
+   the bounding box of the patch is farther than sqrt(cutsq) from quad_r.
+------------------------------------------------------------------------- */
+
+int NPairCAC::surface_projection(double *xm, double cutsq)
+{
+  double unit_cell_mapped[3], surf_args[3], corner[4][3];
+  double c0[3], c1[3], c2[3], c3[3], d[3], pu[3], pv[3], p[3];
+  double boxlo[3], boxhi[3], del, boxdistsq;
+  double guu, gvv, guv, gu, gv, det, du, dv, u, v;
+  double edge_u, edge_v, distsq, min_distsq;
+  double **nodes = neighbor_element_positions[poly_min];
+  int fixed_dim = surf_select[0] - 1;
+  int udim, vdim, converged;
+
+  unit_cell_mapped[0] = 2 / double(neighbor_element_scale[0]);
+  unit_cell_mapped[1] = 2 / double(neighbor_element_scale[1]);
+  unit_cell_mapped[2] = 2 / double(neighbor_element_scale[2]);
+
+  //free isoparametric coordinates in the same order used by the asa objective
+  if (fixed_dim == 0) { udim = 1; vdim = 2; }
+  else if (fixed_dim == 1) { udim = 0; vdim = 2; }
+  else { udim = 0; vdim = 1; }
+  surf_args[fixed_dim] = surf_select[1]*(1 - unit_cell_mapped[fixed_dim] / 2);
+
+  //patch corners in the order (-1,-1), (1,-1), (1,1), (-1,1)
+  for (int ic = 0; ic < 4; ic++) {
+    surf_args[udim] = (ic == 0 || ic == 3) ? -1 : 1;
+    surf_args[vdim] = (ic < 2) ? -1 : 1;
+    corner[ic][0] = corner[ic][1] = corner[ic][2] = 0;
+    for (int kk = 0; kk < neigh_nodes_per_element; kk++) {
+      double shape_func = shape_function(surf_args[0], surf_args[1], surf_args[2], 2, kk + 1);
+      corner[ic][0] += nodes[kk][0] * shape_func;
+      corner[ic][1] += nodes[kk][1] * shape_func;
+      corner[ic][2] += nodes[kk][2] * shape_func;
+    }
+  }
+
+  //the bilinear patch lies in the convex hull of its corners
+  boxdistsq = 0;
+  for (int dim = 0; dim < 3; dim++) {
+    boxlo[dim] = boxhi[dim] = corner[0][dim];
+    for (int ic = 1; ic < 4; ic++) {
+      if (corner[ic][dim] < boxlo[dim]) boxlo[dim] = corner[ic][dim];
+      if (corner[ic][dim] > boxhi[dim]) boxhi[dim] = corner[ic][dim];
+    }
+    if (quad_r[dim] < boxlo[dim]) del = boxlo[dim] - quad_r[dim];
+    else if (quad_r[dim] > boxhi[dim]) del = quad_r[dim] - boxhi[dim];
+    else del = 0;
+    boxdistsq += del*del;
+  }
+  if (boxdistsq >= cutsq) return 0;
+
+  //P(u,v) = c0 + c1*u + c2*v + c3*u*v
+  for (int dim = 0; dim < 3; dim++) {
+    c0[dim] = 0.25*(corner[0][dim] + corner[1][dim] + corner[2][dim] + corner[3][dim]);
+    c1[dim] = 0.25*(-corner[0][dim] + corner[1][dim] + corner[2][dim] - corner[3][dim]);
+    c2[dim] = 0.25*(-corner[0][dim] - corner[1][dim] + corner[2][dim] + corner[3][dim]);
+    c3[dim] = 0.25*(corner[0][dim] - corner[1][dim] + corner[2][dim] - corner[3][dim]);
+  }
+
+  //Newton iteration for the interior stationary point
+  u = v = 0;
+  converged = 0;
+  for (int iter = 0; iter < MAXPROJITER; iter++) {
+    surface_iterations += 1.0;
+    for (int dim = 0; dim < 3; dim++) {
+      pu[dim] = c1[dim] + c3[dim]*v;
+      pv[dim] = c2[dim] + c3[dim]*u;
+      d[dim] = c0[dim] + c1[dim]*u + c2[dim]*v + c3[dim]*u*v - quad_r[dim];
+    }
+    gu = d[0]*pu[0] + d[1]*pu[1] + d[2]*pu[2];
+    gv = d[0]*pv[0] + d[1]*pv[1] + d[2]*pv[2];
+    guu = pu[0]*pu[0] + pu[1]*pu[1] + pu[2]*pu[2];
+    gvv = pv[0]*pv[0] + pv[1]*pv[1] + pv[2]*pv[2];
+    guv = pu[0]*pv[0] + pu[1]*pv[1] + pu[2]*pv[2] + d[0]*c3[0] + d[1]*c3[1] + d[2]*c3[2];
+    det = guu*gvv - guv*guv;
+    //stop if the objective is not locally convex; the edges are searched below
+    if (det <= 0 || guu <= 0) break;
+    du = -(gvv*gu - guv*gv)/det;
+    dv = -(guu*gv - guv*gu)/det;
+    u += du;
+    v += dv;
+    if (u < -2 || u > 2 || v < -2 || v > 2) break;
+    if (fabs(du) + fabs(dv) < PROJTOL) {
+      converged = 1;
+      break;
+    }
+  }
+
+  min_distsq = -1;
+  if (converged && u >= -1 && u <= 1 && v >= -1 && v <= 1) {
+    for (int dim = 0; dim < 3; dim++)
+      p[dim] = c0[dim] + c1[dim]*u + c2[dim]*v + c3[dim]*u*v - quad_r[dim];
+    min_distsq = p[0]*p[0] + p[1]*p[1] + p[2]*p[2];
+    xm[0] = u;
+    xm[1] = v;
+  }
+
+  //the patch is linear along each edge; project onto the four edges
+  for (int iedge = 0; iedge < 4; iedge++) {
+    double e0[3], e1[3], e1sq = 0, proj = 0, lparam;
+    for (int dim = 0; dim < 3; dim++) {
+      if (iedge < 2) {
+        edge_v = (iedge == 0) ? -1 : 1;
+        e0[dim] = c0[dim] + c2[dim]*edge_v - quad_r[dim];
+        e1[dim] = c1[dim] + c3[dim]*edge_v;
+      } else {
+        edge_u = (iedge == 2) ? -1 : 1;
+        e0[dim] = c0[dim] + c1[dim]*edge_u - quad_r[dim];
+        e1[dim] = c2[dim] + c3[dim]*edge_u;
+      }
+      e1sq += e1[dim]*e1[dim];
+      proj += e0[dim]*e1[dim];
+    }
+    lparam = 0;
+    if (e1sq > 0) lparam = -proj/e1sq;
+    if (lparam < -1) lparam = -1;
+    if (lparam > 1) lparam = 1;
+    distsq = 0;
+    for (int dim = 0; dim < 3; dim++) {
+      del = e0[dim] + e1[dim]*lparam;
+      distsq += del*del;
+    }
+    if (min_distsq < 0 || distsq < min_distsq) {
+      min_distsq = distsq;
+      if (iedge < 2) {
+        xm[0] = lparam;
+        xm[1] = edge_v;
+      } else {
+        xm[0] = edge_u;
+        xm[1] = lparam;
+      }
+    }
+  }
+
+  return 1;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void NPairCAC::compute_surface_depths(double &scalex, double &scaley, double &scalez,
@@ -1739,35 +2077,79 @@ void NPairCAC::compute_surface_depths(double &scalex, double &scaley, double &sc
 
 void NPairCAC::quadrature_init(int quadrature_rank){
 
-  if(quadrature_rank==1){
-  atom->quadrature_node_count=quadrature_node_count=1;
-  memory->create(quadrature_weights,quadrature_node_count,"pairCAC:quadrature_weights");
-  memory->create(quadrature_abcissae,quadrature_node_count,"pairCAC:quadrature_abcissae");
-  quadrature_weights[0]=2;
-  quadrature_abcissae[0]=0;
-  }
-  if(quadrature_rank==2){
-  atom->quadrature_node_count=quadrature_node_count=2;
-  memory->create(quadrature_weights,quadrature_node_count,"pairCAC:quadrature_weights");
-  memory->create(quadrature_abcissae,quadrature_node_count,"pairCAC:quadrature_abcissae");
-  quadrature_weights[0]=1;
-  quadrature_weights[1]=1;
-  quadrature_abcissae[0]=-0.5773502691896258;
-  quadrature_abcissae[1]=0.5773502691896258;
-  }
-  if(quadrature_rank==3)
-  {
+  atom->quadrature_node_count=quadrature_node_count=quadrature_rank;
+  if(quad_rule_weights) return;
 
+  //Gauss-Legendre rules for every order an element may select; built once
+  quad_rule_weights = (double **) memory->smalloc(sizeof(double *)*(QUADORDERMAX+1),"pairCAC:quad_rule_weights");
+  quad_rule_abcissae = (double **) memory->smalloc(sizeof(double *)*(QUADORDERMAX+1),"pairCAC:quad_rule_abcissae");
+  quad_rule_weights[0] = quad_rule_abcissae[0] = NULL;
+  for (int order = 1; order <= QUADORDERMAX; order++) {
+    memory->create(quad_rule_weights[order],order,"pairCAC:quadrature_weights");
+    memory->create(quad_rule_abcissae[order],order,"pairCAC:quadrature_abcissae");
   }
-  if(quadrature_rank==4)
-  {
 
-  }
-  if(quadrature_rank==5)
-  {
+  quad_rule_weights[1][0]=2;
+  quad_rule_abcissae[1][0]=0;
+
+  quad_rule_weights[2][0]=1;
+  quad_rule_weights[2][1]=1;
+  quad_rule_abcissae[2][0]=-0.5773502691896258;
+  quad_rule_abcissae[2][1]=0.5773502691896258;
+
+  quad_rule_weights[3][0]=0.5555555555555556;
+  quad_rule_weights[3][1]=0.8888888888888888;
+  quad_rule_weights[3][2]=0.5555555555555556;
+  quad_rule_abcissae[3][0]=-0.7745966692414834;
+  quad_rule_abcissae[3][1]=0;
+  quad_rule_abcissae[3][2]=0.7745966692414834;
+
+}
+
+/* --------------------------------------------------------------------------
+   select the Gauss-Legendre order of an element from the variation of its
+   deformation gradient; the bilinear and trilinear modes of the nodal
+   positions are the part of the Q8 map whose gradient varies over the
+   element, so their magnitude relative to the linear modes measures how
+   far the element is from homogeneous deformation
+----------------------------------------------------------------------------- */
+
+int NPairCAC::select_quad_order(int element_index){
 
+  static const double node_signs[8][3] = {{-1,-1,-1},{1,-1,-1},{1,1,-1},{-1,1,-1},
+                                          {-1,-1,1},{1,-1,1},{1,1,1},{-1,1,1}};
+
+  if (!atom->quad_adapt_flag || atom->element_type[element_index] != 1)
+    return quadrature_node_count;
+
+  double ****nodal_positions = atom->nodal_positions;
+  int npoly = atom->poly_count[element_index];
+  double metric = 0;
+
+  for (int ipoly = 0; ipoly < npoly; ipoly++) {
+    double **nodes = nodal_positions[element_index][ipoly];
+    double modes[7][3];
+    for (int m = 0; m < 7; m++)
+      modes[m][0] = modes[m][1] = modes[m][2] = 0;
+    for (int k = 0; k < 8; k++) {
+      double s = node_signs[k][0], t = node_signs[k][1], w = node_signs[k][2];
+      double phi[7] = {s, t, w, s*t, s*w, t*w, s*t*w};
+      for (int m = 0; m < 7; m++)
+        for (int dim = 0; dim < 3; dim++)
+          modes[m][dim] += 0.125*phi[m]*nodes[k][dim];
+    }
+    double linear = 0, varying = 0;
+    for (int m = 0; m < 7; m++) {
+      double norm = modes[m][0]*modes[m][0] + modes[m][1]*modes[m][1] + modes[m][2]*modes[m][2];
+      if (m < 3) linear += norm;
+      else varying += norm;
+    }
+    if (linear > 0) metric = MAX(metric, sqrt(varying/linear));
   }
 
+  if (metric < atom->quad_adapt_low) return 1;
+  if (atom->quad_adapt_high >= 0 && metric > atom->quad_adapt_high) return QUADORDERMAX;
+  return 2;
 }
 
 /* --------------------------------------------------------------------------
@@ -1780,7 +2162,7 @@ int NPairCAC::compute_quad_points(int element_index){
   int **element_scale = atom->element_scale;
   int *element_type = atom->element_type;
   int *current_element_scale = atom->element_scale[element_index];
-  //int nodes_per_element;
+  int nodes_per_element;
   double coefficients;
   int signs, signt, signw;
   double **x = atom->x;
@@ -1803,6 +2185,14 @@ int NPairCAC::compute_quad_points(int element_index){
   s = t = w = 0;
   double sq, tq, wq;
   int neigh_quad_counter = 0;
+
+  //Gauss-Legendre rule selected for this element
+  int order = quad_orders[element_index];
+  int default_order = quadrature_node_count;
+  quadrature_node_count = order;
+  quadrature_weights = quad_rule_weights[order];
+  quadrature_abcissae = quad_rule_abcissae[order];
+
   //compute interior quadrature point virtual neighbor lists
   if(quadrature_point_max==0) grow_quad_data();
 
@@ -2542,6 +2932,17 @@ int NPairCAC::compute_quad_points(int element_index){
     neigh_quad_counter = 1;
   }
 
+  //tabulate the shape functions at each quadrature point for the force projections
+  if (element_type[element_index]) {
+    nodes_per_element = atom->nodes_per_element_list[element_type[element_index]];
+    for (int iquad = qi - neigh_quad_counter; iquad < qi; iquad++)
+      for (int kk = 0; kk < nodes_per_element; kk++)
+        quadrature_point_data[iquad][QUADSHAPE+kk] =
+          shape_function(quadrature_point_data[iquad][3], quadrature_point_data[iquad][4],
+          quadrature_point_data[iquad][5], 2, kk+1);
+  }
+
+  quadrature_node_count = default_order;
   return neigh_quad_counter;
 }
 
@@ -2843,6 +3244,164 @@ void NPairCAC::allocate_quad_neigh_list() {
       add_quad_count_max = quad_count;
 }
 
+/* ----------------------------------------------------------------------
+   decide if the quadrature lists of the last full build can be kept;
+   requires an unchanged element ordering and quadrature layout, flags the
+   local elements whose lists must be rebuilt and returns 0 when too many
+   of them moved for an incremental update to pay off
+------------------------------------------------------------------------- */
+
+int NPairCAC::check_quad_reuse(int nsum, int *numneigh)
+{
+  int nlocal = atom->nlocal;
+  int nall = atom->nlocal + atom->nghost;
+  tagint *tag = atom->tag;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int *nodes_per_element_list = atom->nodes_per_element_list;
+  double ****nodal_positions = atom->nodal_positions;
+  double half_skin = 0.5*neighbor->skin;
+  double triggersq = half_skin*half_skin;
+  int i, j, row;
+
+  if (!quad_ref_flag || exclude) return 0;
+  if (nlocal != quad_ref_nlocal || nall != quad_ref_nall) return 0;
+  if (cutneighmax != quad_ref_cut || outer_neigh_flag != quad_ref_outer ||
+      add_neigh_flag != quad_ref_add || sector_flag != quad_ref_sector) return 0;
+
+  //the lists store local and ghost indices so the ordering must be identical
+  for (i = 0; i < nall; i++) {
+    if (tag[i] != quad_ref_tags[i] || poly_count[i] != quad_ref_poly[i]) return 0;
+    if (quad_ref_offset[i+1]-quad_ref_offset[i] !=
+        3*poly_count[i]*nodes_per_element_list[element_type[i]]) return 0;
+  }
+
+  //element quadrature points are fixed in natural coordinates unless the
+  //surface layers changed; atoms are covered by the displacement check
+  row = 0;
+  for (i = 0; i < nsum; i++) {
+    if (quadrature_counts[i] != quad_ref_counts[i]) return 0;
+    if (element_type[i]) {
+      for (int iquad = 0; iquad < quadrature_counts[i]; iquad++)
+        if (quadrature_point_data[row+iquad][0] != quad_ref_rows[3*(row+iquad)] ||
+            quadrature_point_data[row+iquad][1] != quad_ref_rows[3*(row+iquad)+1] ||
+            quadrature_point_data[row+iquad][2] != quad_ref_rows[3*(row+iquad)+2]) return 0;
+    }
+    row += quadrature_counts[i];
+  }
+
+  //largest nodal displacement of each element since the last full build
+  for (i = 0; i < nall; i++) {
+    double *nodes = &nodal_positions[i][0][0][0];
+    double *ref = quad_ref_positions + quad_ref_offset[i];
+    int nwords = quad_ref_offset[i+1] - quad_ref_offset[i];
+    quad_moved[i] = 0;
+    for (int n = 0; n < nwords; n += 3) {
+      double delx = nodes[n] - ref[n];
+      double dely = nodes[n+1] - ref[n+1];
+      double delz = nodes[n+2] - ref[n+2];
+      if (delx*delx + dely*dely + delz*delz > triggersq) {
+        quad_moved[i] = 1;
+        break;
+      }
+    }
+  }
+
+  //an element is rebuilt if it, a current neighbor, or an element in its
+  //retained lists moved; rebuilt elements stay flagged until the next full build
+  int ndirty = 0;
+  int pq = 0;
+  for (i = 0; i < nlocal; i++) {
+    int npq = quadrature_counts[i]*poly_count[i];
+    if (!quad_dirty[i]) {
+      if (quad_moved[i]) quad_dirty[i] = 1;
+      for (int jj = 0; jj < numneigh[i] && !quad_dirty[i]; jj++)
+        if (quad_moved[list_container[i][jj]]) quad_dirty[i] = 1;
+      for (int ipq = pq; ipq < pq + npq && !quad_dirty[i]; ipq++) {
+        for (j = 0; j < inner_quad_lists_counts[ipq]; j++)
+          if (quad_moved[inner_quad_lists_index[ipq][j][0]]) { quad_dirty[i] = 1; break; }
+        if (outer_neigh_flag)
+          for (j = 0; j < outer_quad_lists_counts[ipq]; j++)
+            if (quad_moved[outer_quad_lists_index[ipq][j][0]]) { quad_dirty[i] = 1; break; }
+        if (add_neigh_flag)
+          for (j = 0; j < add_quad_lists_counts[ipq]; j++)
+            if (quad_moved[add_quad_lists_index[ipq][j][0]]) { quad_dirty[i] = 1; break; }
+      }
+    }
+    ndirty += quad_dirty[i];
+    pq += npq;
+  }
+
+  if (2*ndirty > nlocal) return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   record the element ordering, quadrature layout and nodal positions
+   of a full quadrature list build for later incremental updates
+------------------------------------------------------------------------- */
+
+void NPairCAC::store_quad_reference(int nsum)
+{
+  int nlocal = atom->nlocal;
+  int nall = atom->nlocal + atom->nghost;
+  tagint *tag = atom->tag;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int *nodes_per_element_list = atom->nodes_per_element_list;
+  double ****nodal_positions = atom->nodal_positions;
+  int i, nrows;
+
+  if (nall+1 > quad_ref_max) {
+    quad_ref_max = nall+1;
+    memory->grow(quad_ref_tags, quad_ref_max, "NPairCAC:quad_ref_tags");
+    memory->grow(quad_ref_counts, quad_ref_max, "NPairCAC:quad_ref_counts");
+    memory->grow(quad_ref_poly, quad_ref_max, "NPairCAC:quad_ref_poly");
+    memory->grow(quad_ref_offset, quad_ref_max, "NPairCAC:quad_ref_offset");
+    memory->grow(quad_moved, quad_ref_max, "NPairCAC:quad_moved");
+    memory->grow(quad_dirty, quad_ref_max, "NPairCAC:quad_dirty");
+  }
+
+  quad_ref_offset[0] = 0;
+  for (i = 0; i < nall; i++) {
+    quad_ref_tags[i] = tag[i];
+    quad_ref_poly[i] = poly_count[i];
+    quad_ref_offset[i+1] = quad_ref_offset[i] +
+      3*poly_count[i]*nodes_per_element_list[element_type[i]];
+  }
+  if (quad_ref_offset[nall] > quad_ref_pos_max) {
+    quad_ref_pos_max = quad_ref_offset[nall];
+    memory->grow(quad_ref_positions, quad_ref_pos_max, "NPairCAC:quad_ref_positions");
+  }
+  for (i = 0; i < nall; i++)
+    memcpy(quad_ref_positions + quad_ref_offset[i], &nodal_positions[i][0][0][0],
+      (quad_ref_offset[i+1] - quad_ref_offset[i])*sizeof(double));
+
+  nrows = 0;
+  for (i = 0; i < nsum; i++) {
+    quad_ref_counts[i] = quadrature_counts[i];
+    nrows += quadrature_counts[i];
+  }
+  if (3*nrows > quad_ref_rows_max) {
+    quad_ref_rows_max = 3*nrows;
+    memory->grow(quad_ref_rows, quad_ref_rows_max, "NPairCAC:quad_ref_rows");
+  }
+  for (i = 0; i < nrows; i++) {
+    quad_ref_rows[3*i] = quadrature_point_data[i][0];
+    quad_ref_rows[3*i+1] = quadrature_point_data[i][1];
+    quad_ref_rows[3*i+2] = quadrature_point_data[i][2];
+  }
+
+  for (i = 0; i < nlocal; i++) quad_dirty[i] = 0;
+  quad_ref_nlocal = nlocal;
+  quad_ref_nall = nall;
+  quad_ref_cut = cutneighmax;
+  quad_ref_outer = outer_neigh_flag;
+  quad_ref_add = add_neigh_flag;
+  quad_ref_sector = sector_flag;
+  quad_ref_flag = 1;
+}
+
 /* ----------------------------------------------------------------------
   associate a quadrature point sector (region closest to quadrature point
   in mapped undeformed space) with a coordinate; designed for Q8 only now
@@ -2993,7 +3552,8 @@ return quad_index;
 
 void NPairCAC::grow_quad_data(){
   quadrature_point_max += 1000*atom->maxpoly;	
-  atom->quadrature_point_data = memory->grow(quadrature_point_data,quadrature_point_max,8,"pairCAC:quadrature_point_data");
+  atom->quadrature_point_data = memory->grow(quadrature_point_data,quadrature_point_max,
+    QUADSHAPE+atom->nodes_per_element,"pairCAC:quadrature_point_data");
   atom->quadrature_point_max = quadrature_point_max;
 }
 
@@ -3022,8 +3582,8 @@ void NPairCAC::allocate_quad_double(double **&double_quad_array, int size){
 }
 
 /* ----------------------------------------------------------------------
-   pack the buffer communicating the interface flags that decide the quadrature 
-   points for ghost elements
+   pack the buffer communicating the interface flags and quadrature orders
+   that decide the quadrature points for ghost elements
 ------------------------------------------------------------------------- */
 
 int NPairCAC::pack_forward_comm(int n, int *list, double *buf,
@@ -3035,13 +3595,14 @@ int NPairCAC::pack_forward_comm(int n, int *list, double *buf,
   for (i = 0; i < n; i++) {
     j = list[i];
     buf[m++] = interface_flags[j];
+    buf[m++] = quad_orders[j];
   }
   return m;
 }
 
 /* ----------------------------------------------------------------------
-   pack the buffer communicating the interface flags that decide the quadrature 
-   points for ghost elements
+   unpack the buffer communicating the interface flags and quadrature orders
+   that decide the quadrature points for ghost elements
 ------------------------------------------------------------------------- */
 
 void NPairCAC::unpack_forward_comm(int n, int first, double *buf)
@@ -3051,6 +3612,7 @@ void NPairCAC::unpack_forward_comm(int n, int first, double *buf)
   last = first + n;
   for (i = first; i < last; i++) {
     interface_flags[i] = buf[m++];
+    quad_orders[i] = static_cast<int> (buf[m++]);
   }
 }
 
@@ -3082,6 +3644,11 @@ bigint NPairCAC::memory_usage()
       bytes_used +=memory->usage(outer_quad_lists_ucell[i],outer_quad_neigh_maxes[i],3);
     }
   }
+  if(quad_ref_flag){
+    bytes_used +=memory->usage(quad_ref_positions,quad_ref_pos_max);
+    bytes_used +=memory->usage(quad_ref_rows,quad_ref_rows_max);
+    bytes_used +=6*memory->usage(quad_ref_counts,quad_ref_max);
+  }
   if(add_quad_allocated){
     for (i = 0; i < add_quad_count_max; i++){
       if(sector_flag)
@@ -18,6 +18,13 @@ NPairStyle(cac,
 	 NP_BIN | NP_ATOMONLY |
 	NP_NEWTON | NP_NEWTOFF | NP_ORTHO | NP_TRI | NP_CAC)
 
+// the quadrature neighbor build is serial; this entry lets the
+// threaded cac/omp pair styles request it through package omp
+NPairStyle(cac/omp,
+           NPairCAC,
+	 NP_BIN | NP_ATOMONLY | NP_OMP |
+	NP_NEWTON | NP_NEWTOFF | NP_ORTHO | NP_TRI | NP_CAC)
+
 #else
 
 #ifndef LMP_NPAIR_CAC_H
@@ -25,6 +32,13 @@ NPairStyle(cac,
 
 #include "npair.h"
 
+// columns of each row of atom->quadrature_point_data:
+// 0-2 = s,t,w of the quadrature point, 3-5 = s,t,w of its image inside
+// the element, 6 = quadrature weight, 7 = 1 for element corner sites,
+// QUADSHAPE on = values of the element shape functions at the point
+
+#define QUADSHAPE 8
+
 namespace LAMMPS_NS {
 
 class NPairCAC : public NPair {
@@ -38,6 +52,7 @@ class NPairCAC : public NPair {
 
   int CAC_decide_quad2element(double *, int);
   int CAC_decide_element2element(int, int);
+  int select_quad_order(int);       //Gauss-Legendre order of an element, also used by compute cac/quad/count
 
   //functions for Asa_Data and NPair to use
   double shape_function(double, double, double,int,int);
@@ -61,7 +76,7 @@ class NPairCAC : public NPair {
   int quadrature_node_count;
   int poly_counter;
   
-  double *quadrature_weights;
+  double *quadrature_weights;       //Gauss-Legendre rule of the element being processed
   double *quadrature_abcissae;
   virtual bigint memory_usage();
   
@@ -82,6 +97,8 @@ protected:
 	int surface_counts_max_old[3];
   int pqi, qi, neigh_count;
   int **list_container, *list_maxes, *interface_flags;
+  int *quad_orders;                             //Gauss-Legendre order used by each element
+  double **quad_rule_weights, **quad_rule_abcissae; //rule tables indexed by order
   int *scan_flags,*bin_scan_flags,*bins_searched, nbins_searched, maxbins_searched;
   double **quadrature_point_data, cut_global;
   int quad_scan_list_max, quadrature_point_max, quadrature_poly_max, quadrature_poly_count;
@@ -94,15 +111,33 @@ protected:
   int **sort_dof_set;
   int **neighbor_weights;
 
+  // state of the last full quadrature list build used by incremental updates
+  int quad_ref_flag, quad_ref_nlocal, quad_ref_nall, quad_ref_max, quad_ref_pos_max;
+  int quad_ref_outer, quad_ref_add, quad_ref_sector, quad_ref_rows_max;
+  double quad_ref_cut;
+  tagint *quad_ref_tags;
+  int *quad_ref_counts, *quad_ref_poly, *quad_ref_offset, *quad_moved, *quad_dirty;
+  double *quad_ref_positions, *quad_ref_rows;
+
   void quadrature_init(int degree);
   void allocate_neigh_list();
+  void scan_stencil(int, int);
+  void scan_bin(int, int *, int);
+  int coarse_bin(int);
+
+  int timing_flag;                  //1 if the build stages are timed for cac_timing
+  double surface_time;              //time spent in surface searches of this build
+  double surface_iterations;        //Newton iterations of all closed form surface searches
   int compute_quad_points(int);
   void allocate_local_arrays();
   void allocate_quad_neigh_list();
   void quad_list_build(int, double, double, double);
   void neighbor_accumulate(double,double,double,int, int,int,int);
+  int surface_projection(double *, double);
   void compute_quad_neighbors(int);
   void grow_quad_data();
+  int check_quad_reuse(int, int *);
+  void store_quad_reference(int);
   virtual int pack_forward_comm(int, int *, double *, int, int *);
   virtual void unpack_forward_comm(int, int, double *);
 
@@ -25,6 +25,7 @@
 #include "neighbor.h"
 #include "neigh_request.h"
 #include "neigh_list.h"
+#include "npair_cac.h"
 #include "math_const.h"
 #include "memory.h"
 #include "error.h"
@@ -36,10 +37,10 @@
 #define PLANE_EPSILON  1e-6 //error tolerance for surface flux calculation
 #define MAXNEIGHOUT  500
 #define MAXNEIGHIN  10
-#define MAXNEIGHBUFF 6000
 #define EXPAND 10
 #define MAXLINE 1024
 #define DELTA 4
+#define INTERP_BATCH 64 //neighbors interpolated together in interpolate_batch
 using namespace LAMMPS_NS;
 
 
@@ -50,6 +51,7 @@ PairCAC::PairCAC(LAMMPS *lmp) : Pair(lmp)
   restartinfo = 0;
   manybody_flag = 1;
   pre_force_flag = 0;
+  local_energy_flag = 1;
   flux_enable = type_map = 0;
   nmax_surf = 0;
   cut_global_s = 0;
@@ -78,11 +80,18 @@ PairCAC::PairCAC(LAMMPS *lmp) : Pair(lmp)
   type_maps = NULL;
   quad_allocated = 0;
   local_inner_max = local_all_max = local_outer_max = local_add_max = 0;
+  maxelement_cost = 0;
+  stage_timing = 0;
+  for (int k = 0; k < NSTAGE; k++) stage_time[k] = 0.0;
   vel_inner_max = vel_outer_max = 0;
   outer_neighflag = 0;
   sector_flag = 0;
   one_layer_flag = 0;
   shape_quad_result  = current_virial_projection = current_flux_projection = NULL;
+  mass_lu_cache = NULL;
+  mass_pivot_cache = NULL;
+  mass_cache_rank = -1;
+  mass_cache_types = 0;
   current_force_column = current_virial_column = current_flux_column = NULL;
   neighbor->pgsize=10;
   neighbor->oneatom=1;
@@ -97,6 +106,26 @@ PairCAC::PairCAC(LAMMPS *lmp) : Pair(lmp)
 /* ---------------------------------------------------------------------- */
 
 PairCAC::~PairCAC() {
+  memory->destroy(add_neighbor_charges);
+  //thread copies only own their quadrature point scratch arrays
+  if (copymode) {
+    memory->destroy(force_column);
+    memory->destroy(current_force_column);
+    memory->destroy(current_virial_column);
+    memory->destroy(current_flux_column);
+    memory->destroy(current_nodal_forces);
+    memory->destroy(current_virial_projection);
+    memory->destroy(current_flux_projection);
+    memory->destroy(inner_neighbor_coords);
+    memory->destroy(inner_neighbor_types);
+    memory->destroy(inner_neighbor_charges);
+    memory->destroy(outer_neighbor_coords);
+    memory->destroy(outer_neighbor_types);
+    memory->destroy(outer_neighbor_charges);
+    destroy_flux_memory();
+    return;
+  }
+  destroy_flux_memory();
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -111,30 +140,108 @@ PairCAC::~PairCAC() {
     memory->destroy(current_virial_projection);
     memory->destroy(current_flux_projection);
   }
+  memory->destroy(mass_lu_cache);
+  memory->destroy(mass_pivot_cache);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairCAC::compute(int eflag, int vflag) {
   int i;
-  double delx,dely,delz,fpair, v[6];
+  double v[6];
   int mi;
-  int mj;
-  int singular;
   ev_init(eflag,vflag);
   v[0]=0;v[1]=0;v[2]=0;v[3]=0;v[4]=0;v[5]=0;
 
-  double **x = atom->x;
-  double ****nodal_positions= atom->nodal_positions;
-  double ****nodal_forces= atom->nodal_forces;
-  double ****nodal_virial= atom->nodal_virial;
   int *element_type = atom->element_type;
-  int *poly_count = atom->poly_count;
-  int **node_types = atom->node_types;
   int **element_scale = atom->element_scale;
+  double ****nodal_virial= atom->nodal_virial;
   int nlocal = atom->nlocal;
   int nodes_per_element;
-  int nsurface;
+  int *nodes_count_list = atom->nodes_per_element_list;	
+  int element_qi;
+
+  setup_compute(eflag);
+  setup_element_cost();
+
+  pqi = qi = 0;
+  //preforce calculations
+  if(pre_force_flag)
+  pre_force_densities();
+ 
+  pqi = qi = 0;
+  element_qi = 0;
+  //compute forces
+  for (i = 0; i < nlocal; i++) {
+    compute_element(i, element_qi);
+    element_qi += quadrature_counts[i];
+    nodes_per_element = nodes_count_list[element_type[i]];
+
+    //Tally energy
+    //the virial is tallied from the nodal virials below
+    if (evflag) ev_tally_full(i,
+          2 * element_energy, 0.0, 0.0, 0.0, 0.0, 0.0);
+
+    //Tally virial, this requires looping over all nodes and atoms
+    if(vflag){
+      for (poly_counter = 0; poly_counter < current_poly_count; poly_counter++) {
+            for (mi = 0; mi < nodes_per_element; mi++){
+                for( int dim = 0; dim < 6; dim ++) v[dim] = nodal_virial[i][poly_counter][mi][dim];
+                // For elements we have to multiply by the number of atoms assigned to node. Just assume that all the elements are rhombohedral for right now
+                if(element_type[i] != 0){
+                    for(int dim = 0; dim < 6; dim ++) v[dim] *= (element_scale[i][0]*element_scale[i][1]*element_scale[i][2])/nodes_count_list[element_type[i]];
+                }
+                v_tally_tensor(0,0,1,0,v[0],v[1],v[2],v[3],v[4],v[5]);
+            }
+      }
+    }
+  }
+  if(stage_timing) flush_stage_times();
+}
+
+/* ----------------------------------------------------------------------
+ turn a copy of this pair style into a thread copy; the copy shares the
+ coefficients, quadrature rules and mass matrix factors of the original
+ and gets its own quadrature point scratch arrays
+------------------------------------------------------------------------- */
+
+void PairCAC::setup_thread_copy()
+{
+  copymode = 1;
+  num_tally_compute = 0;
+  list_tally_compute = NULL;
+  mass_matrix = mass_copy = NULL;
+  shape_quad_result = NULL;
+  pivot = NULL;
+
+  inner_neighbor_coords = inner_neighbor_velocities = NULL;
+  outer_neighbor_coords = outer_neighbor_velocities = NULL;
+  add_neighbor_coords = add_neighbor_velocities = NULL;
+  inner_neighbor_types = outer_neighbor_types = add_neighbor_types = NULL;
+  inner_neighbor_charges = outer_neighbor_charges = add_neighbor_charges = NULL;
+  flux_neigh_intercepts = NULL;
+  flux_neigh_nintercepts = NULL;
+  flux_neigh_indices = nplane_intersects = NULL;
+  local_inner_max = local_outer_max = local_add_max = local_all_max = 0;
+  vel_inner_max = vel_outer_max = 0;
+  for (int k = 0; k < NSTAGE; k++) stage_time[k] = 0.0;
+
+  memory->create(force_column, max_nodes_per_element,3,"pairCAC:force_residue");
+  memory->create(current_force_column, max_nodes_per_element,"pairCAC:current_force_residue");
+  memory->create(current_virial_column, max_nodes_per_element,"pairCAC:current_virial_projection");
+  memory->create(current_flux_column, max_nodes_per_element,"pairCAC:current_flux_projection");
+  memory->create(current_nodal_forces, max_nodes_per_element,"pairCAC:current_nodal_force");
+  memory->create(current_virial_projection, 6, max_nodes_per_element,"pairCAC:virial_projection");
+  memory->create(current_flux_projection, 24, max_nodes_per_element,"pairCAC:flux_projection");
+}
+
+/* ----------------------------------------------------------------------
+ obtain the quadrature point data and neighbor lists for this force
+ computation from the atom class
+------------------------------------------------------------------------- */
+
+void PairCAC::setup_compute(int eflag)
+{
   flux_compute = atom->flux_compute;
   quadrature_counts = atom->quadrature_counts;
   e2quad_index = atom->e2quad_index;
@@ -150,92 +257,142 @@ void PairCAC::compute(int eflag, int vflag) {
     add_quad_lists_ucell = atom->add_quad_lists_ucell;
     add_quad_lists_counts = atom->add_quad_lists_counts;
   }
-  
-  int *nodes_count_list = atom->nodes_per_element_list;	
   quad_eflag = eflag;
   cutoff_skin = neighbor->skin;
+  stage_timing = atom->cac_timing_flag;
+}
+
+/* ----------------------------------------------------------------------
+ add the stage times of this instance to the CAC timers of the atom class;
+ threaded variants call this for each thread copy after the force loop
+------------------------------------------------------------------------- */
+
+void PairCAC::flush_stage_times()
+{
+  for (int k = 0; k < NSTAGE; k++) {
+    atom->cac_times[Atom::CAC_TIME_INTERP+k] += stage_time[k];
+    stage_time[k] = 0.0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+ flux density of the virtual neighbors of the current quadrature point,
+ timed as its own stage if CAC timing is enabled
+------------------------------------------------------------------------- */
+
+void PairCAC::neigh_flux_stage()
+{
+  if(!stage_timing){
+    quad_neigh_flux();
+    return;
+  }
+  double stage_start = MPI_Wtime();
+  quad_neigh_flux();
+  stage_time[FLUX] += MPI_Wtime() - stage_start;
+}
+
+/* ----------------------------------------------------------------------
+ make room for the per element force computation times requested by
+ balance weight cac; must be called outside any threaded region
+------------------------------------------------------------------------- */
+
+void PairCAC::setup_element_cost()
+{
+  if(!atom->element_cost_flag) return;
+  if(atom->nmax > maxelement_cost){
+    maxelement_cost = atom->nmax;
+    memory->grow(atom->element_cost,maxelement_cost,"atom:element_cost");
+  }
+  atom->element_cost_count = atom->nlocal;
+}
 
+/* ----------------------------------------------------------------------
+ prepare compute_element calls outside of compute, e.g. to evaluate the
+ energy change of a few elements after changing the types of some sites
+------------------------------------------------------------------------- */
 
+void PairCAC::setup_local_energy()
+{
+  setup_compute(1);
   pqi = qi = 0;
-  //preforce calculations
   if(pre_force_flag)
   pre_force_densities();
- 
-  pqi = qi = 0;
-  //compute forces
-  for (i = 0; i < nlocal; i++) {
-    current_element_index = i;
-    if(element_type[i]){
-      //compute this element's mass matrix
-      compute_mass_matrix();
-      for ( mi = 0; mi < max_nodes_per_element; mi++) {
-        for (mj = 0; mj < max_nodes_per_element; mj++){
-          mass_copy[mi][mj]=mass_matrix[mi][mj];
-        }      
-      }
-    
+}
 
-    singular = LUPDecompose(mass_copy, max_nodes_per_element,0.00000000000001,  pivot);
-    if(singular==0){
-      error->one(FLERR,"LU matrix is degenerate");
-    }
-    }
-    atomic_flag = 0;
-    current_element_type = element_type[i];
-    current_element_scale = element_scale[i];
-    current_poly_count = poly_count[i];
-    type_array = node_types[i];
-    current_x = x[i];
-    if (eflag) {
-      element_energy = 0;
-    }
-    //determine element type
-    nodes_per_element = nodes_count_list[current_element_type];
-    if (current_element_type == 0) {
-      atomic_flag = 1;
+/* ----------------------------------------------------------------------
+ compute and project the nodal forces of local element i; element_qi is
+ the index of its first quadrature point in quadrature_point_data.
+ returns the element energy if energy is requested.
+------------------------------------------------------------------------- */
+
+double PairCAC::compute_element(int i, int element_qi)
+{
+  int mi, nodes_per_element;
+  double **x = atom->x;
+  double ****nodal_positions= atom->nodal_positions;
+  double ****nodal_forces= atom->nodal_forces;
+  int *element_type = atom->element_type;
+  int *poly_count = atom->poly_count;
+  int **node_types = atom->node_types;
+  int **element_scale = atom->element_scale;
+  int *nodes_count_list = atom->nodes_per_element_list;	
+  double cost_start = 0.0;
+  double stage_start = 0.0, stage_inner = 0.0;
+
+  if(atom->element_cost_flag) cost_start = MPI_Wtime();
+  if(stage_timing){
+    stage_start = MPI_Wtime();
+    stage_inner = stage_time[INTERP] + stage_time[FDENS] + stage_time[FLUX];
+  }
+  qi = element_qi;
+  current_element_index = i;
+  //the mass matrix only depends on the element type and quadrature rank
+  if(element_type[i]){
+    current_mass_lu = mass_lu_cache[element_type[i]];
+    current_pivot = mass_pivot_cache[element_type[i]];
+  }
+  atomic_flag = 0;
+  current_element_type = element_type[i];
+  current_element_scale = element_scale[i];
+  current_poly_count = poly_count[i];
+  type_array = node_types[i];
+  current_x = x[i];
+  element_energy = 0;
+  //determine element type
+  nodes_per_element = nodes_count_list[current_element_type];
+  if (current_element_type == 0) {
+    atomic_flag = 1;
+  }
+  //NOTE:might have to change matrices so they dont have zeros due to maximum node count; ill condition.
+  if(atomic_flag){
+    poly_counter = 0;
+    current_nodal_positions = nodal_positions[i][poly_counter]; 
+    compute_forcev(i);
+    for (int dim = 0; dim < 3; dim++) {
+    nodal_forces[i][0][0][dim] += force_column[0][dim];
     }
-    //NOTE:might have to change matrices so they dont have zeros due to maximum node count; ill condition.
-    if(atomic_flag){
-      poly_counter = 0;
+  }
+  else{
+    for (poly_counter = 0; poly_counter < current_poly_count; poly_counter++) {
       current_nodal_positions = nodal_positions[i][poly_counter]; 
       compute_forcev(i);
       for (int dim = 0; dim < 3; dim++) {
-      nodal_forces[i][0][0][dim] += force_column[0][dim];
-      }
-    }
-    else{
-      for (poly_counter = 0; poly_counter < current_poly_count; poly_counter++) {
-        current_nodal_positions = nodal_positions[i][poly_counter]; 
-        compute_forcev(i);
-        for (int dim = 0; dim < 3; dim++) {
-          for (mi = 0; mi < nodes_per_element; mi++) {
-            current_force_column[mi] = force_column[mi][dim];
-          }
-          LUPSolve(mass_copy, pivot, current_force_column, nodes_per_element, current_nodal_forces);
-          for (mi = 0; mi < nodes_per_element; mi++) {
-            nodal_forces[i][poly_counter][mi][dim] += current_nodal_forces[mi];
-          }
+        for (mi = 0; mi < nodes_per_element; mi++) {
+          current_force_column[mi] = force_column[mi][dim];
+        }
+        LUPSolve(current_mass_lu, current_pivot, current_force_column, nodes_per_element, current_nodal_forces);
+        for (mi = 0; mi < nodes_per_element; mi++) {
+          nodal_forces[i][poly_counter][mi][dim] += current_nodal_forces[mi];
         }
-      }
-    }
-    //Tally energy
-    if (evflag) ev_tally_full(i,
-          2 * element_energy, 0.0, fpair, delx, dely, delz);
-
-    //Tally virial, this requires looping over all nodes and atoms
-    if(vflag){
-      for (poly_counter = 0; poly_counter < current_poly_count; poly_counter++) {
-            for (mi = 0; mi < nodes_per_element; mi++){
-                for( int dim = 0; dim < 6; dim ++) v[dim] = nodal_virial[i][poly_counter][mi][dim];
-                // For elements we have to multiply by the number of atoms assigned to node. Just assume that all the elements are rhombohedral for right now
-                if(element_type[i] != 0){
-                    for(int dim = 0; dim < 6; dim ++) v[dim] *= (element_scale[i][0]*element_scale[i][1]*element_scale[i][2])/nodes_count_list[element_type[i]];
-                }
-                v_tally_tensor(0,0,1,0,v[0],v[1],v[2],v[3],v[4],v[5]);
-            }
       }
     }
   }
+  if(atom->element_cost_flag) atom->element_cost[i] = MPI_Wtime() - cost_start;
+  //whatever the force densities leave of the element time is projection work
+  if(stage_timing)
+    stage_time[PROJ] += MPI_Wtime() - stage_start - (stage_time[INTERP] +
+      stage_time[FDENS] + stage_time[FLUX] - stage_inner);
+  return element_energy;
 }
 
 /* ----------------------------------------------------------------------
@@ -280,6 +437,7 @@ void PairCAC::settings(int narg, char **arg) {
 void PairCAC::init_style()
 {
   check_existence_flags();
+  setup_mass_cache();
   int irequest = neighbor->request(this, instance_me);
   neighbor->requests[irequest]->half = 0;
   neighbor->requests[irequest]->cac = 1;
@@ -331,6 +489,9 @@ void PairCAC::check_existence_flags(){
 
 void PairCAC::quadrature_init(int quadrature_rank){
 
+  //cached mass matrix factors are only valid for the rank they were built with
+  mass_cache_rank = -1;
+
   if(quadrature_rank==1){
   atom->quadrature_node_count=quadrature_node_count=1;
   memory->create(quadrature_weights,quadrature_node_count,"pairCAC:quadrature_weights");
@@ -365,12 +526,12 @@ void PairCAC::quadrature_init(int quadrature_rank){
 
 /* ---------------------------------------------------------------------- */
 
-void PairCAC::compute_mass_matrix()
+void PairCAC::compute_mass_matrix(int nodes_per_element)
 {
   int j,k;
   double result=0;
   //precompute shape function quadrature abcissae
-  for(int ii=0;ii<max_nodes_per_element;ii++){
+  for(int ii=0;ii<nodes_per_element;ii++){
     for (int i=0; i< quadrature_node_count;i++){
       for (int j=0; j< quadrature_node_count;j++){
         for ( k=0; k< quadrature_node_count;k++){
@@ -382,8 +543,8 @@ void PairCAC::compute_mass_matrix()
   }
 
 //assemble matrix with quadrature array of values
-  for ( j=0; j<max_nodes_per_element;j++){
-    for ( k=j; k<max_nodes_per_element;k++){
+  for ( j=0; j<nodes_per_element;j++){
+    for ( k=j; k<nodes_per_element;k++){
       result=shape_product(j,k);
       mass_matrix[j][k]= result;
       if(k>j){
@@ -393,6 +554,52 @@ void PairCAC::compute_mass_matrix()
   }
 }
 
+/* ----------------------------------------------------------------------
+ compute and factorize the mass matrix once per element type; the matrix
+ only depends on the element's shape functions and the quadrature rank so
+ the LU factors are reused by every element of that type until either
+ quadrature_init() or the set of defined element types changes
+------------------------------------------------------------------------- */
+
+void PairCAC::setup_mass_cache()
+{
+  int nodes_per_element, singular;
+  int *nodes_count_list = atom->nodes_per_element_list;
+  int element_type_count = atom->element_type_count;
+
+  if(mass_cache_rank == quadrature_node_count && mass_cache_types == element_type_count)
+    return;
+
+  memory->destroy(mass_lu_cache);
+  memory->destroy(mass_pivot_cache);
+  memory->create(mass_lu_cache, element_type_count, max_nodes_per_element,
+    max_nodes_per_element, "pairCAC:mass_lu_cache");
+  memory->create(mass_pivot_cache, element_type_count, max_nodes_per_element+1,
+    "pairCAC:mass_pivot_cache");
+
+  //type 0 is a pure atom and has no mass matrix
+  for (int itype = 1; itype < element_type_count; itype++) {
+    nodes_per_element = nodes_count_list[itype];
+    if(nodes_per_element > max_nodes_per_element) continue;
+    compute_mass_matrix(nodes_per_element);
+    for (int mi = 0; mi < nodes_per_element; mi++)
+      for (int mj = 0; mj < nodes_per_element; mj++)
+        mass_copy[mi][mj]=mass_matrix[mi][mj];
+
+    singular = LUPDecompose(mass_copy, nodes_per_element, 0.00000000000001, mass_pivot_cache[itype]);
+    if(singular==0)
+      error->all(FLERR,"LU matrix is degenerate");
+
+    //LUPDecompose swaps row pointers; store the factors in logical row order
+    for (int mi = 0; mi < nodes_per_element; mi++)
+      for (int mj = 0; mj < nodes_per_element; mj++)
+        mass_lu_cache[itype][mi][mj] = mass_copy[mi][mj];
+  }
+
+  mass_cache_rank = quadrature_node_count;
+  mass_cache_types = element_type_count;
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairCAC::shape_product(int ii, int jj) {
@@ -421,6 +628,7 @@ void PairCAC::compute_forcev(int iii){
   double ****nodal_virial = atom->nodal_virial;
   double ****nodal_fluxes;
   double shape_func;
+  double stage_start = 0.0, stage_inner = 0.0;
   if(flux_compute){
     nodal_fluxes = fix_cac_alloc_vector->request_vector(0);
     atom->nodal_fluxes = nodal_fluxes;
@@ -433,7 +641,6 @@ void PairCAC::compute_forcev(int iii){
   unit_cell_mapped[2] = 2 / double(current_element_scale[2]);
   
   double s, t, w;
-  double sq, tq, wq;
   //compute interior quadrature point virtual neighbor lists
   double iso_volume=unit_cell_mapped[0]*unit_cell_mapped[1]*unit_cell_mapped[2];
   if(atomic_flag) iso_volume=1;
@@ -463,6 +670,8 @@ void PairCAC::compute_forcev(int iii){
   }
 
   double force_density[3];
+  double weighted_force[3], weighted_virial[6], weighted_flux[24];
+  double *shape_values;
   
     //sum over quadrature points to compute force density
    
@@ -495,42 +704,46 @@ void PairCAC::compute_forcev(int iii){
     s = quadrature_point_data[qi + quad_loop][0];
     t = quadrature_point_data[qi + quad_loop][1];
     w = quadrature_point_data[qi + quad_loop][2];
-    sq = quadrature_point_data[qi + quad_loop][3];
-    tq = quadrature_point_data[qi + quad_loop][4];
-    wq = quadrature_point_data[qi + quad_loop][5];
   }
   coefficients = quadrature_point_data[qi + quad_loop][6];
+  if(stage_timing){
+    stage_start = MPI_Wtime();
+    stage_inner = stage_time[INTERP] + stage_time[FLUX];
+  }
   if(!atomic_flag)
   force_densities(iii, s, t, w, coefficients,
     force_density[0], force_density[1], force_density[2]);
   else
   force_densities(iii, current_x[0], current_x[1], current_x[2], coefficients,
     force_density[0], force_density[1], force_density[2]);
+  if(stage_timing)
+    stage_time[FDENS] += MPI_Wtime() - stage_start -
+      (stage_time[INTERP] + stage_time[FLUX] - stage_inner);
   if(!atomic_flag){
+    //weight the densities once and project them onto the nodes in a single
+    //pass using the shape function values tabulated at this quadrature point
+    shape_values = quadrature_point_data[qi + quad_loop] + QUADSHAPE;
+    for (int jj = 0; jj < 3; jj++)
+      weighted_force[jj] = coefficients*force_density[jj];
+    if(atom->CAC_virial)
+      for (int jj = 0; jj < 6; jj++)
+        weighted_virial[jj] = coefficients*virial_density[jj];
+    if(quad_flux_flag&&atom->cac_flux_flag==2)
+      for (int jj = 0; jj < 24; jj++)
+        weighted_flux[jj] = coefficients*flux_density[jj];
+
     for (int js = 0; js < nodes_per_element; js++) {
-      shape_func = shape_function(sq, tq, wq, 2, js + 1);
-      for (int jj = 0; jj < 3; jj++) {
-        force_column[js][jj] += coefficients*force_density[jj] * shape_func;
-      }
-    }
-    
-    if(atom->CAC_virial){
-      for (int jj = 0; jj < 6; jj++){
-        for (int js = 0; js < nodes_per_element; js++){
-          shape_func = shape_function(sq, tq, wq, 2, js + 1);
-          current_virial_projection[jj][js] += coefficients*virial_density[jj] * shape_func;
-        }
-      }
+      shape_func = shape_values[js];
+      for (int jj = 0; jj < 3; jj++)
+        force_column[js][jj] += weighted_force[jj] * shape_func;
+      if(atom->CAC_virial)
+        for (int jj = 0; jj < 6; jj++)
+          current_virial_projection[jj][js] += weighted_virial[jj] * shape_func;
+      if(quad_flux_flag&&atom->cac_flux_flag==2)
+        for (int jj = 0; jj < 24; jj++)
+          current_flux_projection[jj][js] += weighted_flux[jj] * shape_func;
     }
 
-    if(quad_flux_flag&&atom->cac_flux_flag==2){
-      for (int jj = 0; jj < 24; jj++){
-        for (int js = 0; js < nodes_per_element; js++){
-          shape_func = shape_function(sq, tq, wq, 2, js + 1);
-          current_flux_projection[jj][js] += coefficients*flux_density[jj] * shape_func;
-        }
-      }
-    }
     if(quad_flux_flag&&atom->cac_flux_flag==1){
       ns = quadrature_point_data[qi + quad_loop][7];
       for (int jj = 0; jj < 24; jj++)
@@ -561,7 +774,7 @@ void PairCAC::compute_forcev(int iii){
   //init virial projection
   if(atom->CAC_virial){
     for (int jj = 0; jj<6; jj++) {
-      LUPSolve(mass_copy, pivot, current_virial_projection[jj], nodes_per_element, current_virial_column);
+      LUPSolve(current_mass_lu, current_pivot, current_virial_projection[jj], nodes_per_element, current_virial_column);
       for (int js = 0; js < nodes_per_element; js++) {
         nodal_virial[iii][poly_counter][js][jj] = current_virial_column[js];
       }
@@ -572,7 +785,7 @@ void PairCAC::compute_forcev(int iii){
   //solve for nodal surface flux interpolant
   if(flux_compute&&atom->cac_flux_flag==2){
     for (int jj = 0; jj<24; jj++) {
-      LUPSolve(mass_copy, pivot, current_flux_projection[jj], nodes_per_element, current_flux_column);
+      LUPSolve(current_mass_lu, current_pivot, current_flux_projection[jj], nodes_per_element, current_flux_column);
       for (int js = 0; js<nodes_per_element; js++) {
         nodal_fluxes[iii][poly_counter][js][jj] = current_flux_column[js];
       }
@@ -651,6 +864,33 @@ shape_functions[6]=&PairCAC::quad_shape_seven;
 shape_functions[7]=&PairCAC::quad_shape_eight;
 }
 
+/* ----------------------------------------------------------------------
+   free the neighbor buffers and line-plane intersection arrays that
+   allocate_quad_memory() grows only when computing flux
+------------------------------------------------------------------------- */
+
+void PairCAC::destroy_flux_memory()
+{
+  memory->destroy(inner_neighbor_velocities);
+  memory->destroy(outer_neighbor_velocities);
+  memory->destroy(add_neighbor_coords);
+  memory->destroy(add_neighbor_types);
+  memory->destroy(add_neighbor_velocities);
+  for (int alloc = 0; alloc < local_all_max; alloc++) {
+    memory->destroy(flux_neigh_indices[alloc]);
+    memory->destroy(nplane_intersects[alloc]);
+    memory->destroy(flux_neigh_intercepts[alloc]);
+  }
+  memory->sfree(flux_neigh_indices);
+  memory->sfree(nplane_intersects);
+  memory->sfree(flux_neigh_intercepts);
+  memory->destroy(flux_neigh_nintercepts);
+  flux_neigh_indices = nplane_intersects = NULL;
+  flux_neigh_intercepts = NULL;
+  vel_inner_max = vel_outer_max = 0;
+  local_add_max = local_all_max = 0;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairCAC::allocate_quad_memory(){
@@ -694,7 +934,7 @@ void PairCAC::allocate_quad_memory(){
       memory->grow(add_neighbor_coords, neigh_max_add+EXPAND, 3, "Pair_CAC:add_neighbor_coords");
       memory->grow(add_neighbor_types, neigh_max_add+EXPAND, "Pair_CAC:add_neighbor_types");
       if(atom->q_flag)
-      memory->grow(outer_neighbor_charges, neigh_max_add+EXPAND, "Pair_CAC:neighbor_charges");
+      memory->grow(add_neighbor_charges, neigh_max_add+EXPAND, "Pair_CAC:add_neighbor_charges");
       memory->grow(add_neighbor_velocities, neigh_max_add+EXPAND, 3, "Pair_CAC:add_neighbor_velocities");
       local_add_max=neigh_max_add+EXPAND;
     }
@@ -783,57 +1023,24 @@ void PairCAC::init_quad_arrays(){
 }
 
 /* ---------------------------------------------------------------------- 
- Compute the current positions, velocities, etc. of all virtual/real atom
- neighbors for a quadrature point; uses the element shape functions and
- the parameters associated with each virtual atom neighbor position to do so.
- These parameters are stored in the ucell array.
+ Compute the position (and velocity when computing flux) of quadrature
+ point iii and of all its virtual/real atom neighbors; uses the element
+ shape functions and the unit cell coordinates of each virtual neighbor
+ stored in the ucell arrays. Only the interpolated coordinates and
+ velocities are stored in the neighbor buffers; the neighbor types and
+ charges are filled separately by init_quad_arrays().
 ---------------------------------------------------------------------- */
 
 void PairCAC::interpolation(int iii, double sq, double tq, double wq){
 
   double s, t, w, sp, sm, tp, tm, wp, wm;
-  int *element_type = atom->element_type;
-  double ****nodal_positions = atom->nodal_positions;
   double ****nodal_velocities = atom->nodal_velocities;
-  double **x = atom->x;
   double **v = atom->v;
-  int neigh_max = inner_quad_lists_counts[pqi];
-  int outer_neigh_max, add_neigh_max;
-  double **inner_ucells, **outer_ucells, **add_ucells, shape_func;
-  int inner_etypes[MAXNEIGHBUFF], outer_etypes[MAXNEIGHBUFF], add_etypes[MAXNEIGHBUFF];
-  int **inner_indices, **outer_indices, **add_indices;
-
-  if(neigh_max > MAXNEIGHBUFF)
-    error->one(FLERR,"increase MAXNEIGHBUFF in pair_cac.cpp; this overestimates the maximum possible neighbors for a quadrature point");
-
-  if(outer_neighflag){
-    outer_neigh_max = outer_quad_lists_counts[pqi];
-    if(outer_neigh_max > MAXNEIGHBUFF)
-      error->one(FLERR,"increase MAXNEIGHBUFF in pair_cac.cpp; this overestimates the maximum possible neighbors for a quadrature point");	  
-  }
-
-  if(quad_flux_flag){
-    add_neigh_max = add_quad_lists_counts[pqi];
-    if(add_neigh_max > MAXNEIGHBUFF)
-      error->one(FLERR,"increase MAXNEIGHBUFF in pair_cac.cpp; this overestimates the maximum possible neighbors for a quadrature point");	
-  }
-
-  double shaperesult[MAXNEIGHBUFF][MAXESHAPE];
-  double **nodes, **node_velocities;
-  inner_ucells = inner_quad_lists_ucell[pqi];
-  inner_indices = inner_quad_lists_index[pqi];
-  //init coords to zero etc.
-  for (int l = 0; l < neigh_max; l++) {
-    inner_neighbor_coords[l][0] = 0;
-    inner_neighbor_coords[l][1] = 0;
-    inner_neighbor_coords[l][2] = 0;
-    if(quad_flux_flag){
-      inner_neighbor_velocities[l][0] = 0;
-      inner_neighbor_velocities[l][1] = 0;
-      inner_neighbor_velocities[l][2] = 0;
-    }
-  }
+  double shaperesult[MAXESHAPE];
+  double *nodes, *node_velocities;
+  double stage_start = 0.0;
 
+  if(stage_timing) stage_start = MPI_Wtime();
   //compute interpolation for current quadrature point
   current_position[0]=0;
   current_position[1]=0;
@@ -853,25 +1060,25 @@ void PairCAC::interpolation(int iii, double sq, double tq, double wq){
     tm = 1-t;
     wp = 1+w;
     wm = 1-w;
-    nodes = current_nodal_positions;
+    nodes = current_nodal_positions[0];
     if(quad_flux_flag)
-    node_velocities = nodal_velocities[iii][poly_counter];
-    shaperesult[0][0]= sm*tm*wm;
-    shaperesult[0][1]= sp*tm*wm;
-    shaperesult[0][2]= sp*tp*wm;
-    shaperesult[0][3]= sm*tp*wm;
-    shaperesult[0][4]= sm*tm*wp;
-    shaperesult[0][5]= sp*tm*wp;
-    shaperesult[0][6]= sp*tp*wp;
-    shaperesult[0][7]= sm*tp*wp;
+    node_velocities = nodal_velocities[iii][poly_counter][0];
+    shaperesult[0]= sm*tm*wm;
+    shaperesult[1]= sp*tm*wm;
+    shaperesult[2]= sp*tp*wm;
+    shaperesult[3]= sm*tp*wm;
+    shaperesult[4]= sm*tm*wp;
+    shaperesult[5]= sp*tm*wp;
+    shaperesult[6]= sp*tp*wp;
+    shaperesult[7]= sm*tp*wp;
     for(int r = 0; r < 8; r++){
-      current_position[0]+=nodes[r][0]*shaperesult[0][r];
-      current_position[1]+=nodes[r][1]*shaperesult[0][r];
-      current_position[2]+=nodes[r][2]*shaperesult[0][r];
+      current_position[0]+=nodes[3*r]*shaperesult[r];
+      current_position[1]+=nodes[3*r+1]*shaperesult[r];
+      current_position[2]+=nodes[3*r+2]*shaperesult[r];
       if(quad_flux_flag){
-        current_velocity[0]+=node_velocities[r][0]*shaperesult[0][r];
-        current_velocity[1]+=node_velocities[r][1]*shaperesult[0][r];
-        current_velocity[2]+=node_velocities[r][2]*shaperesult[0][r];
+        current_velocity[0]+=node_velocities[3*r]*shaperesult[r];
+        current_velocity[1]+=node_velocities[3*r+1]*shaperesult[r];
+        current_velocity[2]+=node_velocities[3*r+2]*shaperesult[r];
       }
     }
   }
@@ -891,197 +1098,166 @@ void PairCAC::interpolation(int iii, double sq, double tq, double wq){
   }
 
   //compute interpolation for neighbor coordinates
-  for (int l = 0; l < neigh_max; l++) {
-    inner_etypes[l] = element_type[inner_indices[l][0]];
-    //Q8 interpolation scheme
-    if(inner_etypes[l]==1){
-    s = inner_ucells[l][0];
-    t = inner_ucells[l][1];
-    w = inner_ucells[l][2];
-    sp = (1+s)/8;
-    sm = (1-s)/8;
-    tp = 1+t;
-    tm = 1-t;
-    wp = 1+w;
-    wm = 1-w;
-    nodes = nodal_positions[inner_indices[l][0]][inner_indices[l][1]];
-    if(quad_flux_flag)
-    node_velocities = nodal_velocities[inner_indices[l][0]][inner_indices[l][1]];
-    shaperesult[l][0]= sm*tm*wm;
-    shaperesult[l][1]= sp*tm*wm;
-    shaperesult[l][2]= sp*tp*wm;
-    shaperesult[l][3]= sm*tp*wm;
-    shaperesult[l][4]= sm*tm*wp;
-    shaperesult[l][5]= sp*tm*wp;
-    shaperesult[l][6]= sp*tp*wp;
-    shaperesult[l][7]= sm*tp*wp;
-    for(int r = 0; r < 8; r++){
-      inner_neighbor_coords[l][0]+=nodes[r][0]*shaperesult[l][r];
-      inner_neighbor_coords[l][1]+=nodes[r][1]*shaperesult[l][r];
-      inner_neighbor_coords[l][2]+=nodes[r][2]*shaperesult[l][r];
-      if(quad_flux_flag){
-        inner_neighbor_velocities[l][0]+=node_velocities[r][0]*shaperesult[l][r];
-        inner_neighbor_velocities[l][1]+=node_velocities[r][1]*shaperesult[l][r];
-        inner_neighbor_velocities[l][2]+=node_velocities[r][2]*shaperesult[l][r];
-      }
-    }
-    }
-    //add new shape function block here
-    if (inner_etypes[l]==2){
+  interpolate_neighbors(inner_quad_lists_counts[pqi], inner_quad_lists_ucell[pqi],
+    inner_quad_lists_index[pqi], inner_neighbor_coords, inner_neighbor_velocities);
 
-    }
-    //consider atoms
-    if(inner_etypes[l]==0){	
-    inner_neighbor_coords[l][0] = x[inner_indices[l][0]][0];
-    inner_neighbor_coords[l][1] = x[inner_indices[l][0]][1];
-    inner_neighbor_coords[l][2] = x[inner_indices[l][0]][2];
-    if(quad_flux_flag){
-      inner_neighbor_velocities[l][0] = v[inner_indices[l][0]][0];
-      inner_neighbor_velocities[l][1] = v[inner_indices[l][0]][1];
-      inner_neighbor_velocities[l][2] = v[inner_indices[l][0]][2];
-    }
-    }
+  if(outer_neighflag)
+    interpolate_neighbors(outer_quad_lists_counts[pqi], outer_quad_lists_ucell[pqi],
+      outer_quad_lists_index[pqi], outer_neighbor_coords, outer_neighbor_velocities);
 
-  }
+  if(quad_flux_flag)
+    interpolate_neighbors(add_quad_lists_counts[pqi], add_quad_lists_ucell[pqi],
+      add_quad_lists_index[pqi], add_neighbor_coords, add_neighbor_velocities);
+  if(stage_timing) stage_time[INTERP] += MPI_Wtime() - stage_start;
+}
 
-  if(outer_neighflag){
-  outer_ucells = outer_quad_lists_ucell[pqi];
-  outer_indices = outer_quad_lists_index[pqi];
-  //init coords to zero etc.
-  for (int l = 0; l < outer_neigh_max; l++) {
-    outer_neighbor_coords[l][0] = 0;
-    outer_neighbor_coords[l][1] = 0;
-    outer_neighbor_coords[l][2] = 0;
-    if(quad_flux_flag){
-      outer_neighbor_velocities[l][0] = 0;
-      outer_neighbor_velocities[l][1] = 0;
-      outer_neighbor_velocities[l][2] = 0;
-    }
-  }
+/* ---------------------------------------------------------------------- 
+ interpolate the positions (and velocities when computing flux) of one
+ virtual neighbor list into the given neighbor buffers; the buffers are
+ sized by allocate_quad_memory for the current quadrature point.
+ consecutive Q8 neighbors from the same element and poly are handled in
+ batches that load the nodes once and evaluate all unit cells in SIMD lanes
+---------------------------------------------------------------------- */
 
-  //compute interpolation for outer neighbor coordinates
-  for (int l = 0; l < outer_neigh_max; l++) {
-    outer_etypes[l] = element_type[outer_indices[l][0]];
-    //Q8 interpolation scheme
-    if(outer_etypes[l]==1){
-    s = outer_ucells[l][0];
-    t = outer_ucells[l][1];
-    w = outer_ucells[l][2];
-    sp = (1+s)/8;
-    sm = (1-s)/8;
-    tp = 1+t;
-    tm = 1-t;
-    wp = 1+w;
-    wm = 1-w;
-    nodes = nodal_positions[outer_indices[l][0]][outer_indices[l][1]];
-    if(quad_flux_flag)
-    node_velocities = nodal_velocities[outer_indices[l][0]][outer_indices[l][1]];
-    shaperesult[l][0]= sm*tm*wm;
-    shaperesult[l][1]= sp*tm*wm;
-    shaperesult[l][2]= sp*tp*wm;
-    shaperesult[l][3]= sm*tp*wm;
-    shaperesult[l][4]= sm*tm*wp;
-    shaperesult[l][5]= sp*tm*wp;
-    shaperesult[l][6]= sp*tp*wp;
-    shaperesult[l][7]= sm*tp*wp;
-    for(int r = 0; r < 8; r++){
-      outer_neighbor_coords[l][0]+=nodes[r][0]*shaperesult[l][r];
-      outer_neighbor_coords[l][1]+=nodes[r][1]*shaperesult[l][r];
-      outer_neighbor_coords[l][2]+=nodes[r][2]*shaperesult[l][r];
-      if(quad_flux_flag){
-        outer_neighbor_velocities[l][0]+=node_velocities[r][0]*shaperesult[l][r];
-        outer_neighbor_velocities[l][1]+=node_velocities[r][1]*shaperesult[l][r];
-        outer_neighbor_velocities[l][2]+=node_velocities[r][2]*shaperesult[l][r];
-      }
+void PairCAC::interpolate_neighbors(int neigh_max, double **ucells, int **indices,
+  double **coords, double **velocities){
+
+  int *element_type = atom->element_type;
+  double **x = atom->x;
+  double **v = atom->v;
+  int l = 0;
+
+  while (l < neigh_max) {
+    int jelement = indices[l][0];
+    int jpoly = indices[l][1];
+    int etype = element_type[jelement];
+
+    //Q8 interpolation scheme over the run of neighbors sharing these nodes
+    if(etype==1){
+      int lend = l + 1;
+      while (lend < neigh_max && lend - l < INTERP_BATCH &&
+             indices[lend][0] == jelement && indices[lend][1] == jpoly) lend++;
+      interpolate_batch(l, lend, jelement, jpoly, ucells, coords, velocities);
+      l = lend;
+      continue;
     }
-  }
     //add new shape function block here
-    if (outer_etypes[l]==2){
-
+    else if (etype==2){
+    coords[l][0] = 0;
+    coords[l][1] = 0;
+    coords[l][2] = 0;
+    if(quad_flux_flag){
+      velocities[l][0] = 0;
+      velocities[l][1] = 0;
+      velocities[l][2] = 0;
+    }
     }
     //consider atoms
-    if(outer_etypes[l]==0){
-    outer_neighbor_coords[l][0] = x[outer_indices[l][0]][0];
-    outer_neighbor_coords[l][1] = x[outer_indices[l][0]][1];
-    outer_neighbor_coords[l][2] = x[outer_indices[l][0]][2];
+    else if(etype==0){
+    coords[l][0] = x[jelement][0];
+    coords[l][1] = x[jelement][1];
+    coords[l][2] = x[jelement][2];
     if(quad_flux_flag){
-      outer_neighbor_velocities[l][0] = v[outer_indices[l][0]][0];
-      outer_neighbor_velocities[l][1] = v[outer_indices[l][0]][1];
-      outer_neighbor_velocities[l][2] = v[outer_indices[l][0]][2];
+      velocities[l][0] = v[jelement][0];
+      velocities[l][1] = v[jelement][1];
+      velocities[l][2] = v[jelement][2];
     }
     }
-  }	  
+    l++;
   }
+}
 
-  if(quad_flux_flag){
-  add_ucells = add_quad_lists_ucell[pqi];
-  add_indices = add_quad_lists_index[pqi];
-  //init coords to zero etc.
-  for (int l = 0; l < add_neigh_max; l++) {
-  add_neighbor_coords[l][0] = 0;
-  add_neighbor_coords[l][1] = 0;
-  add_neighbor_coords[l][2] = 0;
-  if(quad_flux_flag){
-    add_neighbor_velocities[l][0] = 0;
-    add_neighbor_velocities[l][1] = 0;
-    add_neighbor_velocities[l][2] = 0;
+/* ---------------------------------------------------------------------- 
+ Q8 interpolation of neighbors lfirst..llast-1, which all lie in poly
+ jpoly of element jelement; the unit cell coordinates are gathered into
+ SoA lanes so the shape function and coordinate sums vectorize, then the
+ results are scattered back to the neighbor buffers
+---------------------------------------------------------------------- */
+
+void PairCAC::interpolate_batch(int lfirst, int llast, int jelement, int jpoly,
+  double **ucells, double **coords, double **velocities){
+
+  double *nodes = atom->nodal_positions[jelement][jpoly][0];
+  double node_x[8], node_y[8], node_z[8];
+  double lane_s[INTERP_BATCH], lane_t[INTERP_BATCH], lane_w[INTERP_BATCH];
+  double lane_x[INTERP_BATCH], lane_y[INTERP_BATCH], lane_z[INTERP_BATCH];
+  double lane_shape[8][INTERP_BATCH];
+  int n = llast - lfirst;
+
+  for (int r = 0; r < 8; r++) {
+    node_x[r] = nodes[3*r];
+    node_y[r] = nodes[3*r+1];
+    node_z[r] = nodes[3*r+2];
   }
+  for (int k = 0; k < n; k++) {
+    lane_s[k] = ucells[lfirst+k][0];
+    lane_t[k] = ucells[lfirst+k][1];
+    lane_w[k] = ucells[lfirst+k][2];
   }
-  
-  //compute interpolation for additional neighbor coordinates
-  for (int l = 0; l < add_neigh_max; l++) {
-    add_etypes[l] = element_type[add_indices[l][0]];
-    //Q8 interpolation scheme
-    if(add_etypes[l]==1){
-    s = add_ucells[l][0];
-    t = add_ucells[l][1];
-    w = add_ucells[l][2];
-    sp = (1+s)/8;
-    sm = (1-s)/8;
-    tp = 1+t;
-    tm = 1-t;
-    wp = 1+w;
-    wm = 1-w;
-    nodes = nodal_positions[add_indices[l][0]][add_indices[l][1]];
-    if(quad_flux_flag)
-    node_velocities = nodal_velocities[add_indices[l][0]][add_indices[l][1]];
-    shaperesult[l][0]= sm*tm*wm;
-    shaperesult[l][1]= sp*tm*wm;
-    shaperesult[l][2]= sp*tp*wm;
-    shaperesult[l][3]= sm*tp*wm;
-    shaperesult[l][4]= sm*tm*wp;
-    shaperesult[l][5]= sp*tm*wp;
-    shaperesult[l][6]= sp*tp*wp;
-    shaperesult[l][7]= sm*tp*wp;
-    for(int r = 0; r < 8; r++){
-      add_neighbor_coords[l][0]+=nodes[r][0]*shaperesult[l][r];
-      add_neighbor_coords[l][1]+=nodes[r][1]*shaperesult[l][r];
-      add_neighbor_coords[l][2]+=nodes[r][2]*shaperesult[l][r];
-      if(quad_flux_flag){
-        add_neighbor_velocities[l][0]+=node_velocities[r][0]*shaperesult[l][r];
-        add_neighbor_velocities[l][1]+=node_velocities[r][1]*shaperesult[l][r];
-        add_neighbor_velocities[l][2]+=node_velocities[r][2]*shaperesult[l][r];
-      }
-    }
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+  for (int k = 0; k < n; k++) {
+    double sp = (1+lane_s[k])/8;
+    double sm = (1-lane_s[k])/8;
+    double tp = 1+lane_t[k];
+    double tm = 1-lane_t[k];
+    double wp = 1+lane_w[k];
+    double wm = 1-lane_w[k];
+    lane_shape[0][k] = sm*tm*wm;
+    lane_shape[1][k] = sp*tm*wm;
+    lane_shape[2][k] = sp*tp*wm;
+    lane_shape[3][k] = sm*tp*wm;
+    lane_shape[4][k] = sm*tm*wp;
+    lane_shape[5][k] = sp*tm*wp;
+    lane_shape[6][k] = sp*tp*wp;
+    lane_shape[7][k] = sm*tp*wp;
+    double xk = 0, yk = 0, zk = 0;
+    for (int r = 0; r < 8; r++) {
+      xk += node_x[r]*lane_shape[r][k];
+      yk += node_y[r]*lane_shape[r][k];
+      zk += node_z[r]*lane_shape[r][k];
+    }
+    lane_x[k] = xk;
+    lane_y[k] = yk;
+    lane_z[k] = zk;
   }
-    //add new shape function block here
-    if (add_etypes[l]==2){
 
+  for (int k = 0; k < n; k++) {
+    double *coord = coords[lfirst+k];
+    coord[0] = lane_x[k];
+    coord[1] = lane_y[k];
+    coord[2] = lane_z[k];
+  }
+
+  if(quad_flux_flag){
+    double *node_velocities = atom->nodal_velocities[jelement][jpoly][0];
+    for (int r = 0; r < 8; r++) {
+      node_x[r] = node_velocities[3*r];
+      node_y[r] = node_velocities[3*r+1];
+      node_z[r] = node_velocities[3*r+2];
+    }
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+    for (int k = 0; k < n; k++) {
+      double xk = 0, yk = 0, zk = 0;
+      for (int r = 0; r < 8; r++) {
+        xk += node_x[r]*lane_shape[r][k];
+        yk += node_y[r]*lane_shape[r][k];
+        zk += node_z[r]*lane_shape[r][k];
+      }
+      lane_x[k] = xk;
+      lane_y[k] = yk;
+      lane_z[k] = zk;
     }
-    //consider atoms
-    if(add_etypes[l]==0){
-    add_neighbor_coords[l][0] = x[add_indices[l][0]][0];
-    add_neighbor_coords[l][1] = x[add_indices[l][0]][1];
-    add_neighbor_coords[l][2] = x[add_indices[l][0]][2];
-    if(quad_flux_flag){
-      add_neighbor_velocities[l][0] = v[add_indices[l][0]][0];
-      add_neighbor_velocities[l][1] = v[add_indices[l][0]][1];
-      add_neighbor_velocities[l][2] = v[add_indices[l][0]][2];
-    }
+    for (int k = 0; k < n; k++) {
+      velocities[lfirst+k][0] = lane_x[k];
+      velocities[lfirst+k][1] = lane_y[k];
+      velocities[lfirst+k][2] = lane_z[k];
     }
   }
-  }
-  
 }
 
 /* ---------------------------------------------------------------------- 
@@ -1796,5 +1972,9 @@ void PairCAC::LUPSolve(double **A, int *P, double *b, int N, double *x) {
 double PairCAC::memory_usage()
 {
   double bytes_used = 0;
+  if(mass_lu_cache){
+    bytes_used += (double)mass_cache_types*max_nodes_per_element*max_nodes_per_element*sizeof(double);
+    bytes_used += (double)mass_cache_types*(max_nodes_per_element+1)*sizeof(int);
+  }
   return bytes_used;
 }
@@ -25,9 +25,12 @@ PairStyle(cac,PairCAC)
 namespace LAMMPS_NS {
 
 class PairCAC : public Pair {
+  friend class PairCACOMP;
+
  public:
 	double cutmax;                // max cutoff for all elements
   int pre_force_flag;           // set to 1 if computing something before force   
+  int local_energy_flag;        // 1 if element energies only depend on their neighbor lists
    
   PairCAC(class LAMMPS *);
   virtual ~PairCAC();
@@ -53,6 +56,14 @@ class PairCAC : public Pair {
  
   virtual double memory_usage();
 
+  //force loop pieces shared with the threaded variants
+  void setup_compute(int);
+  double compute_element(int, int);
+  void setup_thread_copy();
+  void setup_element_cost();
+  void setup_local_energy();
+  void flush_stage_times();
+
  protected:
   int outer_neighflag, current_element_index;
   int sector_flag, flux_enable;
@@ -62,6 +73,9 @@ class PairCAC : public Pair {
   int *current_element_scale;
   double mapped_volume;
   int reneighbor_time;
+  int stage_timing;             // 1 if the force stages are timed for cac_timing
+  enum { INTERP, FDENS, PROJ, FLUX, NSTAGE };
+  double stage_time[NSTAGE];    // interpolation, force density, projection and flux times
   int max_nodes_per_element, neigh_poly_count;
   double virial_density[6], flux_density[24];
   int ***flux_neigh_intercepts, *flux_neigh_nintercepts, **flux_neigh_indices, **nplane_intersects;
@@ -89,6 +103,12 @@ class PairCAC : public Pair {
   double quadrature_energy;
   double **mass_matrix;
   double **mass_copy;
+  double ***mass_lu_cache;      // LU factors of the mass matrix for each element type
+  int **mass_pivot_cache;       // row pivots of the cached LU factors
+  int mass_cache_rank;          // quadrature rank the cache was built with; -1 if stale
+  int mass_cache_types;         // element type count the cache was built with
+  double **current_mass_lu;
+  int *current_pivot;
   double **force_column, **current_virial_projection, **current_flux_projection;
   double *current_nodal_forces, current_position[3], current_velocity[3];
   double *current_force_column, *current_virial_column, *current_flux_column;
@@ -116,6 +136,7 @@ class PairCAC : public Pair {
   int poly_counter;
   int qi, pqi;
   int local_inner_max, local_outer_max, local_add_max, local_all_max;
+  int maxelement_cost;              //allocated length of atom->element_cost
   int vel_inner_max, vel_outer_max;
   double **inner_neighbor_coords, **inner_neighbor_velocities;
   double **outer_neighbor_coords, **outer_neighbor_velocities;
@@ -127,11 +148,15 @@ class PairCAC : public Pair {
 
   //further CAC functions 
   void check_existence_flags();
-  void compute_mass_matrix();
+  void compute_mass_matrix(int);
+  void setup_mass_cache();
   void compute_forcev(int);
   void set_shape_functions();
   void interpolation(int, double, double, double);
+  void interpolate_neighbors(int, double **, int **, double **, double **);
+  void interpolate_batch(int, int, int, int, double **, double **, double **);
   void allocate_quad_memory();
+  void destroy_flux_memory();
   void init_quad_arrays();
   void LUPSolve(double **A, int *P, double *b, int N, double *x);
   int LUPDecompose(double **A, int N, double Tol, int *P);
@@ -139,6 +164,7 @@ class PairCAC : public Pair {
   void quadrature_init(int degree);
   virtual void compute_intersections();
   virtual void quad_neigh_flux();
+  void neigh_flux_stage();
   virtual void current_quad_flux(int, double, double, double);
   virtual double pair_interaction(double, int , int){}
   virtual double pair_interaction_q(double, int, int, double, double){}
@@ -50,6 +50,7 @@ PairCACBuck::PairCACBuck(LAMMPS *lmp) : PairCAC(lmp)
 /* ---------------------------------------------------------------------- */
 
 PairCACBuck::~PairCACBuck() {
+  if (copymode) return;
   if (allocated) {
   memory->destroy(setflag);
   memory->destroy(cutsq);
@@ -304,7 +305,7 @@ void PairCACBuck::force_densities(int iii, double s, double t, double w, double
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
@@ -255,7 +255,7 @@ void PairCACCoulDSF::force_densities(int iii, double s, double t, double w, doub
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
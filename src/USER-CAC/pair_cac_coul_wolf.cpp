@@ -248,7 +248,7 @@ void PairCACCoulWolf::force_densities(int iii, double s, double t, double w, dou
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
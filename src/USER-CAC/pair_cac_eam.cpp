@@ -72,6 +72,12 @@ PairCACEAM::PairCACEAM(LAMMPS *lmp) : PairCAC(lmp)
   add_index = NULL;
   nmax = add_density_count = add_density_max = flux_count = 0;
 
+  density_cache_flag = 0;
+  cache_stamp = cache_nbuckets = cache_count = 0;
+  cache_key = NULL;
+  cache_valid = NULL;
+  cache_rho = NULL;
+
   rhomax = rhomin = 0.0;
 }
 
@@ -83,6 +89,9 @@ PairCACEAM::~PairCACEAM() {
 
   memory->destroy(rho);
   memory->destroy(fp);
+  memory->destroy(cache_key);
+  memory->destroy(cache_valid);
+  memory->destroy(cache_rho);
   if(atom->cac_flux_flag){
     memory->destroy(add_index);
     memory->destroy(add_rho);
@@ -638,6 +647,111 @@ void PairCACEAM::swap_eam(double *fp_caller, double **fp_caller_hold)
   *fp_caller_hold = tmp;
 }
 
+/* ----------------------------------------------------------------------
+   global settings
+------------------------------------------------------------------------- */
+
+void PairCACEAM::settings(int narg, char **arg) {
+  if (narg>2) error->all(FLERR,"Illegal CAC pair_style command");
+
+  for (int iarg = 0; iarg < narg; iarg++) {
+    if (strcmp(arg[iarg], "one") == 0) atom->one_layer_flag=one_layer_flag = 1;
+    else if (strcmp(arg[iarg], "density/cache") == 0) density_cache_flag = 1;
+    else error->all(FLERR, "Unexpected argument in CAC pair style invocation");
+  }
+
+  //the cache is reset once per force evaluation before the element loop
+  pre_force_flag = density_cache_flag;
+  force->newton_pair=0;
+}
+
+/* ----------------------------------------------------------------------
+   invalidate all cached virtual atom densities for a new force evaluation
+------------------------------------------------------------------------- */
+
+void PairCACEAM::pre_force_densities() {
+  int nall = atom->nlocal + atom->nghost;
+
+  cache_stamp++;
+  cache_count = 0;
+  if (cache_nbuckets < 4*nall*atom->maxpoly) grow_density_cache();
+}
+
+/* ----------------------------------------------------------------------
+   double the density cache table and rehash the current entries
+------------------------------------------------------------------------- */
+
+void PairCACEAM::grow_density_cache() {
+  int old_nbuckets = cache_nbuckets;
+  int **old_key = cache_key;
+  int *old_valid = cache_valid;
+  double *old_rho = cache_rho;
+  int nall = atom->nlocal + atom->nghost;
+
+  cache_nbuckets = MAX(old_nbuckets, 1024);
+  while (cache_nbuckets < 4*nall*atom->maxpoly || cache_nbuckets <= 2*cache_count)
+    cache_nbuckets *= 2;
+
+  cache_key = NULL;
+  cache_valid = NULL;
+  cache_rho = NULL;
+  memory->create(cache_key, cache_nbuckets, 5, "pair:cache_key");
+  memory->create(cache_valid, cache_nbuckets, "pair:cache_valid");
+  memory->create(cache_rho, cache_nbuckets, "pair:cache_rho");
+  for (int b = 0; b < cache_nbuckets; b++) cache_valid[b] = cache_stamp - 1;
+
+  for (int b = 0; b < old_nbuckets; b++) {
+    if (old_valid[b] != cache_stamp) continue;
+    int nb = density_cache_slot(old_key[b]);
+    cache_valid[nb] = cache_stamp;
+    cache_rho[nb] = old_rho[b];
+  }
+
+  memory->destroy(old_key);
+  memory->destroy(old_valid);
+  memory->destroy(old_rho);
+}
+
+/* ----------------------------------------------------------------------
+   key a virtual atom by element, poly index and integer unit cell index
+   the unit cell index is recovered from its natural coordinates, which
+   are spaced by 2/element_scale within [-1,1]
+------------------------------------------------------------------------- */
+
+void PairCACEAM::density_cache_key(int element, int poly, double *ucell, int *key) {
+  int **element_scale = atom->element_scale;
+
+  key[0] = element;
+  key[1] = poly;
+  if (atom->element_type[element]) {
+    key[2] = static_cast<int> (lround((ucell[0] + 1.0)*element_scale[element][0]));
+    key[3] = static_cast<int> (lround((ucell[1] + 1.0)*element_scale[element][1]));
+    key[4] = static_cast<int> (lround((ucell[2] + 1.0)*element_scale[element][2]));
+  } else key[2] = key[3] = key[4] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   return the table slot holding key, or the empty slot where it belongs;
+   an empty slot has its key filled in but is not yet marked valid
+------------------------------------------------------------------------- */
+
+int PairCACEAM::density_cache_slot(int *key) {
+  unsigned int hash = 2166136261u;
+  for (int k = 0; k < 5; k++)
+    hash = (hash ^ static_cast<unsigned int> (key[k]))*16777619u;
+
+  int mask = cache_nbuckets - 1;
+  int b = hash & mask;
+  while (cache_valid[b] == cache_stamp) {
+    if (cache_key[b][0] == key[0] && cache_key[b][1] == key[1] &&
+        cache_key[b][2] == key[2] && cache_key[b][3] == key[3] &&
+        cache_key[b][4] == key[4]) return b;
+    b = (b + 1) & mask;
+  }
+  for (int k = 0; k < 5; k++) cache_key[b][k] = key[k];
+  return b;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void *PairCACEAM::extract(const char *str, int &dim)
@@ -680,6 +794,7 @@ void PairCACEAM::force_densities(int iii, double s, double t, double w, double c
   int *nodes_count_list = atom->nodes_per_element_list;
   int origin_type = type_array[poly_counter];
   double cut_add = atom->cut_add;
+  int cache_entry[5], cache_slot;
 
   rcut = cut_global_s;
   
@@ -766,6 +881,17 @@ void PairCACEAM::force_densities(int iii, double s, double t, double w, double c
     coeff = rhor_spline[type2rhor[origin_type][scan_type]][m];
     rho[l+1] += ((coeff[3] * p + coeff[4])*p + coeff[5])*p + coeff[6];
 
+    //reuse the density of this virtual atom if another quadrature point computed it
+    if (density_cache_flag) {
+      density_cache_key(inner_quad_indices[l][0], inner_quad_indices[l][1],
+        inner_quad_lists_ucell[pqi][l], cache_entry);
+      cache_slot = density_cache_slot(cache_entry);
+      if (cache_valid[cache_slot] == cache_stamp) {
+        rho[l+1] = cache_rho[cache_slot];
+        continue;
+      }
+    }
+
     for (int k = 0; k < neigh_max_inner; k++) {
       if(l==k) continue;
       scan_type2 = inner_neighbor_types[k];
@@ -809,6 +935,11 @@ void PairCACEAM::force_densities(int iii, double s, double t, double w, double c
       rho[l + 1] += ((coeff[3] * p + coeff[4])*p + coeff[5])*p + coeff[6];
     }
 
+    if (density_cache_flag) {
+      cache_rho[cache_slot] = rho[l+1];
+      cache_valid[cache_slot] = cache_stamp;
+      if (2*(++cache_count) > cache_nbuckets) grow_density_cache();
+    }
   }
   
   //compute densities for additional neighbors in flux calculation
@@ -1073,7 +1204,7 @@ void PairCACEAM::force_densities(int iii, double s, double t, double w, double c
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
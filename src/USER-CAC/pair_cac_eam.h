@@ -42,6 +42,7 @@ class PairCACEAM : public PairCAC {
   PairCACEAM(class LAMMPS *);
   virtual ~PairCACEAM();
   
+  virtual void settings(int, char **);
   virtual void coeff(int, char **);
   virtual void init_style();
   virtual double init_one(int, int);
@@ -69,6 +70,11 @@ class PairCACEAM : public PairCAC {
   double *rho, *fp, *add_rho, *add_fp;
   int *add_index;
   double density;
+
+  // per step cache of virtual atom densities keyed by (element, poly, unit cell)
+  int density_cache_flag, cache_stamp, cache_nbuckets, cache_count;
+  int **cache_key, *cache_valid;
+  double *cache_rho;
  
   virtual void allocate();
   virtual void read_file(char *);
@@ -113,6 +119,10 @@ class PairCACEAM : public PairCAC {
   virtual void quad_neigh_flux();
 
   //further CAC functions 
+  virtual void pre_force_densities();
+  void grow_density_cache();
+  void density_cache_key(int, int, double *, int *);
+  int density_cache_slot(int *);
   virtual void force_densities(int, double, double, double, double, double
     &fx, double &fy, double &fz);
 
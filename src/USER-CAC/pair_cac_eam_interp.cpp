@@ -72,6 +72,8 @@ PairCACEAMInterp::PairCACEAMInterp(LAMMPS *lmp) : PairCAC(lmp)
   nmax = 0;
   
   flux_enable = pre_force_flag=1;
+  //interpolated densities are computed for all elements before the force loop
+  local_energy_flag = 0;
   quad_electron_densities = NULL;
   max_density = 0;
 }
@@ -968,7 +970,7 @@ void PairCACEAMInterp::force_densities(int iii, double s, double t, double w, do
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
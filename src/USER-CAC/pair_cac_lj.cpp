@@ -51,6 +51,7 @@ PairCACLJ::PairCACLJ(LAMMPS *lmp) : PairCAC(lmp)
 /* ---------------------------------------------------------------------- */
 
 PairCACLJ::~PairCACLJ() {
+  if (copymode) return;
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -299,7 +300,7 @@ void PairCACLJ::force_densities(int iii, double s, double t, double w, double co
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
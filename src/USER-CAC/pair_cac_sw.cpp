@@ -880,7 +880,7 @@ void PairCACSW::force_densities( int iii, double s,double t, double w, double co
   //  in the vicinity of this quadrature point
   if (quad_flux_flag) {
     //compute_intersections();
-    quad_neigh_flux();
+    neigh_flux_stage();
   }
 }
 
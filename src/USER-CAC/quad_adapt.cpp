@@ -0,0 +1,59 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "quad_adapt.h"
+#include <cstring>
+#include "atom.h"
+#include "domain.h"
+#include "utils.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+QuadAdapt::QuadAdapt(LAMMPS *lmp) : Command(lmp) {}
+
+/* ---------------------------------------------------------------------- */
+
+void QuadAdapt::command(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR,"Illegal quad_adapt command");
+  //check if simulation box has been defined
+  if (domain->box_exist == 0)
+    error->all(FLERR,"quad_adapt command before simulation box is defined");
+  //check if CAC atom style is defined
+  if(!atom->CAC_flag)
+  error->all(FLERR, "quad_adapt command requires a CAC atom style");
+
+  if (strcmp(arg[0], "fixed") == 0) {
+    if (narg != 1) error->all(FLERR,"Illegal quad_adapt command");
+    atom->quad_adapt_flag = 0;
+  }
+  else if (strcmp(arg[0], "gradient") == 0) {
+    if (narg != 2 && narg != 4) error->all(FLERR,"Illegal quad_adapt command");
+    double low = utils::numeric(FLERR,arg[1],false,lmp);
+    double high = -1.0;
+    if (narg == 4) {
+      if (strcmp(arg[2], "high") != 0) error->all(FLERR,"Illegal quad_adapt command");
+      high = utils::numeric(FLERR,arg[3],false,lmp);
+      if (high <= low)
+        error->all(FLERR,"Quad_adapt high threshold must exceed the low threshold");
+    }
+    if (low < 0.0) error->all(FLERR,"Illegal quad_adapt command");
+    atom->quad_adapt_flag = 1;
+    atom->quad_adapt_low = low;
+    atom->quad_adapt_high = high;
+  }
+  else error->all(FLERR, "Unexpected argument in quad_adapt command");
+}
@@ -0,0 +1,61 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+
+CommandStyle(quad_adapt,QuadAdapt)
+
+#else
+
+#ifndef LMP_QUAD_ADAPT_H
+#define LMP_QUAD_ADAPT_H
+
+#include "command.h"
+
+namespace LAMMPS_NS {
+
+class QuadAdapt : public Command {
+ public:
+  QuadAdapt(class LAMMPS *);
+  void command(int, char **);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal quad_adapt command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: quad_adapt command before simulation box is defined
+
+Self-explanatory.
+
+E: quad_adapt command requires a CAC atom style
+
+Self-explanatory.
+
+E: Unexpected argument in quad_adapt command
+
+The only accepted styles are fixed and gradient.
+
+E: Quad_adapt high threshold must exceed the low threshold
+
+Elements cannot be both below the low and above the high threshold.
+
+*/
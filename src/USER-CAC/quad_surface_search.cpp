@@ -0,0 +1,41 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "quad_surface_search.h"
+#include <cstring>
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+QuadSurfaceSearch::QuadSurfaceSearch(LAMMPS *lmp) : Command(lmp) {}
+
+/* ---------------------------------------------------------------------- */
+
+void QuadSurfaceSearch::command(int narg, char **arg)
+{
+  if (narg != 1) error->all(FLERR,"Illegal quad_surface_search command");
+  //check if simulation box has been defined
+  if (domain->box_exist == 0)
+    error->all(FLERR,"quad_surface_search command before simulation box is defined");
+  //check if CAC atom style is defined
+  if(!atom->CAC_flag)
+  error->all(FLERR, "quad_surface_search command requires a CAC atom style");
+
+  if (strcmp(arg[0], "projection") == 0) atom->asa_surface_search = 0;
+  else if (strcmp(arg[0], "asa") == 0) atom->asa_surface_search = 1;
+  else error->all(FLERR, "Unexpected argument in quad_surface_search command");
+}
@@ -0,0 +1,52 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+
+CommandStyle(quad_surface_search,QuadSurfaceSearch)
+
+#else
+
+#ifndef LMP_QUAD_SURFACE_SEARCH_H
+#define LMP_QUAD_SURFACE_SEARCH_H
+
+#include "command.h"
+
+namespace LAMMPS_NS {
+
+class QuadSurfaceSearch : public Command {
+ public:
+  QuadSurfaceSearch(class LAMMPS *);
+  void command(int, char **);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: quad_surface_search command before simulation box is defined
+
+Self-explanatory.
+
+E: quad_surface_search command requires a CAC atom style
+
+Self-explanatory.
+
+E: Unexpected argument in quad_surface_search command
+
+The only accepted arguments are projection and asa.
+
+*/
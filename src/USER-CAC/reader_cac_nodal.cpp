@@ -0,0 +1,323 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_cac_nodal.h"
+
+#include "atom.h"
+#include "error.h"
+#include "memory.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+// also in read_dump.cpp
+
+enum{ID,TYPE,X,Y,Z,VX,VY,VZ,Q,IX,IY,IZ,FX,FY,FZ,NODALX,NODALV};
+enum{UNSET,NOSCALE_NOWRAP,NOSCALE_WRAP,SCALE_NOWRAP,SCALE_WRAP};
+
+// file layout is documented in dump_cac_nodal_binary.cpp
+
+#define MAGIC "CACNODAL"
+#define VERSION 1
+#define SKIPCHUNK 16384
+
+enum{POSITIONS=1,VELOCITIES=2,FORCES=4};
+
+// fieldindex values besides the nodal array index
+
+enum{NODATA=-1,ELEMENTID=3,NODETYPE=4};
+
+/* ---------------------------------------------------------------------- */
+
+ReaderCACNodal::ReaderCACNodal(LAMMPS *lmp) : Reader(lmp)
+{
+  file_header = 0;
+  fieldmask = 0;
+  conn = nullptr;
+  first = nullptr;
+  nconn = maxconn = 0;
+  for (int i = 0; i < 3; i++) {
+    nodal[i] = nullptr;
+    maxnodal[i] = 0;
+  }
+  fieldindex = nullptr;
+  fieldoffset = nullptr;
+  fieldnodal = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+ReaderCACNodal::~ReaderCACNodal()
+{
+  memory->destroy(conn);
+  memory->destroy(first);
+  for (int i = 0; i < 3; i++) memory->destroy(nodal[i]);
+  memory->destroy(fieldindex);
+  memory->destroy(fieldoffset);
+  memory->destroy(fieldnodal);
+}
+
+/* ----------------------------------------------------------------------
+   every file starts with its own file header and connectivity
+------------------------------------------------------------------------- */
+
+void ReaderCACNodal::open_file(const char *file)
+{
+  Reader::open_file(file);
+  file_header = 0;
+  nconn = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderCACNodal::read_buf(void *ptr, size_t size, size_t num)
+{
+  if (fread(ptr,size,num,fp) != num)
+    error->one(FLERR,"Unexpected end of dump file");
+}
+
+/* ----------------------------------------------------------------------
+   skip n doubles; fseek() is not possible on gzip pipes
+------------------------------------------------------------------------- */
+
+void ReaderCACNodal::skip_buf(bigint n)
+{
+  double tmp[SKIPCHUNK];
+  while (n > 0) {
+    bigint nchunk = MIN(n,SKIPCHUNK);
+    read_buf(tmp,sizeof(double),nchunk);
+    n -= nchunk;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read and return time stamp from dump file
+   if first read reaches end-of-file, return 1 so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderCACNodal::read_time(bigint &ntimestep)
+{
+  if (!file_header) {
+    char magic[8];
+    int values[4];
+    if (fread(magic,sizeof(char),8,fp) != 8) return 1;
+    if (strncmp(magic,MAGIC,8) != 0)
+      error->one(FLERR,"Dump file is incorrectly formatted");
+    read_buf(values,sizeof(int),4);
+    if (values[0] != VERSION)
+      error->one(FLERR,"Dump file is incorrectly formatted");
+    fieldmask = values[1];
+    file_nodes = values[2];
+    file_maxpoly = values[3];
+    conn_size = 7 + file_maxpoly;
+    file_header = 1;
+  }
+
+  if (fread(&ntimestep,sizeof(bigint),1,fp) != 1) return 1;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip snapshot from timestamp onward
+   the connectivity is kept since later snapshots may refer to it
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderCACNodal::skip()
+{
+  read_frame_header();
+  if (connflag) read_connectivity();
+  for (int ifield = 0; ifield < 3; ifield++)
+    if (fieldmask & (1 << ifield)) skip_buf(3*nnodes);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderCACNodal::read_frame_header()
+{
+  bigint counts[2];
+  read_buf(&triclinic,sizeof(int),1);
+  read_buf(&connflag,sizeof(int),1);
+  read_buf(&box[0][0],sizeof(double),9);
+  read_buf(counts,sizeof(bigint),2);
+  nelements = counts[0];
+  nnodes = counts[1];
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderCACNodal::read_connectivity()
+{
+  if (nelements > maxconn) {
+    maxconn = nelements;
+    memory->destroy(conn);
+    memory->destroy(first);
+    memory->create(conn,maxconn*conn_size,"read_dump:conn");
+    memory->create(first,maxconn,"read_dump:first");
+  }
+  read_buf(conn,sizeof(double),nelements*conn_size);
+  nconn = nelements;
+
+  bigint n = 0;
+  for (bigint i = 0; i < nelements; i++) {
+    first[i] = n;
+    double *one = &conn[i*conn_size];
+    n += 3 * static_cast<bigint> (one[2]) * static_cast<bigint> (one[3]);
+  }
+  if (n != 3*nnodes) error->one(FLERR,"Dump file is incorrectly formatted");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderCACNodal::read_nodal()
+{
+  for (int ifield = 0; ifield < 3; ifield++) {
+    if (!(fieldmask & (1 << ifield))) continue;
+    if (3*nnodes > maxnodal[ifield]) {
+      maxnodal[ifield] = 3*nnodes;
+      memory->destroy(nodal[ifield]);
+      memory->create(nodal[ifield],maxnodal[ifield],"read_dump:nodal");
+    }
+    read_buf(nodal[ifield],sizeof(double),3*nnodes);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read remaining header info and the nodal data of the snapshot:
+     return number of elements
+     box bounds, triclinic, fieldflag (-1 if any fields not found),
+     xyz flags = UNSET (not a requested field) or NOSCALE_WRAP
+   if fieldflag set:
+     match Nfield fields to the stored nodal arrays
+     x,y,z and v,f are the averages over the nodes of each element,
+     nodal/positions and nodal/velocities are the nodal values in the
+     per element layout of the CAC atom style
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderCACNodal::read_header(double boxout[3][3], int &boxinfo, int &triclinic_snap,
+                                   int fieldinfo, int nfield,
+                                   int *fieldtype, char ** /*fieldlabel*/,
+                                   int /*scaleflag*/, int /*wrapflag*/, int &fieldflag,
+                                   int &xflag, int &yflag, int &zflag)
+{
+  read_frame_header();
+  if (connflag) read_connectivity();
+  if (nconn != nelements)
+    error->one(FLERR,"CAC nodal dump file has no element connectivity");
+  read_nodal();
+  ielement = 0;
+
+  boxinfo = 1;
+  triclinic_snap = triclinic;
+  memcpy(&boxout[0][0],&box[0][0],9*sizeof(double));
+
+  if (!fieldinfo) return nelements;
+
+  memory->destroy(fieldindex);
+  memory->destroy(fieldoffset);
+  memory->destroy(fieldnodal);
+  memory->create(fieldindex,nfield,"read_dump:fieldindex");
+  memory->create(fieldoffset,nfield,"read_dump:fieldoffset");
+  memory->create(fieldnodal,nfield,"read_dump:fieldnodal");
+
+  xflag = yflag = zflag = UNSET;
+  fieldflag = 0;
+  int nodalx = 0, nodalv = 0;
+
+  for (int i = 0; i < nfield; i++) {
+    int ifield = NODATA;
+    fieldoffset[i] = 0;
+    fieldnodal[i] = 0;
+    switch (fieldtype[i]) {
+    case ID:
+      ifield = ELEMENTID;
+      break;
+    case TYPE:
+      ifield = NODETYPE;
+      break;
+    case X: case Y: case Z:
+      if (fieldmask & POSITIONS) ifield = 0;
+      fieldoffset[i] = fieldtype[i] - X;
+      if (fieldtype[i] == X) xflag = NOSCALE_WRAP;
+      else if (fieldtype[i] == Y) yflag = NOSCALE_WRAP;
+      else zflag = NOSCALE_WRAP;
+      break;
+    case VX: case VY: case VZ:
+      if (fieldmask & VELOCITIES) ifield = 1;
+      fieldoffset[i] = fieldtype[i] - VX;
+      break;
+    case FX: case FY: case FZ:
+      if (fieldmask & FORCES) ifield = 2;
+      fieldoffset[i] = fieldtype[i] - FX;
+      break;
+    case NODALX:
+      if (fieldmask & POSITIONS) ifield = 0;
+      fieldoffset[i] = nodalx++;
+      fieldnodal[i] = 1;
+      break;
+    case NODALV:
+      if (fieldmask & VELOCITIES) ifield = 1;
+      fieldoffset[i] = nodalv++;
+      fieldnodal[i] = 1;
+      break;
+    }
+    fieldindex[i] = ifield;
+    if (ifield == NODATA) fieldflag = -1;
+  }
+
+  return nelements;
+}
+
+/* ----------------------------------------------------------------------
+   fill the fields of the next N elements of the snapshot
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderCACNodal::read_atoms(int n, int nfield, double **fields)
+{
+  int npe = atom->nodes_per_element;
+  int maxpoly = atom->maxpoly;
+
+  for (int i = 0; i < n; i++, ielement++) {
+    if (ielement >= nelements) error->one(FLERR,"Unexpected end of dump file");
+    double *one = &conn[ielement*conn_size];
+    int poly = static_cast<int> (one[2]);
+    int nodes = static_cast<int> (one[3]);
+    int nvalues = poly*nodes;
+
+    for (int m = 0; m < nfield; m++) {
+      int ifield = fieldindex[m];
+      double value = 0.0;
+
+      if (ifield == ELEMENTID) value = one[0];
+      else if (ifield == NODETYPE) value = one[7];
+      else if (!fieldnodal[m]) {
+        double *values = &nodal[ifield][first[ielement]];
+        for (int k = 0; k < nvalues; k++) value += values[3*k + fieldoffset[m]];
+        value /= nvalues;
+      } else {
+        if (poly > maxpoly || nodes > npe)
+          error->one(FLERR,"CAC nodal dump element does not fit the atom style");
+        double *values = &nodal[ifield][first[ielement]];
+        int k = fieldoffset[m] / (3*npe);
+        int j = (fieldoffset[m] % (3*npe)) / 3;
+        int dim = fieldoffset[m] % 3;
+        if (k < poly && j < nodes) value = values[3*(k*nodes + j) + dim];
+      }
+      fields[i][m] = value;
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+
+ReaderStyle(cac/nodal,ReaderCACNodal)
+
+#else
+
+#ifndef LMP_READER_CAC_NODAL_H
+#define LMP_READER_CAC_NODAL_H
+
+#include "reader.h"
+
+namespace LAMMPS_NS {
+
+class ReaderCACNodal : public Reader {
+ public:
+  ReaderCACNodal(class LAMMPS *);
+  ~ReaderCACNodal();
+
+  int read_time(bigint &);
+  void skip();
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &);
+  void read_atoms(int, int, double **);
+  void open_file(const char *);
+
+ private:
+  int file_header;       // 1 once the file header was read
+  int fieldmask;         // nodal arrays stored in the file
+  int file_nodes, file_maxpoly;
+  int conn_size;         // doubles per element in the connectivity block
+
+  int triclinic;
+  int connflag;
+  double box[3][3];
+  bigint nelements, nnodes;
+
+  double *conn;          // connectivity of the current snapshot
+  bigint *first;         // first node value of each element in the nodal blocks
+  bigint nconn, maxconn;
+  double *nodal[3];      // positions, velocities, forces of the current snapshot
+  bigint maxnodal[3];
+  bigint ielement;       // next element returned by read_atoms()
+
+  int *fieldindex;       // which quantity each requested field maps to
+  int *fieldoffset;      // component or column of each requested field
+  int *fieldnodal;       // 1 if a field is a nodal column, 0 if an average
+
+  void read_buf(void *, size_t, size_t);
+  void skip_buf(bigint);
+  void read_frame_header();
+  void read_connectivity();
+  void read_nodal();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Dump file is incorrectly formatted
+
+The file is not a dump cac/nodal/binary file.
+
+E: Unexpected end of dump file
+
+A read operation from the file failed.
+
+E: CAC nodal dump file has no element connectivity
+
+Snapshots of the file refer to a connectivity block that was not read.
+
+E: CAC nodal dump element does not fit the atom style
+
+The dumped element has more nodes or internal degrees of freedom than
+the CAC atom style was defined with.
+
+*/
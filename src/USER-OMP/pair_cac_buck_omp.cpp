@@ -0,0 +1,58 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_cac_buck_omp.h"
+
+#include "suffix.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairCACBuckOMP::PairCACBuckOMP(LAMMPS *lmp) :
+  PairCACBuck(lmp), PairCACOMP(lmp)
+{
+  suffix_flag |= Suffix::OMP;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairCACBuckOMP::init_style()
+{
+  PairCACBuck::init_style();
+
+  // settings, coefficients or quadrature may have changed since the last run
+  destroy_thr_pair();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairCACBuckOMP::compute(int eflag, int vflag)
+{
+  compute_thr(this,eflag,vflag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairCAC *PairCACBuckOMP::copy_pair()
+{
+  return new PairCACBuck(*this);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairCACBuckOMP::memory_usage()
+{
+  double bytes = memory_usage_cac();
+  bytes += PairCACBuck::memory_usage();
+
+  return bytes;
+}
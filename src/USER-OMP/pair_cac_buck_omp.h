@@ -0,0 +1,44 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(cac/buck/omp,PairCACBuckOMP);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_CAC_BUCK_OMP_H
+#define LMP_PAIR_CAC_BUCK_OMP_H
+
+#include "pair_cac_buck.h"
+#include "pair_cac_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairCACBuckOMP : public PairCACBuck, public PairCACOMP {
+
+ public:
+  PairCACBuckOMP(class LAMMPS *);
+
+  virtual void compute(int, int);
+  virtual void init_style();
+  virtual double memory_usage();
+
+ protected:
+  virtual PairCAC *copy_pair();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
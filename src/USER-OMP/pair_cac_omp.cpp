@@ -0,0 +1,193 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_cac_omp.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "comm.h"
+#include "memory.h"
+#include "pair_cac.h"
+
+#include "omp_compat.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairCACOMP::PairCACOMP(LAMMPS *lmp) : ThrOMP(lmp, THR_PAIR)
+{
+  thr_pair = nullptr;
+  nthr_pair = 0;
+  element_qi = nullptr;
+  maxelement = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairCACOMP::~PairCACOMP()
+{
+  destroy_thr_pair();
+  lmp->memory->destroy(element_qi);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairCACOMP::compute_thr(PairCAC *pair, int eflag, int vflag)
+{
+  Atom *atom = lmp->atom;
+
+  // fix omp takes over clearing forces from the integrator,
+  // but it does not know about the CAC nodal force and virial arrays
+
+  atom->avec->force_clear(0,0);
+
+  // the cac flux computation accumulates into shared nodal flux arrays
+
+  if (atom->flux_compute) {
+    pair->PairCAC::compute(eflag,vflag);
+    return;
+  }
+
+  pair->ev_init(eflag,vflag);
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nlocal = atom->nlocal;
+
+  pair->setup_compute(eflag);
+  pair->setup_element_cost();
+  setup_thr_pair(pair);
+
+  // elements are processed in any order by the threads,
+  // so precompute where each one starts in the quadrature point data
+
+  if (nlocal > maxelement) {
+    maxelement = atom->nmax;
+    lmp->memory->destroy(element_qi);
+    lmp->memory->create(element_qi,maxelement,"pair:element_qi");
+  }
+  int iqi = 0;
+  for (int i = 0; i < nlocal; i++) {
+    element_qi[i] = iqi;
+    iqi += pair->quadrature_counts[i];
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(pair,eflag,vflag)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, pair->eatom, pair->vatom, nullptr, thr);
+
+    thr_pair[tid]->setup_compute(eflag);
+    eval(pair, thr_pair[tid], thr);
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(pair, eflag, vflag, thr);
+  } // end of omp parallel region
+
+  // stage times of CAC timing are summed over the threads
+
+  if (pair->stage_timing)
+    for (int tid = 0; tid < nthr_pair; tid++) thr_pair[tid]->flush_stage_times();
+}
+
+/* ----------------------------------------------------------------------
+   elements are disjoint, so each thread writes the nodal forces and
+   virials of the elements it owns without a reduction. element costs
+   differ widely between atoms and large elements; use dynamic scheduling.
+------------------------------------------------------------------------- */
+
+void PairCACOMP::eval(PairCAC *pair, PairCAC *thrpair, ThrData * const thr)
+{
+  Atom *atom = lmp->atom;
+  const int nlocal = atom->nlocal;
+  const int * _noalias const element_type = atom->element_type;
+  const int * _noalias const poly_count = atom->poly_count;
+  int **element_scale = atom->element_scale;
+  const int * _noalias const nodes_count_list = atom->nodes_per_element_list;
+  double ****nodal_virial = atom->nodal_virial;
+  double v[6], energy, volume_ratio;
+  int i, ipoly, inode, nodes_per_element;
+
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+  for (i = 0; i < nlocal; i++) {
+    energy = thrpair->compute_element(i,element_qi[i]);
+
+    if (pair->eflag_either)
+      ev_tally_xyz_full_thr(pair,i,2.0*energy,0.0,0.0,0.0,0.0,0.0,0.0,0.0,thr);
+
+    if (pair->vflag_either) {
+      nodes_per_element = nodes_count_list[element_type[i]];
+      volume_ratio = 1.0;
+      if (element_type[i] != 0)
+        volume_ratio = (element_scale[i][0]*element_scale[i][1]*element_scale[i][2])/
+          nodes_per_element;
+      for (ipoly = 0; ipoly < poly_count[i]; ipoly++)
+        for (inode = 0; inode < nodes_per_element; inode++) {
+          for (int dim = 0; dim < 6; dim++)
+            v[dim] = volume_ratio*nodal_virial[i][ipoly][inode][dim];
+          v_tally_thr(pair,0,0,1,0,v,thr);
+        }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   create one copy of the pair style per thread; thread 0 uses the original
+------------------------------------------------------------------------- */
+
+void PairCACOMP::setup_thr_pair(PairCAC *pair)
+{
+  const int nthreads = lmp->comm->nthreads;
+
+  if (nthr_pair == nthreads) return;
+  destroy_thr_pair();
+
+  nthr_pair = nthreads;
+  thr_pair = new PairCAC*[nthreads];
+  thr_pair[0] = pair;
+  for (int tid = 1; tid < nthreads; tid++) {
+    thr_pair[tid] = copy_pair();
+    thr_pair[tid]->setup_thread_copy();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairCACOMP::destroy_thr_pair()
+{
+  for (int tid = 1; tid < nthr_pair; tid++) delete thr_pair[tid];
+  delete[] thr_pair;
+  thr_pair = nullptr;
+  nthr_pair = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairCACOMP::memory_usage_cac()
+{
+  double bytes = memory_usage_thr();
+  bytes += (double)maxelement*sizeof(int);
+
+  return bytes;
+}
@@ -0,0 +1,51 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PAIR_CAC_OMP_H
+#define LMP_PAIR_CAC_OMP_H
+
+#include "thr_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairCAC;
+
+// threaded force loop shared by the USER-OMP variants of CAC pair styles
+
+class PairCACOMP : public ThrOMP {
+
+ public:
+  PairCACOMP(class LAMMPS *);
+  virtual ~PairCACOMP();
+
+ protected:
+  PairCAC **thr_pair;    // per thread copies owning their quadrature scratch
+  int nthr_pair;
+  int *element_qi;       // index of the first quadrature point of each element
+  int maxelement;
+
+  void compute_thr(PairCAC *, int, int);
+  void destroy_thr_pair();
+  double memory_usage_cac();
+
+  // return a copy of the pair style for use by one thread
+  virtual PairCAC *copy_pair() = 0;
+
+ private:
+  void setup_thr_pair(PairCAC *);
+  void eval(PairCAC *, PairCAC *, ThrData *const thr);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
@@ -53,6 +53,11 @@ using namespace MathConst;
 #define DELTA_PERATOM 64
 #define EPSILON 1.0e-6
 
+// labels of the CAC stage timers in the order of the CAC_TIME enum
+
+const char *Atom::cac_time_names[Atom::CAC_NTIME] =
+  {"Elist","Qpoints","Qlists","Surface","Interp","Fdens","Project","Flux"};
+
 /* ---------------------------------------------------------------------- */
 
 /** \class LAMMPS_NS::Atom
@@ -207,6 +212,19 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
   element_type_count = dense_count = weight_count = 0;
   outer_neigh_flag = ghost_quad_flag = full_quad_flag = cac_flux_flag = flux_compute = 0;
   interface_quadrature = 1;
+  asa_surface_search = 0;
+  quad_neigh_incremental = 0;
+  quad_adapt_flag = 0;
+  quad_adapt_low = 0.0;
+  quad_adapt_high = -1.0;
+  cac_forward_comm = 0;
+  cac_bin_hierarchical = 0;
+  cac_bin_coarse_factor = 4;
+  cac_timing_flag = 0;
+  for (int i = 0; i < CAC_NTIME; i++) cac_times[i] = 0.0;
+  for (int i = 0; i < CAC_NCOUNT; i++) cac_counts[i] = 0.0;
+  element_cost_flag = element_cost_count = 0;
+  element_cost = NULL;
 
   // USER-DPD package
 
@@ -384,6 +402,7 @@ Atom::~Atom()
   memory->destroy(eboxes);
   memory->destroy(ebox_ref);
   memory->destroy(neighbor_weights);
+  memory->destroy(element_cost);
   memory->destroy(element_names);
   memory->destroy(min_x);
   memory->destroy(min_v);
@@ -813,6 +832,13 @@ void Atom::init()
       error->all(FLERR,"Could not find atom_modify first group ID");
   } else firstgroup = -1;
 
+  // CAC stage timers cover the run that follows
+
+  if (CAC_flag) {
+    for (int i = 0; i < CAC_NTIME; i++) cac_times[i] = 0.0;
+    for (int i = 0; i < CAC_NCOUNT; i++) cac_counts[i] = 0.0;
+  }
+
   // init AtomVec
 
   avec->init();
@@ -1087,10 +1113,12 @@ void Atom::deallocate_topology()
 /* ----------------------------------------------------------------------
    unpack N lines from Atom section of data file
    call style-specific routine to parse line
+   if allflag, keep all atoms inside the global box, not just my sub-domain
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
-                      int type_offset, int shiftflag, double *shift)
+                      int type_offset, int shiftflag, double *shift,
+                      int allflag)
 {
   int m,xptr,iptr;
   imageint imagedata;
@@ -1162,6 +1190,25 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     }
   }
 
+  // for a parallel read, every proc parses different lines of the file
+  // keep all atoms in the global box, caller migrates them to their owners
+
+  if (allflag) {
+    for (int idim = 0; idim < 3; idim++) {
+      if (triclinic == 0) {
+        sublo[idim] = domain->boxlo[idim];
+        subhi[idim] = domain->boxhi[idim];
+      } else {
+        sublo[idim] = 0.0;
+        subhi[idim] = 1.0;
+      }
+      if (domain->periodicity[idim]) {
+        sublo[idim] -= epsilon[idim];
+        subhi[idim] += epsilon[idim];
+      }
+    }
+  }
+
   // xptr = which word in line starts xyz coords
   // iptr = which word in line starts ix,iy,iz image flags
 
@@ -1750,10 +1797,11 @@ void Atom::data_bodies(int n, char *buf, AtomVec *avec_body, tagint id_offset)
 
 /* ----------------------------------------------------------------------
 unpack N lines from CAC section of data file
+if allflag, keep all elements inside the global box, not just my sub-domain
 ------------------------------------------------------------------------- */
 
 void Atom::data_CAC(int n, char *buf, tagint id_offset, int type_offset,
-  int shiftflag, double *shift)
+  int shiftflag, double *shift, int allflag)
 {
 
   int m, xptr, iptr, npoly, nodecount;
@@ -1823,6 +1871,25 @@ void Atom::data_CAC(int n, char *buf, tagint id_offset, int type_offset,
     }
   }
 
+  // for a parallel read, every proc parses different lines of the file
+  // keep all atoms in the global box, caller migrates them to their owners
+
+  if (allflag) {
+    for (int idim = 0; idim < 3; idim++) {
+      if (triclinic == 0) {
+        sublo[idim] = domain->boxlo[idim];
+        subhi[idim] = domain->boxhi[idim];
+      } else {
+        sublo[idim] = 0.0;
+        subhi[idim] = 1.0;
+      }
+      if (domain->periodicity[idim]) {
+        sublo[idim] -= epsilon[idim];
+        subhi[idim] += epsilon[idim];
+      }
+    }
+  }
+
   // loop over lines of CAC data
   // tokenize the lines into values
   // extract xyz coords and image flags
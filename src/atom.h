@@ -33,6 +33,9 @@ class Atom : protected Pointers {
   enum { GROW = 0, RESTART = 1, BORDER = 2 };
   enum { ATOMIC = 0, MOLECULAR = 1, TEMPLATE = 2 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { CAC_TIME_ELIST, CAC_TIME_QPOINTS, CAC_TIME_QLISTS, CAC_TIME_SURF,
+         CAC_TIME_INTERP, CAC_TIME_FDENS, CAC_TIME_PROJ, CAC_TIME_FLUX, CAC_NTIME };
+  enum { CAC_COUNT_BUILD, CAC_COUNT_QUAD, CAC_COUNT_NEIGH, CAC_COUNT_SURF, CAC_NCOUNT };
 
   // atom counts
 
@@ -127,6 +130,8 @@ class Atom : protected Pointers {
   int nodes_per_element, maxpoly, words_per_node; //maximum number of nodes and atoms per unit cell per element in model
 	// followed by number of words per node in a data file and the number of pure atoms in the CAC model
 
+  // nodal 4D arrays are views into contiguous per element blocks; &array[i][0][0][0]
+  // addresses all poly_count*node_count entries of element i back to back
   double **node_charges, ****nodal_positions, ****nodal_velocities, ****nodal_forces, ****nodal_fluxes,
 	  ****nodal_gradients, ****initial_nodal_positions, **eboxes, **foreign_eboxes,
     ****nodal_virial, ***inner_quad_lists_ucell, ***outer_quad_lists_ucell, ***add_quad_lists_ucell, **quadrature_point_data,
@@ -142,6 +147,20 @@ class Atom : protected Pointers {
 
   int one_layer_flag, weight_count,CAC_pair_flag, element_type_count,
     outer_neigh_flag, ghost_quad_flag, sector_flag, full_quad_flag, cac_flux_flag, flux_compute;
+  int asa_surface_search;               //1 if quadrature neighboring uses the asa_cg surface search
+  int quad_neigh_incremental;           //1 if quadrature neighbor lists are kept for elements that barely moved
+  int quad_adapt_flag;                  //1 if each element picks its quadrature order from its deformation gradient
+  double quad_adapt_low, quad_adapt_high; //gradient variation below/above which elements use order 1/3; high < 0 disables 3
+  int cac_forward_comm;                 //ghost data sent by CAC forward comm; 0 full, 1 nodal, 2 float deltas
+  int cac_bin_hierarchical;             //1 if large elements are binned in a coarse grid for neighboring
+  int cac_bin_coarse_factor;            //fine neighbor bins per coarse bin along each dimension
+  int cac_timing_flag;                  //1 if CAC pair and neighbor styles time their stages
+  double cac_times[CAC_NTIME];          //wall time of each CAC stage since the last init
+  double cac_counts[CAC_NCOUNT];        //neighbor builds, quadrature points, quadrature neighbors, surface search iterations
+  static const char *cac_time_names[CAC_NTIME];
+  int element_cost_flag;                //1 if CAC pair styles time the force computation of each element
+  int element_cost_count;               //number of local elements element_cost was measured for
+  double *element_cost;                 //per element force computation time used by balance weight cac
   double max_search_range;              //currently used by comm style to determine communication overlap range
   char **element_names;                 //stores names for element types
   double *min_x, *min_v, *min_f;        //used by CAC min styles
@@ -330,7 +349,7 @@ class Atom : protected Pointers {
 
   void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int);
   void data_vels(int, char *, tagint);
   void data_bonds(int, char *, int *, tagint, int);
   void data_angles(int, char *, int *, tagint, int);
@@ -338,7 +357,7 @@ class Atom : protected Pointers {
   void data_impropers(int, char *, int *, tagint, int);
   void data_bonus(int, char *, class AtomVec *, tagint);
   void data_bodies(int, char *, class AtomVec *, tagint);
-  void data_CAC(int, char *, tagint, int, int, double *);
+  void data_CAC(int, char *, tagint, int, int, double *, int);
   void data_fix_compute_variable(int, int);
 
   virtual void allocate_type_arrays();
@@ -28,6 +28,7 @@
 #include "domain.h"
 #include "fix_store.h"
 #include "imbalance.h"
+#include "imbalance_cac.h"
 #include "imbalance_group.h"
 #include "imbalance_neigh.h"
 #include "imbalance_store.h"
@@ -457,6 +458,10 @@ void Balance::options(int iarg, int narg, char **arg)
         imb = new ImbalanceStore(lmp);
         nopt = imb->options(narg-iarg,arg+iarg+2);
         imbalances[nimbalance++] = imb;
+      } else if (strcmp(arg[iarg+1],"cac") == 0) {
+        imb = new ImbalanceCAC(lmp);
+        nopt = imb->options(narg-iarg,arg+iarg+2);
+        imbalances[nimbalance++] = imb;
       } else {
         error->all(FLERR,"Unknown (fix) balance weight method: {}", arg[iarg+1]);
       }
@@ -721,6 +721,12 @@ double Comm::get_comm_cutoff()
 
   maxcommcutoff = MAX(cutghostuser,neighbor->cutneighmax);
 
+  // partial neighbor re-listing lets atoms move a full skin between
+  // reneighborings, so ghost atoms must reach one skin further
+
+  if (neighbor->partial_active)
+    maxcommcutoff = MAX(cutghostuser,neighbor->cutneighmax+neighbor->skin);
+
   // use cutoff estimate from bond length only if no user specified
   // cutoff was given and no pair style present. Otherwise print a
   // warning, if the estimated bond based cutoff is larger than what
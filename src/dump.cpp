@@ -28,8 +28,111 @@
 
 #include <cstring>
 
+#ifdef LAMMPS_ASYNC_DUMP
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
 using namespace LAMMPS_NS;
 
+#ifdef LAMMPS_ASYNC_DUMP
+namespace LAMMPS_NS {
+
+/* ----------------------------------------------------------------------
+   writer thread of a dump with dump_modify async yes
+   holds one snapshot at a time, so the next snapshot can be captured
+   while the previous one is written, but never more than two exist
+------------------------------------------------------------------------- */
+
+class DumpAsync {
+ public:
+  DumpAsync(Dump *ptr) : dump(ptr), fp(nullptr), frame(nullptr), nframe(0),
+    flush(0), close(0), pending(0), done(0), failed(0)
+  {
+    worker = std::thread(&DumpAsync::run,this);
+  }
+
+  ~DumpAsync()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (pending) cond.wait(lock);
+      done = 1;
+    }
+    cond.notify_all();
+    worker.join();
+  }
+
+  // wait until the pending snapshot is written, return 1 if that failed
+
+  int wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (pending) cond.wait(lock);
+    int flag = failed;
+    failed = 0;
+    return flag;
+  }
+
+  // hand a snapshot allocated by open_memstream() to the thread, which frees it
+
+  void submit(FILE *file, char *data, size_t n, int flushflag, int closeflag)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      fp = file;
+      frame = data;
+      nframe = n;
+      flush = flushflag;
+      close = closeflag;
+      pending = 1;
+    }
+    cond.notify_all();
+  }
+
+ private:
+  Dump *dump;
+  std::thread worker;
+  std::mutex mutex;
+  std::condition_variable cond;
+  FILE *fp;
+  char *frame;
+  size_t nframe;
+  int flush, close, pending, done, failed;
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      while (!pending && !done) cond.wait(lock);
+      if (!pending) return;
+      lock.unlock();
+
+      int flag = 0;
+      try {
+        if (dump->async_output(fp,frame,nframe) != nframe) flag = 1;
+        if (flush) dump->async_flush(fp);
+        if (close) dump->async_close(fp);
+      } catch (std::exception &) {
+        flag = 1;
+      }
+      free(frame);
+
+      lock.lock();
+      if (flag) failed = 1;
+      frame = nullptr;
+      pending = 0;
+      cond.notify_all();
+    }
+  }
+};
+
+}
+#endif
+
 #if defined(LMP_QSORT)
 // allocate space for static class variable
 Dump *Dump::dumpptr;
@@ -85,6 +188,13 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
   unit_count = 0;
   delay_flag = 0;
 
+  async_flag = 0;
+  async_capture = 0;
+  async = nullptr;
+  async_fp = nullptr;
+  async_frame = nullptr;
+  async_nframe = 0;
+
   maxfiles = -1;
   numfiles = 0;
   fileidx = 0;
@@ -151,6 +261,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
 
 Dump::~Dump()
 {
+  async_stop();
+
   delete [] id;
   delete [] style;
   delete [] filename;
@@ -211,6 +323,14 @@ void Dump::init()
 {
   init_style();
 
+  // start or finish the writer thread of a filewriter proc
+
+  if (!async_flag || !filewriter) async_stop();
+#ifdef LAMMPS_ASYNC_DUMP
+  if (async_flag && filewriter && !async) async = new DumpAsync(this);
+#endif
+  sync();
+
   if (!sort_flag) {
     memory->destroy(bufsort);
     memory->destroy(ids);
@@ -332,8 +452,12 @@ void Dump::write()
   if (delay_flag && update->ntimestep < delaystep) return;
 
   // if file per timestep, open new file
+  // the writer thread must be done with the previous file first
 
-  if (multifile) openfile();
+  if (multifile) {
+    sync();
+    openfile();
+  }
 
   // simulation box bounds
 
@@ -378,6 +502,7 @@ void Dump::write()
   if (multiproc)
     MPI_Allreduce(&bnme,&nheader,1,MPI_LMP_BIGINT,MPI_SUM,clustercomm);
 
+  if (async) async_begin();
   if (filewriter) write_header(nheader);
 
   // insure buf is sized for packing and communicating
@@ -502,6 +627,10 @@ void Dump::write()
     }
   }
 
+  // hand the captured snapshot to the writer thread
+
+  if (async) async_end();
+
   // restore original x,v,image unaltered by PBC
 
   if (pbcflag) {
@@ -527,6 +656,89 @@ void Dump::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   redirect the file output of this snapshot into a memory buffer
+------------------------------------------------------------------------- */
+
+void Dump::async_begin()
+{
+#ifdef LAMMPS_ASYNC_DUMP
+  async_fp = fp;
+  fp = open_memstream(&async_frame,&async_nframe);
+  if (fp == nullptr) error->one(FLERR,"Cannot capture dump snapshot in memory");
+  async_capture = 1;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   pass the captured snapshot to the writer thread once it is done with
+   the previous one; the thread closes the file if one per timestep
+------------------------------------------------------------------------- */
+
+void Dump::async_end()
+{
+#ifdef LAMMPS_ASYNC_DUMP
+  fclose(fp);
+  fp = async_fp;
+  async_capture = 0;
+  sync();
+  async->submit(fp,async_frame,async_nframe,flush_flag,multifile);
+  async_frame = nullptr;
+  async_nframe = 0;
+  if (multifile) fp = nullptr;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   wait until the writer thread wrote the last snapshot
+------------------------------------------------------------------------- */
+
+void Dump::sync()
+{
+#ifdef LAMMPS_ASYNC_DUMP
+  if (async && async->wait())
+    error->one(FLERR,"Asynchronous write of dump file failed");
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   write any pending snapshot and end the writer thread
+   styles with their own output state call this in their destructor
+------------------------------------------------------------------------- */
+
+void Dump::async_stop()
+{
+#ifdef LAMMPS_ASYNC_DUMP
+  delete async;
+#endif
+  async = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   output functions called by the writer thread, only on filewriter procs
+   styles that do not write through fp override them
+------------------------------------------------------------------------- */
+
+size_t Dump::async_output(FILE *file, const char *data, size_t n)
+{
+  return fwrite(data,sizeof(char),n,file);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Dump::async_flush(FILE *file)
+{
+  fflush(file);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Dump::async_close(FILE *file)
+{
+  if (compressed) pclose(file);
+  else fclose(file);
+}
+
 /* ----------------------------------------------------------------------
    generic opening of a dump file
    ASCII or binary or gzipped
@@ -916,6 +1128,23 @@ void Dump::modify_params(int narg, char **arg)
       else error->all(FLERR,"Illegal dump_modify command");
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) async_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) async_flag = 0;
+      else error->all(FLERR,"Illegal dump_modify command");
+      if (async_flag) {
+        if (strcmp(style,"atom") != 0 && strcmp(style,"custom") != 0 &&
+            strcmp(style,"atom/gz") != 0 && strcmp(style,"custom/gz") != 0 &&
+            strcmp(style,"atom/zstd") != 0 && strcmp(style,"custom/zstd") != 0)
+          error->all(FLERR,"Dump_modify async is not supported by this dump style");
+#ifndef LAMMPS_ASYNC_DUMP
+        error->all(FLERR,"Dump_modify async requires LAMMPS be built "
+                   "with -DLAMMPS_ASYNC_DUMP");
+#endif
+      }
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"buffer") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
       if (strcmp(arg[iarg+1],"yes") == 0) buffer_flag = 1;
@@ -48,6 +48,7 @@ class Dump : protected Pointers {
 
   void modify_params(int, char **);
   virtual double memory_usage();
+  void sync();    // wait until asynchronous file output is written
 
  protected:
   int me, nprocs;    // proc info
@@ -81,6 +82,14 @@ class Dump : protected Pointers {
   int delay_flag;           // 1 if delay output until delaystep
   bigint delaystep;
 
+  int async_flag;              // 1 if a writer thread does the file output
+  int async_capture;           // 1 while a snapshot is captured in memory
+  class DumpAsync *async;      // writer thread of a filewriter proc
+  FILE *async_fp;              // file the captured snapshot goes to
+  char *async_frame;           // captured snapshot
+  size_t async_nframe;         // # of bytes in captured snapshot
+  friend class DumpAsync;
+
   int refreshflag;    // 1 if dump_modify refresh specified
   char *refresh;      // compute ID to invoke refresh() on
   int irefresh;       // index of compute
@@ -148,6 +157,13 @@ class Dump : protected Pointers {
   void pbc_allocate();
   double compute_time();
 
+  virtual size_t async_output(FILE *, const char *, size_t);
+  virtual void async_flush(FILE *);
+  virtual void async_close(FILE *);
+  void async_begin();
+  void async_end();
+  void async_stop();
+
   void sort();
 #if defined(LMP_QSORT)
   static int idcompare(const void *, const void *);
@@ -171,6 +187,25 @@ E: Dump file MPI-IO output not allowed with % in filename
 This is because a % signifies one file per processor and MPI-IO
 creates one large file for all processors.
 
+E: Dump_modify async is not supported by this dump style
+
+Only the atom and custom dump styles and their gz and zstd variants can
+hand their file output to a writer thread.
+
+E: Dump_modify async requires LAMMPS be built with -DLAMMPS_ASYNC_DUMP
+
+The writer thread needs C++11 threads and the open_memstream()
+function.  The CMake build enables it when both are available.
+
+E: Cannot capture dump snapshot in memory
+
+The memory stream for an asynchronous dump snapshot could not be
+opened.
+
+E: Asynchronous write of dump file failed
+
+The writer thread could not write a snapshot to the dump file.
+
 E: Cannot dump sort when multiple dump files are written
 
 In this mode, each processor dumps its atoms to a file, so
@@ -189,6 +189,8 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
 DumpCustom::~DumpCustom()
 {
+  async_stop();
+
   // if wildcard expansion occurred, free earg memory from expand_args()
   // could not do in constructor, b/c some derived classes process earg
 
@@ -48,6 +48,11 @@ static void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
                         MPI_Comm world, const int nprocs, const int nthreads,
                         const int me, double time_loop, FILE *scr, FILE *log);
 
+static void mpi_timings(const char *label, double time, double time_cpu,
+                        int cpuflag, MPI_Comm world, const int nprocs,
+                        const int nthreads, const int me, double time_loop,
+                        FILE *scr, FILE *log);
+
 #ifdef LMP_USER_OMP
 static void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
                       const int nthreads,FILE *scr, FILE *log);
@@ -396,6 +401,33 @@ void Finish::end(int flag)
   }
 #endif
 
+  // CAC pair and neighbor stage breakdown requested with cac_timing
+
+  if (timeflag && atom->CAC_flag && atom->cac_timing_flag) {
+    if (me == 0)
+      utils::logmesg(lmp,"\nCAC stage timing breakdown:\nStage   |  min time  "
+                     "|  avg time  |  max time  |%varavg| %total\n---------"
+                     "------------------------------------------------------\n");
+
+    for (i = 0; i < Atom::CAC_NTIME; i++)
+      mpi_timings(Atom::cac_time_names[i],atom->cac_times[i],0.0,0,world,
+                  nprocs,nthreads,me,time_loop,screen,logfile);
+
+    double counts[Atom::CAC_NCOUNT];
+    MPI_Allreduce(atom->cac_counts,counts,Atom::CAC_NCOUNT,MPI_DOUBLE,MPI_SUM,world);
+    double nbuild = counts[Atom::CAC_COUNT_BUILD]/nprocs;
+    if (me == 0 && nbuild > 0.0) {
+      double nquad = counts[Atom::CAC_COUNT_QUAD];
+      utils::logmesg(lmp,"CAC neighbor builds = {:.8g}\n"
+                     "Quadrature points per build = {:.8g}\n"
+                     "Neighbors per quadrature point = {:.8g}\n"
+                     "Surface search iterations per build = {:.8g}\n",
+                     nbuild,nquad/nbuild,
+                     nquad > 0.0 ? counts[Atom::CAC_COUNT_NEIGH]/nquad : 0.0,
+                     counts[Atom::CAC_COUNT_SURF]/nbuild);
+    }
+  }
+
   if ((comm->me == 0) && lmp->kokkos && (lmp->kokkos->ngpus > 0))
     if (const char* env_clb = getenv("CUDA_LAUNCH_BLOCKING"))
       if (!(strcmp(env_clb,"1") == 0)) {
@@ -584,6 +616,9 @@ void Finish::end(int flag)
         mesg += fmt::format("Ave special neighs/atom = {:.8}\n",
                             nspec_all/atom->natoms);
       mesg += fmt::format("Neighbor list builds = {}\n",neighbor->ncalls);
+      if (neighbor->partial_active)
+        mesg += fmt::format("Partial neighbor list builds = {}\n",
+                            neighbor->npartial);
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
@@ -647,11 +682,23 @@ void Finish::stats(int n, double *data,
 void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
                         MPI_Comm world, const int nprocs, const int nthreads,
                         const int me, double time_loop, FILE *scr, FILE *log)
+{
+  mpi_timings(label,t->get_wall(tt),t->get_cpu(tt),t->has_full(),world,
+              nprocs,nthreads,me,time_loop,scr,log);
+}
+
+/* ----------------------------------------------------------------------
+   statistics of one wall time across MPI tasks, with the %CPU column
+   only if cpuflag is set
+------------------------------------------------------------------------- */
+
+void mpi_timings(const char *label, double time, double time_cpu,
+                 int cpuflag, MPI_Comm world, const int nprocs,
+                 const int nthreads, const int me, double time_loop,
+                 FILE *scr, FILE *log)
 {
   double tmp, time_max, time_min, time_sq;
-  double time = t->get_wall(tt);
 
-  double time_cpu = t->get_cpu(tt);
   if (time/time_loop < 0.001)  // insufficient timer resolution!
     time_cpu = 1.0;
   else
@@ -665,8 +712,10 @@ void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
   time = tmp/nprocs;
   MPI_Allreduce(&time_sq,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
   time_sq = tmp/nprocs;
-  MPI_Allreduce(&time_cpu,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
-  time_cpu = tmp/nprocs*100.0;
+  if (cpuflag) {
+    MPI_Allreduce(&time_cpu,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+    time_cpu = tmp/nprocs*100.0;
+  }
 
   // % variance from the average as measure of load imbalance
   if ((time > 0.001) && ((time_sq/time - time) > 1.0e-10))
@@ -677,7 +726,7 @@ void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
   if (me == 0) {
     tmp = time/time_loop*100.0;
     std::string mesg;
-    if (t->has_full())
+    if (cpuflag)
       mesg = fmt::format("{:<8s}| {:<10.5g} | {:<10.5g} | {:<10.5g} |{:6.1f} |"
                          "{:6.1f} |{:6.2f}\n",
                          label,time_min,time,time_max,time_sq,time_cpu,tmp);
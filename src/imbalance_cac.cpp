@@ -0,0 +1,181 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "imbalance_cac.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "memory.h"
+
+using namespace LAMMPS_NS;
+
+#define BIG 1.0e20
+#define MINCOST 1.0e-3    // smallest element cost relative to the average
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCAC::ImbalanceCAC(LAMMPS *lmp) : Imbalance(lmp)
+{
+  did_warn = 0;
+  source = 0;
+  nmax = 0;
+  cost = nullptr;
+}
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCAC::~ImbalanceCAC()
+{
+  memory->destroy(cost);
+}
+
+/* -------------------------------------------------------------------- */
+
+int ImbalanceCAC::options(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR,"Illegal balance weight command");
+  if (!atom->CAC_flag)
+    error->all(FLERR,"Balance weight cac requires a CAC atom style");
+  factor = utils::numeric(FLERR,arg[0],false,lmp);
+  if (factor <= 0.0) error->all(FLERR,"Illegal balance weight command");
+
+  // ask the CAC pair styles to time the force computation of each element
+
+  atom->element_cost_flag = 1;
+  return 1;
+}
+
+/* --------------------------------------------------------------------
+   weight each element by the work its force computation takes.
+   preferred source are the per element timings of the last force
+   computation, the fallback are the sizes of the quadrature point
+   neighbor lists of the last CAC neighbor list build.
+------------------------------------------------------------------------- */
+
+void ImbalanceCAC::compute(double *weight)
+{
+  const int nlocal = atom->nlocal;
+
+  if (nlocal > nmax) {
+    memory->destroy(cost);
+    nmax = atom->nmax;
+    memory->create(cost,nmax,"imbalance:cost");
+  }
+
+  // measured force computation times, if current and non-zero
+
+  int flag = 0;
+  double costsum = 0.0;
+  if (atom->element_cost_flag && atom->element_cost &&
+      atom->element_cost_count == nlocal) {
+    flag = 1;
+    for (int i = 0; i < nlocal; i++) {
+      cost[i] = atom->element_cost[i];
+      costsum += cost[i];
+    }
+    if (nlocal && costsum <= 0.0) flag = 0;
+  }
+
+  // otherwise count the interactions each quadrature point of the element
+  // interpolates; the neighbor lists of elements that migrated are stale
+
+  if (!flag && atom->weight_count == nlocal && atom->inner_quad_lists_counts &&
+      atom->e2quad_index && atom->quadrature_counts) {
+    flag = 2;
+    costsum = 0.0;
+    const int *e2quad_index = atom->e2quad_index;
+    const int *quadrature_counts = atom->quadrature_counts;
+    const int *poly_count = atom->poly_count;
+    const int *inner_counts = atom->inner_quad_lists_counts;
+    const int *outer_counts = atom->outer_neigh_flag ? atom->outer_quad_lists_counts : nullptr;
+    const int *add_counts = atom->flux_compute ? atom->add_quad_lists_counts : nullptr;
+    for (int i = 0; i < nlocal; i++) {
+      const int pqilo = e2quad_index[i];
+      const int pqihi = pqilo + quadrature_counts[i]*poly_count[i];
+      cost[i] = 0.0;
+      for (int pqi = pqilo; pqi < pqihi; pqi++) {
+        cost[i] += 1.0 + inner_counts[pqi];
+        if (outer_counts) cost[i] += outer_counts[pqi];
+        if (add_counts) cost[i] += add_counts[pqi];
+      }
+      costsum += cost[i];
+    }
+  }
+
+  // all procs must agree on the source, otherwise skip this balancing
+
+  int maxsource;
+  MPI_Allreduce(&flag,&source,1,MPI_INT,MPI_MIN,world);
+  MPI_Allreduce(&flag,&maxsource,1,MPI_INT,MPI_MAX,world);
+  if (source == 0 || maxsource != source) {
+    if (comm->me == 0 && !did_warn)
+      error->warning(FLERR,"Balance weight cac skipped b/c no element costs available");
+    did_warn = 1;
+    source = 0;
+    return;
+  }
+
+  // normalize by the average element cost across all procs,
+  // so that the weights are independent of the timer resolution
+  // elements too cheap to be timed get a small non-zero weight
+
+  double allsum;
+  bigint nelements = nlocal;
+  bigint allelements;
+  MPI_Allreduce(&costsum,&allsum,1,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(&nelements,&allelements,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (allelements == 0 || allsum <= 0.0) return;
+  const double average = allsum/allelements;
+
+  double wtlo = BIG;
+  double wthi = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    cost[i] /= average;
+    if (cost[i] < MINCOST) cost[i] = MINCOST;
+    if (cost[i] < wtlo) wtlo = cost[i];
+    if (cost[i] > wthi) wthi = cost[i];
+  }
+
+  // apply factor if specified != 1.0
+  // lo value does not change
+  // newhi = new hi value to give hi/lo ratio factor times larger/smaller
+  // expand/contract all element costs from lo->hi to lo->newhi
+
+  if (factor != 1.0) {
+    double lo,hi;
+    MPI_Allreduce(&wtlo,&lo,1,MPI_DOUBLE,MPI_MIN,world);
+    MPI_Allreduce(&wthi,&hi,1,MPI_DOUBLE,MPI_MAX,world);
+    if (lo != hi) {
+      double newhi = hi*factor;
+      for (int i = 0; i < nlocal; i++)
+        cost[i] = lo + ((cost[i]-lo)/(hi-lo)) * (newhi-lo);
+    }
+  }
+
+  for (int i = 0; i < nlocal; i++) {
+    if (cost[i] <= 0.0) error->one(FLERR,"Balance weight <= 0.0");
+    weight[i] *= cost[i];
+  }
+}
+
+/* -------------------------------------------------------------------- */
+
+std::string ImbalanceCAC::info()
+{
+  std::string mesg = fmt::format("  CAC element cost weight factor: {}\n",factor);
+  if (source == 1) mesg += "  CAC element cost source: force timings\n";
+  else if (source == 2) mesg += "  CAC element cost source: quadrature neighbor counts\n";
+  return mesg;
+}
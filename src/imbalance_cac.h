@@ -0,0 +1,64 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_IMBALANCE_CAC_H
+#define LMP_IMBALANCE_CAC_H
+
+#include "imbalance.h"
+
+namespace LAMMPS_NS {
+
+class ImbalanceCAC : public Imbalance {
+ public:
+  ImbalanceCAC(class LAMMPS *);
+  virtual ~ImbalanceCAC();
+
+ public:
+  // parse options, return number of arguments consumed
+  virtual int options(int, char **) override;
+  // compute and apply weight factors to local atom array
+  virtual void compute(double *) override;
+  // print information about the state of this imbalance compute
+  virtual std::string info() override;
+
+ private:
+  double factor;    // weight factor for CAC element cost imbalance
+  int did_warn;     // 1 if warned about missing element costs
+  int source;       // 1 if the last weights used timings, 2 if list sizes
+  int nmax;         // allocated length of cost
+  double *cost;     // per element cost of the local elements
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Balance weight cac requires a CAC atom style
+
+Self-explanatory.
+
+W: Balance weight cac skipped b/c no element costs available
+
+Neither element timings from a CAC pair style nor quadrature neighbor
+lists matching the current elements exist, e.g. because no run was
+performed yet. No weights are computed in this case.
+
+*/
@@ -295,6 +295,7 @@ void Info::command(int narg, char **arg)
     if (has_png_support()) fputs("-DLAMMPS_PNG\n",out);
     if (has_jpeg_support()) fputs("-DLAMMPS_JPEG\n",out);
     if (has_ffmpeg_support()) fputs("-DLAMMPS_FFMPEG\n",out);
+    if (has_async_dump_support()) fputs("-DLAMMPS_ASYNC_DUMP\n",out);
     if (has_exceptions()) fputs("-DLAMMPS_EXCEPTIONS\n",out);
 
 #if defined(LAMMPS_BIGBIG)
@@ -898,6 +899,8 @@ bool Info::is_available(const char *category, const char *name)
       return has_jpeg_support();
     } else if (strcmp(name,"ffmpeg") == 0) {
       return has_ffmpeg_support();
+    } else if (strcmp(name,"async_dump") == 0) {
+      return has_async_dump_support();
     } else if (strcmp(name,"exceptions") == 0) {
       return has_exceptions();
     }
@@ -1146,6 +1149,14 @@ bool Info::has_ffmpeg_support() {
 #endif
 }
 
+bool Info::has_async_dump_support() {
+#ifdef LAMMPS_ASYNC_DUMP
+  return true;
+#else
+  return false;
+#endif
+}
+
 bool Info::has_exceptions() {
 #ifdef LAMMPS_EXCEPTIONS
   return true;
@@ -37,7 +37,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      COMM_MODE,COMM_CUTOFF,COMM_VEL,NO_PAIR,
      EXTRA_BOND_PER_ATOM,EXTRA_ANGLE_PER_ATOM,EXTRA_DIHEDRAL_PER_ATOM,
      EXTRA_IMPROPER_PER_ATOM,EXTRA_SPECIAL_PER_ATOM,ATOM_MAXSPECIAL,
-     NELLIPSOIDS,NLINES,NTRIS,NBODIES};
+     NELLIPSOIDS,NLINES,NTRIS,NBODIES,SHARD};
 
 #define LB_FACTOR 1.1
 
@@ -19,6 +19,7 @@
 #include "error.h"
 #include "finish.h"
 #include "min.h"
+#include "output.h"
 #include "timer.h"
 #include "update.h"
 
@@ -64,6 +65,7 @@ void Minimize::command(int narg, char **arg)
   update->minimize->run(update->nsteps);
   timer->barrier_stop();
 
+  output->sync_dumps();
   update->minimize->cleanup();
 
   Finish finish(lmp);
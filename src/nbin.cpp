@@ -31,6 +31,7 @@ NBin::NBin(LAMMPS *lmp) : Pointers(lmp)
   binhead = nullptr;
   bins = nullptr;
   atom2bin = nullptr;
+  coarse_flag = 0;
 
   nbinx_multi = nullptr; nbiny_multi = nullptr; nbinz_multi = nullptr;
   mbins_multi = nullptr;
@@ -171,6 +172,50 @@ int NBin::coord2bin(double *x)
 }
 
 
+/* ----------------------------------------------------------------------
+   convert atom coords into local bin #
+   return -1 if coords are outside the bins of this proc
+------------------------------------------------------------------------- */
+
+int NBin::coord2bin_check(double *x)
+{
+  int ix,iy,iz;
+
+  if (!std::isfinite(x[0]) || !std::isfinite(x[1]) || !std::isfinite(x[2]))
+    error->one(FLERR,"Non-numeric positions - simulation unstable");
+
+  if (x[0] >= bboxhi[0])
+    ix = static_cast<int> ((x[0]-bboxhi[0])*bininvx) + nbinx;
+  else if (x[0] >= bboxlo[0]) {
+    ix = static_cast<int> ((x[0]-bboxlo[0])*bininvx);
+    ix = MIN(ix,nbinx-1);
+  } else
+    ix = static_cast<int> ((x[0]-bboxlo[0])*bininvx) - 1;
+
+  if (x[1] >= bboxhi[1])
+    iy = static_cast<int> ((x[1]-bboxhi[1])*bininvy) + nbiny;
+  else if (x[1] >= bboxlo[1]) {
+    iy = static_cast<int> ((x[1]-bboxlo[1])*bininvy);
+    iy = MIN(iy,nbiny-1);
+  } else
+    iy = static_cast<int> ((x[1]-bboxlo[1])*bininvy) - 1;
+
+  if (x[2] >= bboxhi[2])
+    iz = static_cast<int> ((x[2]-bboxhi[2])*bininvz) + nbinz;
+  else if (x[2] >= bboxlo[2]) {
+    iz = static_cast<int> ((x[2]-bboxlo[2])*bininvz);
+    iz = MIN(iz,nbinz-1);
+  } else
+    iz = static_cast<int> ((x[2]-bboxlo[2])*bininvz) - 1;
+
+  ix -= mbinxlo;
+  iy -= mbinylo;
+  iz -= mbinzlo;
+  if (ix < 0 || ix >= mbinx || iy < 0 || iy >= mbiny || iz < 0 || iz >= mbinz)
+    return -1;
+  return iz*mbiny*mbinx + iy*mbinx + ix;
+}
+
 /* ----------------------------------------------------------------------
    convert atom coords into local bin # for a particular collection
 ------------------------------------------------------------------------- */
@@ -55,6 +55,14 @@ class NBin : protected Pointers {
   int *quad2bin;              //bin location of each local quadrature point
   int *nbin_element_overlap;  //array storing the number of bins this element overlaps
   int **bin_element_overlap;  //set of bins this element overlaps
+  int coarse_flag;            //1 if large elements are binned in the coarse grid only
+  int coarse_factor;          //fine bins per coarse bin along each dimension
+  int mcbinx, mcbiny, mcbinz; //number of coarse bins along each dimension
+  int *coarse_ncontent;       //number of large elements in each coarse bin
+  int **coarse_content;       //large elements in each coarse bin
+  int **coarse_limits;        //coarse bin limits of each atom and element bounding box
+  int **fine_limits;          //fine bin limits of the reduced box of each large element
+  int *coarse_binned;         //1 if this element is binned in the coarse grid
 
   NBin(class LAMMPS *);
   virtual ~NBin();
@@ -64,7 +72,9 @@ class NBin : protected Pointers {
   virtual void bin_atoms_setup(int) = 0;
   virtual void setup_bins(int) = 0;
   virtual void bin_atoms() = 0;
+  virtual void bin_atoms_partial() { bin_atoms(); }
   virtual int coord2bin(double *);
+  int coord2bin_check(double *);
   int coord2bin_multi(double *, int);
   virtual double memory_usage() { return 0.0; }
 
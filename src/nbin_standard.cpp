@@ -260,6 +260,37 @@ void NBinStandard::bin_atoms()
   }
 }
 
+/* ----------------------------------------------------------------------
+   bin owned and ghost atoms between reneighborings for a partial build
+   ghost atoms may have drifted out of the binned region since borders(),
+     those are beyond the neighbor cutoff of any owned atom, so skip them
+     and set their atom2bin to -1
+------------------------------------------------------------------------- */
+
+void NBinStandard::bin_atoms_partial()
+{
+  int i,ibin;
+
+  last_bin = update->ntimestep;
+  for (i = 0; i < mbins; i++) binhead[i] = -1;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  for (i = nall-1; i >= 0; i--) {
+    ibin = coord2bin_check(x[i]);
+    atom2bin[i] = ibin;
+    if (ibin < 0) {
+      if (i < nlocal)
+        error->one(FLERR,"Owned atom outside neighbor bins in partial build");
+      continue;
+    }
+    bins[i] = binhead[ibin];
+    binhead[ibin] = i;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 double NBinStandard::memory_usage()
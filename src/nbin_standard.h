@@ -33,6 +33,7 @@ class NBinStandard : public NBin {
   void bin_atoms_setup(int);
   void setup_bins(int);
   void bin_atoms();
+  void bin_atoms_partial();
   double memory_usage();
 };
 
@@ -55,4 +56,10 @@ E: Too many neighbor bins
 
 UNDOCUMENTED
 
+E: Owned atom outside neighbor bins in partial build
+
+An owned atom moved further from its sub-domain than the partial
+neighbor rebuild allows for.  This should not normally happen, since a
+full reneighboring is triggered before that.
+
 */
@@ -20,10 +20,12 @@
 #include "neigh_request.h"
 #include "my_page.h"
 #include "memory.h"
+#include "error.h"
 
 using namespace LAMMPS_NS;
 
 #define PGDELTA 1
+#define BIG 1.0e10
 
 /* ---------------------------------------------------------------------- */
 
@@ -38,11 +40,23 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   numneigh = nullptr;
   firstneigh = nullptr;
 
+  clustersize = 0;
+  nicluster = ncluster = 0;
+  clusteratom = nullptr;
+  numjcluster = nullptr;
+  firstjcluster = nullptr;
+  tilecode = nullptr;
+  ntilecode = 0;
+  maxslot = maxtilecode = 0;
+  xcluster = nullptr;
+  tcluster = nullptr;
+
   // defaults, but may be reset by post_constructor()
 
   occasional = 0;
   ghost = 0;
   ssa = 0;
+  cluster = 0;
   history = 0;
   respaouter = 0;
   respamiddle = 0;
@@ -102,6 +116,12 @@ NeighList::~NeighList()
     memory->destroy(numneigh);
     memory->sfree(firstneigh);
     delete [] ipage;
+    memory->destroy(clusteratom);
+    memory->destroy(numjcluster);
+    memory->sfree(firstjcluster);
+    memory->destroy(tilecode);
+    memory->destroy(xcluster);
+    memory->destroy(tcluster);
   }
 
   if (respainner) {
@@ -139,6 +159,7 @@ void NeighList::post_constructor(NeighRequest *nq)
   occasional = nq->occasional;
   ghost = nq->ghost;
   ssa = nq->ssa;
+  cluster = nq->cluster;
   history = nq->history;
   respaouter = nq->respaouter;
   respamiddle = nq->respamiddle;
@@ -245,6 +266,76 @@ void NeighList::grow(int nlocal, int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   grow per-slot data to allow for N clusters of clustersize slots
+   triggered by cluster list build, contents are not preserved
+------------------------------------------------------------------------- */
+
+void NeighList::grow_cluster(int n)
+{
+  if ((bigint) n*clustersize <= maxslot) return;
+  if ((bigint) n*clustersize*3 > MAXSMALLINT)
+    error->one(FLERR,"Too many atoms for cluster neighbor list");
+
+  maxslot = n*clustersize;
+
+  memory->destroy(clusteratom);
+  memory->destroy(numjcluster);
+  memory->sfree(firstjcluster);
+  memory->destroy(xcluster);
+  memory->destroy(tcluster);
+  memory->create(clusteratom,maxslot,"neighlist:clusteratom");
+  memory->create(numjcluster,maxslot,"neighlist:numjcluster");
+  firstjcluster = (int **) memory->smalloc(maxslot*sizeof(int *),
+                                           "neighlist:firstjcluster");
+  memory->create(xcluster,3*maxslot,"neighlist:xcluster");
+  memory->create(tcluster,maxslot,"neighlist:tcluster");
+}
+
+/* ----------------------------------------------------------------------
+   grow tilecode so N more codes fit, existing codes are preserved
+------------------------------------------------------------------------- */
+
+void NeighList::grow_tilecode(int n)
+{
+  if (ntilecode + n <= maxtilecode) return;
+  if ((bigint) ntilecode + n > MAXSMALLINT/2)
+    error->one(FLERR,"Too many special pairs for cluster neighbor list");
+  maxtilecode = 2*(ntilecode + n);
+  memory->grow(tilecode,maxtilecode,"neighlist:tilecode");
+}
+
+/* ----------------------------------------------------------------------
+   pack current coords and types of all clustered atoms
+   each cluster stores its x, then y, then z values in contiguous blocks
+   padding slots sit far outside any cutoff and carry type 1
+------------------------------------------------------------------------- */
+
+void NeighList::pack_cluster()
+{
+  double **x = atom->x;
+  int *type = atom->type;
+  const int cs = clustersize;
+
+  for (int c = 0; c < ncluster; c++) {
+    const int *catom = &clusteratom[c*cs];
+    double *xc = &xcluster[3*c*cs];
+    int *tc = &tcluster[c*cs];
+    for (int k = 0; k < cs; k++) {
+      const int i = catom[k];
+      if (i >= 0) {
+        xc[k] = x[i][0];
+        xc[cs+k] = x[i][1];
+        xc[2*cs+k] = x[i][2];
+        tc[k] = type[i];
+      } else {
+        xc[k] = xc[cs+k] = xc[2*cs+k] = BIG;
+        tc[k] = 1;
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    print attributes of this list and associated request
 ------------------------------------------------------------------------- */
@@ -283,6 +374,7 @@ void NeighList::print_attributes()
   printf("  %d = kokkos host\n",rq->kokkos_host);
   printf("  %d = kokkos device\n",rq->kokkos_device);
   printf("  %d = ssa flag\n",ssa);
+  printf("  %d = cluster flag\n",cluster);
   printf("\n");
   printf("  %d = skip flag\n",rq->skip);
   printf("  %d = off2on\n",rq->off2on);
@@ -311,6 +403,15 @@ double NeighList::memory_usage()
       bytes += ipage[i].size();
   }
 
+  if (cluster) {
+    bytes += memory->usage(clusteratom,maxslot);
+    bytes += memory->usage(numjcluster,maxslot);
+    bytes += (double)maxslot * sizeof(int *);
+    bytes += memory->usage(xcluster,3*maxslot);
+    bytes += memory->usage(tcluster,maxslot);
+    bytes += memory->usage(tilecode,maxtilecode);
+  }
+
   if (respainner) {
     bytes += memory->usage(ilist_inner,maxatom);
     bytes += memory->usage(numneigh_inner,maxatom);
@@ -37,6 +37,7 @@ class NeighList : protected Pointers {
   int occasional;     // 0 if build every reneighbor, 1 if not
   int ghost;          // 1 if list stores neighbors of ghosts
   int ssa;            // 1 if list stores Shardlow data
+  int cluster;        // 1 if list stores cluster pairs
   int history;        // 1 if there is neigh history (FixNeighHist)
   int respaouter;     // 1 if list is a rRespa outer list
   int respamiddle;    // 1 if there is also a rRespa middle list
@@ -59,6 +60,26 @@ class NeighList : protected Pointers {
   int oneatom;           // max size for one atom
   MyPage<int> *ipage;    // pages of neighbor indices
 
+  // data structs to store cluster pairs I,J of a cluster list
+  // owned atoms are grouped into the first nicluster clusters,
+  //   ghost atoms into the remaining ones
+  // each J entry is a pair of ints: J cluster and offset into tilecode,
+  //   offset is -1 if all atom pairs of the tile interact normally
+
+  int clustersize;           // # of atom slots per cluster
+  int nicluster;             // # of I clusters, all made of owned atoms
+  int ncluster;              // # of owned + ghost clusters
+  int *clusteratom;          // atom index of each slot, -1 if padding
+  int *numjcluster;          // # of J clusters for each I cluster
+  int **firstjcluster;       // ptr to 1st J entry of each I cluster
+  unsigned char *tilecode;   // special codes of each I,J slot pair of a tile
+  int ntilecode;             // # of codes stored in tilecode
+  int maxslot;               // size of allocated per-slot arrays
+  int maxtilecode;           // size of allocated tilecode
+
+  double *xcluster;    // coords packed by pack_cluster(), x,y,z blocks
+  int *tcluster;       // types packed by pack_cluster()
+
   // data structs to store rRESPA neighbor pairs I,J and associated values
 
   int inum_inner;            // # of I atoms neighbors are stored for
@@ -106,6 +127,9 @@ class NeighList : protected Pointers {
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);    // setup page data structures
   void grow(int, int);           // grow all data structs
+  void grow_cluster(int);        // grow per-slot data of cluster list
+  void grow_tilecode(int);       // grow tilecode to hold N more codes
+  void pack_cluster();           // pack coords and types by cluster
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
   double memory_usage();
@@ -114,3 +138,17 @@ class NeighList : protected Pointers {
 }    // namespace LAMMPS_NS
 
 #endif
+
+/* ERROR/WARNING messages:
+
+E: Too many atoms for cluster neighbor list
+
+The per-slot arrays of a cluster-pair neighbor list would exceed the
+size of a 32-bit integer index.  Use more processors.
+
+E: Too many special pairs for cluster neighbor list
+
+The special-bond codes of the cluster tiles would exceed the size of
+a 32-bit integer index.  Use more processors.
+
+*/
@@ -52,6 +52,7 @@ NeighRequest::NeighRequest(LAMMPS *lmp) : Pointers(lmp)
   // default is no Intel-specific neighbor list build
   // default is no Kokkos neighbor list build
   // default is no Shardlow Splitting Algorithm (SSA) neighbor list build
+  // default is neighbors of atoms, not cluster pairs
   // default is no list-specific cutoff
   // default is no storage of auxiliary floating point values
 
@@ -67,6 +68,7 @@ NeighRequest::NeighRequest(LAMMPS *lmp) : Pointers(lmp)
   intel = 0;
   kokkos_host = kokkos_device = 0;
   ssa = 0;
+  cluster = 0;
   cut = 0;
   cutoff = 0.0;
 
@@ -150,6 +152,7 @@ int NeighRequest::identical(NeighRequest *other)
   if (kokkos_host != other->kokkos_host) same = 0;
   if (kokkos_device != other->kokkos_device) same = 0;
   if (ssa != other->ssa) same = 0;
+  if (cluster != other->cluster) same = 0;
   if (copy != other->copy) same = 0;
   if (cutoff != other->cutoff) same = 0;
 
@@ -217,6 +220,7 @@ void NeighRequest::copy_request(NeighRequest *other, int skipflag)
   kokkos_host = other->kokkos_host;
   kokkos_device = other->kokkos_device;
   ssa = other->ssa;
+  cluster = other->cluster;
   cut = other->cut;
   cutoff = other->cutoff;
 
@@ -72,6 +72,7 @@ class NeighRequest : protected Pointers {
   int kokkos_host;     // set by KOKKOS package
   int kokkos_device;
   int ssa;          // set by USER-DPD package, for Shardlow lists
+  int cluster;      // 1 if list stores cluster pairs for SIMD tile kernels
   int cut;          // 1 if use a non-standard cutoff length
   double cutoff;    // special cutoff distance for this list
 
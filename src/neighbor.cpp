@@ -119,11 +119,13 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   pgsize = 100000;
   oneatom = 2000;
   binsizeflag = 0;
+  clustersize = 4;
   build_once = 0;
   cluster_check = 0;
   ago = -1;
   atomvec_check_flag=0;
   stencil_post_create_flag=0;
+  partialflag = partial_active = partial_pending = 0;
 
   cutneighmax = 0.0;
   cutneighsq = nullptr;
@@ -182,6 +184,8 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
 
   maxhold = 0;
   xhold = nullptr;
+  maxhot = nhot = 0;
+  hotlist = hotflag = nullptr;
   lastcall = -1;
   last_setup_bins = -1;
 
@@ -261,6 +265,8 @@ Neighbor::~Neighbor()
   delete neigh_improper;
 
   memory->destroy(xhold);
+  memory->destroy(hotlist);
+  memory->destroy(hotflag);
 
   memory->destroy(ex1_type);
   memory->destroy(ex2_type);
@@ -287,7 +293,7 @@ void Neighbor::init()
 {
   int i,j,n;
 
-  ncalls = ndanger = 0;
+  ncalls = ndanger = npartial = 0;
   dimension = domain->dimension;
   triclinic = domain->triclinic;
   newton_pair = force->newton_pair;
@@ -650,6 +656,27 @@ void Neighbor::init()
 
   if (!same && comm->me == 0) print_pairwise_info();
 
+  // partial re-listing between full builds, only used by verlet dynamics
+  // every perpetual list must be able to re-list a subset of owned atoms
+  // set before Comm::init(), since it extends the ghost cutoff
+
+  partial_active = partial_pending = 0;
+  if (partialflag && update->whichflag == 1 &&
+      strcmp(update->integrate_style,"verlet") == 0) {
+    if (style != Neighbor::BIN || includegroup || !dist_check || build_once ||
+        atomvec_check_flag)
+      error->all(FLERR,"Neighbor partial requires bin style, check yes, "
+                 "and no include group or once setting");
+    for (i = 0; i < npair_perpetual; i++) {
+      NeighList *list = lists[plist[i]];
+      if (!neigh_pair[plist[i]]->partial || list->ghost || list->history ||
+          list->respaouter || list->kokkos)
+        error->all(FLERR,"Neighbor partial is not supported by "
+                   "neighbor list build {}",pairnames[list->pair_method-1]);
+    }
+    partial_active = 1;
+  }
+
   // can now delete requests so next run can make new ones
   // print_pairwise_info() made use of requests
   // set of NeighLists now stores all needed info
@@ -1172,6 +1199,7 @@ void Neighbor::morph_skip()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
       if (irq->cut != jrq->cut) continue;
       if (irq->cutoff != jrq->cutoff) continue;
 
@@ -1320,6 +1348,7 @@ void Neighbor::morph_halffull()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
       if (irq->cut != jrq->cut) continue;
       if (irq->cutoff != jrq->cutoff) continue;
 
@@ -1416,6 +1445,7 @@ void Neighbor::morph_copy()
       if (irq->kokkos_host && !jrq->kokkos_host) continue;
       if (irq->kokkos_device && !jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
       if (irq->cut != jrq->cut) continue;
       if (irq->cutoff != jrq->cutoff) continue;
 
@@ -1681,6 +1711,7 @@ void Neighbor::print_pairwise_info()
     if (rq->kokkos_device) out += ", kokkos_device";
     if (rq->kokkos_host) out += ", kokkos_host";
     if (rq->ssa) out += ", ssa";
+    if (rq->cluster) out += ", cluster";
     if (rq->cut) out += fmt::format(", cut {}",rq->cutoff);
     if (rq->off2on) out += ", off2on";
     out += "\n";
@@ -1989,6 +2020,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!rq->cluster != !(mask & NP_CLUSTER)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2166,6 +2198,16 @@ int Neighbor::check_distance()
     }
   } else deltasq = triggersq;
 
+  // with partial re-listing, atoms past the trigger are re-listed
+  //   by build_partial(), full rebuild only when an atom moved
+  //   twice the trigger, i.e. the extra skin added to the ghost cutoff
+
+  double flagsq = deltasq;
+  if (partial_active) {
+    partial_triggersq = deltasq;
+    flagsq = 4.0*deltasq;
+  }
+
   double **x = atom->x;
   int nlocal = atom->nlocal;
   if (includegroup) nlocal = atom->nfirst;
@@ -2176,7 +2218,7 @@ int Neighbor::check_distance()
     dely = x[i][1] - xhold[i][1];
     delz = x[i][2] - xhold[i][2];
     rsq = delx*delx + dely*dely + delz*delz;
-    if (rsq > deltasq) flag = 1;
+    if (rsq > flagsq) flag = 1;
   }
 
   //check if npair style requires its own neighbor list rebuild check
@@ -2192,6 +2234,7 @@ int Neighbor::check_distance()
   int flagall;
   MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
   if (flagall && ago == MAX(every,delay)) ndanger++;
+  if (partial_active && !flagall) partial_pending = 1;
   return flagall;
 }
 
@@ -2208,6 +2251,7 @@ void Neighbor::build(int topoflag)
   ago = 0;
   ncalls++;
   lastcall = update->ntimestep;
+  partial_pending = 0;
 
   int nlocal = atom->nlocal;
   int nall = nlocal + atom->nghost;
@@ -2229,11 +2273,26 @@ void Neighbor::build(int topoflag)
       memory->destroy(xhold);
       memory->create(xhold,maxhold,3,"neigh:xhold");
     }
-    for (i = 0; i < nlocal; i++) {
+    int nhold = nlocal;
+    if (partial_active) nhold = nall;
+    for (i = 0; i < nhold; i++) {
       xhold[i][0] = x[i][0];
       xhold[i][1] = x[i][1];
       xhold[i][2] = x[i][2];
     }
+
+    // no atom has moved past trigger yet for partial builds
+
+    if (partial_active) {
+      if (nall > maxhot) {
+        maxhot = atom->nmax;
+        memory->destroy(hotlist);
+        memory->destroy(hotflag);
+        memory->create(hotlist,maxhot,"neigh:hotlist");
+        memory->create(hotflag,maxhot,"neigh:hotflag");
+      }
+      for (i = 0; i < nall; i++) hotflag[i] = 0;
+    }
     if (boxcheck) {
       if (triclinic == 0) {
         boxlo_hold[0] = bboxlo[0];
@@ -2291,6 +2350,7 @@ void Neighbor::build(int topoflag)
       lists[m]->grow(nlocal,nall);
     neigh_pair[m]->build_setup();
     neigh_pair[m]->build(lists[m]);
+    neigh_pair[m]->capacity_flag = 0;
   }
 
   // build topology lists for bonds/angles/etc
@@ -2298,6 +2358,52 @@ void Neighbor::build(int topoflag)
   if ((atom->molecular != Atom::ATOMIC) && topoflag) build_topology();
 }
 
+/* ----------------------------------------------------------------------
+   re-list owned atoms near atoms that moved past the trigger distance
+   called by Verlet after forward comm when check_distance() requested it
+   no exchange or borders since last build(), so xhold of both owned and
+     ghost atoms is valid and ghost coords are current
+   hotflag is sticky: once an atom moved past the trigger, it stays hot
+     until next build(), so pairs of atoms that were never hot are exactly
+     the pairs listed by last build() and are still valid
+   pairs with a hot atom are found again by NPair::build_partial()
+   re-bin all atoms, cheap compared to the pairwise search
+------------------------------------------------------------------------- */
+
+void Neighbor::build_partial()
+{
+  int i,m;
+  double delx,dely,delz;
+
+  partial_pending = 0;
+
+  double **x = atom->x;
+  int nall = atom->nlocal + atom->nghost;
+
+  nhot = 0;
+  for (i = 0; i < nall; i++) {
+    if (!hotflag[i]) {
+      delx = x[i][0] - xhold[i][0];
+      dely = x[i][1] - xhold[i][1];
+      delz = x[i][2] - xhold[i][2];
+      if (delx*delx + dely*dely + delz*delz <= partial_triggersq) continue;
+      hotflag[i] = 1;
+    }
+    hotlist[nhot++] = i;
+  }
+  if (nhot == 0) return;
+
+  npartial++;
+
+  for (i = 0; i < nbin; i++) neigh_bin[i]->bin_atoms_partial();
+
+  for (i = 0; i < npair_perpetual; i++) {
+    m = plist[i];
+    neigh_pair[m]->build_setup();
+    neigh_pair[m]->build_partial(lists[m]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    build topology neighbor lists: bond, angle, dihedral, improper
    copy their list info back to Neighbor for access by bond/angle/etc classes
@@ -2454,6 +2560,12 @@ void Neighbor::modify_params(int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) dist_check = 0;
       else error->all(FLERR,"Illegal neigh_modify command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"partial") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) partialflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) partialflag = 0;
+      else error->all(FLERR,"Illegal neigh_modify command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"once") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
       if (strcmp(arg[iarg+1],"yes") == 0) build_once = 1;
@@ -2476,6 +2588,12 @@ void Neighbor::modify_params(int narg, char **arg)
       if (binsize_user <= 0.0) binsizeflag = 0;
       else binsizeflag = 1;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"clustersize") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      clustersize = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (clustersize != 4 && clustersize != 8)
+        error->all(FLERR,"Illegal neigh_modify command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"cluster") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
       if (strcmp(arg[iarg+1],"yes") == 0) cluster_check = 1;
@@ -2758,6 +2876,7 @@ double Neighbor::memory_usage()
 {
   double bytes = 0;
   bytes += memory->usage(xhold,maxhold,3);
+  bytes += 2.0*memory->usage(hotlist,maxhot);
 
   for (int i = 0; i < nlist; i++)
     if (lists[i]) bytes += lists[i]->memory_usage(); 
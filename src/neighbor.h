@@ -31,6 +31,9 @@ class Neighbor : protected Pointers {
   int includegroup;    // only build pairwise lists for this group
   int build_once;      // 1 if only build lists once per run
   int atomvec_check_flag;          // 1 if atomvec style invokes its own check function for rebuilds
+  int partialflag;       // 1 if re-listing only near moved atoms is requested
+  int partial_active;    // 1 if partial re-listing is used in current run
+  int partial_pending;   // 1 if check_distance() requests a partial build
   int stencil_post_create_flag;    // 1 if atomvec style invokes its own check function for rebuilds
 
   double skin;                    // skin distance
@@ -47,9 +50,11 @@ class Neighbor : protected Pointers {
 
   int binsizeflag;        // user-chosen bin size
   double binsize_user;    // set externally by some accelerator pkgs
+  int clustersize;        // # of atoms per cluster in cluster-pair lists
 
   bigint ncalls;      // # of times build has been called
   bigint ndanger;     // # of dangerous builds
+  bigint npartial;    // # of partial builds
   bigint lastcall;    // timestep of last neighbor::build() call
 
   // geometry and static info, used by other Neigh classes
@@ -93,6 +98,12 @@ class Neighbor : protected Pointers {
   class NeighRequest **requests;        // from Pair,Fix,Compute,Command classes
   class NeighRequest **old_requests;    // copy of requests to compare to
 
+  // atoms that moved past trigger, set by build_partial() for NPair classes
+
+  int nhot;         // # of owned and ghost atoms in hotlist
+  int *hotlist;     // indices of those atoms
+  int *hotflag;     // 1 if atom moved past trigger since last build
+
   // data from topology neighbor lists
 
   int nbondlist;    // list of bonds to compute
@@ -126,6 +137,7 @@ class Neighbor : protected Pointers {
   virtual int check_distance();     // check max distance moved since last build
   void setup_bins();                // setup bins based on box and cutoff
   virtual void build(int);          // build all perpetual neighbor lists
+  void build_partial();             // re-list atoms near atoms that moved
   virtual void build_topology();    // pairwise topology neighbor lists
   void build_one(class NeighList *list, int preflag = 0);
   // create a one-time pairwise neigh list
@@ -158,9 +170,11 @@ class Neighbor : protected Pointers {
   int *fixchecklist;    // which fixes to check
 
   double triggersq;    // trigger = build when atom moves this dist
+  double partial_triggersq;    // trigger of last check_distance()
 
   double **xhold;    // atom coords at last neighbor build
   int maxhold;       // size of xhold array
+  int maxhot;        // size of hotlist array
 
   int boxcheck;                           // 1 if need to store box size
   double boxlo_hold[3], boxhi_hold[3];    // box size at last neighbor build
@@ -304,7 +318,8 @@ namespace NeighConst {
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
     NP_MULTI_OLD = 1 << 25,
-    NP_CAC = 1<<26
+    NP_CAC = 1<<26,
+    NP_CLUSTER = 1 << 27
   };
 }    // namespace NeighConst
 
@@ -320,6 +335,17 @@ The delay and every parameters set via the neigh_modify command are
 inconsistent.  If the delay setting is non-zero, then it must be a
 multiple of the every setting.
 
+E: Neighbor partial requires bin style, check yes, and no include group or once setting
+
+Partial re-listing of neighbors relies on binned lists and on the
+distance check that decides when atoms have moved too far.
+
+E: Neighbor partial is not supported by neighbor list build %s
+
+Partial re-listing of neighbors is only implemented for half lists
+with newton pair off, full lists, and lists copied or derived from
+those.  Use neigh_modify partial no.
+
 E: Neighbor page size must be >= 10x the one atom setting
 
 This is required to prevent wasting too much memory.
@@ -14,7 +14,10 @@
 
 #include "npair.h"
 #include <cmath>
+#include <cstring>
 #include "neighbor.h"
+#include "neigh_list.h"
+#include "my_page.h"
 #include "neigh_request.h"
 #include "nbin.h"
 #include "nstencil.h"
@@ -25,6 +28,8 @@
 
 using namespace LAMMPS_NS;
 
+#define PARTIAL_EXTRA 8   // lists growing in a partial build get 1/8 extra room
+
 /* ---------------------------------------------------------------------- */
 
 NPair::NPair(LAMMPS *lmp)
@@ -32,6 +37,11 @@ NPair::NPair(LAMMPS *lmp)
 {
   last_build = -1;
   mycutneighsq = nullptr;
+  partial = 0;
+  npartial = maxpartial = maxbinflag = 0;
+  partlist = binflag = dirtybins = nullptr;
+  capacity_flag = maxcapacity = 0;
+  capacity = nullptr;
   molecular = atom->molecular;
   copymode = 0;
   execution_space = Host;
@@ -44,6 +54,10 @@ NPair::~NPair()
   if (copymode) return;
 
   memory->destroy(mycutneighsq);
+  memory->destroy(partlist);
+  memory->destroy(binflag);
+  memory->destroy(dirtybins);
+  memory->destroy(capacity);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -164,6 +178,16 @@ void NPair::copy_bin_info()
   bin_content = nb->bin_content;
   nbin_element_overlap = nb->nbin_element_overlap;
   bin_element_overlap = nb->bin_element_overlap;
+  coarse_flag = nb->coarse_flag;
+  coarse_factor = nb->coarse_factor;
+  mcbinx = nb->mcbinx;
+  mcbiny = nb->mcbiny;
+  mcbinz = nb->mcbinz;
+  coarse_ncontent = nb->coarse_ncontent;
+  coarse_content = nb->coarse_content;
+  coarse_limits = nb->coarse_limits;
+  fine_limits = nb->fine_limits;
+  coarse_binned = nb->coarse_binned;
 }
 
 /* ----------------------------------------------------------------------
@@ -196,6 +220,112 @@ void NPair::build_setup()
   last_build = update->ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   find owned atoms whose neighbors must be re-listed in a partial build
+   flag bins within stencil of any bin holding an atom in Neighbor hotlist,
+     stencil is symmetric, so these are all bins whose owned atoms
+     can have a moved atom within cutoff
+   partlist = owned atoms in flagged bins
+   bins must be current, i.e. set by NBin::bin_atoms_partial()
+------------------------------------------------------------------------- */
+
+void NPair::partial_atoms()
+{
+  int i,k,ibin,jbin;
+
+  if (mbins > maxbinflag) {
+    maxbinflag = mbins;
+    memory->destroy(binflag);
+    memory->destroy(dirtybins);
+    memory->create(binflag,maxbinflag,"npair:binflag");
+    memory->create(dirtybins,maxbinflag,"npair:dirtybins");
+    for (i = 0; i < maxbinflag; i++) binflag[i] = 0;
+  }
+
+  int nlocal = atom->nlocal;
+  if (nlocal > maxpartial) {
+    maxpartial = atom->nmax;
+    memory->destroy(partlist);
+    memory->create(partlist,maxpartial,"npair:partlist");
+  }
+
+  int nhot = neighbor->nhot;
+  int *hotlist = neighbor->hotlist;
+  int ndirty = 0;
+
+  for (i = 0; i < nhot; i++) {
+    ibin = atom2bin[hotlist[i]];
+    if (ibin < 0) continue;
+    for (k = 0; k < nstencil; k++) {
+      jbin = ibin + stencil[k];
+      if (jbin < 0 || jbin >= mbins || binflag[jbin]) continue;
+      binflag[jbin] = 1;
+      dirtybins[ndirty++] = jbin;
+    }
+  }
+
+  // owned atoms precede ghost atoms in each bin
+
+  npartial = 0;
+  for (k = 0; k < ndirty; k++) {
+    jbin = dirtybins[k];
+    binflag[jbin] = 0;
+    for (i = binhead[jbin]; i >= 0 && i < nlocal; i = bins[i])
+      partlist[npartial++] = i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store N neighbors of atom I found by a partial build
+   neighptr = chunk from ipage->vget() used as scratch, not yet recorded
+   copy the new list into the old chunk of I if it fits, so repeated
+     partial builds between full builds do not use up more pages,
+   else record the scratch chunk with some room to grow and point I to it
+   capacity = room in the chunk of each owned atom,
+     taken from numneigh at the first partial build after a full build
+------------------------------------------------------------------------- */
+
+void NPair::store_partial(NeighList *list, int i, int *neighptr, int n)
+{
+  if (!capacity_flag) {
+    int nlocal = atom->nlocal;
+    if (nlocal > maxcapacity) {
+      maxcapacity = atom->nmax;
+      memory->destroy(capacity);
+      memory->create(capacity,maxcapacity,"npair:capacity");
+    }
+    for (int j = 0; j < nlocal; j++) capacity[j] = list->numneigh[j];
+    capacity_flag = 1;
+  }
+
+  if (n <= capacity[i]) {
+    memcpy(list->firstneigh[i],neighptr,n*sizeof(int));
+  } else {
+    capacity[i] = MIN(n + n/PARTIAL_EXTRA + 1,list->oneatom);
+    list->firstneigh[i] = neighptr;
+    list->ipage->vgot(MAX(n,capacity[i]));
+    if (list->ipage->status())
+      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+  }
+  list->numneigh[i] = n;
+}
+
+/* ----------------------------------------------------------------------
+   partlist = atoms re-listed by NPair of parent list
+   for lists derived from a parent, so their own children see the same atoms
+------------------------------------------------------------------------- */
+
+void NPair::copy_partial(NPair *np)
+{
+  if (np->npartial > maxpartial) {
+    maxpartial = atom->nmax;
+    memory->destroy(partlist);
+    memory->create(partlist,maxpartial,"npair:partlist");
+  }
+  npartial = np->npartial;
+  for (int i = 0; i < npartial; i++) partlist[i] = np->partlist[i];
+}
+
 /* ----------------------------------------------------------------------
    test if atom pair i,j is excluded from neighbor list
    due to type, group, molecule settings from neigh_modify command
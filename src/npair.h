@@ -27,12 +27,18 @@ class NPair : protected Pointers {
 
   double cutoff_custom;    // cutoff set by requestor
 
+  int partial;        // 1 if build_partial() can re-list a subset of atoms
+  int npartial;       // # of owned atoms re-listed by last build_partial()
+  int *partlist;      // indices of those atoms
+  int capacity_flag;  // 0 if capacity must be reset after a full build
+
   NPair(class LAMMPS *);
   virtual ~NPair();
   void post_constructor(class NeighRequest *);
   virtual void copy_neighbor_info();
   void build_setup();
   virtual void build(class NeighList *) = 0;
+  virtual void build_partial(class NeighList *) {}
   virtual bigint memory_usage() {return 0;}
   virtual int pack_forward_comm(int, int *, double *, int, int *){}
   virtual void unpack_forward_comm(int, int, double *){}
@@ -100,6 +106,14 @@ class NPair : protected Pointers {
   int *quad2bin;              //bin location of each local quadrature point
   int *nbin_element_overlap;  //array storing the number of bins this element overlaps
   int **bin_element_overlap;  //set of bins this element overlaps
+  int coarse_flag;            //1 if large elements are binned in the coarse grid only
+  int coarse_factor;          //fine bins per coarse bin along each dimension
+  int mcbinx, mcbiny, mcbinz; //number of coarse bins along each dimension
+  int *coarse_ncontent;       //number of large elements in each coarse bin
+  int **coarse_content;       //large elements in each coarse bin
+  int **coarse_limits;        //coarse bin limits of each atom and element bounding box
+  int **fine_limits;          //fine bin limits of the reduced box of each large element
+  int *coarse_binned;         //1 if this element is binned in the coarse grid
 
   // data from NStencil class
 
@@ -122,6 +136,17 @@ class NPair : protected Pointers {
   virtual void copy_bin_info();
   virtual void copy_stencil_info();
 
+  int maxpartial;     // size of partlist
+  int maxbinflag;     // size of binflag and dirtybins
+  int *binflag;       // 1 if bin is in stencil of a moved atom
+  int *dirtybins;     // list of flagged bins
+  int maxcapacity;    // size of capacity
+  int *capacity;      // room in the neighbor chunk of each owned atom
+
+  void partial_atoms();            // find owned atoms near atoms that moved
+  void copy_partial(NPair *);      // re-list same atoms as parent list
+  void store_partial(class NeighList *, int, int *, int);   // keep re-listed neighbors
+
   int exclusion(int, int, int, int, int *, tagint *) const;    // test for pair exclusion
   int coord2bin(double *);                                     // mapping atom coord to a bin
   int coord2bin(double *, int &, int &, int &);                // ditto
@@ -19,7 +19,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-NPairCopy::NPairCopy(LAMMPS *lmp) : NPair(lmp) {}
+NPairCopy::NPairCopy(LAMMPS *lmp) : NPair(lmp)
+{
+  partial = 1;
+}
 
 /* ----------------------------------------------------------------------
    create list which is simply a copy of parent list
@@ -35,4 +38,27 @@ void NPairCopy::build(NeighList *list)
   list->numneigh = listcopy->numneigh;
   list->firstneigh = listcopy->firstneigh;
   list->ipage = listcopy->ipage;
+
+  if (listcopy->cluster) {
+    list->clustersize = listcopy->clustersize;
+    list->nicluster = listcopy->nicluster;
+    list->ncluster = listcopy->ncluster;
+    list->clusteratom = listcopy->clusteratom;
+    list->numjcluster = listcopy->numjcluster;
+    list->firstjcluster = listcopy->firstjcluster;
+    list->tilecode = listcopy->tilecode;
+    list->ntilecode = listcopy->ntilecode;
+    list->xcluster = listcopy->xcluster;
+    list->tcluster = listcopy->tcluster;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   partial build of parent list already updated the arrays I point to
+   just expose which atoms it re-listed to lists derived from me
+------------------------------------------------------------------------- */
+
+void NPairCopy::build_partial(NeighList *list)
+{
+  copy_partial(list->listcopy->np);
 }
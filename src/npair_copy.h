@@ -31,6 +31,7 @@ class NPairCopy : public NPair {
   NPairCopy(class LAMMPS *);
   ~NPairCopy() {}
   void build(class NeighList *);
+  void build_partial(class NeighList *);
 };
 
 }    // namespace LAMMPS_NS
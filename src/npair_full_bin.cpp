@@ -19,13 +19,17 @@
 #include "molecule.h"
 #include "domain.h"
 #include "my_page.h"
+#include "neighbor.h"
 #include "error.h"
 
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-NPairFullBin::NPairFullBin(LAMMPS *lmp) : NPair(lmp) {}
+NPairFullBin::NPairFullBin(LAMMPS *lmp) : NPair(lmp)
+{
+  partial = 1;
+}
 
 /* ----------------------------------------------------------------------
    binned neighbor list construction for all neighbors
@@ -123,3 +127,103 @@ void NPairFullBin::build(NeighList *list)
   list->inum = inum;
   list->gnum = 0;
 }
+
+/* ----------------------------------------------------------------------
+   re-list owned atoms near atoms that moved past the trigger distance
+   same criteria as build() for pairs with a hot atom, see Neighbor::hotflag
+   new neighbors are appended to current pages, old ones are dropped
+     when pages are reset by next build()
+------------------------------------------------------------------------- */
+
+void NPairFullBin::build_partial(NeighList *list)
+{
+  int i,j,k,n,ii,jj,jnum,itype,jtype,ibin,which,imol,iatom,moltemplate;
+  tagint tagprev;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  int *neighptr,*jlist;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  tagint **special = atom->special;
+  int **nspecial = atom->nspecial;
+
+  int *molindex = atom->molindex;
+  int *molatom = atom->molatom;
+  Molecule **onemols = atom->avec->onemols;
+  if (molecular == Atom::TEMPLATE) moltemplate = 1;
+  else moltemplate = 0;
+
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  MyPage<int> *ipage = list->ipage;
+  int *hotflag = neighbor->hotflag;
+
+  partial_atoms();
+
+  for (ii = 0; ii < npartial; ii++) {
+    i = partlist[ii];
+    n = 0;
+    neighptr = ipage->vget();
+
+    // if I never moved past trigger, keep my neighbors that never did either
+    // only search bins for neighbors that did
+
+    if (!hotflag[i]) {
+      jlist = firstneigh[i];
+      jnum = numneigh[i];
+      for (jj = 0; jj < jnum; jj++)
+        if (!hotflag[jlist[jj] & NEIGHMASK]) neighptr[n++] = jlist[jj];
+    }
+
+    itype = type[i];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    if (moltemplate) {
+      imol = molindex[i];
+      iatom = molatom[i];
+      tagprev = tag[i] - iatom - 1;
+    }
+
+    // loop over all atoms in surrounding bins in stencil including self
+    // skip i = j
+
+    ibin = atom2bin[i];
+
+    for (k = 0; k < nstencil; k++) {
+      for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
+        if (i == j) continue;
+        if (!hotflag[i] && !hotflag[j]) continue;
+
+        jtype = type[j];
+        if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
+
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq <= cutneighsq[itype][jtype]) {
+          if (molecular != Atom::ATOMIC) {
+            if (!moltemplate)
+              which = find_special(special[i],nspecial[i],tag[j]);
+            else if (imol >= 0)
+              which = find_special(onemols[imol]->special[iatom],
+                                   onemols[imol]->nspecial[iatom],
+                                   tag[j]-tagprev);
+            else which = 0;
+            if (which == 0) neighptr[n++] = j;
+            else if (domain->minimum_image_check(delx,dely,delz))
+              neighptr[n++] = j;
+            else if (which > 0) neighptr[n++] = j ^ (which << SBBITS);
+          } else neighptr[n++] = j;
+        }
+      }
+    }
+
+    store_partial(list,i,neighptr,n);
+  }
+}
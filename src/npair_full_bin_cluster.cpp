@@ -0,0 +1,348 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_full_bin_cluster.h"
+#include <cmath>
+#include "neigh_list.h"
+#include "atom.h"
+#include "atom_vec.h"
+#include "molecule.h"
+#include "domain.h"
+#include "my_page.h"
+#include "neighbor.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+#define BIG 1.0e20
+
+/* ---------------------------------------------------------------------- */
+
+NPairFullBinCluster::NPairFullBinCluster(LAMMPS *lmp) : NPair(lmp)
+{
+  maxbin = 0;
+  ofirst = olast = gfirst = glast = nullptr;
+  maxcluster = 0;
+  cbin = nullptr;
+  cbox = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairFullBinCluster::~NPairFullBinCluster()
+{
+  memory->destroy(ofirst);
+  memory->destroy(olast);
+  memory->destroy(gfirst);
+  memory->destroy(glast);
+  memory->destroy(cbin);
+  memory->destroy(cbox);
+}
+
+/* ----------------------------------------------------------------------
+   binned cluster-pair list construction for all neighbors
+   atoms are grouped into clusters of clustersize atoms in bin order,
+     a cluster never spans two rows of bins along x
+   owned and ghost atoms are put into separate clusters
+   every owned cluster lists all clusters whose bounding box is
+     within the largest neighbor cutoff of its own, including itself
+------------------------------------------------------------------------- */
+
+void NPairFullBinCluster::build(NeighList *list)
+{
+  int i,j,k,n,ic,jc,b,iy,iz,jy,jz,lo,hi,ix0,ix1,cf,cl;
+  int *neighptr;
+
+  if (includegroup || exclude)
+    error->all(FLERR,"Cluster neighbor lists do not support "
+               "neigh_modify exclude or include");
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  int ntypes = atom->ntypes;
+
+  const int cs = neighbor->clustersize;
+  list->clustersize = cs;
+
+  // grow per-bin and per-cluster arrays
+  // each row of bins adds at most one partially filled cluster
+  //   for owned and one for ghost atoms
+
+  if (mbins > maxbin) {
+    maxbin = mbins;
+    memory->destroy(ofirst);
+    memory->destroy(olast);
+    memory->destroy(gfirst);
+    memory->destroy(glast);
+    memory->create(ofirst,maxbin,"neigh:ofirst");
+    memory->create(olast,maxbin,"neigh:olast");
+    memory->create(gfirst,maxbin,"neigh:gfirst");
+    memory->create(glast,maxbin,"neigh:glast");
+  }
+
+  int nrow = mbiny*mbinz;
+  int nbound = nlocal/cs + (nall-nlocal)/cs + 2*nrow + 2;
+  list->grow_cluster(nbound);
+
+  if (nbound > maxcluster) {
+    maxcluster = nbound;
+    memory->destroy(cbin);
+    memory->destroy(cbox);
+    memory->create(cbin,3*maxcluster,"neigh:cbin");
+    memory->create(cbox,6*maxcluster,"neigh:cbox");
+  }
+
+  // group owned atoms first, then ghost atoms
+
+  int nicluster = make_clusters(list,0,nlocal,0,ofirst,olast);
+  int ncluster = make_clusters(list,nlocal,nall,nicluster,gfirst,glast);
+  list->nicluster = nicluster;
+  list->ncluster = ncluster;
+
+  // bounding box of each cluster
+
+  int *clusteratom = list->clusteratom;
+
+  for (ic = 0; ic < ncluster; ic++) {
+    double *box = &cbox[6*ic];
+    box[0] = box[1] = box[2] = BIG;
+    box[3] = box[4] = box[5] = -BIG;
+    for (k = 0; k < cs; k++) {
+      i = clusteratom[ic*cs+k];
+      if (i < 0) continue;
+      box[0] = MIN(box[0],x[i][0]);
+      box[1] = MIN(box[1],x[i][1]);
+      box[2] = MIN(box[2],x[i][2]);
+      box[3] = MAX(box[3],x[i][0]);
+      box[4] = MAX(box[4],x[i][1]);
+      box[5] = MAX(box[5],x[i][2]);
+    }
+  }
+
+  // pairs of clusters are kept if their boxes are closer than
+  //   the largest neighbor cutoff of any pair of types
+  // bin reach in each dimension is the same as for a bin stencil
+
+  double cutmaxsq = 0.0;
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++)
+      cutmaxsq = MAX(cutmaxsq,cutneighsq[i][j]);
+  double cutmax = sqrt(cutmaxsq);
+
+  int sx = static_cast<int> (cutmax*bininvx);
+  if (sx/bininvx < cutmax) sx++;
+  int sy = static_cast<int> (cutmax*bininvy);
+  if (sy/bininvy < cutmax) sy++;
+  int sz = static_cast<int> (cutmax*bininvz);
+  if (sz/bininvz < cutmax) sz++;
+
+  int *numjcluster = list->numjcluster;
+  int **firstjcluster = list->firstjcluster;
+  MyPage<int> *ipage = list->ipage;
+
+  ipage->reset();
+  list->ntilecode = 0;
+
+  for (ic = 0; ic < nicluster; ic++) {
+    n = 0;
+    neighptr = ipage->vget();
+
+    const double *ibox = &cbox[6*ic];
+    ix0 = cbin[3*ic];
+    ix1 = cbin[3*ic+1];
+    iy = cbin[3*ic+2] % mbiny;
+    iz = cbin[3*ic+2] / mbiny;
+    lo = MAX(ix0-sx,0);
+    hi = MIN(ix1+sx,mbinx-1);
+
+    // clusters of each row within reach are a contiguous range
+    //   of owned and a contiguous range of ghost clusters
+
+    for (jz = MAX(iz-sz,0); jz <= MIN(iz+sz,mbinz-1); jz++) {
+      for (jy = MAX(iy-sy,0); jy <= MIN(iy+sy,mbiny-1); jy++) {
+        int base = (jz*mbiny + jy)*mbinx;
+
+        for (int pass = 0; pass < 2; pass++) {
+          int *first = pass ? gfirst : ofirst;
+          int *last = pass ? glast : olast;
+
+          cf = cl = -1;
+          for (b = base+lo; b <= base+hi; b++)
+            if (first[b] >= 0) {
+              cf = first[b];
+              break;
+            }
+          if (cf < 0) continue;
+          for (b = base+hi; b >= base+lo; b--)
+            if (last[b] >= 0) {
+              cl = last[b];
+              break;
+            }
+
+          for (jc = cf; jc <= cl; jc++) {
+            const double *jbox = &cbox[6*jc];
+            double dx = MAX(0.0,MAX(jbox[0]-ibox[3],ibox[0]-jbox[3]));
+            double dy = MAX(0.0,MAX(jbox[1]-ibox[4],ibox[1]-jbox[4]));
+            double dz = MAX(0.0,MAX(jbox[2]-ibox[5],ibox[2]-jbox[5]));
+            if (dx*dx + dy*dy + dz*dz > cutmaxsq) continue;
+            neighptr[n++] = jc;
+            neighptr[n++] = tile_codes(list,ic,jc);
+          }
+        }
+      }
+    }
+
+    firstjcluster[ic] = neighptr;
+    numjcluster[ic] = n/2;
+    ipage->vgot(n);
+    if (ipage->status())
+      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+  }
+
+  list->inum = 0;
+  list->gnum = 0;
+}
+
+/* ----------------------------------------------------------------------
+   group binned atoms with indices ilo <= i < ihi into clusters
+   clusters are numbered from nc on, padding slots are set to -1
+   first/last = range of clusters holding atoms of each bin, -1 if none
+   relies on binned atoms being chained in increasing index order
+   return new # of clusters
+------------------------------------------------------------------------- */
+
+int NPairFullBinCluster::make_clusters(NeighList *list, int ilo, int ihi,
+                                       int nc, int *first, int *last)
+{
+  int j,b,ix,slot,c;
+
+  int *clusteratom = list->clusteratom;
+  const int cs = list->clustersize;
+  int nrow = mbiny*mbinz;
+
+  for (int row = 0; row < nrow; row++) {
+    slot = 0;
+    c = -1;
+    for (ix = 0; ix < mbinx; ix++) {
+      b = row*mbinx + ix;
+      first[b] = last[b] = -1;
+      for (j = binhead[b]; j >= 0; j = bins[j]) {
+        if (j < ilo) continue;
+        if (j >= ihi) break;
+        if (slot == 0) {
+          c = nc++;
+          cbin[3*c] = ix;
+          cbin[3*c+2] = row;
+        }
+        clusteratom[c*cs+slot] = j;
+        cbin[3*c+1] = ix;
+        if (first[b] < 0) first[b] = c;
+        last[b] = c;
+        if (++slot == cs) slot = 0;
+      }
+    }
+    if (slot)
+      for (; slot < cs; slot++) clusteratom[c*cs+slot] = -1;
+  }
+
+  return nc;
+}
+
+/* ----------------------------------------------------------------------
+   store special codes for all I,J slot pairs of tile of clusters IC,JC
+   codes follow the same rules as special bits of regular lists
+   return offset of codes in list->tilecode
+   return -1 if all atom pairs of the tile are normal pairs
+------------------------------------------------------------------------- */
+
+int NPairFullBinCluster::tile_codes(NeighList *list, int ic, int jc)
+{
+  int i,j,ii,jj,which,imol,iatom;
+  tagint tagprev;
+
+  if (ic != jc && molecular == Atom::ATOMIC) return -1;
+
+  double **x = atom->x;
+  tagint *tag = atom->tag;
+  tagint **special = atom->special;
+  int **nspecial = atom->nspecial;
+  int *molindex = atom->molindex;
+  int *molatom = atom->molatom;
+  Molecule **onemols = atom->avec->onemols;
+  int moltemplate = (molecular == Atom::TEMPLATE) ? 1 : 0;
+
+  const int cs = list->clustersize;
+  const int *iatoms = &list->clusteratom[ic*cs];
+  const int *jatoms = &list->clusteratom[jc*cs];
+
+  list->grow_tilecode(cs*cs);
+  unsigned char *code = &list->tilecode[list->ntilecode];
+  int anycode = 0;
+
+  for (ii = 0; ii < cs; ii++) {
+    i = iatoms[ii];
+    if (moltemplate && i >= 0) {
+      imol = molindex[i];
+      iatom = molatom[i];
+      tagprev = tag[i] - iatom - 1;
+    }
+
+    for (jj = 0; jj < cs; jj++) {
+      j = jatoms[jj];
+      code[ii*cs+jj] = 0;
+      if (i < 0 || j < 0) continue;
+      if (i == j) {
+        code[ii*cs+jj] = SKIP;
+        anycode = 1;
+        continue;
+      }
+      if (molecular == Atom::ATOMIC) continue;
+
+      if (!moltemplate)
+        which = find_special(special[i],nspecial[i],tag[j]);
+      else if (imol >= 0)
+        which = find_special(onemols[imol]->special[iatom],
+                             onemols[imol]->nspecial[iatom],
+                             tag[j]-tagprev);
+      else which = 0;
+      if (which == 0) continue;
+
+      double delx = x[i][0] - x[j][0];
+      double dely = x[i][1] - x[j][1];
+      double delz = x[i][2] - x[j][2];
+      if (domain->minimum_image_check(delx,dely,delz)) continue;
+
+      code[ii*cs+jj] = (which > 0) ? which : SKIP;
+      anycode = 1;
+    }
+  }
+
+  if (!anycode) return -1;
+  int offset = list->ntilecode;
+  list->ntilecode += cs*cs;
+  return offset;
+}
+
+/* ---------------------------------------------------------------------- */
+
+bigint NPairFullBinCluster::memory_usage()
+{
+  bigint bytes = 0;
+  bytes += (bigint) 4*maxbin*sizeof(int);
+  bytes += (bigint) 3*maxcluster*sizeof(int);
+  bytes += (bigint) 6*maxcluster*sizeof(double);
+  return bytes;
+}
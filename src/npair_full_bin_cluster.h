@@ -0,0 +1,75 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(full/bin/cluster,
+           NPairFullBinCluster,
+           NP_FULL | NP_BIN | NP_CLUSTER |
+           NP_NEWTON | NP_NEWTOFF | NP_ORTHO);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_FULL_BIN_CLUSTER_H
+#define LMP_NPAIR_FULL_BIN_CLUSTER_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+class NPairFullBinCluster : public NPair {
+ public:
+  // special codes stored per I,J slot pair in NeighList::tilecode
+  // 0 = normal pair, 1-3 = special_lj/coul index, SKIP = no interaction
+
+  enum { SKIP = 4 };
+
+  NPairFullBinCluster(class LAMMPS *);
+  ~NPairFullBinCluster();
+  void build(class NeighList *);
+  bigint memory_usage();
+
+ private:
+  int maxbin;        // size of per-bin arrays
+  int *ofirst;       // 1st owned cluster with atoms in each bin, -1 if none
+  int *olast;        // last owned cluster with atoms in each bin
+  int *gfirst;       // same for ghost clusters
+  int *glast;
+
+  int maxcluster;    // size of per-cluster arrays
+  int *cbin;         // 1st and last x bin and row of each cluster
+  double *cbox;      // bounding box of each cluster, lo xyz then hi xyz
+
+  int make_clusters(class NeighList *, int, int, int, int *, int *);
+  int tile_codes(class NeighList *, int, int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Cluster neighbor lists do not support neigh_modify exclude or include
+
+Cluster-pair lists store whole tiles of atoms and cannot drop
+individual pairs by type, group, or molecule, or restrict the list
+to a group.
+
+E: Neighbor list overflow, boost neigh_modify one
+
+There are too many neighbor clusters of one cluster.  Each cluster
+uses 2 entries per neighbor cluster of the page.
+
+*/
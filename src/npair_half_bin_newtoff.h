@@ -31,6 +31,7 @@ class NPairHalfBinNewtoff : public NPair {
   NPairHalfBinNewtoff(class LAMMPS *);
   ~NPairHalfBinNewtoff() {}
   void build(class NeighList *);
+  void build_partial(class NeighList *);
 };
 
 }    // namespace LAMMPS_NS
@@ -22,7 +22,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-NPairHalffullNewtoff::NPairHalffullNewtoff(LAMMPS *lmp) : NPair(lmp) {}
+NPairHalffullNewtoff::NPairHalffullNewtoff(LAMMPS *lmp) : NPair(lmp)
+{
+  partial = 1;
+}
 
 /* ----------------------------------------------------------------------
    build half list from full list
@@ -81,3 +84,40 @@ void NPairHalffullNewtoff::build(NeighList *list)
   list->inum = inum;
   if (list->ghost) list->gnum = list->listfull->gnum;
 }
+
+/* ----------------------------------------------------------------------
+   re-derive half list of atoms the full list re-listed in a partial build
+   new neighbors are appended to current pages
+   same atoms are re-listed in lists derived from me
+------------------------------------------------------------------------- */
+
+void NPairHalffullNewtoff::build_partial(NeighList *list)
+{
+  int i,j,ii,jj,n,jnum,joriginal;
+  int *neighptr,*jlist;
+
+  MyPage<int> *ipage = list->ipage;
+
+  int *numneigh_full = list->listfull->numneigh;
+  int **firstneigh_full = list->listfull->firstneigh;
+  NPair *np = list->listfull->np;
+
+  for (ii = 0; ii < np->npartial; ii++) {
+    n = 0;
+    neighptr = ipage->vget();
+
+    i = np->partlist[ii];
+    jlist = firstneigh_full[i];
+    jnum = numneigh_full[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      joriginal = jlist[jj];
+      j = joriginal & NEIGHMASK;
+      if (j > i) neighptr[n++] = joriginal;
+    }
+
+    store_partial(list,i,neighptr,n);
+  }
+
+  copy_partial(np);
+}
@@ -47,6 +47,7 @@ class NPairHalffullNewtoff : public NPair {
   NPairHalffullNewtoff(class LAMMPS *);
   ~NPairHalffullNewtoff() {}
   void build(class NeighList *);
+  void build_partial(class NeighList *);
 };
 
 }    // namespace LAMMPS_NS
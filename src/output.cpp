@@ -396,6 +396,16 @@ void Output::write_dump(bigint ntimestep)
   }
 }
 
+/* ----------------------------------------------------------------------
+   wait until dumps with a writer thread wrote their last snapshot
+   called at the end of a run so the files are complete
+------------------------------------------------------------------------- */
+
+void Output::sync_dumps()
+{
+  for (int idump = 0; idump < ndump; idump++) dump[idump]->sync();
+}
+
 /* ----------------------------------------------------------------------
    force restart file(s) to be written
    called from PRD and TAD
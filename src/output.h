@@ -71,6 +71,7 @@ class Output : protected Pointers {
   void setup(int memflag = 1);    // initial output before run/min
   void write(bigint);             // output for current timestep
   void write_dump(bigint);        // force output of dump snapshots
+  void sync_dumps();              // wait for asynchronous dump output
   void write_restart(bigint);     // force output of a restart file
   void reset_timestep(bigint);    // reset next timestep for all output
 
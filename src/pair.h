@@ -29,6 +29,7 @@ class Pair : protected Pointers {
   friend class FixIntel;
   friend class FixOMP;
   friend class ThrOMP;
+  friend class PairCACOMP;
   friend class Info;
 
  public:
@@ -0,0 +1,202 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_cluster.h"
+
+#include "atom.h"
+#include "force.h"
+#include "neighbor.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "npair_full_bin_cluster.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCluster::PairLJCutCluster(LAMMPS *lmp) : PairLJCut(lmp)
+{
+  respa_enable = 0;
+  no_virial_fdotr_compute = 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCluster::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  list->pack_cluster();
+
+  if (list->clustersize == 8) {
+    if (evflag) eval<8,1>();
+    else eval<8,0>();
+  } else {
+    if (evflag) eval<4,1>();
+    else eval<4,0>();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   loop over CS x CS tiles of a full cluster-pair list
+   the inner loop runs over the J slots of a tile with SIMD masks
+   forces and energy/virial are only accumulated for I atoms,
+     so each pair contributes half its energy and virial from each side
+------------------------------------------------------------------------- */
+
+template <int CS, int EVFLAG>
+void PairLJCutCluster::eval()
+{
+  const int SKIP = NPairFullBinCluster::SKIP;
+  static const unsigned char nocode[CS] = {0};
+
+  double** _noalias f = atom->f;
+  const double* _noalias special_lj = force->special_lj;
+
+  const int nicluster = list->nicluster;
+  const int* _noalias clusteratom = list->clusteratom;
+  const double* _noalias xcluster = list->xcluster;
+  const int* _noalias tcluster = list->tcluster;
+  const unsigned char* _noalias tilecode = list->tilecode;
+  int* _noalias numjcluster = list->numjcluster;
+  int** _noalias firstjcluster = list->firstjcluster;
+
+  // special factor for each tile code, SKIP pairs are masked out
+
+  double factor[SKIP+1];
+  for (int m = 0; m < 4; m++) factor[m] = special_lj[m];
+  factor[SKIP] = 0.0;
+
+  for (int ic = 0; ic < nicluster; ic++) {
+    const int *iatoms = &clusteratom[ic*CS];
+    const double *xi = &xcluster[3*ic*CS];
+    const int *ti = &tcluster[ic*CS];
+    const int *jlist = firstjcluster[ic];
+    const int jnum = numjcluster[ic];
+
+    double fxi[CS],fyi[CS],fzi[CS],evdwli[CS],vi[CS][6];
+    for (int ii = 0; ii < CS; ii++) {
+      fxi[ii] = fyi[ii] = fzi[ii] = 0.0;
+      if (EVFLAG) {
+        evdwli[ii] = 0.0;
+        for (int m = 0; m < 6; m++) vi[ii][m] = 0.0;
+      }
+    }
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int jc = jlist[2*jj];
+      const int coff = jlist[2*jj+1];
+      const double* _noalias xj = &xcluster[3*jc*CS];
+      const int* _noalias tj = &tcluster[jc*CS];
+
+      for (int ii = 0; ii < CS; ii++) {
+        if (iatoms[ii] < 0) continue;
+
+        const double xtmp = xi[ii];
+        const double ytmp = xi[CS+ii];
+        const double ztmp = xi[2*CS+ii];
+        const int itype = ti[ii];
+        const double* _noalias cutsqi = cutsq[itype];
+        const double* _noalias lj1i = lj1[itype];
+        const double* _noalias lj2i = lj2[itype];
+        const double* _noalias lj3i = lj3[itype];
+        const double* _noalias lj4i = lj4[itype];
+        const double* _noalias offseti = offset[itype];
+        const unsigned char* _noalias code =
+          (coff >= 0) ? &tilecode[coff+ii*CS] : nocode;
+
+        double fx = 0.0, fy = 0.0, fz = 0.0, evdwl = 0.0;
+        double v0 = 0.0, v1 = 0.0, v2 = 0.0, v3 = 0.0, v4 = 0.0, v5 = 0.0;
+
+#if defined(_OPENMP) || defined(LMP_OPENMP_SIMD)
+#pragma omp simd reduction(+:fx,fy,fz,evdwl,v0,v1,v2,v3,v4,v5)
+#endif
+        for (int k = 0; k < CS; k++) {
+          const double delx = xtmp - xj[k];
+          const double dely = ytmp - xj[CS+k];
+          const double delz = ztmp - xj[2*CS+k];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          const int jtype = tj[k];
+
+          if (rsq < cutsqi[jtype] && code[k] != SKIP) {
+            const double factor_lj = factor[code[k]];
+            const double r2inv = 1.0/rsq;
+            const double r6inv = r2inv*r2inv*r2inv;
+            const double forcelj = r6inv*(lj1i[jtype]*r6inv - lj2i[jtype]);
+            const double fpair = factor_lj*forcelj*r2inv;
+
+            fx += delx*fpair;
+            fy += dely*fpair;
+            fz += delz*fpair;
+
+            if (EVFLAG) {
+              evdwl += factor_lj*(r6inv*(lj3i[jtype]*r6inv - lj4i[jtype]) -
+                                  offseti[jtype]);
+              v0 += delx*delx*fpair;
+              v1 += dely*dely*fpair;
+              v2 += delz*delz*fpair;
+              v3 += delx*dely*fpair;
+              v4 += delx*delz*fpair;
+              v5 += dely*delz*fpair;
+            }
+          }
+        }
+
+        fxi[ii] += fx;
+        fyi[ii] += fy;
+        fzi[ii] += fz;
+        if (EVFLAG) {
+          evdwli[ii] += evdwl;
+          vi[ii][0] += v0;
+          vi[ii][1] += v1;
+          vi[ii][2] += v2;
+          vi[ii][3] += v3;
+          vi[ii][4] += v4;
+          vi[ii][5] += v5;
+        }
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = iatoms[ii];
+      if (i < 0) continue;
+      f[i][0] += fxi[ii];
+      f[i][1] += fyi[ii];
+      f[i][2] += fzi[ii];
+
+      if (EVFLAG) {
+        if (eflag_global) eng_vdwl += 0.5*evdwli[ii];
+        if (eflag_atom) eatom[i] += 0.5*evdwli[ii];
+        if (vflag_global)
+          for (int m = 0; m < 6; m++) virial[m] += 0.5*vi[ii][m];
+        if (vflag_atom)
+          for (int m = 0; m < 6; m++) vatom[i][m] += 0.5*vi[ii][m];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   request a full cluster-pair neighbor list
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::init_style()
+{
+  int irequest = neighbor->request(this,instance_me);
+  neighbor->requests[irequest]->half = 0;
+  neighbor->requests[irequest]->full = 1;
+  neighbor->requests[irequest]->cluster = 1;
+
+  cut_respa = nullptr;
+}
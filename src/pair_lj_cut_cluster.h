@@ -0,0 +1,40 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/cut/cluster,PairLJCutCluster);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_CUT_CLUSTER_H
+#define LMP_PAIR_LJ_CUT_CLUSTER_H
+
+#include "pair_lj_cut.h"
+
+namespace LAMMPS_NS {
+
+class PairLJCutCluster : public PairLJCut {
+ public:
+  PairLJCutCluster(class LAMMPS *);
+  void compute(int, int);
+  void init_style();
+
+ private:
+  template <int CS, int EVFLAG> void eval();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -54,6 +54,10 @@ static constexpr int NSECTIONS = 26;
 
 enum{NONE,APPEND,VALUE,MERGE};
 
+// sections which can be read in parallel after the Atoms section
+
+enum{VELOCITIES,BONDS,ANGLES,DIHEDRALS,IMPROPERS};
+
 // pair style suffixes to ignore
 // when matching Pair Coeffs comment to currently-defined pair style
 
@@ -75,6 +79,12 @@ ReadData::ReadData(LAMMPS *lmp) : Command(lmp)
   coeffarg = nullptr;
   fp = nullptr;
 
+  parallelflag = distflag = 0;
+  shard = nullptr;
+  rbuf = sbuf = nullptr;
+  proclist = nullptr;
+  maxrbuf = maxsend = 0;
+
   // customize for new sections
   // pointers to atom styles that store bonus info
 
@@ -98,6 +108,11 @@ ReadData::~ReadData()
   delete [] buffer;
   memory->sfree(coeffarg);
 
+  memory->destroy(shard);
+  memory->destroy(rbuf);
+  memory->destroy(sbuf);
+  memory->destroy(proclist);
+
   for (int i = 0; i < nfix; i++) {
     delete [] fix_header[i];
     delete [] fix_section[i];
@@ -280,6 +295,12 @@ void ReadData::command(int narg, char **arg)
       fix_section[nfix] = utils::strdup(arg[iarg+3]);
       nfix++;
       iarg += 4;
+    } else if (strcmp(arg[iarg],"parallel") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal read_data command");
+      if (strcmp(arg[iarg+1],"yes") == 0) parallelflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) parallelflag = 0;
+      else error->all(FLERR,"Illegal read_data command");
+      iarg += 2;
 
     } else error->all(FLERR,"Illegal read_data command");
   }
@@ -305,12 +326,20 @@ void ReadData::command(int narg, char **arg)
       (extra_atom_types || extra_bond_types || extra_angle_types ||
        extra_dihedral_types || extra_improper_types))
     error->all(FLERR,"Cannot use read_data extra with add flag");
+  if (parallelflag && addflag != NONE)
+    error->all(FLERR,"Cannot use read_data parallel with add flag");
+  if (parallelflag && utils::strmatch(arg[0],"\\.gz$"))
+    error->all(FLERR,"Cannot use read_data parallel with a compressed "
+               "data file");
 
   // check if data file is available and readable
 
   if (!utils::file_is_readable(arg[0]))
     error->all(FLERR,fmt::format("Cannot open file {}: {}",
                                  arg[0], utils::getsyserror()));
+  datafile = arg[0];
+  if (parallelflag)
+    memory->create(shard,comm->nprocs+1,"read_data:shard");
 
   // first time system initialization
 
@@ -858,8 +887,9 @@ void ReadData::command(int narg, char **arg)
   // use irregular() b/c box size could have changed dramaticaly
   // resulting in procs now owning very different subboxes
   // with their previously owned atoms now far outside the subbox
+  // same for a parallel read, which left atoms distributed by atom ID
 
-  if (addflag != NONE) {
+  if (addflag != NONE || distflag) {
     if (domain->triclinic) domain->x2lamda(atom->nlocal);
     Irregular *irregular = new Irregular(lmp);
     irregular->migrate_atoms(1);
@@ -1242,12 +1272,31 @@ void ReadData::atoms()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,shiftflag,shift);
-    nread += nchunk;
+  // parallel read: each proc parses its own block of lines
+  //   and keeps all atoms it read, migrate_by_id() below moves them
+
+  if (parallelflag) {
+    scan_section(natoms,0);
+    FILE *sfp = open_shard();
+    bigint nmine = shard_first(me+1,natoms) - shard_first(me,natoms);
+    while (nread < nmine) {
+      nchunk = MIN(nmine-nread,CHUNK);
+      read_shard(sfp,nchunk,buffer);
+      atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,
+                       shiftflag,shift,1);
+      nread += nchunk;
+    }
+    fclose(sfp);
+
+  } else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,
+                       shiftflag,shift,0);
+      nread += nchunk;
+    }
   }
 
   // check that all atoms were assigned correctly
@@ -1276,6 +1325,8 @@ void ReadData::atoms()
     atom->map_init();
     atom->map_set();
   }
+
+  if (parallelflag) migrate_by_id();
 }
 
 /* ----------------------------------------------------------------------
@@ -1298,12 +1349,15 @@ void ReadData::velocities()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_vels(nchunk,buffer,id_offset);
-    nread += nchunk;
+  if (parallelflag) parallel_section(VELOCITIES,natoms,nullptr);
+  else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_vels(nchunk,buffer,id_offset);
+      nread += nchunk;
+    }
   }
 
   if (mapflag) {
@@ -1340,12 +1394,15 @@ void ReadData::bonds(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nbonds) {
-    nchunk = MIN(nbonds-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_bonds(nchunk,buffer,count,id_offset,boffset);
-    nread += nchunk;
+  if (parallelflag) parallel_section(BONDS,nbonds,count);
+  else {
+    while (nread < nbonds) {
+      nchunk = MIN(nbonds-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_bonds(nchunk,buffer,count,id_offset,boffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max bond/atom and return
@@ -1414,12 +1471,15 @@ void ReadData::angles(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nangles) {
-    nchunk = MIN(nangles-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_angles(nchunk,buffer,count,id_offset,aoffset);
-    nread += nchunk;
+  if (parallelflag) parallel_section(ANGLES,nangles,count);
+  else {
+    while (nread < nangles) {
+      nchunk = MIN(nangles-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_angles(nchunk,buffer,count,id_offset,aoffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max angle/atom and return
@@ -1488,12 +1548,15 @@ void ReadData::dihedrals(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < ndihedrals) {
-    nchunk = MIN(ndihedrals-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_dihedrals(nchunk,buffer,count,id_offset,doffset);
-    nread += nchunk;
+  if (parallelflag) parallel_section(DIHEDRALS,ndihedrals,count);
+  else {
+    while (nread < ndihedrals) {
+      nchunk = MIN(ndihedrals-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_dihedrals(nchunk,buffer,count,id_offset,doffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max dihedral/atom and return
@@ -1562,12 +1625,15 @@ void ReadData::impropers(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nimpropers) {
-    nchunk = MIN(nimpropers-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_impropers(nchunk,buffer,count,id_offset,ioffset);
-    nread += nchunk;
+  if (parallelflag) parallel_section(IMPROPERS,nimpropers,count);
+  else {
+    while (nread < nimpropers) {
+      nchunk = MIN(nimpropers-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_impropers(nchunk,buffer,count,id_offset,ioffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max improper/atom and return
@@ -1756,120 +1822,133 @@ read all CAC element definitions
 
 void ReadData::CAC_elements()
 {
-	int m, nchunk, nline, nlineinner, nmax, npoly, tmp, nodecount;
-
-	char *eof;
-	char *element_type = (char*)memory->smalloc(sizeof(char) * 20, "read_data: element type string");
-	int chunk = 20;
-	int mapflag = 0;
+  int m = 0, nchunk;
+  int chunk = 20;
   int maxelement = 2*(atom->maxpoly*atom->nodes_per_element);
-	char *CAC_buffer = (char*)memory->smalloc(sizeof(char) *(chunk*MAXLINE*(maxelement+1)+1), "read_data: CAC_buffer");
-  int *nodes_per_element_list = atom->nodes_per_element_list;
-  char **element_names = atom->element_names;
-  int element_type_count = atom->element_type_count;
-	//std::ofstream myfile;
-
-	// nmax = max # of bodies to read in this chunk
-	// nchunk = actual # read
-
-	bigint nread = 0;
-
-
-	while (nread < nCAC_elements) {
-		if (nCAC_elements - nread > chunk) nmax = chunk;
-		else nmax = nCAC_elements - nread;
-
-		if (me == 0) {
-
-
-			nchunk = 0;
-			nline = 0;
-			m = 0;
-
-			while (nchunk < nmax) {
-				eof = fgets(&CAC_buffer[m], MAXLINE, fp);
-
-				if (eof == NULL) error->one(FLERR, "Unexpected end of data file");
-				sscanf(&CAC_buffer[m], "%d %s %d", &tmp, element_type, &npoly);
-				m += strlen(&CAC_buffer[m]);
-				element_type = strtok(element_type, " \t\n\r\f");
-        
-        int type_found=0;
-	      for(int string_check=1; string_check < element_type_count; string_check++){
-	    	if (strcmp(element_type, element_names[string_check]) == 0){
-		    type_found=1;	
-	     	nodecount = nodes_per_element_list[string_check];
-		    }
-	      }
-        if (strcmp(element_type, "Atom") == 0) {
-        type_found=1;
-		   	nodecount = 1;
-		  	npoly = 1;
-	      }
-        if(!type_found) {
-		    error->one(FLERR, "element type not yet defined, add definition in process_args function of atom_vec_CAC.cpp style");
-	      }
-        if(npoly<1)
-        error->one(FLERR, "poly_count less than one in data file");
-        
-				for (nlineinner = 0; nlineinner < nodecount*npoly; nlineinner++) {
-					eof = fgets(&CAC_buffer[m], MAXLINE, fp);
-					// fflush(fp);
-					if (eof == NULL) error->one(FLERR, "Unexpected end of data file");
-
-					m += strlen(&CAC_buffer[m]);
-					if (nlineinner + 1 >= maxelement)
-						error->one(FLERR,
-							"Too many lines in one element in data file - increase maxpoly or max nodes per element for atom style CAC");
-
-				}
-
-				nchunk += 1;
-			}
-    if (m) {
-      if (CAC_buffer[m-1] != '\n') strcpy(&CAC_buffer[m++],"\n");
-      m++;
+  char *CAC_buffer = (char*)memory->smalloc(sizeof(char) *(chunk*MAXLINE*(maxelement+1)+1), "read_data: CAC_buffer");
+
+  // nchunk = # of elements to read in this chunk
+
+  bigint nread = 0;
+
+  // parallel read: each proc parses its own block of elements
+  //   and keeps all elements it read, migrate_by_id() below moves them
+
+  if (parallelflag) {
+    scan_section(nCAC_elements, 1);
+    FILE *sfp = open_shard();
+    bigint nmine = shard_first(me+1, nCAC_elements) - shard_first(me, nCAC_elements);
+    while (nread < nmine) {
+      nchunk = MIN(nmine-nread, chunk);
+      read_CAC_elements(sfp, nchunk, CAC_buffer);
+      atom->data_CAC(nchunk, CAC_buffer, id_offset, toffset, shiftflag, shift, 1);
+      nread += nchunk;
     }
+    fclose(sfp);
 
-		}
+  } else {
+    while (nread < nCAC_elements) {
+      nchunk = MIN(nCAC_elements-nread, chunk);
+      if (me == 0) m = read_CAC_elements(fp, nchunk, CAC_buffer);
+      MPI_Bcast(&m, 1, MPI_INT, 0, world);
+      MPI_Bcast(CAC_buffer, m, MPI_CHAR, 0, world);
+
+      atom->data_CAC(nchunk, CAC_buffer, id_offset, toffset, shiftflag, shift, 0);
+      nread += nchunk;
+    }
+  }
 
+  //check elements were assigned correctly
+  bigint n = atom->nlocal;
+  bigint sum;
+  MPI_Allreduce(&n, &sum, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+  bigint nassign = sum - (atom->natoms - nCAC_elements);
 
-		MPI_Bcast(&nchunk, 1, MPI_INT, 0, world);
-		MPI_Bcast(&m, 1, MPI_INT, 0, world);
-    
-		MPI_Bcast(CAC_buffer, m, MPI_CHAR, 0, world);
+  if (me == 0) {
+    if (screen) fprintf(screen, "  " BIGINT_FORMAT " CAC_Elements\n", nassign);
+    if (logfile) fprintf(logfile, "  " BIGINT_FORMAT " CAC_Elements\n", nassign);
+  }
+
+  if (sum != atom->natoms)
+    error->all(FLERR, "Did not assign all atoms correctly");
 
+  //check if atom ids are valid
+  atom->tag_check();
+
+  if (atom->map_style) {
+    atom->map_init();
+    atom->map_set();
+  }
+
+  if (parallelflag) migrate_by_id();
+
+  memory->sfree(CAC_buffer);
+}
+
+/* ----------------------------------------------------------------------
+read N CAC elements, each a header line plus its node lines, into buf
+returns # of chars in buf, including the terminating null
+------------------------------------------------------------------------- */
 
+int ReadData::read_CAC_elements(FILE *efp, int n, char *buf)
+{
+  int m = 0;
+  int maxelement = 2*(atom->maxpoly*atom->nodes_per_element);
 
-		atom->data_CAC(nchunk, CAC_buffer, id_offset, toffset, shiftflag, shift);
-		nread += nchunk;
-	}
+  for (int i = 0; i < n; i++) {
+    if (fgets(&buf[m], MAXLINE, efp) == nullptr)
+      error->one(FLERR, "Unexpected end of data file");
+    int nnode = CAC_node_lines(&buf[m]);
+    if (nnode >= maxelement)
+      error->one(FLERR, "Too many lines in one element in data file - "
+                 "increase maxpoly or max nodes per element for atom style CAC");
+    m += strlen(&buf[m]);
+
+    for (int j = 0; j < nnode; j++) {
+      if (fgets(&buf[m], MAXLINE, efp) == nullptr)
+        error->one(FLERR, "Unexpected end of data file");
+      m += strlen(&buf[m]);
+    }
+  }
 
-	//check elements were assigned correctly
-	bigint n = atom->nlocal;
-	bigint sum;
-	MPI_Allreduce(&n, &sum, 1, MPI_LMP_BIGINT, MPI_SUM, world);
-	bigint nassign = sum - (atom->natoms - nCAC_elements);
+  if (m) {
+    if (buf[m-1] != '\n') strcpy(&buf[m++], "\n");
+    m++;
+  }
+  return m;
+}
 
-	if (me == 0) {
-		if (screen) fprintf(screen, "  " BIGINT_FORMAT " CAC_Elements\n", nassign);
-		if (logfile) fprintf(logfile, "  " BIGINT_FORMAT " CAC_Elements\n", nassign);
-	}
+/* ----------------------------------------------------------------------
+return # of node lines following a CAC element header line
+------------------------------------------------------------------------- */
 
-	if (sum != atom->natoms)
-		error->all(FLERR, "Did not assign all atoms correctly");
+int ReadData::CAC_node_lines(char *header)
+{
+  char element_type[MAXLINE];
+  int npoly, nodecount;
 
+  if (sscanf(header, "%*s %s %d", element_type, &npoly) != 2)
+    error->one(FLERR, "Incorrect element header line format in data file");
 
-	//check if atom ids are valid
-	atom->tag_check();
+  int type_found = 0;
+  for (int string_check = 1; string_check < atom->element_type_count; string_check++) {
+    if (strcmp(element_type, atom->element_names[string_check]) == 0) {
+      type_found = 1;
+      nodecount = atom->nodes_per_element_list[string_check];
+    }
+  }
+  if (strcmp(element_type, "Atom") == 0) {
+    type_found = 1;
+    nodecount = 1;
+    npoly = 1;
+  }
+  if (!type_found)
+    error->one(FLERR, "element type not yet defined, add definition in "
+               "process_args function of atom_vec_CAC.cpp style");
+  if (npoly < 1)
+    error->one(FLERR, "poly_count less than one in data file");
 
-	if (atom->map_style) {
-		atom->map_init();
-		atom->map_set();
-	}
-	
-	free (element_type);
-	free (CAC_buffer);
+  return nodecount*npoly;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -2201,6 +2280,256 @@ void ReadData::skip_lines(bigint n)
   if (eof == nullptr) error->one(FLERR,"Unexpected end of data file");
 }
 
+/* ----------------------------------------------------------------------
+   proc 0 scans a section of N records, each one line or one CAC element
+   sets shard[p] = byte offset of 1st record read by proc P in a parallel
+     read, and shard[nprocs] = byte offset of end of section
+   leaves fp at end of section, as if proc 0 had read it
+------------------------------------------------------------------------- */
+
+void ReadData::scan_section(bigint n, int elementflag)
+{
+  int nprocs = comm->nprocs;
+
+  if (me == 0) {
+    int iproc = 0;
+    bigint first = 0;
+
+    for (bigint i = 0; i <= n; i++) {
+      while (iproc <= nprocs && i == first) {
+        shard[iproc++] = ftell(fp);
+        first = shard_first(iproc,n);
+      }
+      if (i == n) break;
+
+      if (elementflag) {
+        if (fgets(line,MAXLINE,fp) == nullptr)
+          error->one(FLERR,"Unexpected end of data file");
+        int nnode = CAC_node_lines(line);
+        for (int j = 0; j < nnode; j++)
+          if (fgets(line,MAXLINE,fp) == nullptr)
+            error->one(FLERR,"Unexpected end of data file");
+      } else if (utils::fgets_trunc(line,MAXLINE,fp) == nullptr)
+        error->one(FLERR,"Unexpected end of data file");
+    }
+  }
+
+  MPI_Bcast(shard,nprocs+1,MPI_LMP_BIGINT,0,world);
+}
+
+/* ----------------------------------------------------------------------
+   index of 1st of N records read by proc Iproc in a parallel read
+------------------------------------------------------------------------- */
+
+bigint ReadData::shard_first(int iproc, bigint n)
+{
+  return iproc*n / comm->nprocs;
+}
+
+/* ----------------------------------------------------------------------
+   open data file on every proc, positioned at my 1st record
+------------------------------------------------------------------------- */
+
+FILE *ReadData::open_shard()
+{
+  FILE *sfp = fopen(datafile,"r");
+  if (sfp == nullptr)
+    error->one(FLERR,"Cannot open file {}: {}",datafile,utils::getsyserror());
+  if (fseek(sfp,shard[me],SEEK_SET))
+    error->one(FLERR,"Cannot seek in data file");
+  return sfp;
+}
+
+/* ----------------------------------------------------------------------
+   read N lines from my part of data file into buf, without broadcast
+------------------------------------------------------------------------- */
+
+void ReadData::read_shard(FILE *sfp, int n, char *buf)
+{
+  char *ptr = buf;
+  *ptr = '\0';
+
+  for (int i = 0; i < n; i++) {
+    if (utils::fgets_trunc(ptr,MAXLINE,sfp) == nullptr)
+      error->one(FLERR,"Unexpected end of data file");
+    ptr += strlen(ptr);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   parallel read of N lines of a Velocities or topology section
+   each proc reads its own block of lines and sends each line to
+     the procs owning the atoms in it, which process it as usual
+   count = per-atom topology count on 1st pass, else nullptr
+------------------------------------------------------------------------- */
+
+void ReadData::parallel_section(int section, bigint n, int *count)
+{
+  // ifirst,ilast = words of a line which hold atom IDs
+
+  int ifirst,ilast;
+  if (section == VELOCITIES) ifirst = ilast = 0;
+  else {
+    ifirst = 2;
+    if (section == BONDS) ilast = 3;
+    else if (section == ANGLES) ilast = 4;
+    else ilast = 5;
+  }
+
+  scan_section(n,0);
+  FILE *sfp = open_shard();
+
+  // every proc loops over same # of chunks, since routing is collective
+
+  bigint nmine = shard_first(me+1,n) - shard_first(me,n);
+  bigint nloop = (nmine + CHUNK-1) / CHUNK;
+  bigint nloopall;
+  MPI_Allreduce(&nloop,&nloopall,1,MPI_LMP_BIGINT,MPI_MAX,world);
+
+  Irregular *irregular = new Irregular(lmp);
+
+  bigint nread = 0;
+  for (bigint iloop = 0; iloop < nloopall; iloop++) {
+    int nchunk = MIN(nmine-nread,CHUNK);
+    if (nchunk) read_shard(sfp,nchunk,buffer);
+    nread += nchunk;
+
+    int nrecv = route_lines(irregular,nchunk,buffer,ifirst,ilast);
+    if (nrecv == 0) continue;
+
+    if (section == VELOCITIES)
+      atom->data_vels(nrecv,rbuf,id_offset);
+    else if (section == BONDS)
+      atom->data_bonds(nrecv,rbuf,count,id_offset,boffset);
+    else if (section == ANGLES)
+      atom->data_angles(nrecv,rbuf,count,id_offset,aoffset);
+    else if (section == DIHEDRALS)
+      atom->data_dihedrals(nrecv,rbuf,count,id_offset,doffset);
+    else if (section == IMPROPERS)
+      atom->data_impropers(nrecv,rbuf,count,id_offset,ioffset);
+  }
+
+  delete irregular;
+  fclose(sfp);
+}
+
+/* ----------------------------------------------------------------------
+   send each of N lines in buf to the procs owning the atom IDs in
+     words ifirst to ilast of the line, while atoms are distributed by ID
+   a line with an invalid atom ID stays on this proc to trigger the error
+   returns # of lines received, stored one after the other in rbuf
+------------------------------------------------------------------------- */
+
+int ReadData::route_lines(Irregular *irregular, int n, char *buf,
+                          int ifirst, int ilast)
+{
+  int nper = ilast - ifirst + 1;
+  if (CHUNK*nper > maxsend) {
+    maxsend = CHUNK*nper;
+    memory->destroy(sbuf);
+    memory->destroy(proclist);
+    memory->create(sbuf,(bigint) maxsend*MAXLINE,"read_data:sbuf");
+    memory->create(proclist,maxsend,"read_data:proclist");
+  }
+
+  // copy each line once per distinct owning proc into MAXLINE records
+
+  int nsend = 0;
+  char *next,*ptr;
+  tagint id;
+  int iproc,k;
+
+  for (int i = 0; i < n; i++) {
+    next = strchr(buf,'\n');
+    int nchar = next - buf + 1;
+    int first = nsend;
+
+    ptr = buf;
+    for (int iword = 0; iword <= ilast; iword++) {
+      ptr += strspn(ptr," \t\r\f");
+      if (iword >= ifirst) {
+        id = ATOTAGINT(ptr);
+        if (id > 0 && id <= maxtag) iproc = id_owner(id);
+        else iproc = me;
+        for (k = first; k < nsend; k++)
+          if (proclist[k] == iproc) break;
+        if (k == nsend) {
+          proclist[nsend] = iproc;
+          memcpy(&sbuf[(bigint) nsend*MAXLINE],buf,nchar);
+          sbuf[(bigint) nsend*MAXLINE + nchar] = '\0';
+          nsend++;
+        }
+      }
+      ptr += strcspn(ptr," \t\n\r\f");
+    }
+    buf = next + 1;
+  }
+
+  int nrecv = irregular->create_data(nsend,proclist,1);
+  if (nrecv > maxrbuf) {
+    maxrbuf = nrecv;
+    memory->destroy(rbuf);
+    memory->create(rbuf,(bigint) maxrbuf*MAXLINE,"read_data:rbuf");
+  }
+  irregular->exchange_data(sbuf,MAXLINE,rbuf);
+  irregular->destroy_data();
+
+  // compact received records into consecutive lines, as read from a file
+
+  if (nrecv) {
+    ptr = rbuf;
+    for (int i = 0; i < nrecv; i++) {
+      int nchar = strlen(&rbuf[(bigint) i*MAXLINE]);
+      memmove(ptr,&rbuf[(bigint) i*MAXLINE],nchar);
+      ptr += nchar;
+    }
+    *ptr = '\0';
+  }
+
+  return nrecv;
+}
+
+/* ----------------------------------------------------------------------
+   proc which owns atom ID while atoms are distributed by ID
+------------------------------------------------------------------------- */
+
+int ReadData::id_owner(tagint id)
+{
+  return static_cast<int> ((bigint) (id-1) * comm->nprocs / maxtag);
+}
+
+/* ----------------------------------------------------------------------
+   migrate atoms of a parallel read to procs owning contiguous blocks of
+     atom IDs, so later sections can send each line to its atoms
+   for a file sorted by ID the blocks match the lines each proc read,
+     so few atoms move
+   atoms are moved to procs by position at the end of read_data
+------------------------------------------------------------------------- */
+
+void ReadData::migrate_by_id()
+{
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  tagint maxone = 0;
+  for (int i = 0; i < nlocal; i++) maxone = MAX(maxone,tag[i]);
+  MPI_Allreduce(&maxone,&maxtag,1,MPI_LMP_TAGINT,MPI_MAX,world);
+
+  int *procassign;
+  memory->create(procassign,nlocal,"read_data:procassign");
+  for (int i = 0; i < nlocal; i++) {
+    if (maxtag > 0) procassign[i] = id_owner(tag[i]);
+    else procassign[i] = me;
+  }
+
+  Irregular *irregular = new Irregular(lmp);
+  irregular->migrate_atoms(1,1,procassign);
+  delete irregular;
+
+  memory->destroy(procassign);
+  distflag = 1;
+}
+
 /* ----------------------------------------------------------------------
    parse a line of coeffs into words, storing them in ncoeffarg,coeffarg
    trim anything from '#' onward
@@ -34,6 +34,7 @@ class ReadData : public Command {
   int me, compressed;
   char *line, *keyword, *buffer, *style;
   FILE *fp;
+  char *datafile;
   char **coeffarg;
   int ncoeffarg, maxcoeffarg;
   char argoffset1[8], argoffset2[8];
@@ -71,6 +72,18 @@ class ReadData : public Command {
   int extra_dihedral_types, extra_improper_types;
   int groupbit;
 
+  // parallel read of Atoms, Velocities, topology and CAC Elements sections
+
+  int parallelflag;    // 1 if each proc reads its own block of a section
+  int distflag;        // 1 if atoms are distributed by atom ID, not position
+  tagint maxtag;       // max atom ID, for blocks of IDs owned by each proc
+  bigint *shard;       // byte offset of 1st record read by each proc
+  char *rbuf;          // lines routed to this proc
+  int maxrbuf;
+  char *sbuf;          // fixed-size copies of lines sent to other procs
+  int *proclist;
+  int maxsend;
+
   int nfix;
   int *fix_index;
   char **fix_header;
@@ -99,6 +112,18 @@ class ReadData : public Command {
   void bonus(bigint, class AtomVec *, const char *);
   void bodies(int, class AtomVec *);
   void CAC_elements();
+  int CAC_node_lines(char *);
+
+  int read_CAC_elements(FILE *, int, char *);
+
+  void scan_section(bigint, int);
+  bigint shard_first(int, bigint);
+  FILE *open_shard();
+  void read_shard(FILE *, int, char *);
+  void parallel_section(int, bigint, int *);
+  int route_lines(class Irregular *, int, char *, int, int);
+  int id_owner(tagint);
+  void migrate_by_id();
 
   void mass();
   void paircoeffs();
@@ -185,6 +210,21 @@ E: Cannot use read_data extra with add flag
 
 Self-explanatory.
 
+E: Cannot use read_data parallel with add flag
+
+The atoms of a parallel read are distributed by atom ID while the file
+is read, which is not possible when atoms already exist.
+
+E: Cannot use read_data parallel with a compressed data file
+
+Each processor seeks to its own part of the data file, which is only
+possible for an uncompressed file.
+
+E: Cannot seek in data file
+
+A processor could not position its file handle at the start of its
+block of lines during a parallel read of the data file.
+
 W: Atom style in data file differs from currently defined atom style
 
 Self-explanatory.
@@ -35,9 +35,9 @@ using namespace LAMMPS_NS;
 
 #define CHUNK 16384
 
-// also in reader_native.cpp
+// also in reader_native.cpp and USER-CAC/reader_cac_nodal.cpp
 
-enum{ID,TYPE,X,Y,Z,VX,VY,VZ,Q,IX,IY,IZ,FX,FY,FZ};
+enum{ID,TYPE,X,Y,Z,VX,VY,VZ,Q,IX,IY,IZ,FX,FY,FZ,NODALX,NODALV};
 enum{UNSET,NOSCALE_NOWRAP,NOSCALE_WRAP,SCALE_NOWRAP,SCALE_WRAP};
 enum{NOADD,YESADD,KEEPADD};
 
@@ -903,6 +903,14 @@ void ReadDump::process_atoms()
         case FZ:
           f[m][2] = fields[i][ifield];
           break;
+        case NODALX:
+          if (fieldtype[ifield-1] != NODALX)
+            nodal_field(m,&fields[i][ifield],atom->nodal_positions,x[m]);
+          break;
+        case NODALV:
+          if (fieldtype[ifield-1] != NODALV)
+            nodal_field(m,&fields[i][ifield],atom->nodal_velocities,v[m]);
+          break;
         }
       }
 
@@ -1063,6 +1071,33 @@ void ReadDump::process_atoms()
   memory->destroy(newflag);
 }
 
+/* ----------------------------------------------------------------------
+   overwrite the nodal values of CAC element m with the ncacfield columns
+   of one snapshot element and reset the element average to their mean
+------------------------------------------------------------------------- */
+
+void ReadDump::nodal_field(int m, double *values, double ****nodal, double *average)
+{
+  int npe = atom->nodes_per_element;
+  int nodes = atom->nodes_per_element_list[atom->element_type[m]];
+  int poly = atom->poly_count[m];
+
+  average[0] = average[1] = average[2] = 0.0;
+  for (int k = 0; k < poly; k++)
+    for (int j = 0; j < nodes; j++) {
+      double *one = &values[3*(k*npe + j)];
+      nodal[m][k][j][0] = one[0];
+      nodal[m][k][j][1] = one[1];
+      nodal[m][k][j][2] = one[2];
+      average[0] += one[0];
+      average[1] += one[1];
+      average[2] += one[2];
+    }
+  average[0] /= nodes*poly;
+  average[1] /= nodes*poly;
+  average[2] /= nodes*poly;
+}
+
 /* ----------------------------------------------------------------------
    migrate old atoms to new procs based on atom IDs
    use migrate_atoms() with explicit processor assignments
@@ -1151,9 +1186,19 @@ void ReadDump::migrate_atoms_by_coords()
 int ReadDump::fields_and_keywords(int narg, char **arg)
 {
   // per-field vectors, leave space for ID and TYPE
+  // CAC nodal fields take one column per nodal value of an element
 
-  fieldtype = new int[narg+2];
-  fieldlabel = new char*[narg+2];
+  ncacfield = 0;
+  if (atom->CAC_flag) ncacfield = 3*atom->nodes_per_element*atom->maxpoly;
+  int nnodal = 0;
+  for (int i = 0; i < narg; i++) {
+    int type = whichtype(arg[i]);
+    if (type < 0) break;
+    if (type == NODALX || type == NODALV) nnodal++;
+  }
+
+  fieldtype = new int[narg+2+nnodal*ncacfield];
+  fieldlabel = new char*[narg+2+nnodal*ncacfield];
 
   // add id and type fields as needed
   // scan ahead to see if "add yes/keep" keyword/value is used
@@ -1177,7 +1222,14 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
     if (type < 0) break;
     if (type == Q && !atom->q_flag)
       error->all(FLERR,"Read dump of atom property that isn't allocated");
-    fieldtype[nfield++] = type;
+    if (type == NODALX || type == NODALV) {
+      if (!atom->CAC_flag)
+        error->all(FLERR,"Read_dump nodal fields require a CAC atom style");
+      for (int i = 0; i < nfield; i++)
+        if (fieldtype[i] == type)
+          error->all(FLERR,"Duplicate fields in read_dump command");
+      for (int i = 0; i < ncacfield; i++) fieldtype[nfield++] = type;
+    } else fieldtype[nfield++] = type;
     iarg++;
   }
 
@@ -1193,10 +1245,12 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
         error->all(FLERR,"Illegal read_dump command");
   }
 
-  for (int i = 0; i < nfield; i++)
+  for (int i = 0; i < nfield; i++) {
+    if (fieldtype[i] == NODALX || fieldtype[i] == NODALV) continue;
     for (int j = i+1; j < nfield; j++)
       if (fieldtype[i] == fieldtype[j])
         error->all(FLERR,"Duplicate fields in read_dump command");
+  }
 
   // parse optional args
 
@@ -1249,6 +1303,8 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
     } else if (strcmp(arg[iarg],"label") == 0) {
       if (iarg+3 > narg) error->all(FLERR,"Illegal read_dump command");
       int type = whichtype(arg[iarg+1]);
+      if (type == NODALX || type == NODALV)
+        error->all(FLERR,"Illegal read_dump command");
       int i;
       for (i = 0; i < nfield; i++)
         if (type == fieldtype[i]) break;
@@ -1285,6 +1341,10 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
     error->all(FLERR,"If read_dump purges it cannot replace or trim");
   if (addflag == KEEPADD && atom->tag_enable == 0)
     error->all(FLERR,"Read_dump cannot use 'add keep' without atom IDs");
+  if (addflag != NOADD && atom->CAC_flag)
+    error->all(FLERR,"Read_dump cannot add CAC elements");
+  if (nnodal && strcmp(readerstyle,"cac/nodal") != 0)
+    error->all(FLERR,"Read_dump nodal fields require format cac/nodal");
 
   return narg-iarg;
 }
@@ -1313,6 +1373,8 @@ int ReadDump::whichtype(char *str)
   else if (strcmp(str,"fx") == 0) type = FX;
   else if (strcmp(str,"fy") == 0) type = FY;
   else if (strcmp(str,"fz") == 0) type = FZ;
+  else if (strcmp(str,"nodal/positions") == 0) type = NODALX;
+  else if (strcmp(str,"nodal/velocities") == 0) type = NODALV;
   return type;
 }
 
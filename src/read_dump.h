@@ -92,6 +92,7 @@ class ReadDump : public Command {
 
   int npurge, nreplace, ntrim, nadd;    // stats on processed atoms
   int yindex, zindex;                   // field index for Y,Z coords
+  int ncacfield;                        // columns of a CAC nodal field
 
   class Reader **readers;    // class that reads a dump file
                              // nreader-length list of readers if proc reads
@@ -106,6 +107,7 @@ class ReadDump : public Command {
   void setup_multiproc();
   int whichtype(char *);
 
+  void nodal_field(int, double *, double ****, double *);
   double xfield(int, int);
   double yfield(int, int);
   double zfield(int, int);
@@ -172,6 +174,19 @@ E: Duplicate fields in read_dump command
 
 Self-explanatory.
 
+E: Read_dump nodal fields require a CAC atom style
+
+The nodal/positions and nodal/velocities fields set the nodal arrays of
+CAC elements.
+
+E: Read_dump cannot add CAC elements
+
+Elements cannot be created from dump file fields.  Use add no.
+
+E: Read_dump nodal fields require format cac/nodal
+
+Only the cac/nodal reader provides per node data.
+
 E: If read_dump purges it cannot replace or trim
 
 These operations are not compatible.  See the read_dump doc
@@ -38,6 +38,13 @@
 #include <cstring>
 #include <dirent.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "lmprestart.h"
 
 using namespace LAMMPS_NS;
@@ -93,6 +100,11 @@ void ReadRestart::command(int narg, char **arg)
     error->all(FLERR,
                "Read restart MPI-IO input not allowed with % in filename");
 
+  // sharded layout is detected from the file itself in file_layout()
+
+  shardflag = 0;
+  shard_offset = shard_size = nullptr;
+
   if (mpiioflag) {
     mpiio = new RestartMPIIO(lmp);
     if (!mpiio->mpiio_exists)
@@ -200,6 +212,42 @@ void ReadRestart::command(int narg, char **arg)
     while (m < assignedChunkSize) m += avec->unpack_restart(&buf[m]);
   }
 
+  // input of sharded single native file
+  // index in file layout gives offset and size of each per-proc section
+  // procs = chunks: each proc maps its own section and keeps all its atoms
+  // procs < chunks: each proc reads a subset of sections, striding by nprocs
+  // procs > chunks: cluster procs by section, each proc in a cluster
+  //   keeps every Nth atom of the cluster's section
+  // atoms are migrated to correct procs below, same as multiproc files
+
+  else if (shardflag) {
+    check_eof_magic();
+    if (me == 0) {
+      fclose(fp);
+      fp = nullptr;
+    }
+
+    if (nprocs <= nprocs_file) {
+      for (int iproc = me; iproc < nprocs_file; iproc += nprocs)
+        read_shard(file,iproc,0,1);
+    } else {
+      int nfile = nprocs_file;
+      int icluster = static_cast<int> ((bigint) me * nfile/nprocs);
+      int fileproc = static_cast<int> ((bigint) icluster * nprocs/nfile);
+      int fcluster = static_cast<int> ((bigint) fileproc * nfile/nprocs);
+      if (fcluster < icluster) fileproc++;
+      int fileprocnext =
+        static_cast<int> ((bigint) (icluster+1) * nprocs/nfile);
+      fcluster = static_cast<int> ((bigint) fileprocnext * nfile/nprocs);
+      if (fcluster < icluster+1) fileprocnext++;
+      int nclusterprocs = fileprocnext - fileproc;
+      read_shard(file,icluster,me-fileproc,nclusterprocs);
+    }
+
+    memory->destroy(shard_offset);
+    memory->destroy(shard_size);
+  }
+
   // input of single native file
   // nprocs_file = # of chunks in file
   // proc 0 reads a chunk and bcasts it to other procs
@@ -404,10 +452,10 @@ void ReadRestart::command(int narg, char **arg)
   delete [] file;
   memory->destroy(buf);
 
-  // for multiproc or MPI-IO files:
+  // for multiproc, MPI-IO, or sharded files:
   // perform irregular comm to migrate atoms to correct procs
 
-  if (multiproc || mpiioflag) {
+  if (multiproc || mpiioflag || shardflag) {
 
     // if remapflag set, remap all atoms I read back to box before migrating
 
@@ -1119,6 +1167,24 @@ void ReadRestart::file_layout()
         memory->destroy(nproc_chunk_sizes);
         memory->destroy(nproc_chunk_offsets);
       }
+
+    } else if (flag == SHARD) {
+      if (multiproc)
+        error->all(FLERR,"Sharded restart file cannot be read "
+                   "with % in filename");
+      if (read_int() != nprocs_file)
+        error->all(FLERR,"Invalid section index in sharded restart file");
+      shardflag = 1;
+      memory->create(shard_offset,nprocs_file,"read_restart:shard_offset");
+      memory->create(shard_size,nprocs_file,"read_restart:shard_size");
+      if (me == 0) {
+        utils::sfread(FLERR,shard_offset,sizeof(bigint),nprocs_file,
+                      fp,nullptr,error);
+        utils::sfread(FLERR,shard_size,sizeof(bigint),nprocs_file,
+                      fp,nullptr,error);
+      }
+      MPI_Bcast(shard_offset,nprocs_file,MPI_LMP_BIGINT,0,world);
+      MPI_Bcast(shard_size,nprocs_file,MPI_LMP_BIGINT,0,world);
     }
 
     flag = read_int();
@@ -1133,6 +1199,76 @@ void ReadRestart::file_layout()
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack atoms from one per-proc section of a sharded restart file
+   section is memory-mapped, so atoms are unpacked straight from page cache
+   keep every nparts-th atom, starting with atom ipart
+------------------------------------------------------------------------- */
+
+void ReadRestart::read_shard(const char *file, int ichunk, int ipart, int nparts)
+{
+  bigint n = shard_size[ichunk];
+  if (n == 0) return;
+
+  bigint offset = shard_offset[ichunk];
+  bigint nbytes = n*sizeof(double);
+  double *buf;
+
+#if defined(_WIN32)
+
+  FILE *fpshard = fopen(file,"rb");
+  if (fpshard == nullptr)
+    error->one(FLERR,"Cannot open restart file {}: {}",
+               file, utils::getsyserror());
+  memory->create(buf,n,"read_restart:buf");
+  fseek(fpshard,offset,SEEK_SET);
+  utils::sfread(FLERR,buf,sizeof(double),n,fpshard,nullptr,error);
+  fclose(fpshard);
+
+#else
+
+  int fd = open(file,O_RDONLY);
+  if (fd < 0)
+    error->one(FLERR,"Cannot open restart file {}: {}",
+               file, utils::getsyserror());
+  struct stat st;
+  if (fstat(fd,&st) == 0 && offset + nbytes > (bigint) st.st_size)
+    error->one(FLERR,"Restart file section extends beyond end of file");
+
+  // mmap() requires a page-aligned file offset
+  // private mapping, so unpack_restart() may modify buf without touching file
+
+  bigint pagesize = sysconf(_SC_PAGESIZE);
+  bigint start = offset - offset % pagesize;
+  size_t length = offset - start + nbytes;
+  void *ptr = mmap(nullptr,length,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,start);
+  close(fd);
+  if (ptr == MAP_FAILED)
+    error->one(FLERR,"Cannot map restart file section: {}",
+               utils::getsyserror());
+  madvise(ptr,length,MADV_SEQUENTIAL);
+  buf = (double *) ((char *) ptr + (offset - start));
+
+#endif
+
+  AtomVec *avec = atom->avec;
+  bigint m = 0;
+  int size;
+  for (int i = 0; m < n; i++) {
+    size = static_cast<int> (buf[m]);
+    if (size <= 0)
+      error->one(FLERR,"Invalid per-atom record in restart file");
+    if (i % nparts == ipart) avec->unpack_restart(&buf[m]);
+    m += size;
+  }
+
+#if defined(_WIN32)
+  memory->destroy(buf);
+#else
+  munmap(ptr,length);
+#endif
+}
+
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 // low-level fread methods
@@ -46,6 +46,12 @@ class ReadRestart : public Command {
   bigint assignedChunkSize;
   MPI_Offset assignedChunkOffset, headerOffset;
 
+  // sharded single-file values
+
+  int shardflag;           // 1 if file has an index of per-proc sections
+  bigint *shard_offset;    // byte offset of each section in file
+  bigint *shard_size;      // # of doubles in each section
+
   void file_search(char *, char *);
   void header();
   void type_arrays();
@@ -56,6 +62,7 @@ class ReadRestart : public Command {
   void format_revision();
   void check_eof_magic();
   void file_layout();
+  void read_shard(const char *, int, int, int);
 
   int read_int();
   bigint read_bigint();
@@ -207,6 +214,36 @@ E: Restart file is not a MPI-IO file
 
 The file is inconsistent with the filename you specified for it.
 
+E: Sharded restart file cannot be read with % in filename
+
+A sharded restart file is a single file, written with the
+write_restart or restart shard keyword.
+
+E: Invalid section index in sharded restart file
+
+The number of per-processor sections does not match the number of
+processors that wrote the file.  The file is likely corrupted.
+
+E: Restart file section extends beyond end of file
+
+A per-processor section in the index of a sharded restart file is
+larger than the file.  The file is likely truncated.
+
+E: Cannot map restart file section: %s
+
+The operating system refused to memory-map a per-processor section
+of a sharded restart file.
+
+E: Invalid per-atom record in restart file
+
+A per-atom record in a sharded restart file has a non-positive
+length.  The file is likely incomplete or corrupted.
+
+E: Incomplete or corrupted LAMMPS restart file
+
+The magic string at the end of the restart file is missing, which
+indicates the file was not completely written.
+
 E: Invalid LAMMPS restart file
 
 The file does not appear to be a LAMMPS restart file since
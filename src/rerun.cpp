@@ -186,6 +186,7 @@ void Rerun::command(int narg, char **arg)
 
   timer->barrier_stop();
 
+  output->sync_dumps();
   update->integrate->cleanup();
 
   // set update->nsteps to ndump for Finish stats to print
@@ -180,6 +180,7 @@ void Run::command(int narg, char **arg)
     update->integrate->run(nsteps);
     timer->barrier_stop();
 
+    output->sync_dumps();
     update->integrate->cleanup();
 
     Finish finish(lmp);
@@ -221,6 +222,7 @@ void Run::command(int narg, char **arg)
       update->integrate->run(nsteps);
       timer->barrier_stop();
 
+      output->sync_dumps();
       update->integrate->cleanup();
 
       Finish finish(lmp);
@@ -263,6 +263,10 @@ void Verlet::run(int n)
       timer->stamp();
       comm->forward_comm();
       timer->stamp(Timer::COMM);
+      if (neighbor->partial_pending) {
+        neighbor->build_partial();
+        timer->stamp(Timer::NEIGH);
+      }
     } else {
       if (n_pre_exchange) {
         timer->stamp();
@@ -41,6 +41,10 @@
 
 using namespace LAMMPS_NS;
 
+// alignment of per-proc sections in a sharded restart file
+
+static constexpr bigint SHARD_ALIGN = 4096;
+
 /* ---------------------------------------------------------------------- */
 
 WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
@@ -49,6 +53,7 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   MPI_Comm_size(world,&nprocs);
   multiproc = 0;
   noinit = 0;
+  shardflag = 0;
   fp = nullptr;
 }
 
@@ -193,6 +198,19 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
       else filewriter = 0;
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"shard") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      if (strcmp(arg[iarg+1],"yes") == 0) shardflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) shardflag = 0;
+      else error->all(FLERR,"Illegal write_restart command");
+      if (shardflag && multiproc)
+        error->all(FLERR,"Cannot use write_restart shard "
+                   "with % in restart file name");
+      if (shardflag && mpiioflag)
+        error->all(FLERR,"Cannot use write_restart shard "
+                   "with MPI-IO restart file");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
@@ -368,6 +386,43 @@ void WriteRestart::write(std::string file)
     mpiio->openForWrite(file.c_str());
     mpiio->write(headerOffset,send_size,buf);
     mpiio->close();
+
+  // sharded output to single native file
+  // proc 0 has written the header and an index of per-proc sections
+  // each proc writes its own section at its offset, no funnel thru proc 0
+  // proc 0 appends magic string only after all sections are written,
+  //   so an interrupted write is detected as an incomplete file
+
+  } else if (shardflag) {
+    if (me && send_size) {
+      fp = fopen(file.c_str(),"r+b");
+      if (fp == nullptr)
+        error->one(FLERR, "Cannot open restart file {}: {}",
+                                      file, utils::getsyserror());
+    }
+
+    if (fp) {
+      fseek(fp,shardOffset,SEEK_SET);
+      if ((int) fwrite(buf,sizeof(double),send_size,fp) != send_size)
+        io_error = 1;
+    }
+
+    if (me && fp) {
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+
+    MPI_Barrier(world);
+
+    if (me == 0) {
+      fseek(fp,shardEnd,SEEK_SET);
+      magic_string();
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+
   } else {
 
     // output of one or more native files
@@ -584,6 +639,37 @@ void WriteRestart::file_layout(int send_size)
     memory->destroy(all_send_sizes);
   }
 
+  // sharded file: index of byte offset and length of each proc's section
+  // sections start after the end of the layout info,
+  //   each aligned to SHARD_ALIGN bytes so a reader can map it directly
+  // proc 0 writes index, each proc is told where its section starts
+
+  if (shardflag) {
+    bigint *offsets,*sizes;
+    memory->create(offsets,nprocs,"write_restart:offsets");
+    memory->create(sizes,nprocs,"write_restart:sizes");
+    bigint bsize = send_size;
+    MPI_Gather(&bsize,1,MPI_LMP_BIGINT,sizes,1,MPI_LMP_BIGINT,0,world);
+
+    if (me == 0) {
+      bigint offset = ftell(fp) + 3*sizeof(int) + 2*nprocs*sizeof(bigint);
+      for (int iproc = 0; iproc < nprocs; iproc++) {
+        offset = (offset + SHARD_ALIGN - 1) / SHARD_ALIGN * SHARD_ALIGN;
+        offsets[iproc] = offset;
+        offset += sizes[iproc]*sizeof(double);
+      }
+      shardEnd = offset;
+
+      write_int(SHARD,nprocs);
+      fwrite(offsets,sizeof(bigint),nprocs,fp);
+      fwrite(sizes,sizeof(bigint),nprocs,fp);
+    }
+
+    MPI_Scatter(offsets,1,MPI_LMP_BIGINT,&shardOffset,1,MPI_LMP_BIGINT,0,world);
+    memory->destroy(offsets);
+    memory->destroy(sizes);
+  }
+
   // -1 flag signals end of file layout info
 
   if (me == 0) {
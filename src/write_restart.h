@@ -50,6 +50,12 @@ class WriteRestart : public Command {
   class RestartMPIIO *mpiio;    // MPIIO for restart file output
   MPI_Offset headerOffset;
 
+  // sharded single-file values
+
+  int shardflag;         // 1 if each proc writes its own indexed section
+  bigint shardOffset;    // byte offset of my section in file
+  bigint shardEnd;       // byte offset of end of last section (proc 0)
+
   void header();
   void type_arrays();
   void force_fields();
@@ -102,6 +108,16 @@ E: Cannot use write_restart nfile without % in restart file name
 
 Self-explanatory.
 
+E: Cannot use write_restart shard with % in restart file name
+
+A sharded restart file is a single file with one section per
+processor, so it cannot also be split into multiple files.
+
+E: Cannot use write_restart shard with MPI-IO restart file
+
+The MPI-IO and sharded layouts of a single restart file are
+alternatives to each other.
+
 E: Atom count is inconsistent, cannot write restart file
 
 Sum of atoms across processors does not equal initial total count.
@@ -111,4 +127,9 @@ E: Cannot open restart file %s
 
 Self-explanatory.
 
+E: I/O error while writing restart
+
+A processor failed to write its part of the restart file, e.g.
+because the file system is full.
+
 */
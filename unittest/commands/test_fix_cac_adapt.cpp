@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "atom.h"
+#include "fix.h"
+#include "fmt/format.h"
+#include "force.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../testing/core.h"
+
+#include <cmath>
+#include <cstdio>
+#include <mpi.h>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using LAMMPS_NS::utils::split_words;
+
+namespace LAMMPS_NS {
+
+static const char data_file[] = "test_fix_cac_adapt.data";
+
+// one 4x4x4 cell fcc element with a distorted corner, topped by
+// two layers of lattice cells of atoms
+
+static void create_data_file(const char *filename)
+{
+    const double a = 3.615;
+    const int sc = 4, nlayers = 2;
+    const double basis[4][3] = {{0, 0, 0}, {0.5, 0.5, 0}, {0.5, 0, 0.5}, {0, 0.5, 0.5}};
+    const int corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                               {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    std::string elements = fmt::format("1 Eight_Node 4 {} {} {}\n", sc, sc, sc);
+    for (int p = 0; p < 4; p++)
+        for (int n = 0; n < 8; n++) {
+            double x = (basis[p][0] + corners[n][0] * sc) * a;
+            double y = (basis[p][1] + corners[n][1] * sc) * a;
+            double z = (basis[p][2] + corners[n][2] * sc) * a;
+            if (n == 6) {
+                x += 0.15 * a;
+                z += 0.1 * a;
+            }
+            elements += fmt::format("{} {} 1 {:.6f} {:.6f} {:.6f}\n", n + 1, p + 1, x, y, z);
+        }
+
+    int id     = 1;
+    double ztop = sc * a;
+    for (int ix = 0; ix < sc; ix++)
+        for (int iy = 0; iy < sc; iy++)
+            for (int iz = 0; iz < nlayers; iz++)
+                for (int b = 0; b < 4; b++) {
+                    elements += fmt::format("{} Atom 1 1 1 1\n1 1 1 {:.6f} {:.6f} {:.6f}\n", ++id,
+                                            (ix + basis[b][0] + 0.5) * a,
+                                            (iy + basis[b][1] + 0.5) * a,
+                                            ztop + (iz + basis[b][2] + 0.5) * a);
+                }
+
+    FILE *fp = fopen(filename, "w");
+    if (!fp) return;
+    fmt::print(fp, "fix cac/adapt test\n\n{} cac elements\n1 atom types\n\n", id);
+    fmt::print(fp, "-5 {} xlo xhi\n-5 {} ylo yhi\n-5 {} zlo zhi\n\n", sc * a + 5, sc * a + 5,
+               ztop + nlayers * a + 5);
+    fmt::print(fp, "Masses\n\n1 63.546\n\n CAC Elements\n\n{}", elements);
+    fclose(fp);
+}
+
+// lattice sites, momentum and kinetic energy of all atoms and elements
+// with lumped nodal masses, the measure fix cac/adapt conserves
+
+struct SiteSums {
+    bigint nsites;
+    double p[3];
+    double pabs; // sum of |m v| components, the scale of p
+    double ke;
+};
+
+class FixCACAdaptTest : public LAMMPSTest {
+protected:
+    static void SetUpTestSuite() { create_data_file(data_file); }
+
+    static void TearDownTestSuite() { remove(data_file); }
+
+    void SetUp() override
+    {
+        testbinary = "FixCACAdaptTest";
+        LAMMPSTest::SetUp();
+        if (!info->has_style("atom", "cac")) GTEST_SKIP();
+        BEGIN_HIDE_OUTPUT();
+        command("units metal");
+        command("dimension 3");
+        command("boundary s s s");
+        command("atom_style cac 8 4");
+        command("atom_modify map array");
+        command("comm_style cac");
+        command("newton off");
+        command(fmt::format("read_data {}", data_file));
+        command("lattice fcc 3.615 origin 0.5 0.5 0.5");
+        command("pair_style cac/lj 5.5");
+        command("pair_coeff 1 1 0.4093 2.338");
+        command("timestep 0.002");
+        END_HIDE_OUTPUT();
+    }
+
+    SiteSums site_sums()
+    {
+        Atom *atom = lmp->atom;
+        SiteSums local = {0, {0.0, 0.0, 0.0}, 0.0, 0.0};
+        for (int i = 0; i < atom->nlocal; i++) {
+            int npe      = atom->nodes_per_element_list[atom->element_type[i]];
+            int *scale   = atom->element_scale[i];
+            bigint sites = (bigint)scale[0] * scale[1] * scale[2];
+            local.nsites += sites * atom->poly_count[i];
+            for (int ipoly = 0; ipoly < atom->poly_count[i]; ipoly++)
+                for (int k = 0; k < npe; k++) {
+                    double *v = atom->nodal_velocities[i][ipoly][k];
+                    double w  = atom->mass[atom->node_types[i][ipoly]] * sites / npe;
+                    for (int d = 0; d < 3; d++) {
+                        local.p[d] += w * v[d];
+                        local.pabs += w * fabs(v[d]);
+                    }
+                    local.ke += w * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                }
+        }
+        SiteSums all;
+        MPI_Allreduce(&local.nsites, &all.nsites, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(local.p, all.p, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(&local.pabs, &all.pabs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(&local.ke, &all.ke, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        all.ke *= 0.5 * lmp->force->mvv2e;
+        return all;
+    }
+
+    void expect_conserved(const SiteSums &before, const SiteSums &after)
+    {
+        ASSERT_EQ(before.nsites, after.nsites);
+        for (int d = 0; d < 3; d++) EXPECT_NEAR(before.p[d], after.p[d], 1.0e-10 * before.pabs);
+        EXPECT_NEAR(before.ke, after.ke, 1.0e-10 * before.ke);
+    }
+
+    double fix_vector(int n)
+    {
+        int ifix = lmp->modify->find_fix("AD");
+        return lmp->modify->fix[ifix]->compute_vector(n);
+    }
+};
+
+TEST_F(FixCACAdaptTest, Split)
+{
+    // strain the element with a short hot run, then adapt without
+    // time integration so any change comes from the conversions
+
+    BEGIN_HIDE_OUTPUT();
+    command("velocity/cac all create 600 12345 loop geom");
+    command("fix NVE all cac/nve");
+    command("run 30");
+    command("unfix NVE");
+    command("fix AD all cac/adapt 1 split strain 0.01 energy no");
+    END_HIDE_OUTPUT();
+
+    SiteSums before = site_sums();
+    ASSERT_EQ(lmp->atom->natoms, 129);
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 1");
+    END_HIDE_OUTPUT();
+
+    ASSERT_EQ(fix_vector(0), 1.0);
+    ASSERT_EQ(lmp->atom->natoms, 384);
+    expect_conserved(before, site_sums());
+}
+
+TEST_F(FixCACAdaptTest, Merge)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("velocity/cac all create 300 12345 loop geom");
+    command("fix AD all cac/adapt 1 merge 2 0.01 energy no");
+    END_HIDE_OUTPUT();
+
+    SiteSums before = site_sums();
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 1");
+    END_HIDE_OUTPUT();
+
+    ASSERT_EQ(fix_vector(1), 4.0);
+    ASSERT_EQ(lmp->atom->natoms, 5);
+    expect_conserved(before, site_sums());
+}
+
+TEST_F(FixCACAdaptTest, EnergyRestored)
+{
+    // the energy keyword rescales velocities about the center of mass,
+    // which must leave the momentum unchanged
+
+    BEGIN_HIDE_OUTPUT();
+    command("velocity/cac all create 300 12345 loop geom");
+    command("fix AD all cac/adapt 1 merge 2 0.01");
+    END_HIDE_OUTPUT();
+
+    SiteSums before = site_sums();
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 1");
+    END_HIDE_OUTPUT();
+
+    SiteSums after = site_sums();
+    ASSERT_EQ(fix_vector(1), 4.0);
+    ASSERT_EQ(before.nsites, after.nsites);
+    for (int d = 0; d < 3; d++) EXPECT_NEAR(before.p[d], after.p[d], 1.0e-10 * before.pabs);
+}
+
+TEST_F(FixCACAdaptTest, NoThermoPE)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("uncompute thermo_pe");
+    command("thermo_style custom step atoms");
+    command("fix AD all cac/adapt 1 merge 2 0.01");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Fix cac/adapt requires the thermo_pe compute.*", command("run 0"););
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (Info::get_mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,184 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "atom.h"
+#include "fmt/format.h"
+#include "info.h"
+#include "lammps.h"
+#include "my_page.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../testing/core.h"
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mpi.h>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using LAMMPS_NS::utils::split_words;
+
+namespace LAMMPS_NS {
+
+// potential energy and per-atom forces by atom ID after a run
+
+struct RunResult {
+    double pe;
+    std::map<tagint, std::vector<double>> f;
+    bigint ncalls, npartial;
+    double pages;
+};
+
+class NeighborPartialTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "NeighborPartialTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // hot LJ liquid, so atoms pass the trigger distance between full builds
+
+    RunResult run(const std::string &partial, const std::string &newton, int nsteps)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("units lj");
+        command("atom_style atomic");
+        command("atom_modify map array");
+        command(fmt::format("newton {}", newton));
+        command("lattice fcc 0.8442");
+        command("region box block 0 5 0 5 0 5");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("set type 1 type/fraction 2 0.3 4321");
+        command("mass * 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("pair_coeff 1 2 1.0 1.1 2.5");
+        command("pair_coeff 2 2 1.0 1.2 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify page 10000 one 500");
+        command(fmt::format("neigh_modify every 1 delay 0 check yes partial {}", partial));
+        command("fix 1 all nve");
+        command("variable pe equal pe");
+        command(fmt::format("run {} post no", nsteps));
+        END_HIDE_OUTPUT();
+        return current();
+    }
+
+    RunResult current()
+    {
+        RunResult result;
+        result.pe  = get_variable_value("pe");
+        Atom *atom = lmp->atom;
+        for (int i = 0; i < atom->nlocal; i++)
+            result.f[atom->tag[i]] = {atom->f[i][0], atom->f[i][1], atom->f[i][2]};
+        result.ncalls   = lmp->neighbor->ncalls;
+        result.npartial = lmp->neighbor->npartial;
+        result.pages    = lmp->neighbor->lists[0]->ipage->size();
+        return result;
+    }
+
+    void expect_same(const RunResult &ref, const RunResult &partial, double epsilon)
+    {
+        EXPECT_NEAR(ref.pe, partial.pe, epsilon * fabs(ref.pe));
+        ASSERT_EQ(ref.f.size(), partial.f.size());
+        for (auto &one : ref.f) {
+            auto &other = partial.f.at(one.first);
+            for (int d = 0; d < 3; d++) EXPECT_NEAR(one.second[d], other[d], epsilon);
+        }
+    }
+};
+
+TEST_F(NeighborPartialTest, HalfBinNewtoff)
+{
+    auto ref     = run("no", "off", 200);
+    auto partial = run("yes", "off", 200);
+
+    // partial builds must have replaced some of the full builds
+    // without using up more pages each time
+
+    ASSERT_EQ(ref.npartial, 0);
+    ASSERT_GT(partial.npartial, 0);
+    ASSERT_LT(partial.ncalls, ref.ncalls);
+    ASSERT_LE(partial.pages, 2 * ref.pages);
+
+    // same trajectory up to round-off from the order of pairs in the lists
+
+    expect_same(ref, partial, 1.0e-8);
+
+    // a full build from the same coordinates finds the same pairs
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    expect_same(current(), partial, 1.0e-12);
+}
+
+TEST_F(NeighborPartialTest, NewtonOn)
+{
+    // newton on half lists cannot re-list a subset of atoms
+
+    BEGIN_HIDE_OUTPUT();
+    command("units lj");
+    command("atom_style atomic");
+    command("newton on");
+    command("lattice fcc 0.8442");
+    command("region box block 0 2 0 2 0 2");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff 1 1 1.0 1.0 2.5");
+    command("neigh_modify delay 0 partial yes");
+    command("fix 1 all nve");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Neighbor partial is not supported by neighbor list build.*",
+                 command("run 0 post no"););
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (Info::get_mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,264 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "atom.h"
+#include "fmt/format.h"
+#include "info.h"
+#include "lammps.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../testing/core.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using LAMMPS_NS::utils::split_words;
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+static const char cac_data_file[] = "test_read_data_parallel.data";
+
+// two 4x4x4 cell fcc elements side by side topped by a layer of atoms
+
+static void create_cac_data_file(const char *filename)
+{
+    const double a = 3.615;
+    const int sc = 4, nelements = 2;
+    const double basis[4][3] = {{0, 0, 0}, {0.5, 0.5, 0}, {0.5, 0, 0.5}, {0, 0.5, 0.5}};
+    const int corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                               {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    std::string elements;
+    int id = 0;
+    for (int e = 0; e < nelements; e++) {
+        elements += fmt::format("{} Eight_Node 4 {} {} {}\n", ++id, sc, sc, sc);
+        for (int p = 0; p < 4; p++)
+            for (int n = 0; n < 8; n++)
+                elements += fmt::format("{} {} 1 {:.6f} {:.6f} {:.6f}\n", n + 1, p + 1,
+                                        (basis[p][0] + (corners[n][0] + e) * sc) * a,
+                                        (basis[p][1] + corners[n][1] * sc) * a,
+                                        (basis[p][2] + corners[n][2] * sc) * a);
+    }
+
+    double ztop = sc * a;
+    for (int ix = 0; ix < nelements * sc; ix++)
+        for (int iy = 0; iy < sc; iy++)
+            for (int b = 0; b < 4; b++) {
+                elements += fmt::format("{} Atom 1 1 1 1\n1 1 1 {:.6f} {:.6f} {:.6f}\n", ++id,
+                                        (ix + basis[b][0] + 0.5) * a,
+                                        (iy + basis[b][1] + 0.5) * a,
+                                        ztop + (basis[b][2] + 0.5) * a);
+            }
+
+    FILE *fp = fopen(filename, "w");
+    if (!fp) return;
+    fmt::print(fp, "read_data parallel test\n\n{} cac elements\n1 atom types\n\n", id);
+    fmt::print(fp, "-5 {} xlo xhi\n-5 {} ylo yhi\n-5 {} zlo zhi\n\n", nelements * sc * a + 5,
+               sc * a + 5, ztop + a + 5);
+    fmt::print(fp, "Masses\n\n1 63.546\n\n CAC Elements\n\n{}", elements);
+    fclose(fp);
+}
+
+namespace LAMMPS_NS {
+
+// all per-atom data read from a data file, by atom ID
+
+typedef std::map<tagint, std::vector<double>> AtomState;
+
+class ReadDataParallelTest : public LAMMPSTest {
+protected:
+    static void SetUpTestSuite() { create_cac_data_file(cac_data_file); }
+
+    static void TearDownTestSuite() { remove(cac_data_file); }
+
+    void SetUp() override
+    {
+        testbinary = "ReadDataParallelTest";
+        LAMMPSTest::SetUp();
+    }
+
+    void read_molecular(const std::string &parallel)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("atom_style full");
+        command("atom_modify map array");
+        command("units real");
+        command("newton on on");
+        command("pair_style zero 8.0");
+        command("bond_style zero");
+        command("angle_style zero");
+        command("dihedral_style zero");
+        command("improper_style zero");
+        command(fmt::format("read_data {}/data.fourmol parallel {}",
+                            STRINGIFY(TEST_INPUT_FOLDER), parallel));
+        END_HIDE_OUTPUT();
+    }
+
+    void read_cac(const std::string &parallel)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("units metal");
+        command("boundary s s s");
+        command("atom_style cac 8 4");
+        command("atom_modify map array");
+        command("comm_style cac");
+        command("newton off");
+        command(fmt::format("read_data {} parallel {}", cac_data_file, parallel));
+        END_HIDE_OUTPUT();
+    }
+
+    AtomState molecular_state()
+    {
+        Atom *atom = lmp->atom;
+        AtomState state;
+        for (int i = 0; i < atom->nlocal; i++) {
+            std::vector<double> &one = state[atom->tag[i]];
+            one = {(double)atom->type[i], (double)atom->molecule[i], atom->q[i],
+                   (double)atom->image[i]};
+            for (int d = 0; d < 3; d++) one.push_back(atom->x[i][d]);
+            for (int d = 0; d < 3; d++) one.push_back(atom->v[i][d]);
+            one.push_back(atom->num_bond[i]);
+            for (int m = 0; m < atom->num_bond[i]; m++) {
+                one.push_back(atom->bond_type[i][m]);
+                one.push_back(atom->bond_atom[i][m]);
+            }
+            one.push_back(atom->num_angle[i]);
+            for (int m = 0; m < atom->num_angle[i]; m++)
+                one.insert(one.end(), {(double)atom->angle_type[i][m],
+                                       (double)atom->angle_atom1[i][m],
+                                       (double)atom->angle_atom2[i][m],
+                                       (double)atom->angle_atom3[i][m]});
+            one.push_back(atom->num_dihedral[i]);
+            for (int m = 0; m < atom->num_dihedral[i]; m++)
+                one.insert(one.end(), {(double)atom->dihedral_type[i][m],
+                                       (double)atom->dihedral_atom1[i][m],
+                                       (double)atom->dihedral_atom2[i][m],
+                                       (double)atom->dihedral_atom3[i][m],
+                                       (double)atom->dihedral_atom4[i][m]});
+            one.push_back(atom->num_improper[i]);
+            for (int m = 0; m < atom->num_improper[i]; m++)
+                one.insert(one.end(), {(double)atom->improper_type[i][m],
+                                       (double)atom->improper_atom1[i][m],
+                                       (double)atom->improper_atom2[i][m],
+                                       (double)atom->improper_atom3[i][m],
+                                       (double)atom->improper_atom4[i][m]});
+        }
+        return state;
+    }
+
+    AtomState element_state()
+    {
+        Atom *atom = lmp->atom;
+        AtomState state;
+        for (int i = 0; i < atom->nlocal; i++) {
+            int npe = atom->nodes_per_element_list[atom->element_type[i]];
+            std::vector<double> &one = state[atom->tag[i]];
+            one = {(double)atom->type[i], (double)atom->element_type[i],
+                   (double)atom->poly_count[i]};
+            for (int d = 0; d < 3; d++) one.push_back(atom->element_scale[i][d]);
+            for (int d = 0; d < 3; d++) one.push_back(atom->x[i][d]);
+            for (int ipoly = 0; ipoly < atom->poly_count[i]; ipoly++) {
+                one.push_back(atom->node_types[i][ipoly]);
+                for (int k = 0; k < npe; k++)
+                    for (int d = 0; d < 3; d++)
+                        one.push_back(atom->nodal_positions[i][ipoly][k][d]);
+            }
+        }
+        return state;
+    }
+};
+
+TEST_F(ReadDataParallelTest, Molecular)
+{
+    if (!info->has_style("atom", "full")) GTEST_SKIP();
+
+    read_molecular("no");
+    auto serial = molecular_state();
+    bigint nbonds = lmp->atom->nbonds, nangles = lmp->atom->nangles;
+    bigint ndihedrals = lmp->atom->ndihedrals, nimpropers = lmp->atom->nimpropers;
+
+    read_molecular("yes");
+    ASSERT_EQ(lmp->atom->natoms, 29);
+    ASSERT_EQ(lmp->atom->nbonds, nbonds);
+    ASSERT_EQ(lmp->atom->nangles, nangles);
+    ASSERT_EQ(lmp->atom->ndihedrals, ndihedrals);
+    ASSERT_EQ(lmp->atom->nimpropers, nimpropers);
+    ASSERT_EQ(molecular_state(), serial);
+}
+
+TEST_F(ReadDataParallelTest, CACElements)
+{
+    if (!info->has_style("atom", "cac")) GTEST_SKIP();
+
+    read_cac("no");
+    auto serial = element_state();
+    ASSERT_EQ(lmp->atom->natoms, 130);
+
+    read_cac("yes");
+    ASSERT_EQ(lmp->atom->natoms, 130);
+    ASSERT_EQ(element_state(), serial);
+}
+
+TEST_F(ReadDataParallelTest, Errors)
+{
+    TEST_FAILURE(".*ERROR: Illegal read_data command.*",
+                 command("read_data test.data parallel maybe"););
+    TEST_FAILURE(".*ERROR: Cannot use read_data parallel with a compressed data file.*",
+                 command("read_data test.data.gz parallel yes"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style atomic");
+    command("region box block 0 1 0 1 0 1");
+    command("create_box 1 box");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Cannot use read_data parallel with add flag.*",
+                 command("read_data test.data add append parallel yes"););
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (Info::get_mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
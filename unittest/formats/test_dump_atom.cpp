@@ -15,6 +15,7 @@
 #include "../testing/systems/melt.h"
 #include "../testing/utils.h"
 #include "fmt/format.h"
+#include "info.h"
 #include "output.h"
 #include "thermo.h"
 #include "utils.h"
@@ -542,6 +543,59 @@ TEST_F(DumpAtomTest, per_processor_multi_file_run1)
     delete_file("dump_run1_p0_1.melt");
 }
 
+TEST_F(DumpAtomTest, async_run1plus1)
+{
+    if (!Info::has_async_dump_support()) GTEST_SKIP();
+
+    auto reference = "dump_sync_run1plus1.melt";
+    auto dump_file = "dump_async_run1plus1.melt";
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all atom 1 {}", reference));
+    command(fmt::format("dump id1 all atom 1 {}", dump_file));
+    command("dump_modify id1 async yes");
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 82);
+    continue_dump(1);
+    ASSERT_EQ(count_lines(dump_file), 123);
+    ASSERT_FILE_EQUAL(reference, dump_file);
+    delete_file(reference);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, async_multi_file_run1)
+{
+    if (!Info::has_async_dump_support()) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command("dump id0 all atom 1 dump_sync_run1_*.melt");
+    command("dump id1 all atom 1 dump_async_run1_*.melt");
+    command("dump_modify id1 async yes");
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS("dump_async_run1_0.melt");
+    ASSERT_FILE_EXISTS("dump_async_run1_1.melt");
+    ASSERT_FILE_EQUAL("dump_sync_run1_0.melt", "dump_async_run1_0.melt");
+    ASSERT_FILE_EQUAL("dump_sync_run1_1.melt", "dump_async_run1_1.melt");
+    delete_file("dump_sync_run1_0.melt");
+    delete_file("dump_sync_run1_1.melt");
+    delete_file("dump_async_run1_0.melt");
+    delete_file("dump_async_run1_1.melt");
+}
+
+TEST_F(DumpAtomTest, dump_modify_async_invalid)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all atom 1 dump.txt");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*Illegal dump_modify command.*", command("dump_modify id async true"););
+}
+
 TEST_F(DumpAtomTest, dump_modify_scale_invalid)
 {
     BEGIN_HIDE_OUTPUT();
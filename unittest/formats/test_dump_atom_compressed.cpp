@@ -14,6 +14,7 @@
 #include "../testing/utils.h"
 #include "compressed_dump_test.h"
 #include "fmt/format.h"
+#include "info.h"
 #include "utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -89,6 +90,31 @@ TEST_F(DumpAtomCompressTest, compressed_no_buffer_run0)
     delete_file(converted_file);
 }
 
+TEST_F(DumpAtomCompressTest, compressed_async_run1)
+{
+    if (!COMPRESS_BINARY) GTEST_SKIP();
+    if (!Info::has_async_dump_support()) GTEST_SKIP();
+
+    auto text_file       = text_dump_filename("async_run1.melt");
+    auto compressed_file = compressed_dump_filename("async_run1.melt");
+
+    generate_text_and_compressed_dump(text_file, compressed_file, "", "", "", "async yes", 1);
+
+    TearDown();
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(compressed_file);
+
+    auto converted_file = convert_compressed_to_text(compressed_file);
+
+    ASSERT_THAT(converted_file, Eq(converted_dump_filename("async_run1.melt")));
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+    delete_file(text_file);
+    delete_file(compressed_file);
+    delete_file(converted_file);
+}
+
 TEST_F(DumpAtomCompressTest, compressed_multi_file_run1)
 {
     if (!COMPRESS_BINARY) GTEST_SKIP();
@@ -129,6 +155,43 @@ TEST_F(DumpAtomCompressTest, compressed_multi_file_run1)
     delete_file(converted_file_1);
 }
 
+TEST_F(DumpAtomCompressTest, compressed_async_multi_file_run1)
+{
+    if (!COMPRESS_BINARY) GTEST_SKIP();
+    if (!Info::has_async_dump_support()) GTEST_SKIP();
+
+    auto base_name         = "async_multi_file_run1_*.melt";
+    auto base_name_0       = "async_multi_file_run1_0.melt";
+    auto base_name_1       = "async_multi_file_run1_1.melt";
+    auto text_file         = text_dump_filename(base_name);
+    auto text_file_0       = text_dump_filename(base_name_0);
+    auto text_file_1       = text_dump_filename(base_name_1);
+    auto compressed_file   = compressed_dump_filename(base_name);
+    auto compressed_file_0 = compressed_dump_filename(base_name_0);
+    auto compressed_file_1 = compressed_dump_filename(base_name_1);
+
+    generate_text_and_compressed_dump(text_file, compressed_file, "", "", "", "async yes", 1);
+
+    TearDown();
+
+    auto converted_file_0 = convert_compressed_to_text(compressed_file_0);
+    auto converted_file_1 = convert_compressed_to_text(compressed_file_1);
+
+    ASSERT_THAT(converted_file_0, Eq(converted_dump_filename(base_name_0)));
+    ASSERT_THAT(converted_file_1, Eq(converted_dump_filename(base_name_1)));
+    ASSERT_FILE_EXISTS(converted_file_0);
+    ASSERT_FILE_EXISTS(converted_file_1);
+    ASSERT_FILE_EQUAL(text_file_0, converted_file_0);
+    ASSERT_FILE_EQUAL(text_file_1, converted_file_1);
+
+    delete_file(text_file_0);
+    delete_file(text_file_1);
+    delete_file(compressed_file_0);
+    delete_file(compressed_file_1);
+    delete_file(converted_file_0);
+    delete_file(converted_file_1);
+}
+
 TEST_F(DumpAtomCompressTest, compressed_multi_file_with_pad_run1)
 {
     if (!COMPRESS_BINARY) GTEST_SKIP();
@@ -0,0 +1,272 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "../testing/utils.h"
+#include "atom.h"
+#include "fmt/format.h"
+#include "info.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using LAMMPS_NS::bigint;
+using LAMMPS_NS::tagint;
+using LAMMPS_NS::utils::split_words;
+
+static const char data_file[] = "test_dump_cac_nodal_binary.data";
+
+// one 4x4x4 cell fcc element topped by two layers of lattice cells of atoms
+
+static void create_data_file(const char *filename)
+{
+    const double a = 3.615;
+    const int sc = 4, nlayers = 2;
+    const double basis[4][3] = {{0, 0, 0}, {0.5, 0.5, 0}, {0.5, 0, 0.5}, {0, 0.5, 0.5}};
+    const int corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                               {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    std::string elements = fmt::format("1 Eight_Node 4 {} {} {}\n", sc, sc, sc);
+    for (int p = 0; p < 4; p++)
+        for (int n = 0; n < 8; n++)
+            elements += fmt::format("{} {} 1 {:.6f} {:.6f} {:.6f}\n", n + 1, p + 1,
+                                    (basis[p][0] + corners[n][0] * sc) * a,
+                                    (basis[p][1] + corners[n][1] * sc) * a,
+                                    (basis[p][2] + corners[n][2] * sc) * a);
+
+    int id      = 1;
+    double ztop = sc * a;
+    for (int ix = 0; ix < sc; ix++)
+        for (int iy = 0; iy < sc; iy++)
+            for (int iz = 0; iz < nlayers; iz++)
+                for (int b = 0; b < 4; b++) {
+                    elements += fmt::format("{} Atom 1 1 1 1\n1 1 1 {:.6f} {:.6f} {:.6f}\n", ++id,
+                                            (ix + basis[b][0] + 0.5) * a,
+                                            (iy + basis[b][1] + 0.5) * a,
+                                            ztop + (iz + basis[b][2] + 0.5) * a);
+                }
+
+    FILE *fp = fopen(filename, "w");
+    if (!fp) return;
+    fmt::print(fp, "dump cac/nodal/binary test\n\n{} cac elements\n1 atom types\n\n", id);
+    fmt::print(fp, "-5 {} xlo xhi\n-5 {} ylo yhi\n-5 {} zlo zhi\n\n", sc * a + 5, sc * a + 5,
+               ztop + nlayers * a + 5);
+    fmt::print(fp, "Masses\n\n1 63.546\n\n CAC Elements\n\n{}", elements);
+    fclose(fp);
+}
+
+// timestep, connectivity flag and element IDs of each frame of a dump file
+
+struct Frame {
+    bigint ntimestep;
+    int connflag;
+    std::vector<tagint> ids;
+};
+
+static std::vector<Frame> read_frames(const std::string &file)
+{
+    std::vector<Frame> frames;
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return frames;
+
+    char magic[8];
+    int values[4];
+    if ((fread(magic, 1, 8, fp) != 8) || (strncmp(magic, "CACNODAL", 8) != 0) ||
+        (fread(values, sizeof(int), 4, fp) != 4)) {
+        fclose(fp);
+        return frames;
+    }
+    int nfields   = 0;
+    for (int bit = 1; bit <= 4; bit <<= 1)
+        if (values[1] & bit) nfields++;
+    int conn_size = 7 + values[3];
+
+    Frame frame;
+    int flags[2];
+    double box[9];
+    bigint counts[2];
+    while (fread(&frame.ntimestep, sizeof(bigint), 1, fp) == 1) {
+        if ((fread(flags, sizeof(int), 2, fp) != 2) || (fread(box, sizeof(double), 9, fp) != 9) ||
+            (fread(counts, sizeof(bigint), 2, fp) != 2))
+            break;
+        frame.connflag = flags[1];
+        frame.ids.clear();
+        if (frame.connflag) {
+            std::vector<double> conn(counts[0] * conn_size);
+            if (fread(conn.data(), sizeof(double), conn.size(), fp) != conn.size()) break;
+            for (bigint i = 0; i < counts[0]; i++) frame.ids.push_back((tagint)conn[i * conn_size]);
+        }
+        std::vector<double> nodal(3 * counts[1] * nfields);
+        if (fread(nodal.data(), sizeof(double), nodal.size(), fp) != nodal.size()) break;
+        frames.push_back(frame);
+    }
+    fclose(fp);
+    return frames;
+}
+
+namespace LAMMPS_NS {
+
+class DumpCACNodalBinaryTest : public LAMMPSTest {
+protected:
+    static void SetUpTestSuite() { create_data_file(data_file); }
+
+    static void TearDownTestSuite() { remove(data_file); }
+
+    void SetUp() override
+    {
+        testbinary = "DumpCACNodalBinaryTest";
+        LAMMPSTest::SetUp();
+        if (!info->has_style("atom", "cac")) GTEST_SKIP();
+        BEGIN_HIDE_OUTPUT();
+        command("units metal");
+        command("dimension 3");
+        command("boundary s s s");
+        command("atom_style cac 8 4");
+        command("atom_modify map array");
+        command("comm_style cac");
+        command("newton off");
+        command(fmt::format("read_data {}", data_file));
+        command("pair_style cac/lj 5.5");
+        command("pair_coeff 1 1 0.4093 2.338");
+        command("timestep 0.002");
+        command("velocity/cac all create 600 12345 loop geom");
+        command("fix NVE all cac/nve");
+        END_HIDE_OUTPUT();
+    }
+
+    // nodal positions and velocities of all elements by ID
+
+    std::map<tagint, std::vector<double>> nodal_state()
+    {
+        Atom *atom = lmp->atom;
+        std::map<tagint, std::vector<double>> state;
+        for (int i = 0; i < atom->nlocal; i++) {
+            int npe = atom->nodes_per_element_list[atom->element_type[i]];
+            std::vector<double> &one = state[atom->tag[i]];
+            for (int ipoly = 0; ipoly < atom->poly_count[i]; ipoly++)
+                for (int k = 0; k < npe; k++)
+                    for (int d = 0; d < 3; d++) {
+                        one.push_back(atom->nodal_positions[i][ipoly][k][d]);
+                        one.push_back(atom->nodal_velocities[i][ipoly][k][d]);
+                    }
+        }
+        return state;
+    }
+};
+
+TEST_F(DumpCACNodalBinaryTest, RoundTrip)
+{
+    auto dump_file = "dump_cac_nodal_binary_roundtrip.bin";
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump D all cac/nodal/binary 10 {} positions velocities forces", dump_file));
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+
+    auto before = nodal_state();
+
+    BEGIN_HIDE_OUTPUT();
+    command("undump D");
+    command("run 20 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_NE(nodal_state(), before);
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("read_dump {} 10 nodal/positions nodal/velocities box no format cac/nodal",
+                        dump_file));
+    END_HIDE_OUTPUT();
+
+    ASSERT_EQ(nodal_state(), before);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpCACNodalBinaryTest, ConnectivityOnce)
+{
+    // reordering elements by sorting must not rewrite the connectivity
+
+    auto dump_file = "dump_cac_nodal_binary_once.bin";
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort 1 2.0");
+    command(fmt::format("dump D all cac/nodal/binary 5 {} positions", dump_file));
+    command("run 20 post no");
+    command("undump D");
+    END_HIDE_OUTPUT();
+
+    auto frames = read_frames(dump_file);
+    ASSERT_EQ(frames.size(), 5);
+    ASSERT_EQ(frames[0].connflag, 1);
+    ASSERT_EQ(frames[0].ids.size(), 129);
+    for (size_t i = 1; i < frames[0].ids.size(); i++)
+        ASSERT_LT(frames[0].ids[i - 1], frames[0].ids[i]);
+    for (size_t i = 1; i < frames.size(); i++)
+        ASSERT_EQ(frames[i].connflag, 0);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpCACNodalBinaryTest, ConnectivityChanged)
+{
+    // converting the element to atoms changes the set of dumped elements
+
+    auto dump_file = "dump_cac_nodal_binary_changed.bin";
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump D all cac/nodal/binary 1 {} positions", dump_file));
+    command("run 1 post no");
+    command("fix AD all cac/adapt 1 split strain 1.0e-6 energy no");
+    command("run 2 post no");
+    command("undump D");
+    END_HIDE_OUTPUT();
+
+    auto frames = read_frames(dump_file);
+    ASSERT_EQ(frames.size(), 4);
+    ASSERT_EQ(frames[0].connflag, 1);
+    ASSERT_EQ(frames[1].connflag, 0);
+    ASSERT_EQ(frames[2].connflag, 1);
+    ASSERT_EQ(frames[2].ids.size(), 384);
+    ASSERT_EQ(frames[3].connflag, 0);
+    delete_file(dump_file);
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -24,8 +24,10 @@
 #include "gtest/gtest.h"
 
 #include <cstdio>
+#include <map>
 #include <mpi.h>
 #include <string>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -396,6 +398,54 @@ TEST_F(FileOperationsTest, write_restart)
     if (info->has_package("MPIIO")) delete_file("test.restart.mpiio");
 }
 
+TEST_F(FileOperationsTest, write_restart_shard)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    command("atom_modify map array");
+    command("lattice sc 1.0");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("displace_atoms all random 0.1 0.1 0.1 6534");
+    command("reset_timestep 333");
+    command("write_restart test.shard.restart shard yes");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS("test.shard.restart");
+
+    bigint natoms = lmp->atom->natoms;
+    std::map<tagint, std::vector<double>> coords;
+    for (int i = 0; i < lmp->atom->nlocal; i++)
+        coords[lmp->atom->tag[i]] = {lmp->atom->x[i][0], lmp->atom->x[i][1], lmp->atom->x[i][2]};
+
+    TEST_FAILURE(".*ERROR: Cannot use write_restart shard with % in restart file name.*",
+                 command("write_restart multi-%.restart shard yes"););
+    if (info->has_package("MPIIO")) {
+        TEST_FAILURE(".*ERROR: Cannot use write_restart shard with MPI-IO restart file.*",
+                     command("write_restart test.restart.mpiio shard yes"););
+    } else {
+        TEST_FAILURE(".*ERROR: Writing to MPI-IO filename when MPIIO package is not inst.*",
+                     command("write_restart test.restart.mpiio shard yes"););
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("atom_modify map array");
+    command("read_restart test.shard.restart");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, natoms);
+    ASSERT_EQ(lmp->update->ntimestep, 333);
+    ASSERT_EQ(lmp->atom->nlocal, (int)coords.size());
+    for (int i = 0; i < lmp->atom->nlocal; i++) {
+        auto &x = coords.at(lmp->atom->tag[i]);
+        EXPECT_EQ(lmp->atom->x[i][0], x[0]);
+        EXPECT_EQ(lmp->atom->x[i][1], x[1]);
+        EXPECT_EQ(lmp->atom->x[i][2], x[2]);
+    }
+    delete_file("test.shard.restart");
+}
+
 TEST_F(FileOperationsTest, write_data)
 {
     BEGIN_HIDE_OUTPUT();